@@ -0,0 +1,121 @@
+#ifndef __CLOCK_CONFIG__      // Derleme zamanı saat ağacı için header guard başlangıcı
+#define __CLOCK_CONFIG__
+
+// Hedef sistem saati derleme anında seçilir (örn. -DCLOCK_SYSCLK_HZ=72000000).
+// Denenmiş değerler: 72 MHz ve 168 MHz. Diğer değerler aşağıdaki kontrollerden geçiyorsa kullanılabilir.
+#define CLOCK_PRESET_72MHZ      72000000
+#define CLOCK_PRESET_168MHZ     168000000
+
+#ifndef CLOCK_SYSCLK_HZ
+#define CLOCK_SYSCLK_HZ         CLOCK_PRESET_168MHZ
+#endif
+
+#define CLOCK_HSE_HZ            8000000     // Karttaki harici kristal
+#define CLOCK_USB_HZ            48000000    // PLLQ çıkışı (USB OTG FS, SDIO, RNG) tam 48 MHz olmalı
+
+// Kullanılan sınırlar (RM0090 / STM32F407 datasheet, VDD = 2.7-3.6 V, VOS = Scale 1)
+#define CLOCK_MAX_SYSCLK_HZ     168000000
+#define CLOCK_MAX_PCLK1_HZ      42000000
+#define CLOCK_MAX_PCLK2_HZ      84000000
+#define CLOCK_MAX_ADCCLK_HZ     36000000
+#define CLOCK_FLASH_WS_STEP_HZ  30000000    // Her 30 MHz için bir bekleme durumu (wait state)
+
+// PLL: VCO girişi 1 MHz, VCO = 2 × SYSCLK, P = 2, Q = VCO / 48 MHz
+#define CLOCK_PLL_IN_HZ         1000000
+#define CLOCK_PLLM              (CLOCK_HSE_HZ / CLOCK_PLL_IN_HZ)
+#define CLOCK_PLLP              2
+#define CLOCK_VCO_HZ            (CLOCK_SYSCLK_HZ * CLOCK_PLLP)
+#define CLOCK_PLLN              (CLOCK_VCO_HZ / CLOCK_PLL_IN_HZ)
+#define CLOCK_PLLQ              (CLOCK_VCO_HZ / CLOCK_USB_HZ)
+#define CLOCK_PLLP_BITS         ((CLOCK_PLLP / 2) - 1)          // PLLCFGR PLLP: 00 = /2, 01 = /4, 10 = /6, 11 = /8
+
+// Flash bekleme durumu: 0-30 MHz → 0WS, 30-60 MHz → 1WS, ..., 150-168 MHz → 5WS
+#define CLOCK_FLASH_WS          ((CLOCK_SYSCLK_HZ - 1) / CLOCK_FLASH_WS_STEP_HZ)
+
+// AHB bölücüsü hep 1: HCLK = SYSCLK (CPU, DMA, SysTick, DWT aynı saatte)
+#define CLOCK_HCLK_HZ           CLOCK_SYSCLK_HZ
+
+// APB1 / APB2: sınırı aşmayan en küçük bölücü
+#if   CLOCK_HCLK_HZ <= CLOCK_MAX_PCLK1_HZ
+#define CLOCK_APB1_DIV          1
+#elif CLOCK_HCLK_HZ <= 2 * CLOCK_MAX_PCLK1_HZ
+#define CLOCK_APB1_DIV          2
+#elif CLOCK_HCLK_HZ <= 4 * CLOCK_MAX_PCLK1_HZ
+#define CLOCK_APB1_DIV          4
+#else
+#define CLOCK_APB1_DIV          8
+#endif
+
+#if   CLOCK_HCLK_HZ <= CLOCK_MAX_PCLK2_HZ
+#define CLOCK_APB2_DIV          1
+#elif CLOCK_HCLK_HZ <= 2 * CLOCK_MAX_PCLK2_HZ
+#define CLOCK_APB2_DIV          2
+#else
+#define CLOCK_APB2_DIV          4
+#endif
+
+#define CLOCK_PCLK1_HZ          (CLOCK_HCLK_HZ / CLOCK_APB1_DIV)
+#define CLOCK_PCLK2_HZ          (CLOCK_HCLK_HZ / CLOCK_APB2_DIV)
+
+// APB bölücüsü 1 değilse timer'lar PCLK'nın iki katıyla çalışır (RM0090, 6.2 Clocks)
+#define CLOCK_APB1_TIMER_HZ     (CLOCK_APB1_DIV == 1 ? CLOCK_PCLK1_HZ : 2 * CLOCK_PCLK1_HZ)
+#define CLOCK_APB2_TIMER_HZ     (CLOCK_APB2_DIV == 1 ? CLOCK_PCLK2_HZ : 2 * CLOCK_PCLK2_HZ)
+
+// CFGR PPRE kodları: 0xx = /1, 100 = /2, 101 = /4, 110 = /8, 111 = /16
+#define CLOCK_PPRE_BITS(div)    ((div) == 1 ? 0 : (div) == 2 ? 4 : (div) == 4 ? 5 : (div) == 8 ? 6 : 7)
+#define CLOCK_PPRE1_BITS        CLOCK_PPRE_BITS(CLOCK_APB1_DIV)
+#define CLOCK_PPRE2_BITS        CLOCK_PPRE_BITS(CLOCK_APB2_DIV)
+
+// ADC saati PCLK2'den gelir, bölücü 2/4/6/8 olabilir (ADC->CCR ADCPRE)
+#if   CLOCK_PCLK2_HZ <= 2 * CLOCK_MAX_ADCCLK_HZ
+#define CLOCK_ADC_DIV           2
+#elif CLOCK_PCLK2_HZ <= 4 * CLOCK_MAX_ADCCLK_HZ
+#define CLOCK_ADC_DIV           4
+#elif CLOCK_PCLK2_HZ <= 6 * CLOCK_MAX_ADCCLK_HZ
+#define CLOCK_ADC_DIV           6
+#else
+#define CLOCK_ADC_DIV           8
+#endif
+
+#define CLOCK_ADC_HZ            (CLOCK_PCLK2_HZ / CLOCK_ADC_DIV)
+#define CLOCK_ADCPRE_BITS       ((CLOCK_ADC_DIV / 2) - 1)       // 00 = /2, 01 = /4, 10 = /6, 11 = /8
+
+// SysTick (1 ms) ve µs gecikme sabitleri
+#define CLOCK_SYSTICK_HZ        1000
+#define CLOCK_SYSTICK_RELOAD    ((CLOCK_HCLK_HZ / CLOCK_SYSTICK_HZ) - 1)
+#define CLOCK_CYCLES_PER_US     (CLOCK_HCLK_HZ / 1000000)
+#define CLOCK_CYCLES_PER_MS     (CLOCK_HCLK_HZ / 1000)
+
+// Geçersiz birleşimler derleme anında yakalanır
+_Static_assert(CLOCK_SYSCLK_HZ % 1000000 == 0,                         "SYSCLK tam MHz olmalı");
+_Static_assert(CLOCK_SYSCLK_HZ <= CLOCK_MAX_SYSCLK_HZ,                 "SYSCLK 168 MHz'i aşamaz");
+_Static_assert(CLOCK_HSE_HZ % CLOCK_PLL_IN_HZ == 0,                    "HSE, PLL girişine tam bölünmeli");
+_Static_assert(CLOCK_PLLM >= 2 && CLOCK_PLLM <= 63,                    "PLLM 2-63 aralığında olmalı");
+_Static_assert(CLOCK_PLL_IN_HZ >= 1000000 && CLOCK_PLL_IN_HZ <= 2000000, "VCO girişi 1-2 MHz olmalı");
+_Static_assert(CLOCK_PLLN >= 50 && CLOCK_PLLN <= 432,                  "PLLN 50-432 aralığında olmalı");
+_Static_assert(CLOCK_VCO_HZ >= 100000000 && CLOCK_VCO_HZ <= 432000000, "VCO çıkışı 100-432 MHz olmalı");
+_Static_assert(CLOCK_VCO_HZ % CLOCK_USB_HZ == 0,                       "VCO, 48 MHz'e tam bölünmeli (USB)");
+_Static_assert(CLOCK_PLLQ >= 2 && CLOCK_PLLQ <= 15,                    "PLLQ 2-15 aralığında olmalı");
+_Static_assert(CLOCK_FLASH_WS <= 7,                                    "Flash bekleme durumu 0-7 olmalı");
+_Static_assert(CLOCK_PCLK1_HZ <= CLOCK_MAX_PCLK1_HZ,                   "APB1 42 MHz'i aşamaz");
+_Static_assert(CLOCK_PCLK2_HZ <= CLOCK_MAX_PCLK2_HZ,                   "APB2 84 MHz'i aşamaz");
+_Static_assert(CLOCK_ADC_HZ <= CLOCK_MAX_ADCCLK_HZ,                    "ADC saati 36 MHz'i aşamaz");
+_Static_assert(CLOCK_APB1_TIMER_HZ % 1000000 == 0,                     "TIM2 1 µs tick için timer saati tam MHz olmalı");
+_Static_assert(CLOCK_SYSTICK_RELOAD <= 0xFFFFFF,                       "SysTick reload 24 biti aşamaz");
+
+// Denenmiş hazır ayarlar için beklenen değerler
+#if CLOCK_SYSCLK_HZ == CLOCK_PRESET_168MHZ
+_Static_assert(CLOCK_PLLM == 8 && CLOCK_PLLN == 336 && CLOCK_PLLQ == 7, "168 MHz: PLL 8/336/2/7 olmalı");
+_Static_assert(CLOCK_FLASH_WS == 5,                                    "168 MHz: 5 bekleme durumu");
+_Static_assert(CLOCK_APB1_DIV == 4 && CLOCK_APB2_DIV == 2,             "168 MHz: APB1 /4, APB2 /2");
+_Static_assert(CLOCK_APB1_TIMER_HZ == 84000000,                        "168 MHz: APB1 timer saati 84 MHz");
+_Static_assert(CLOCK_ADC_HZ == 21000000,                               "168 MHz: ADC saati 21 MHz");
+#elif CLOCK_SYSCLK_HZ == CLOCK_PRESET_72MHZ
+_Static_assert(CLOCK_PLLM == 8 && CLOCK_PLLN == 144 && CLOCK_PLLQ == 3, "72 MHz: PLL 8/144/2/3 olmalı");
+_Static_assert(CLOCK_FLASH_WS == 2,                                    "72 MHz: 2 bekleme durumu");
+_Static_assert(CLOCK_APB1_DIV == 2 && CLOCK_APB2_DIV == 1,             "72 MHz: APB1 /2, APB2 /1");
+_Static_assert(CLOCK_APB1_TIMER_HZ == 72000000,                        "72 MHz: APB1 timer saati 72 MHz");
+_Static_assert(CLOCK_ADC_HZ == 36000000,                               "72 MHz: ADC saati 36 MHz");
+#endif
+
+#endif  // __CLOCK_CONFIG__   // Header guard bitişi
@@ -1,9 +1,12 @@
 #ifndef __DELAY__     // Header dosyasının birden fazla kez include edilmesini engellemek için koruma tanımı başlatılır
 #define __DELAY__
 
+#include "clock_config.h"   // CLOCK_CYCLES_PER_US: seçilen sistem saatinden türetilir
+
 void systick_config(void);     // SysTick yapılandırma fonksiyonu (1ms tabanlı delay için)
 void SysTick_Handler(void);    // SysTick kesme fonksiyonu prototipi
 void delay_ms(uint32_t ms);    // Milisaniye cinsinden gecikme fonksiyonu
+uint32_t millis(void);         // Açılıştan beri geçen milisaniye (serbest sayar)
 
 uint32_t DWT_Delay_Init(void); // DWT modülünü başlatan fonksiyon (mikrosaniye delay için kullanılacak)
 
@@ -11,8 +14,15 @@ uint32_t DWT_Delay_Init(void); // DWT modülünü başlatan fonksiyon (mikrosani
 __STATIC_INLINE void DWT_Delay_us(volatile uint32_t microseconds)   // Inline fonksiyon: mikro saniye gecikme yapar
 {
   uint32_t clk_cycle_start = DWT->CYCCNT;                          // Başlangıç cycle değerini al
-  microseconds *= (72000000 / 1000000);                            // 72 MHz -> 1 µs = 72 clock cycle, çevrim sayısına çevir
+  microseconds *= CLOCK_CYCLES_PER_US;                             // 168 MHz -> 1 µs = 168 clock cycle, çevrim sayısına çevir
   while ((DWT->CYCCNT - clk_cycle_start) < microseconds);          // İstenen süre dolana kadar bekle (busy-wait döngüsü)
 }
 
+__STATIC_INLINE void DWT_Delay_ns(uint32_t nanoseconds)            // Inline fonksiyon: nano saniye gecikme yapar (LCD darbe süreleri için)
+{
+  uint32_t clk_cycle_start = DWT->CYCCNT;                          // Başlangıç cycle değerini al
+  uint32_t cycles = (nanoseconds * CLOCK_CYCLES_PER_US + 999) / 1000;   // 168 MHz -> 1 cycle ≈ 5.95 ns, yukarı yuvarla
+  while ((DWT->CYCCNT - clk_cycle_start) < cycles);                // İstenen süre dolana kadar bekle
+}
+
 #endif  // __DELAY__   // Header guard bitişi
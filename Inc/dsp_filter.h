@@ -0,0 +1,53 @@
+#ifndef __DSP_FILTER__        // Q15 FIR / biquad / medyan filtre modülü için header guard başlangıcı
+#define __DSP_FILTER__
+
+#include <stdint.h>
+
+// Cortex-M4 DSP komutları (SMLALD, SMUAD, PKHBT) derleyici hedefi destekliyorsa kullanılır; bilgisayarda taşınabilir C.
+// Bilgisayarda -DDSP_FILTER_SIMD=1 ile bu komutları C ile taklit eden bir stm32f4xx.h verilerek iki yol karşılaştırılabilir.
+#ifndef DSP_FILTER_SIMD
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+#define DSP_FILTER_SIMD     1
+#else
+#define DSP_FILTER_SIMD     0
+#endif
+#endif
+
+#define DSP_MEDIAN_MAX      7           // En uzun medyan penceresi (3, 5 veya 7)
+
+typedef struct {
+    const int16_t* coeffs;      // Q15, ters zaman sırasında: coeffs[0] = h[taps-1] (simetrik FIR'de fark etmez)
+    int16_t* state;             // taps - 1 + block_max örneklik tampon (çağıran sağlar)
+    uint16_t taps;
+    uint16_t block_max;         // state'e tek seferde giren en fazla örnek (uzun bloklar parçalanır)
+} dsp_fir_t;
+
+typedef struct {
+    const int16_t* coeffs;      // Kat başına 6: {b0, 0, b1, b2, a1, a2}; a1, a2 işareti ters (y = ... + a1·y[n-1] + a2·y[n-2])
+    int16_t* state;             // Kat başına 4: {x[n-1], x[n-2], y[n-1], y[n-2]} (çağıran sağlar)
+    uint8_t stages;
+    uint8_t post_shift;         // Katsayılar Q(15 - post_shift): 1 → Q14, |katsayı| < 2
+} dsp_biquad_t;
+
+typedef struct {
+    int16_t window[DSP_MEDIAN_MAX];     // Son taps örnek (halka)
+    uint8_t taps;
+    uint8_t pos;                // En eski örneğin yeri
+} dsp_median_t;
+
+// Hepsinde in ve out aynı dizi olabilir (yerinde filtreleme)
+uint8_t dsp_fir_init(dsp_fir_t* f, const int16_t* coeffs, uint16_t taps, int16_t* state, uint16_t block_max);  // 0: başarılı, 1: geçersiz
+void dsp_fir_process(dsp_fir_t* f, const int16_t* in, int16_t* out, uint16_t n);       // Hedefte çift MAC (SMLALD)
+void dsp_fir_process_c(dsp_fir_t* f, const int16_t* in, int16_t* out, uint16_t n);     // Taşınabilir C, sonucu bit bit aynı
+
+uint8_t dsp_biquad_init(dsp_biquad_t* b, const int16_t* coeffs, uint8_t stages, int16_t* state, uint8_t post_shift);
+void dsp_biquad_process(dsp_biquad_t* b, const int16_t* in, int16_t* out, uint16_t n);
+void dsp_biquad_process_c(dsp_biquad_t* b, const int16_t* in, int16_t* out, uint16_t n);
+
+uint8_t dsp_median_init(dsp_median_t* m, uint8_t taps, int16_t initial);   // taps: 3, 5 veya 7
+void dsp_median_process(dsp_median_t* m, const int16_t* in, int16_t* out, uint16_t n);
+int16_t dsp_median_of(const int16_t* v, uint8_t taps);                      // v değişmez; sıralama ağı ile medyan
+
+void dsp_filter_bench(void (*put)(char c));     // PROF_ENABLE ile: her çekirdek ve uzunluk için cycle / örnek tablosu
+
+#endif  // __DSP_FILTER__     // Header guard bitişi
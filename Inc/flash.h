@@ -0,0 +1,19 @@
+#ifndef __FLASH__             // Dahili flash sürücüsü için header guard başlangıcı
+#define __FLASH__
+
+#include <stdint.h>
+
+#define FLASH_SECTOR_CALIB_FIRST 10             // Kalibrasyon kayıtları: sektör 10-11 dönüşümlü (0x080C0000-0x080FFFFF, 2 × 128 KB)
+#define FLASH_SECTOR_CALIB_COUNT 2
+#define FLASH_SECTOR_LOG_FIRST  8               // Örnek geçmişi halkası: sektör 8-9 (0x08080000-0x080BFFFF, 2 × 128 KB)
+#define FLASH_SECTOR_LOG_COUNT  2
+
+void flash_unlock(void);                                    // FLASH->CR yazma kilidini açar
+void flash_lock(void);                                      // Kilidi tekrar kapatır
+uint8_t flash_erase_sector(uint8_t sector);                 // Sektörü siler (0: başarılı, 1: hata)
+uint8_t flash_program_word(uint32_t address, uint32_t data); // 32-bit kelime yazar (0: başarılı, 1: hata)
+uint32_t flash_read_word(uint32_t address);                  // 32-bit kelime okur
+uint32_t flash_sector_address(uint8_t sector);              // Sektörün başlangıç adresi
+uint32_t flash_sector_size(uint8_t sector);                 // Sektörün bayt cinsinden boyutu
+
+#endif  // __FLASH__          // Header guard bitişi
@@ -0,0 +1,47 @@
+#ifndef __FLASH_LOG__         // Flash üzerinde halka kayıt defteri için header guard başlangıcı
+#define __FLASH_LOG__
+
+#include <stdint.h>
+
+#define FLASH_LOG_MAGIC         0x314C474DU     // "MGL1": sektör başlığı tamam
+#define FLASH_LOG_COMMIT_KEY    0xA5C3E1F0U     // Kayıt onay kelimesi = w0 ^ w1 ^ w2 ^ anahtar
+#define FLASH_LOG_HEADER_SIZE   16              // magic, seq, ~seq, ayrılmış
+#define FLASH_LOG_RECORD_SIZE   16              // 4 kelime, onay kelimesi en son yazılır
+#define FLASH_LOG_STAGE_RECORDS 16              // RAM'de biriktirilen kayıt sayısı (bir yazımda 256 bayt)
+#define FLASH_LOG_PREERASE_PERCENT 75           // Aktif sektör bu kadar dolunca sıradaki sektör önceden silinir
+
+typedef struct {
+    uint32_t timestamp_s;           // Açılıştan beri saniye
+    uint16_t min;
+    uint16_t max;
+    uint16_t mean;
+    uint16_t count;                 // Özete giren örnek sayısı
+} flash_log_record_t;
+
+typedef struct {
+    uint32_t sum;
+    uint16_t min;
+    uint16_t max;
+    uint16_t count;
+} flash_log_acc_t;                  // Bir saniyelik özeti toplayan yardımcı
+
+typedef struct {
+    uint32_t seq;                   // Gezilen sektörün sıra numarası
+    uint8_t sector;                 // FLASH_SECTOR_LOG_FIRST'e göre indeks
+    uint32_t address;
+    uint8_t staged;                 // Flash bitti, RAM'deki kayıtlar geziliyor
+} flash_log_iter_t;
+
+uint8_t flash_log_init(void);                               // Sektörleri tarar, aktif sektörü ve yazma konumunu bulur (0: başarılı)
+uint8_t flash_log_append(const flash_log_record_t* record); // Kaydı RAM sayfasına ekler; sayfa dolunca flash'a yazar (0: başarılı)
+uint8_t flash_log_flush(void);                              // Bekleyen kayıtları hemen yazar (0: başarılı)
+uint8_t flash_log_staged(void);                             // RAM'de bekleyen kayıt sayısı
+uint8_t flash_log_service(void);                            // Gerekiyorsa sıradaki sektörü önceden siler (1-2 sn bekler; alarm yokken, 0: başarılı)
+void flash_log_iter_begin(flash_log_iter_t* it);            // En eski kayıttan başlar
+uint8_t flash_log_iter_next(flash_log_iter_t* it, flash_log_record_t* record);  // 0: kayıt verildi, 1: bitti
+
+void flash_log_acc_reset(flash_log_acc_t* acc);
+void flash_log_acc_add(flash_log_acc_t* acc, uint16_t value);
+void flash_log_acc_take(flash_log_acc_t* acc, uint32_t timestamp_s, flash_log_record_t* record);  // Özeti çıkarır ve sıfırlar
+
+#endif  // __FLASH_LOG__      // Header guard bitişi
@@ -0,0 +1,20 @@
+#ifndef __FMT__               // Sabit genişlikli sayı biçimlendirme için header guard başlangıcı
+#define __FMT__
+
+#include <stdint.h>
+
+#define FMT_MAX_DIGITS      10          // 32-bit bir sayının en fazla basamak sayısı
+#define FMT_OVERFLOW_CHAR   '*'         // Sayı alana sığmazsa alan bununla doldurulur
+
+typedef enum {
+    FMT_ALIGN_RIGHT,
+    FMT_ALIGN_LEFT
+} fmt_align_t;
+
+// Hepsi dst'ye tam olarak width karakter yazar, sonuna '\0' EKLEMEZ (LCD çerçevesine doğrudan yazılabilsin diye).
+// Dönüş: 0 başarılı, 1 sayı sığmadı (alan FMT_OVERFLOW_CHAR ile doldurulur).
+uint8_t fmt_u32(char* dst, uint8_t width, uint32_t value, fmt_align_t align, char pad);
+uint8_t fmt_i32(char* dst, uint8_t width, int32_t value, fmt_align_t align, char pad);
+uint8_t fmt_fixed(char* dst, uint8_t width, int32_t value, uint8_t decimals, fmt_align_t align, char pad);  // value / 10^decimals
+
+#endif  // __FMT__            // Header guard bitişi
@@ -0,0 +1,28 @@
+#ifndef __GAS_ALARM__         // Analog watchdog ile hızlı röle tetiklemesi için header guard başlangıcı
+#define __GAS_ALARM__
+
+#include <stdint.h>
+
+#define GAS_ALARM_RELAY_PIN     12          // PD12: röle girişi (LOW = gaz var, lamba yanar)
+#define GAS_ALARM_HIGH          2300        // 12-bit değer bu eşiği aşınca alarm (analog watchdog ve gas_trend seviye sınırı)
+#define GAS_ALARM_LOW           2200        // Alarm, değer bu eşiğin altına inince kalkar (histerezis)
+#define GAS_ALARM_MIN_ON_US     3000000     // Röle gaz konumunda en az bu kadar kalır (µs, hrtimer ile)
+#define GAS_ALARM_EVENTS        8           // Röle geçiş kuyruğu (2'nin kuvveti olmalı, bir eksiği kadar geçiş tutar)
+
+typedef struct {
+    uint64_t cycles;                        // Geçiş anı (timebase_cycles)
+    uint32_t trips;                         // O ana kadarki alarm girişi sayısı
+    uint8_t state;                          // 1: röle gaz konumuna geçti, 0: bırakıldı
+} gas_alarm_event_t;
+
+void gas_alarm_init(uint8_t channel, uint16_t high, uint16_t low);  // Analog watchdog'u kanala bağlar ve kesmeyi açar (hrtimer_init()'ten sonra)
+void gas_alarm_set_trend(uint8_t alarm);    // gas_trend alarm kademesi (1: alarm); kesmeden çağrılabilir
+uint8_t gas_alarm_active(void);             // Röle gaz konumundaysa 1
+uint32_t gas_alarm_trips(void);             // Alarm girişi sayısı
+uint32_t gas_alarm_latency_last(void);      // Son eşik aşımından röle kenarına kadar geçen süre (CPU cycle)
+uint32_t gas_alarm_latency_max(void);       // Ölçülen en kötü gecikme (CPU cycle)
+uint8_t gas_alarm_event_pop(gas_alarm_event_t* event);  // En eski röle geçişi (0: verildi, 1: kuyruk boş); sadece ana döngü
+uint32_t gas_alarm_events_lost(void);       // Kuyruk doluyken kaybolan geçiş sayısı
+void ADC_IRQHandler(void);
+
+#endif  // __GAS_ALARM__      // Header guard bitişi
@@ -0,0 +1,66 @@
+#ifndef __GAS_TREND__         // Seviye + yükselme hızı ile kademeli gaz alarmı için header guard başlangıcı
+#define __GAS_TREND__
+
+#include <stdint.h>
+
+#define GAS_TREND_WINDOW_MAX    64          // Eğim penceresi en fazla bu kadar örnek (geçmiş halkası 2 × pencere)
+#define GAS_TREND_ACCEL_MAX     64          // İvme penceresi en fazla bu kadar örnek
+
+// Varsayılan ayarlar: 15.625 Hz'lik filtrelenmiş akış (1 kHz / 64), 12-bit ölçek
+#define GAS_TREND_SLOPE_WINDOW  32          // ~2 sn'lik iki pencere
+#define GAS_TREND_ACCEL_WINDOW  32          // ~2 sn önceki eğimle karşılaştırılır
+#define GAS_TREND_LEVEL_PRE     1800        // Ön alarm seviyesi (alarm seviyesi: GAS_ALARM_HIGH)
+#define GAS_TREND_SLOPE_PRE     600         // 10 ADC/sn
+#define GAS_TREND_SLOPE_ALARM   1800        // 30 ADC/sn
+#define GAS_TREND_SLOPE_HYST    300         // Kademeden inmek için eğim sınırın 5 ADC/sn altına düşmeli
+#define GAS_TREND_ACCEL_ALARM   6000        // Ön alarm eğimi ~6 sn'dir sürerken eğim 2 sn'de 200 ADC/dk daha artıyorsa kaçak açılıyor
+#define GAS_TREND_RAISE_MS      500
+#define GAS_TREND_CLEAR_MS      5000
+
+typedef enum {
+    GAS_TREND_NORMAL,
+    GAS_TREND_PREALARM,         // Ön alarm: seviye veya yükselme hızı ilk sınırı geçti (sadece gösterilir)
+    GAS_TREND_ALARM             // Alarm: röle gaz konumuna geçer
+} gas_trend_level_t;
+
+typedef struct {
+    uint32_t rate_mhz;          // Örnek hızı (mHz), örn. 1 kHz / 64 = 15625
+    uint8_t slope_window;       // Eğim: son W örneğin ortalaması ile önceki W örneğin ortalaması farkı (W ≤ GAS_TREND_WINDOW_MAX)
+    uint8_t accel_window;       // İvme: eğimin A örnek önceki eğimden farkı (A ≤ GAS_TREND_ACCEL_MAX)
+    uint16_t level_pre;         // 12-bit ADC seviye sınırları
+    uint16_t level_alarm;
+    uint16_t level_hyst;        // Bir kademeden inmek için sınırın bu kadar altına düşmek gerekir
+    int32_t slope_pre;          // Eğim sınırları (ADC / dakika)
+    int32_t slope_alarm;
+    int32_t slope_hyst;
+    int32_t accel_alarm;        // Eğim 2W + A örnektir ön alarm sınırındayken ivme bunu aşarsa alarm (ADC / dakika²), 0: kullanılmaz
+    uint16_t raise_ms;          // Daha yüksek kademe bu kadar süre kesintisiz istenirse geçilir
+    uint16_t clear_ms;          // Daha düşük kademe bu kadar süre kesintisiz istenirse inilir
+} gas_trend_config_t;
+
+typedef struct {
+    gas_trend_config_t cfg;
+    uint16_t hist[2 * GAS_TREND_WINDOW_MAX];    // Son 2W örnek (halka)
+    int32_t slopes[GAS_TREND_ACCEL_MAX];        // Son A eğim (halka)
+    uint8_t hist_pos;           // En eski örneğin yeri
+    uint8_t slope_pos;          // En eski eğimin yeri
+    uint16_t warmup;            // Eğim / ivme geçerli olana kadar kalan örnek
+    uint16_t rising;            // Eğimin kesintisiz ≥ slope_pre olduğu örnek sayısı (ivme kriteri için)
+    int32_t sum_new;            // Son W örneğin toplamı
+    int32_t sum_old;            // Önceki W örneğin toplamı
+    int32_t slope;              // ADC / dakika
+    int32_t accel;              // ADC / dakika²
+    uint16_t value;             // Son örnek
+    uint16_t raise_samples;     // raise_ms / clear_ms örnek cinsinden
+    uint16_t clear_samples;
+    uint16_t streak;            // Mevcut kademeden farklı bir kademenin kesintisiz istendiği örnek sayısı
+    gas_trend_level_t streak_target;    // O süre boyunca istenen en yakın kademe
+    gas_trend_level_t level;    // Onaylanmış (çıkıştaki) kademe
+} gas_trend_t;
+
+uint8_t gas_trend_init(gas_trend_t* t, const gas_trend_config_t* cfg, uint16_t initial);  // 0: başarılı, 1: geçersiz ayar
+void gas_trend_reset(gas_trend_t* t, uint16_t value);   // Geçmişi value ile doldurur, kademe NORMAL olur
+void gas_trend_hold_rates(gas_trend_t* t);              // Eğim / ivme kriterlerini 2W + A örnek daha bekletir; seviye kriterleri çalışır
+gas_trend_level_t gas_trend_update(gas_trend_t* t, uint16_t adc);  // Her filtrelenmiş örnekte O(1); onaylanmış kademeyi döndürür
+
+#endif  // __GAS_TREND__      // Header guard bitişi
@@ -0,0 +1,17 @@
+#ifndef __HRTIMER__           // TIM2 tabanlı µs zamanlayıcı servisi için header guard başlangıcı
+#define __HRTIMER__
+
+#include <stdint.h>
+#include "timer_wheel.h"
+
+#define HRTIMER_TICK_HZ     1000000     // TIM2 1 MHz sayar: 1 tick = 1 µs, 32 bit → 71.6 dakikada taşar
+#define HRTIMER_IRQ_PRIO    1           // ADC watchdog (0) her zaman önce gelir
+
+void hrtimer_init(void);                                    // TIM2'yi serbest sayan 32-bit sayaç + CC1 compare kesmesi olarak kurar
+uint32_t hrtimer_now(void);                                 // TIM2->CNT (µs)
+uint8_t hrtimer_start(timer_wheel_timer_t* t, uint32_t delay_us, uint32_t period_us);  // 0: kuruldu (bekliyorsa yeniden kurulur)
+void hrtimer_cancel(timer_wheel_timer_t* t);
+uint32_t hrtimer_pending(void);                             // Bekleyen zamanlayıcı sayısı
+void TIM2_IRQHandler(void);                                 // Callback'ler bu kesmenin içinden çağrılır
+
+#endif  // __HRTIMER__        // Header guard bitişi
@@ -0,0 +1,19 @@
+#ifndef __LCD_ASYNC__         // Kesme tabanlı LCD kuyruğu için header guard başlangıcı
+#define __LCD_ASYNC__
+
+#include <stdint.h>
+
+#define LCD_ASYNC_QUEUE_SIZE  128         // Kuyruk kapasitesi (2'nin kuvveti olmalı, en fazla 128; LCD_FLUSH_MAX_BYTES sığmalı)
+#define LCD_ASYNC_WAIT_DMA    0xFFFFFFFFu // lcd_async_step(): transfer sürüyor, bitince taşıma katmanı devam ettirir
+
+void lcd_async_init(void);                              // hrtimer servisinde tek atımlık bekleme zamanlayıcısını hazırlar
+uint8_t lcd_async_command(uint8_t command);             // Komutu kuyruğa ekler (0: başarılı, 1: kuyruk dolu)
+uint8_t lcd_async_data(uint8_t data);                   // Karakteri kuyruğa ekler (0: başarılı, 1: kuyruk dolu)
+uint8_t lcd_async_pending(void);                        // Kuyrukta bekleyen bayt sayısı
+uint8_t lcd_async_free(void);                           // Kuyruktaki boş yer
+uint8_t lcd_async_busy(void);                           // Gönderim devam ediyorsa 1
+void lcd_async_wait(void);                              // Kuyruk boşalana kadar bekler (kesme içinden çağrılmaz)
+void lcd_async_set_callback(void (*callback)(void));    // Kuyruk tamamen boşaldığında ISR içinden çağrılacak fonksiyon
+uint32_t lcd_async_step(void);                          // Durum makinesini bir adım ilerletir, sonraki adıma kadar beklenecek µs'yi döndürür (0: bitti, LCD_ASYNC_WAIT_DMA: devamı I2C kesmesinden; PCF8574'te parti gönderince zaman aşımı süresi)
+
+#endif  // __LCD_ASYNC__      // Header guard bitişi
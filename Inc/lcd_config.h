@@ -4,14 +4,33 @@
 
 #include "stm32f4xx.h"        // STM32F4 donanım tanımlarını içeren header
 
-void lcd_gpio_config(void);                     // LCD için gerekli GPIO pinlerini ayarlar
-void lcd_send_nibble(uint8_t nibble);           // LCD'ye 4-bit (nibble) veri yollar
+#define LCD_ROWS        2     // Panel satır sayısı
+#define LCD_COLS        16    // Panel sütun sayısı
+#define LCD_CGRAM_SLOTS     8     // Kullanıcı tanımlı karakter sayısı (CGRAM)
+#define LCD_GLYPH_ROWS      8     // 5x8 fontta bir karakterin satır sayısı
+#define LCD_SPARK_CELLS     4     // Sparkline genişliği (hücre)
+#define LCD_SPARK_SAMPLES   (LCD_SPARK_CELLS * 5)   // Her hücrede 5 piksel sütunu = 5 örnek
+#define LCD_FLUSH_MAX_BYTES (LCD_ROWS * (LCD_COLS + 1) + \
+                             LCD_CGRAM_SLOTS * (LCD_GLYPH_ROWS + 1))  // En kötü durum: satır başına 1 imleç komutu + 16 karakter, her glyph için adres + 8 satır
+
+void lcd_send_nibble(uint8_t nibble);           // Başlatmadaki tek nibble'lık komutu yollar (taşıma katmanı: lcd_transport.h)
 void lcd_send_command(uint8_t command);         // LCD'ye komut gönderir (ör. clear, cursor ayarı)
 void lcd_send_data(uint8_t data);               // LCD'ye veri (karakter) gönderir
-void lcd_init(void);                            // LCD'yi başlatır (4-bit mod ayarı vs.)
+void lcd_init(void);                            // LCD'yi başlatır (4-bit / 8-bit mod ayarı vs.)
 void lcd_send_command_nibble_only(uint8_t nibble); // LCD’ye sadece nibble komutu gönderir (özel init için)
 void lcd_print_string(const char* str);         // Stringi LCD’ye karakter karakter yazar
 void lcd_clear(void);                           // LCD ekranını temizler ve imleci başa alır
 void lcd_set_cursor(uint8_t row, uint8_t col);  // İmleci istenen satır ve sütuna taşır
 
+void lcd_fb_clear(void);                                        // RAM'deki çerçeveyi boşluk karakterleriyle doldurur
+void lcd_fb_write(uint8_t row, uint8_t col, const char* str);   // Çerçeveye (panele değil) string yazar, taşan kısmı kırpar
+char* lcd_fb_region(uint8_t row, uint8_t col, uint8_t width);   // Çerçevede width hücrelik alanın adresi (sığmıyorsa NULL)
+void lcd_bar_graph(uint8_t row, uint8_t col, uint8_t width, uint16_t value, uint16_t max);  // Çerçeveye yatay çubuk çizer (hücre başına 5 piksel)
+void lcd_sparkline_push(uint16_t value, uint16_t max);          // Sparkline'a yeni örnek ekler, en eskisi soldan kayar
+void lcd_sparkline_draw(uint8_t row, uint8_t col);              // Son LCD_SPARK_SAMPLES örneği çerçeveye çizer (LCD_SPARK_CELLS hücre)
+const uint8_t* lcd_glyph_bitmap(uint8_t slot);                  // Slot için istenen 8 satırlık desen (bit 4 = en sol piksel)
+uint32_t lcd_cgram_uploads(void);                               // Açılıştan beri CGRAM'e gönderilen glyph sayısı
+uint8_t lcd_flush(void);                                        // Sadece değişen hücreleri LCD'ye gönderir, gönderilen bayt sayısını döndürür
+uint8_t lcd_flush_async(void);                                  // lcd_flush ile aynı, ama baytları lcd_async kuyruğuna ekler (beklemez)
+
 #endif  // __LCD__            // Header guard bitişi
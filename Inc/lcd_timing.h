@@ -0,0 +1,79 @@
+#ifndef __LCD_TIMING__        // HD44780 zamanlama profilleri için header guard başlangıcı
+#define __LCD_TIMING__
+
+#include <stdint.h>
+
+// Derleme zamanında seçilebilen profiller
+#define LCD_TIMING_PROFILE_DATASHEET     0      // Datasheet'teki minimum değerler (en hızlı)
+#define LCD_TIMING_PROFILE_CONSERVATIVE  1      // Yavaş osilatörlü / klon paneller için paylı değerler
+
+#ifndef LCD_TIMING_PROFILE
+#define LCD_TIMING_PROFILE  LCD_TIMING_PROFILE_DATASHEET
+#endif
+
+// HD44780 datasheet sınırları (VCC = 4.5-5.5 V, fosc = 270 kHz)
+#define LCD_MIN_E_PULSE_NS       450     // PWEH: E HIGH darbe genişliği
+#define LCD_MIN_E_CYCLE_NS       1000    // tcycE: iki E yükselen kenarı arası süre
+#define LCD_MIN_SETUP_NS         195     // tDSW (195 ns) ve tAS (60 ns) sınırlarının büyüğü
+#define LCD_MIN_EXEC_CLEAR_US    1520    // Clear Display / Return Home
+#define LCD_MIN_EXEC_SHORT_US    37      // Diğer komutlar
+#define LCD_MIN_EXEC_DATA_US     41      // DDRAM yazımı: 37 µs + adres sayacı güncellemesi 4 µs
+
+// Datasheet profili
+#define LCD_TIMING_DS_E_PULSE_NS         450
+#define LCD_TIMING_DS_E_CYCLE_NS         1000
+#define LCD_TIMING_DS_SETUP_NS           200
+#define LCD_TIMING_DS_EXEC_CLEAR_US      1520
+#define LCD_TIMING_DS_EXEC_ADDR_US       37
+#define LCD_TIMING_DS_EXEC_DATA_US       41
+#define LCD_TIMING_DS_EXEC_FUNC_US       37
+
+// Temkinli profil: fosc'un alt sınırı 190 kHz'de süreler 270/190 ≈ 1.42 kat uzar
+#define LCD_TIMING_CONS_E_PULSE_NS       1000
+#define LCD_TIMING_CONS_E_CYCLE_NS       2000
+#define LCD_TIMING_CONS_SETUP_NS         500
+#define LCD_TIMING_CONS_EXEC_CLEAR_US    2200
+#define LCD_TIMING_CONS_EXEC_ADDR_US     55
+#define LCD_TIMING_CONS_EXEC_DATA_US     60
+#define LCD_TIMING_CONS_EXEC_FUNC_US     55
+
+// Her profilin datasheet sınırlarını sağladığını derleme anında kontrol et
+#define LCD_TIMING_CHECK(P) \
+    _Static_assert(LCD_TIMING_##P##_E_PULSE_NS    >= LCD_MIN_E_PULSE_NS,    #P ": E darbesi çok kısa"); \
+    _Static_assert(LCD_TIMING_##P##_E_CYCLE_NS    >= LCD_MIN_E_CYCLE_NS,    #P ": E periyodu çok kısa"); \
+    _Static_assert(LCD_TIMING_##P##_E_CYCLE_NS    >  LCD_TIMING_##P##_E_PULSE_NS, #P ": E periyodu darbeden uzun olmalı"); \
+    _Static_assert(LCD_TIMING_##P##_SETUP_NS      >= LCD_MIN_SETUP_NS,      #P ": setup süresi çok kısa"); \
+    _Static_assert(LCD_TIMING_##P##_EXEC_CLEAR_US >= LCD_MIN_EXEC_CLEAR_US, #P ": clear/home süresi çok kısa"); \
+    _Static_assert(LCD_TIMING_##P##_EXEC_ADDR_US  >= LCD_MIN_EXEC_SHORT_US, #P ": adres komutu süresi çok kısa"); \
+    _Static_assert(LCD_TIMING_##P##_EXEC_DATA_US  >= LCD_MIN_EXEC_DATA_US,  #P ": veri yazma süresi çok kısa"); \
+    _Static_assert(LCD_TIMING_##P##_EXEC_FUNC_US  >= LCD_MIN_EXEC_SHORT_US, #P ": function set süresi çok kısa")
+
+LCD_TIMING_CHECK(DS);
+LCD_TIMING_CHECK(CONS);
+
+#if LCD_TIMING_PROFILE == LCD_TIMING_PROFILE_DATASHEET
+#define LCD_TIMING(name)    LCD_TIMING_DS_##name
+#elif LCD_TIMING_PROFILE == LCD_TIMING_PROFILE_CONSERVATIVE
+#define LCD_TIMING(name)    LCD_TIMING_CONS_##name
+#else
+#error "LCD_TIMING_PROFILE gecersiz"
+#endif
+
+typedef enum {
+    LCD_CLASS_CLEAR_HOME,       // 0x01, 0x02-0x03
+    LCD_CLASS_SET_ADDRESS,      // 0x80+ (DDRAM), 0x40+ (CGRAM) ve diğer 37 µs'lik kısa komutlar
+    LCD_CLASS_WRITE_DATA,       // RS = 1, DDRAM / CGRAM yazımı
+    LCD_CLASS_FUNCTION_SET,     // 0x20-0x3F ve başlatmadaki tek nibble'lık komutlar
+    LCD_CLASS_COUNT
+} lcd_instr_class_t;
+
+typedef struct {
+    uint16_t e_pulse_ns;        // E pininin HIGH kalma süresi
+    uint16_t e_low_ns;          // E düştükten sonra bir sonraki darbeye kadar (periyot - darbe)
+    uint16_t setup_ns;          // RS / veri pinleri ayarlandıktan sonra E yükselmeden önceki bekleme
+    uint16_t exec_us;           // İkinci nibble'dan sonra LCD'nin komutu işlemesi için beklenecek süre
+} lcd_timing_t;
+
+const lcd_timing_t* lcd_timing_for(uint8_t rs, uint8_t byte);  // Gönderilecek bayta uygun profil satırını döndürür
+
+#endif  // __LCD_TIMING__     // Header guard bitişi
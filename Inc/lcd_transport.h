@@ -0,0 +1,79 @@
+#ifndef __LCD_TRANSPORT__     // LCD taşıma katmanı (GPIO / I2C) için header guard başlangıcı
+#define __LCD_TRANSPORT__
+
+#include <stdint.h>
+#include "lcd_config.h"
+#include "lcd_timing.h"
+
+// Derleme zamanında seçilebilen taşıma katmanları (örn. -DLCD_TRANSPORT=1)
+#define LCD_TRANSPORT_GPIO4     0       // 4-bit paralel: RS, E, D4-D7 (kart üzerindeki mevcut bağlantı)
+#define LCD_TRANSPORT_GPIO8     1       // 8-bit paralel: ayrıca D0-D3, bayt başına tek E darbesi
+#define LCD_TRANSPORT_PCF8574   2       // I2C PCF8574 sırt kartı (4-bit), satırlar tek DMA transferiyle gider
+
+#ifndef LCD_TRANSPORT
+#define LCD_TRANSPORT   LCD_TRANSPORT_GPIO4
+#endif
+
+#if LCD_TRANSPORT == LCD_TRANSPORT_GPIO8
+#define LCD_BUS_BITS        8
+#define LCD_FUNCTION_SET    0x38        // 8-bit arayüz, 2 satır, 5x8 font
+#elif LCD_TRANSPORT == LCD_TRANSPORT_GPIO4 || LCD_TRANSPORT == LCD_TRANSPORT_PCF8574
+#define LCD_BUS_BITS        4
+#define LCD_FUNCTION_SET    0x28        // 4-bit arayüz, 2 satır, 5x8 font
+#else
+#error "LCD_TRANSPORT gecersiz"
+#endif
+
+// Paralel bağlantı: RS ve E GPIOA'da, veri pinleri GPIOB'de (pin numaraları port içinde serbestçe değiştirilebilir)
+#define LCD_RS_PIN      1               // PA1
+#define LCD_E_PIN       3               // PA3
+#define LCD_D0_PIN      12              // PB12 (sadece 8-bit)
+#define LCD_D1_PIN      13              // PB13
+#define LCD_D2_PIN      14              // PB14
+#define LCD_D3_PIN      15              // PB15
+#define LCD_D4_PIN      4               // PB4
+#define LCD_D5_PIN      5               // PB5
+#define LCD_D6_PIN      6               // PB6
+#define LCD_D7_PIN      7               // PB7
+
+// PCF8574 sırt kartı: I2C1, PB6 = SCL, PB9 = SDA (kart üzerindeki CS43L22 ile aynı hat, adresleri farklı)
+#define LCD_PCF_ADDR    0x27            // 7-bit adres, A0-A2 açık (PCF8574A'lı kartlarda 0x3F)
+#define LCD_PCF_I2C_HZ  100000          // PCF8574 datasheet'i Standard mode (100 kHz) tanımlar
+#define LCD_PCF_RS      0x01            // P0 → RS
+#define LCD_PCF_E       0x04            // P2 → E   (P1 = RW, hep 0: sadece yazma)
+#define LCD_PCF_BL      0x08            // P3 → arka ışık transistörü
+                                        // P4-P7 → D4-D7
+
+#define LCD_PCF_BYTE_NS         (9000000000ull / LCD_PCF_I2C_HZ)   // 8 bit + ACK: 100 kHz'de 90 µs
+#define LCD_PCF_PAD(exec_us)    ((uint16_t)((((uint64_t)(exec_us) * 1000 + LCD_PCF_BYTE_NS - 1) / LCD_PCF_BYTE_NS) - 1))  // Komutun çalışma süresini dolduran boş yazım sayısı
+#define LCD_PCF_WRITES          6       // Bayt başına: her nibble için veri, veri|E, veri
+#define LCD_PCF_BYTE_MAX        (LCD_PCF_WRITES + LCD_PCF_PAD(LCD_TIMING(EXEC_CLEAR_US)))   // En uzun bayt (clear / home)
+#define LCD_PCF_LINE_BYTES      (LCD_COLS + 1)                      // Bir satır: imleç komutu + 16 karakter
+#define LCD_PCF_BATCH_SIZE      (LCD_PCF_LINE_BYTES * (LCD_PCF_WRITES + LCD_PCF_PAD(LCD_TIMING(EXEC_DATA_US))) + LCD_PCF_BYTE_MAX)
+#define LCD_PCF_TIMEOUT_US      (4 * LCD_PCF_BYTE_NS / 1000)       // Tek bayrak için en uzun bekleme (4 bayt süresi), sonra hat kurtarılır
+#define LCD_PCF_IRQ_PRIO        2       // I2C1_EV / ER: ADC watchdog (0), DMA (0) ve TIM2 (HRTIMER_IRQ_PRIO = 1) önce gelir
+#define LCD_PCF_BUS_FREE_US     ((2000000 + LCD_PCF_I2C_HZ - 1) / LCD_PCF_I2C_HZ)   // STOP'tan sonraki START'a kadar (tBUF = 4.7 µs, pay ile 2 bit)
+
+_Static_assert(LCD_PCF_I2C_HZ <= 100000,            "PCF8574 100 kHz'i aşamaz");
+_Static_assert(LCD_PCF_BATCH_SIZE <= 0xFFFF,        "DMA NDTR 16 bittir");
+_Static_assert(LCD_RS_PIN != LCD_E_PIN,             "RS ve E ayrı pinler olmalı");
+
+void lcd_transport_init(void);                      // Seçili taşıma katmanının pinlerini / I2C + DMA'sını hazırlar
+uint8_t lcd_transport_write(uint8_t rs, uint8_t byte);  // Baytı gönderir ve LCD komutu işleyene kadar bekler (bloklar); 1: panele ulaşmadı
+void lcd_transport_reset_nibble(uint8_t nibble);    // Başlatmadaki tek nibble'lık komut (RS = 0, 8-bit'te nibble << 4)
+uint32_t lcd_transport_errors(void);                // I2C NACK / hata / atılan parti sayısı (GPIO katmanlarında hep 0); lcd_config gölgeyi buna göre geçersiz yapar
+
+#if LCD_TRANSPORT == LCD_TRANSPORT_PCF8574
+uint16_t lcd_pcf_encode(uint8_t rs, uint8_t byte, uint8_t* out);   // Bir LCD baytını PCF8574 yazımlarına çevirir (en fazla LCD_PCF_BYTE_MAX)
+void lcd_pcf_batch_begin(void);                     // DMA tamponunu boşaltır
+uint8_t lcd_pcf_batch_add(uint8_t rs, uint8_t byte);            // 0: eklendi, 1: tampon dolu
+uint32_t lcd_pcf_batch_send(void (*done)(void));    // Tamponu tek I2C + DMA transferiyle yollar; bitince done() kesmeden çağrılır. En geç bitiş süresi (µs)
+uint8_t lcd_pcf_batch_abort(void);                  // Parti bu süreden sonra hâlâ sürüyorsa: hattı kurtarır, done()'ı çağırır (1: iptal edildi)
+void I2C1_EV_IRQHandler(void);
+void I2C1_ER_IRQHandler(void);
+#else
+void lcd_bus_set(uint8_t rs, uint8_t value);        // RS'i ayarlar, veri pinlerini tek BSRR yazımıyla kurar (4-bit: nibble, 8-bit: bayt)
+void lcd_bus_enable(uint8_t level);                 // E pinini beklemeden HIGH/LOW yapar
+#endif
+
+#endif  // __LCD_TRANSPORT__  // Header guard bitişi
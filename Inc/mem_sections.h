@@ -0,0 +1,26 @@
+#ifndef __MEM_SECTIONS__      // Kod / veri bellek yerleşimi için header guard başlangıcı
+#define __MEM_SECTIONS__
+
+#include <stdint.h>
+
+#ifndef MEM_PLACEMENT
+#define MEM_PLACEMENT       1           // 0: her şey flash + SRAM'de kalır (önce / sonra ölçümü için)
+#endif
+
+#define MEM_VECTOR_COUNT    (16 + 82)   // Cortex-M4 çekirdek vektörleri + STM32F407'nin 82 kesmesi
+#define MEM_VECTOR_ALIGN    512         // VTOR hizası: tablo boyutunu (392 B) kapsayan 2'nin kuvveti
+
+#if MEM_PLACEMENT && defined(__arm__)
+#define RAMFUNC     __attribute__((section(".RamFunc"), noinline))  // SRAM'den çalışır (startup .data ile kopyalar)
+#define CCMRAM      __attribute__((section(".ccmram")))             // 64 KB CCM: sadece CPU erişir, DMA erişemez
+#else
+#define RAMFUNC
+#define CCMRAM
+#endif
+
+void mem_sections_init(void);                                   // .ccmram'i doldurur, vektör tablosunu SRAM'e taşır
+uint8_t mem_vector_set(int32_t irq, void (*handler)(void));     // RAM tablosundaki bir kesme vektörünü değiştirir
+uint32_t mem_ramfunc_bytes(void);                              // SRAM'e taşınan RAMFUNC kodunun boyutu (linker script'ten)
+void mem_sections_bench(void (*put)(char c));                   // PROF_ENABLE ile: aynı kodun flash (soğuk / sıcak ART) ve SRAM cycle'ı
+
+#endif  // __MEM_SECTIONS__   // Header guard bitişi
@@ -1,9 +1,52 @@
 #ifndef __MQ2__     // Header dosyasının birden fazla kez include edilmesini engellemek için koruma tanımı başlatılır
 #define __MQ2__
 
+#include <stdint.h>
+
+#define ADC_STREAM_BLOCK    128     // DMA tamponunun her yarısındaki örnek sayısı
+
+#define ADC_MAX_CHANNELS    16      // Regular sequence en fazla 16 dönüşüm içerebilir
+#define ADC_NOT_READY       0xFFFF  // adc1_read(): akış başladı ama kanal henüz hiç dönüştürülmedi (12-bit ADC bu değeri üretmez)
+
+// SMPx kodları: örnekleme süresi (ADCCLK cycle)
+#define ADC_SMP_3           0
+#define ADC_SMP_15          1
+#define ADC_SMP_28          2
+#define ADC_SMP_56          3
+#define ADC_SMP_84          4
+#define ADC_SMP_112         5
+#define ADC_SMP_144         6
+#define ADC_SMP_480         7
+
+typedef void (*adc_block_callback_t)(const uint16_t* block, uint16_t count);   // Dolan yarım tamponu alan fonksiyon
+
+typedef struct {
+    uint8_t channel;            // ADC kanalı (0-18)
+    uint8_t sample_time;        // ADC_SMP_x kodu
+} adc_channel_cfg_t;
+
+typedef struct {
+    uint32_t sqr1, sqr2, sqr3;  // Sıra (sequence) register'ları
+    uint32_t smpr1, smpr2;      // Örnekleme süresi register'ları
+} adc_sequence_regs_t;
+
 void gpio_pa0_analog_init(void);
 void adc1_init(void);
-uint16_t adc1_read(void);
+uint16_t adc1_read(void);                               // Akış açıkken ilk örnekten önce ADC_NOT_READY
+
+void adc1_stream_start(adc_block_callback_t callback);  // ADC1'i sürekli moda alır, DMA2 Stream0 ile dairesel tampona yazar
+void adc1_stream_stop(void);                            // Sürekli örneklemeyi durdurur, adc1_read() tekrar polling yapar
+void DMA2_Stream0_IRQHandler(void);                     // Yarım / tam transfer kesmesi
+
+uint32_t adc1_set_sample_rate(uint32_t hz);             // ADC1'i TIM3 TRGO ile tetikler, gerçekleşen örnekleme hızını döndürür (0: geçersiz)
+uint32_t adc1_get_sample_rate(void);                    // Ayarlı örnekleme hızı (0: yazılım / sürekli mod)
+uint64_t adc1_block_time(void);                         // Callback'e verilen bloğun son örneğinin zamanı (timebase_cycles)
+uint8_t adc_sequence_encode(const adc_channel_cfg_t* table, uint8_t count, adc_sequence_regs_t* regs);  // Tabloyu register değerlerine çevirir (0: başarılı, 1: geçersiz)
+uint8_t adc1_scan_config(const adc_channel_cfg_t* table, uint8_t count);    // Tarama sırasını ayarlar (akış başlamadan önce çağrılır)
+void adc1_scan_set_pipeline(uint8_t index, adc_block_callback_t callback);   // Sıradaki index. kanalın ayrıştırılmış örneklerini alacak fonksiyon
+uint16_t adc1_read_index(uint8_t index);                                     // Sıradaki index. kanalın en son örneği (ADC_NOT_READY: henüz yok veya index sırada yok)
+uint32_t adc1_dma_errors(void);                                              // DMA2 Stream0 transfer hatası sayısı
+uint8_t adc_timer_calc(uint32_t timer_clk, uint32_t hz, uint16_t* psc, uint16_t* arr);  // 16-bit timer için PSC/ARR hesabı (0: başarılı, 1: ulaşılamaz)
 
 #endif  // __MQ2__   // Header guard bitişi
 
@@ -0,0 +1,26 @@
+#ifndef __MQ2_CALIB__         // MQ2 ısınma takibi ve R0 kalibrasyonu için header guard başlangıcı
+#define __MQ2_CALIB__
+
+#include <stdint.h>
+
+#define MQ2_CALIB_MIN_WARMUP_S      120     // Isıtıcı için en kısa bekleme (okumalar kararlı görünse bile)
+#define MQ2_CALIB_STABLE_DELTA      3       // Kararlı seride 1 sn'lik pencere ortalamalarının serinin başından izin verilen farkı (ADC)
+#define MQ2_CALIB_STABLE_WINDOWS    30      // Kararlı sayılmak için gereken ardışık kararlı pencere sayısı
+#define MQ2_CALIB_TRACK_SHIFT       12      // R0 takibi: her pencerede farkın 1/4096'sı eklenir (zaman sabiti ≈ 68 dk)
+#define MQ2_CALIB_CLEAN_TOLERANCE   15      // Temiz hava kabul aralığı: Rs/R0 = 9.83 ± %15
+#define MQ2_CALIB_SAVE_DRIFT        2       // Kayıtlı değerden en az %2 sapınca flash'a yeniden yazılır
+#define MQ2_CALIB_SAVE_INTERVAL_S   3600    // İki flash yazımı arasındaki en kısa süre
+
+typedef enum {
+    MQ2_CALIB_WARMUP,       // Isıtıcı ısınıyor, okumalar henüz anlamlı değil
+    MQ2_CALIB_SETTLING,     // En kısa süre doldu, okumaların oturması bekleniyor
+    MQ2_CALIB_READY         // Sensör kararlı, R0 geçerli
+} mq2_calib_state_t;
+
+void mq2_calib_init(uint32_t update_mhz);       // Flash'tan R0'ı yükler (eski sektörü siler: sadece açılışta), mq2_calib_update() hızını mHz olarak alır
+void mq2_calib_update(uint16_t adc);            // Her filtrelenmiş örnekte çağrılır (kesme içinden çağrılabilir)
+void mq2_calib_service(void);                   // Bekleyen flash kaydını yapar (sadece ana döngüden)
+mq2_calib_state_t mq2_calib_state(void);
+uint8_t mq2_calib_has_r0(void);                 // R0 flash'tan yüklendiyse veya öğrenildiyse 1
+
+#endif  // __MQ2_CALIB__      // Header guard bitişi
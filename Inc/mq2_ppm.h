@@ -0,0 +1,29 @@
+#ifndef __MQ2_PPM__           // MQ2 ppm dönüşümü için header guard başlangıcı
+#define __MQ2_PPM__
+
+#include <stdint.h>
+
+#define MQ2_SUPPLY_COUNTS       4095        // Sensör besleme gerilimine (Vc) karşılık gelen ADC değeri (modül çıkışı 3.3 V'a bölünmüş)
+#define MQ2_CLEAN_AIR_RATIO     9.83        // Datasheet: temiz havada Rs / R0
+#define MQ2_PPM_MAX             100000      // mq2_ppm() üst sınırı (%10 hacim); eğri 10000 ppm'de biter, ötesi doyum
+#define MQ2_Q16(x)              ((int32_t)((x) * 65536.0 + ((x) >= 0 ? 0.5 : -0.5)))   // Sabit sayıyı Q16'ya çevirir (derleme anında)
+
+typedef enum {
+    MQ2_GAS_LPG,
+    MQ2_GAS_CO,
+    MQ2_GAS_SMOKE,
+    MQ2_GAS_H2,
+    MQ2_GAS_COUNT
+} mq2_gas_t;
+
+void mq2_set_r0(uint32_t r0_rl_q16);                    // R0 / RL oranını (Q16) ayarlar; kalibrasyondan gelir
+uint32_t mq2_get_r0(void);
+uint32_t mq2_rs_rl_q16(uint16_t adc);                   // ADC değerinden Rs / RL (Q16)
+int32_t mq2_log2_ratio_q16(uint16_t adc);               // log2(Rs / R0), Q16
+uint32_t mq2_ratio_q16(uint16_t adc);                   // Rs / R0, Q16
+uint32_t mq2_ppm(uint16_t adc, mq2_gas_t gas);          // Seçilen gaz için konsantrasyon (ppm), en fazla MQ2_PPM_MAX
+
+int32_t mq2_log2_q16(uint32_t x);                       // log2(x), Q16 (x > 0)
+uint32_t mq2_exp2_q16(int32_t y);                       // 2^(y / 65536), Q16 sonuç (doyumlu)
+
+#endif  // __MQ2_PPM__        // Header guard bitişi
@@ -0,0 +1,29 @@
+#ifndef __OVERSAMPLE__        // Aşırı örnekleme / seyreltme (decimation) modülü için header guard başlangıcı
+#define __OVERSAMPLE__
+
+#include <stdint.h>
+
+#define OVERSAMPLE_INPUT_BITS   12      // ADC1 çözünürlüğü
+
+typedef enum {
+    OVERSAMPLE_ACCUMULATE,      // R örneği topla, kaydır (kutu/ortalama filtresi)
+    OVERSAMPLE_CIC2             // 2. dereceden CIC (üçgen pencere, daha iyi alias bastırma)
+} oversample_mode_t;
+
+typedef struct {
+    oversample_mode_t mode;
+    uint16_t ratio;             // Aşırı örnekleme oranı R (4, 16, 64, 256)
+    uint16_t count;             // Mevcut çıktı için toplanan örnek sayısı
+    uint8_t  extra_bits;        // Kazanılan bit sayısı: log4(R)
+    uint8_t  shift;             // Çıkışı (12 + extra_bits) bite indirmek için sağa kaydırma
+    uint32_t acc;               // ACCUMULATE: toplam
+    uint32_t integ1, integ2;    // CIC: integratör katları
+    uint32_t comb1, comb2;      // CIC: comb katlarının gecikme elemanları
+} oversample_t;
+
+uint8_t oversample_init(oversample_t* os, uint16_t ratio, oversample_mode_t mode);     // 0: başarılı, 1: geçersiz oran
+uint16_t oversample_process(oversample_t* os, const uint16_t* in, uint16_t count,
+                            uint16_t* out, uint16_t out_max);                           // Üretilen çıktı sayısını döndürür
+uint8_t oversample_output_bits(const oversample_t* os);                                 // Çıkış çözünürlüğü (13-16 bit)
+
+#endif  // __OVERSAMPLE__     // Header guard bitişi
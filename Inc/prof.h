@@ -0,0 +1,61 @@
+#ifndef __PROF__              // DWT cycle sayacı ile profil çıkarma için header guard başlangıcı
+#define __PROF__
+
+#include <stdint.h>
+
+#ifndef PROF_ENABLE
+#define PROF_ENABLE         0           // Derleme bayrağı: -DPROF_ENABLE=1 (0 iken makrolar hiçbir kod üretmez)
+#endif
+
+#define PROF_TRACE_SIZE     64          // Ham kayıt halkasının boyutu (2'nin kuvveti olmalı)
+#define PROF_HIST_BINS      16          // log2 histogram: k. kutu [2^(k-1), 2^k) cycle, son kutu üstünü de toplar
+
+typedef struct prof_site {
+    const char* name;
+    struct prof_site* next;             // Kayıtlı noktaların bağlı listesi (ilk kullanımda eklenir)
+    uint8_t registered;
+    uint32_t last;                      // Trace noktası: bir önceki geçişin zamanı
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;                     // Ortalama = total / count
+    uint32_t hist[PROF_HIST_BINS];
+} prof_site_t;
+
+typedef struct {
+    prof_site_t* site;
+    uint32_t start;                     // Giriş (trace noktasında bir önceki geçiş)
+    uint32_t end;                       // Çıkış (trace noktasında bu geçiş)
+} prof_trace_t;
+
+void prof_record(prof_site_t* site, uint32_t start, uint32_t end);  // Kaydı halkaya yazar ve istatistiğe ekler
+void prof_trace_point(prof_site_t* site, uint32_t now);            // İki geçiş arasındaki süreyi kaydeder
+void prof_reset(void);                                             // Bütün istatistikleri ve halkayı sıfırlar
+prof_site_t* prof_sites(void);                                     // Kayıtlı noktaların listesi
+uint32_t prof_trace_count(void);                                   // Halkaya yazılmış toplam kayıt (taşma dahil)
+const prof_trace_t* prof_trace_get(uint32_t age);                  // age = 0 en yeni kayıt (yoksa NULL)
+void prof_dump(void (*put)(char c));                               // İstatistikleri metin olarak verilen fonksiyona yazar
+void prof_dump_itm(void);                                          // prof_dump() çıktısını ITM port 0'a (SWO) gönderir
+void prof_itm_put(char c);                                         // Tek karakteri ITM port 0'a yazar (*_bench() çıktıları için)
+
+#if PROF_ENABLE
+
+#ifndef PROF_CYCLES
+#include "stm32f4xx.h"
+#define PROF_CYCLES()       (DWT->CYCCNT)   // Bilgisayarda sahte bir sayaçla değiştirilebilir
+#endif
+
+#define PROF_SITE(id)       static prof_site_t prof_site_##id = { .name = #id }
+#define PROF_BEGIN(id)      PROF_SITE(id); uint32_t prof_start_##id = PROF_CYCLES()
+#define PROF_END(id)        prof_record(&prof_site_##id, prof_start_##id, PROF_CYCLES())
+#define PROF_TRACE(id)      do { PROF_SITE(id); prof_trace_point(&prof_site_##id, PROF_CYCLES()); } while (0)
+
+#else
+
+#define PROF_BEGIN(id)      ((void)0)
+#define PROF_END(id)        ((void)0)
+#define PROF_TRACE(id)      ((void)0)
+
+#endif
+
+#endif  // __PROF__           // Header guard bitişi
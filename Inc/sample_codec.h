@@ -0,0 +1,24 @@
+#ifndef __SAMPLE_CODEC__      // Örnek akışı sıkıştırma (tahmin + Rice) için header guard başlangıcı
+#define __SAMPLE_CODEC__
+
+#include <stdint.h>
+
+#define SAMPLE_CODEC_BLOCK_MAX      256     // Blok başına en fazla örnek (her blok tek başına çözülebilir)
+#define SAMPLE_CODEC_HEADER_LEN     4       // İlk örnek (2), sayı - 1 (1), derece / k (1)
+#define SAMPLE_CODEC_ESCAPE_Q       24      // Bu kadar 1 bitinden sonra artık 18 bit ham yazılır
+#define SAMPLE_CODEC_RAW_BITS       18      // 2. derece artığın zig-zag'i 16-bit örnekte 18 bite sığar
+#define SAMPLE_CODEC_MAX_BYTES(n)   (SAMPLE_CODEC_HEADER_LEN + \
+                                     ((uint32_t)(n) * (SAMPLE_CODEC_ESCAPE_Q + SAMPLE_CODEC_RAW_BITS) + 7) / 8)  // En kötü durum
+
+typedef enum {
+    SAMPLE_CODEC_AUTO   = 0,        // Blok için daha kısa olanı seç
+    SAMPLE_CODEC_DELTA  = 1,        // tahmin = bir önceki örnek
+    SAMPLE_CODEC_ORDER2 = 2         // tahmin = 2 × önceki - ondan önceki (doğrusal eğilim)
+} sample_codec_order_t;
+
+uint16_t sample_codec_encode(const uint16_t* in, uint16_t count, sample_codec_order_t order,
+                             uint8_t* out, uint16_t out_max);   // Bloğu kodlar, yazılan bayt sayısını döndürür (0: hata / sığmadı)
+uint16_t sample_codec_decode(const uint8_t* in, uint16_t in_len, uint16_t* out, uint16_t out_max,
+                             uint16_t* consumed);               // Bir bloğu çözer, örnek sayısını döndürür (0: bozuk)
+
+#endif  // __SAMPLE_CODEC__   // Header guard bitişi
@@ -0,0 +1,33 @@
+#ifndef __SCHEDULER__         // İşbirlikçi (cooperative) görev zamanlayıcısı için header guard başlangıcı
+#define __SCHEDULER__
+
+#include <stdint.h>
+
+#define SCHED_MAX_TASKS     8           // Aynı anda kayıtlı olabilecek görev sayısı
+#define SCHED_INVALID       0xFF        // sched_add_*() hata dönüşü (tablo dolu / geçersiz parametre)
+
+typedef void (*sched_fn_t)(void);
+typedef uint32_t (*sched_clock_t)(void); // Çalışma süresi ölçümü için serbest sayan sayaç (hedefte DWT->CYCCNT)
+
+typedef struct {
+    const char* name;
+    sched_fn_t fn;
+    uint32_t period_ms;                 // 0: tek seferlik görev
+    uint32_t deadline_ms;               // Tetiklenme anından itibaren bitmesi gereken süre
+    uint32_t release_ms;                // Bir sonraki tetiklenme zamanı
+    uint8_t active;
+    uint32_t runs;                      // Çalışma sayısı
+    uint32_t wcet;                      // En uzun çalışma süresi (sched_clock_t biriminde)
+    uint32_t missed;                    // Kaçırılan son tarih sayısı (atlanan periyotlar dahil)
+} sched_task_t;
+
+void sched_init(sched_clock_t clock, uint32_t clock_per_ms);   // Sayaç fonksiyonu ve 1 ms'deki sayım (NULL: süre ölçülmez)
+uint8_t sched_add_periodic(const char* name, sched_fn_t fn, uint32_t now_ms,
+                           uint32_t period_ms, uint32_t offset_ms, uint32_t deadline_ms);  // Görev numarasını döndürür
+uint8_t sched_add_oneshot(const char* name, sched_fn_t fn, uint32_t now_ms,
+                          uint32_t delay_ms, uint32_t deadline_ms);                        // Görev numarasını döndürür
+void sched_cancel(uint8_t id);
+uint8_t sched_dispatch(uint32_t now_ms);        // Zamanı gelen görevleri çalıştırır, çalışan görev sayısını döndürür
+const sched_task_t* sched_task(uint8_t id);     // İstatistikler için görev kaydı (geçersizse NULL)
+
+#endif  // __SCHEDULER__      // Header guard bitişi
@@ -0,0 +1,20 @@
+#ifndef __TELEMETRY__         // USART3 + DMA telemetri akışı için header guard başlangıcı
+#define __TELEMETRY__
+
+#include <stdint.h>
+#include "telemetry_frame.h"
+
+#define TELEMETRY_TX_SIZE       1024    // Gönderim halkası (2'nin kuvveti olmalı)
+#define TELEMETRY_SAMPLE_SIZE   64      // Kesmeden gelen örnekler için halka (2'nin kuvveti olmalı)
+#define TELEMETRY_SAMPLES_MAX   16      // Bir SAMPLES çerçevesindeki en fazla örnek
+
+void telemetry_init(uint32_t baud);                         // USART3 TX (PD8), DMA1 Stream3 Kanal 4
+uint8_t telemetry_send(uint8_t type, const uint8_t* payload, uint8_t len, uint32_t timestamp_ms);  // 0: kuyruğa eklendi, 1: yer yok (çerçeve atıldı)
+void telemetry_push_sample(uint16_t value, uint32_t timestamp_ms);  // Kesme içinden çağrılabilir, asla beklemez
+void telemetry_service(uint16_t period_us);                 // Biriken örnekleri SAMPLES çerçevelerine çevirir (ana döngü)
+uint8_t telemetry_send_status(uint32_t now_ms, uint8_t alarm, uint32_t trips, uint32_t latency_max, uint32_t ppm, uint8_t calib_state);
+uint8_t telemetry_send_relay(uint32_t now_ms, uint8_t state, uint32_t trips);
+uint32_t telemetry_dropped(void);                           // Yer olmadığı için atılan çerçeve + örnek sayısı
+void DMA1_Stream3_IRQHandler(void);
+
+#endif  // __TELEMETRY__      // Header guard bitişi
@@ -0,0 +1,39 @@
+#ifndef __TELEMETRY_FRAME__   // Telemetri çerçeveleme (COBS + CRC16) için header guard başlangıcı
+#define __TELEMETRY_FRAME__
+
+#include <stdint.h>
+
+#define TELEMETRY_HEADER_LEN    6       // type (1) + seq (1) + timestamp_ms (4)
+#define TELEMETRY_CRC_LEN       2
+#define TELEMETRY_MAX_PAYLOAD   64
+#define TELEMETRY_RAW_MAX       (TELEMETRY_HEADER_LEN + TELEMETRY_MAX_PAYLOAD + TELEMETRY_CRC_LEN)
+#define TELEMETRY_FRAME_MAX     (TELEMETRY_RAW_MAX + TELEMETRY_RAW_MAX / 254 + 2)  // COBS ek baytı + 0x00 ayırıcı
+#define TELEMETRY_DELIMITER     0x00
+
+typedef enum {
+    TELEMETRY_SAMPLES = 1,              // channel (1), count (1), period_us (2), count × u16 örnek
+    TELEMETRY_STATUS  = 2,              // alarm (1), trips (4), latency_max (4), ppm (4), calib_state (1)
+    TELEMETRY_RELAY   = 3               // state (1), trips (4)
+} telemetry_type_t;
+
+typedef struct {
+    uint8_t type;
+    uint8_t seq;
+    uint32_t timestamp_ms;
+    uint8_t len;
+    uint8_t payload[TELEMETRY_MAX_PAYLOAD];
+} telemetry_frame_t;
+
+uint16_t telemetry_crc16(const uint8_t* data, uint16_t len);        // CRC-16/CCITT-FALSE (poly 0x1021, başlangıç 0xFFFF)
+uint16_t telemetry_cobs_encode(const uint8_t* in, uint16_t len, uint8_t* out);   // Kodlanmış uzunluğu döndürür (ayırıcı hariç)
+uint8_t telemetry_cobs_decode(const uint8_t* in, uint16_t len, uint8_t* out, uint16_t* out_len);  // 0: başarılı, 1: bozuk
+uint16_t telemetry_frame_build(uint8_t type, uint8_t seq, uint32_t timestamp_ms,
+                               const uint8_t* payload, uint8_t len, uint8_t* out);   // Ayırıcı dahil çerçeve uzunluğu (0: payload çok uzun)
+uint8_t telemetry_frame_parse(const uint8_t* in, uint16_t len, telemetry_frame_t* frame);  // Ayırıcısız çerçeve; 0: geçerli, 1: bozuk/CRC hatası
+
+uint8_t* telemetry_put_u16(uint8_t* p, uint16_t v);    // Little-endian yazar, bir sonraki konumu döndürür
+uint8_t* telemetry_put_u32(uint8_t* p, uint32_t v);
+uint16_t telemetry_get_u16(const uint8_t* p);
+uint32_t telemetry_get_u32(const uint8_t* p);
+
+#endif  // __TELEMETRY_FRAME__  // Header guard bitişi
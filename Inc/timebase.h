@@ -0,0 +1,15 @@
+#ifndef __TIMEBASE__          // 64-bit monotonik zaman tabanı için header guard başlangıcı
+#define __TIMEBASE__
+
+#include <stdint.h>
+
+void timebase_init(void);               // Sayacı sıfırdan başlatır (DWT_Delay_Init()'ten sonra çağrılmalı)
+void timebase_tick(void);               // SysTick kesmesinden çağrılır; CYCCNT taşmalarını 64 bite taşır
+uint64_t timebase_cycles(void);         // timebase_init()'ten beri geçen CPU cycle (kilitsiz, kesmeden de çağrılabilir)
+uint64_t timebase_us(void);             // Aynı sayaç, µs cinsinden
+uint64_t timebase_ms(void);             // Aynı sayaç, ms cinsinden
+uint64_t timebase_cycles_to_us(uint64_t cycles);   // Çarpma + kaydırma ile bölme (2^56 cycle'a kadar tam sonuç)
+uint64_t timebase_cycles_to_ms(uint64_t cycles);
+uint32_t timebase_retries(void);        // Okuma sırasında yazıcı araya girdiği için tekrarlanan okuma sayısı
+
+#endif  // __TIMEBASE__       // Header guard bitişi
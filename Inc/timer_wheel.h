@@ -0,0 +1,42 @@
+#ifndef __TIMER_WHEEL__       // Hiyerarşik zamanlayıcı çarkı için header guard başlangıcı
+#define __TIMER_WHEEL__
+
+#include <stdint.h>
+
+#define TIMER_WHEEL_BITS        5                           // Seviye başına 2^5 = 32 yuva (doluluk maskesi tek uint32_t)
+#define TIMER_WHEEL_SLOTS       (1u << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_LEVELS      5                           // 1 µs, 32 µs, 1.024 ms, 32.8 ms, 1.05 s çözünürlüklü seviyeler
+#define TIMER_WHEEL_SPAN        (1ul << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS))   // Tek seferde yerleşen en uzak süre (~33.5 sn)
+#define TIMER_WHEEL_MAX_DELAY   0x7FFFFFFFu                 // Daha uzunları en üst seviyede bekleyip tekrar yerleşir
+#define TIMER_WHEEL_IDLE        0xFF                        // timer_wheel_timer_t.level: çarkta değil
+
+typedef void (*timer_wheel_fn_t)(void* arg);
+
+typedef struct timer_wheel_timer {
+    struct timer_wheel_timer* next;     // Aynı yuvadaki çift yönlü liste
+    struct timer_wheel_timer* prev;
+    uint32_t expires;                   // Mutlak zaman (tick, taşmalı karşılaştırılır)
+    uint32_t period;                    // 0: tek seferlik
+    timer_wheel_fn_t fn;
+    void* arg;
+    uint8_t level;                      // Bulunduğu seviye (TIMER_WHEEL_IDLE: beklemiyor)
+    uint8_t slot;
+} timer_wheel_timer_t;
+
+typedef struct {
+    timer_wheel_timer_t* slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+    uint32_t occupied[TIMER_WHEEL_LEVELS];  // Dolu yuvaların bit maskesi
+    uint32_t now;                       // Çarkın işlediği son zaman
+    uint32_t pending;                   // Bekleyen zamanlayıcı sayısı
+} timer_wheel_t;
+
+void timer_wheel_init(timer_wheel_t* w, uint32_t now);
+void timer_wheel_timer_init(timer_wheel_timer_t* t, timer_wheel_fn_t fn, void* arg);
+uint8_t timer_wheel_add(timer_wheel_t* w, timer_wheel_timer_t* t, uint32_t expires, uint32_t period);  // 0: eklendi, 1: geçersiz
+void timer_wheel_cancel(timer_wheel_t* w, timer_wheel_timer_t* t);      // Beklemiyorsa bir şey yapmaz
+uint8_t timer_wheel_is_pending(const timer_wheel_timer_t* t);
+uint8_t timer_wheel_next(const timer_wheel_t* w, uint32_t* when);       // En yakın olay zamanı (0: var, 1: çark boş)
+timer_wheel_timer_t* timer_wheel_expire(timer_wheel_t* w, uint32_t now);  // now'a kadar süresi dolan ilki (çağrılmaz), NULL: yok
+uint32_t timer_wheel_advance(timer_wheel_t* w, uint32_t now);           // now'a kadar süresi dolanları çağırır, çağrılan sayısını döndürür
+
+#endif  // __TIMER_WHEEL__    // Header guard bitişi
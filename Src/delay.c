@@ -1,40 +1,56 @@
 #include "stm32f4xx.h"      // STM32F4 serisi için temel CMSIS tanımları
 #include "delay.h"          // delay fonksiyonlarının başlık dosyası
+#include "mem_sections.h"   // RAMFUNC
+#include "prof.h"
+#include "timebase.h"
 
-#define SYSTICK_FREQ_HZ 1000  // SysTick kesme frekansı (1000 Hz = 1 ms periyot)
-uint32_t SystemCoreClock = 72000000;  // Sistem saat frekansı 72 MHz
-static volatile uint32_t systick_counter;  // 1 ms kesmelerde azalacak sayaç
+uint32_t SystemCoreClock = CLOCK_SYSCLK_HZ;  // Sistem saat frekansı (clock_config.h, varsayılan 168 MHz)
+static volatile uint32_t systick_ms;  // Açılıştan beri geçen ms (serbest sayar, ~49.7 günde taşar)
 
 void systick_config(void)
 {
     // Reload değeri = (Saat Frekansı / Kesme Frekansı) - 1
-    SysTick->LOAD = (SystemCoreClock / SYSTICK_FREQ_HZ) - 1;   // 72000000 / 1000 - 1 = 71999
+    SysTick->LOAD = CLOCK_SYSTICK_RELOAD;   // 168000000 / 1000 - 1 = 167999 (derleme anında hesaplanır)
 
     SysTick->VAL = 0;   // Sayaç başlangıç değerini sıfırla
 
-    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk |   // İşlemci saatini (AHB clock = 72 MHz) kullan
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk |   // İşlemci saatini (AHB clock = HCLK = SYSCLK) kullan
                     SysTick_CTRL_TICKINT_Msk   |   // SysTick kesmesini etkinleştir
                     SysTick_CTRL_ENABLE_Msk;       // SysTick sayacını başlat
 }
 
-void SysTick_Handler(void)
+RAMFUNC void SysTick_Handler(void)
 {
+    PROF_BEGIN(isr_systick);
     // SysTick kesmesi her 1 ms’de bir çalışır
-    if (systick_counter > 0)     // Sayaç 0’dan büyükse azalt
-    {
-        systick_counter--;       // ms bazlı bekleme için sayaç bir azalır
-    }
+    systick_ms++;                // Zaman sayacı hiç sıfırlanmaz, herkes kendi başlangıç değerini tutar
+    timebase_tick();             // CYCCNT taşmalarını 64-bit zaman tabanına işle
+    PROF_END(isr_systick);
+}
+
+uint32_t millis(void)
+{
+    return systick_ms;
 }
 
 void delay_ms(uint32_t ms)
 {
-    systick_counter = ms;                 // Bekleme süresini global sayaç değişkenine yükle
-    while (systick_counter != 0)          // Sayaç 0 olana kadar döngüde kal
+    uint32_t start = millis();            // Başlangıç zamanını al
+    while ((millis() - start) < ms)       // Fark hesabı sayaç taşsa bile doğru sonuç verir
     {
-        // Döngü içinde bekleme yapılır, kesmeler sayaç değerini azaltır
+        // Döngü içinde bekleme yapılır, kesmeler sayacı artırır
     }
 }
 
+/*
+
+Eskiden delay_ms() tek bir global sayacı yükleyip sıfıra inmesini bekliyordu; iki yerden (örneğin kesme ve ana döngü)
+aynı anda kullanılamıyor, ölçüm yapmak için de bir zaman kaynağı sunmuyordu.
+Artık SysTick sadece serbest sayan bir ms sayacını artırır. millis() bu değeri verir, delay_ms() ise başlangıç değerine göre
+farkı bekler. (millis() - start) işaretsiz çıkarma olduğu için sayaç taşarken de doğru çalışır.
+
+*/
+
 // Mikro-saniye gecikme için DWT (Data Watchpoint and Trace) yapılandırması
 uint32_t DWT_Delay_Init(void)
 {
@@ -0,0 +1,354 @@
+#include <stdint.h>
+#include <string.h>
+#include "dsp_filter.h"
+#include "mem_sections.h"
+#include "prof.h"
+#include "fmt.h"
+#if DSP_FILTER_SIMD
+#include "stm32f4xx.h"          // __SMLALD, __SMUAD, __PKHBT (CMSIS)
+#endif
+
+#define DSP_FIR_ROUND       (1 << 14)                       // Q30 → Q15 yuvarlama
+
+static inline int16_t dsp_sat16(int64_t v)
+{
+    if (v > 32767) return 32767;
+    if (v < -32768) return -32768;
+    return (int16_t)v;
+}
+
+#if DSP_FILTER_SIMD
+static inline uint32_t dsp_read_q15x2(const int16_t* p)
+{
+    uint32_t v;
+    memcpy(&v, p, 4);           // Cortex-M4 hizasız LDR yapabilir; memcpy tek LDR'ye derlenir
+    return v;                   // Alt 16 bit p[0], üst 16 bit p[1] (little endian)
+}
+#endif
+
+uint8_t dsp_fir_init(dsp_fir_t* f, const int16_t* coeffs, uint16_t taps, int16_t* state, uint16_t block_max)
+{
+    if (!coeffs || !state || taps == 0 || block_max == 0) return 1;
+
+    f->coeffs = coeffs;
+    f->state = state;
+    f->taps = taps;
+    f->block_max = block_max;
+    for (uint16_t i = 0; i < taps - 1; i++) state[i] = 0;  // Geçmiş sıfırla başlar
+    return 0;
+}
+
+static inline __attribute__((always_inline)) void dsp_fir_block(dsp_fir_t* f, const int16_t* in, int16_t* out, uint16_t n, uint8_t simd)
+{
+    uint16_t taps = f->taps;
+    int16_t* hist = f->state;
+    int16_t* fresh = hist + taps - 1;
+
+    for (uint16_t i = 0; i < n; i++) fresh[i] = in[i];     // Yeni blok geçmişin hemen arkasına
+
+    for (uint16_t i = 0; i < n; i++) {
+        const int16_t* x = hist + i;            // x[n - taps + 1] ... x[n], artan zaman
+        const int16_t* c = f->coeffs;           // h[taps - 1] ... h[0]
+        int64_t acc = DSP_FIR_ROUND;
+        uint16_t k = 0;
+
+#if DSP_FILTER_SIMD
+        if (simd) {
+            for (; k + 1 < taps; k += 2) {
+                acc = (int64_t)__SMLALD(dsp_read_q15x2(x + k), dsp_read_q15x2(c + k), (uint64_t)acc);  // İki çarpım, tek komut
+            }
+        }
+#else
+        (void)simd;
+#endif
+        for (; k < taps; k++) {
+            acc += (int32_t)x[k] * c[k];
+        }
+        out[i] = dsp_sat16(acc >> 15);
+    }
+
+    for (uint16_t i = 0; i < taps - 1; i++) hist[i] = hist[n + i];    // Son taps - 1 örnek sonraki bloğun geçmişi
+}
+
+static inline __attribute__((always_inline)) void dsp_fir_run(dsp_fir_t* f, const int16_t* in, int16_t* out, uint16_t n, uint8_t simd)
+{
+    while (n > 0) {                             // state en fazla block_max yeni örnek alır: uzun bloklar parça parça
+        uint16_t chunk = n < f->block_max ? n : f->block_max;
+        dsp_fir_block(f, in, out, chunk, simd);
+        in += chunk;
+        out += chunk;
+        n -= chunk;
+    }
+}
+
+RAMFUNC void dsp_fir_process(dsp_fir_t* f, const int16_t* in, int16_t* out, uint16_t n)
+{
+    dsp_fir_run(f, in, out, n, 1);
+}
+
+void dsp_fir_process_c(dsp_fir_t* f, const int16_t* in, int16_t* out, uint16_t n)
+{
+    dsp_fir_run(f, in, out, n, 0);
+}
+
+/*
+
+FIR (blok işleme):
+	state tamponu [taps - 1 örnek geçmiş | n örnek yeni blok] şeklindedir. Her çıktı, tampondaki taps uzunluğunda bir pencere ile
+	katsayı dizisinin iç çarpımıdır; pencere her çıktıda bir kayar. Blok sonunda sadece son taps - 1 örnek başa taşınır,
+	yani halka indeks hesabı (modulo) iç döngüye girmez. block_max'tan uzun bir blok block_max'lık parçalar halinde
+	işlenir; sonuç tek seferde işlenmiş gibidir (her parçanın geçmişi bir önceki parçanın son örnekleridir).
+
+Paketli okuma ve SMLALD:
+	İki ardışık Q15 örnek tek 32-bit okuma ile alınır (alt yarım = eski örnek). Katsayılar da aynı sırada olduğu için
+	SMLALD tek komutta x[k]·c[k] + x[k+1]·c[k+1] hesaplar ve 64-bit toplama ekler. Tek sayıda katsayı varsa son çarpım
+	skaler yapılır. Katsayılar bu yüzden ters zaman sırasındadır (CMSIS-DSP ile aynı düzen).
+
+Sayı biçimi:
+	Q15 × Q15 = Q30 çarpımlar 64 bitte toplanır, ara sonuçta taşma veya doyma olmaz. Sonuç yuvarlanıp 15 bit kaydırılır ve
+	int16'ya doyurulur. Tam sayı toplama sıradan bağımsız olduğu için dsp_fir_process() ile dsp_fir_process_c() bit bit
+	aynı sonucu verir.
+
+*/
+
+uint8_t dsp_biquad_init(dsp_biquad_t* b, const int16_t* coeffs, uint8_t stages, int16_t* state, uint8_t post_shift)
+{
+    if (!coeffs || !state || stages == 0 || post_shift > 14) return 1;
+
+    b->coeffs = coeffs;
+    b->state = state;
+    b->stages = stages;
+    b->post_shift = post_shift;
+    for (uint16_t i = 0; i < 4u * stages; i++) state[i] = 0;
+    return 0;
+}
+
+#if DSP_FILTER_SIMD
+static void dsp_biquad_stage_simd(const int16_t* c, int16_t* s, const int16_t* in, int16_t* out, uint16_t n, uint8_t shift)
+{
+    uint32_t b0 = dsp_read_q15x2(&c[0]);        // {b0, 0}: üst yarım çarpımı sıfırlar
+    uint32_t b12 = dsp_read_q15x2(&c[2]);       // {b1, b2}
+    uint32_t a12 = dsp_read_q15x2(&c[4]);       // {a1, a2}
+    uint32_t x12 = dsp_read_q15x2(&s[0]);       // {x[n-1], x[n-2]}
+    uint32_t y12 = dsp_read_q15x2(&s[2]);       // {y[n-1], y[n-2]}
+    int64_t round = (int64_t)1 << (14 - shift);
+
+    for (uint16_t i = 0; i < n; i++) {
+        uint32_t x = (uint16_t)in[i];
+        int64_t acc = round + (int32_t)__SMUAD(b0, x);
+        acc = (int64_t)__SMLALD(b12, x12, (uint64_t)acc);
+        acc = (int64_t)__SMLALD(a12, y12, (uint64_t)acc);
+
+        int16_t y = dsp_sat16(acc >> (15 - shift));
+        out[i] = y;
+        x12 = __PKHBT(x, x12, 16);              // {x[n], x[n-1]}: yeni örnek alta, eski alt yarım üste
+        y12 = __PKHBT((uint16_t)y, y12, 16);
+    }
+
+    memcpy(&s[0], &x12, 4);
+    memcpy(&s[2], &y12, 4);
+}
+#endif
+
+static void dsp_biquad_stage_c(const int16_t* c, int16_t* s, const int16_t* in, int16_t* out, uint16_t n, uint8_t shift)
+{
+    int16_t x1 = s[0], x2 = s[1], y1 = s[2], y2 = s[3];
+    int64_t round = (int64_t)1 << (14 - shift);
+
+    for (uint16_t i = 0; i < n; i++) {
+        int16_t x = in[i];
+        int64_t acc = round + (int32_t)c[0] * x + (int32_t)c[2] * x1 + (int32_t)c[3] * x2 + (int32_t)c[4] * y1 + (int32_t)c[5] * y2;
+
+        int16_t y = dsp_sat16(acc >> (15 - shift));
+        out[i] = y;
+        x2 = x1; x1 = x;
+        y2 = y1; y1 = y;
+    }
+
+    s[0] = x1; s[1] = x2; s[2] = y1; s[3] = y2;
+}
+
+RAMFUNC void dsp_biquad_process(dsp_biquad_t* b, const int16_t* in, int16_t* out, uint16_t n)
+{
+    for (uint8_t k = 0; k < b->stages; k++) {
+#if DSP_FILTER_SIMD
+        dsp_biquad_stage_simd(&b->coeffs[6 * k], &b->state[4 * k], in, out, n, b->post_shift);
+#else
+        dsp_biquad_stage_c(&b->coeffs[6 * k], &b->state[4 * k], in, out, n, b->post_shift);
+#endif
+        in = out;                               // Sonraki kat bu katın çıktısını işler
+    }
+}
+
+void dsp_biquad_process_c(dsp_biquad_t* b, const int16_t* in, int16_t* out, uint16_t n)
+{
+    for (uint8_t k = 0; k < b->stages; k++) {
+        dsp_biquad_stage_c(&b->coeffs[6 * k], &b->state[4 * k], in, out, n, b->post_shift);
+        in = out;
+    }
+}
+
+/*
+
+Biquad (Direct Form I, kaskat):
+	y[n] = b0·x[n] + b1·x[n-1] + b2·x[n-2] + a1·y[n-1] + a2·y[n-2]
+	a1 ve a2 işareti ters çevrilmiş olarak saklanır, böylece hepsi toplama olur. Katsayılar Q14'tür (post_shift = 1):
+	alçak geçiren filtrelerde |a1| 1'den büyük olabildiği için Q15'e sığmaz.
+
+Paketli düzen:
+	Katsayılar {b0, 0, b1, b2, a1, a2}, durum {x[n-1], x[n-2], y[n-1], y[n-2]} olarak saklanır. Böylece b1/b2, a1/a2 ve
+	geçmiş çiftleri 32-bit kelimelerdir; her örnek SMUAD + 2 × SMLALD ile 5 çarpımı 3 komutta yapar. Geçmiş çiftleri döngü
+	boyunca register'da kalır ve PKHBT ile tek komutta kaydırılır. Direct Form I seçildi çünkü toplayıcı 64 bit olduğunda
+	ara taşma yoktur ve tek doyma noktası çıkıştır (DF2'nin iç durumu Q15'te taşabilir).
+
+Taşınabilir yol aynı çarpımları 64 bitte toplar, aynı yuvarlama ve doyma ile bit bit aynı sonucu verir.
+
+*/
+
+#define DSP_SORT(a, b)      do { if ((a) > (b)) { int16_t t_ = (a); (a) = (b); (b) = t_; } } while (0)
+
+int16_t dsp_median_of(const int16_t* v, uint8_t taps)
+{
+    int16_t p[DSP_MEDIAN_MAX];
+
+    switch (taps) {
+    case 3:
+        p[0] = v[0]; p[1] = v[1]; p[2] = v[2];
+        DSP_SORT(p[0], p[1]); DSP_SORT(p[1], p[2]); DSP_SORT(p[0], p[1]);
+        return p[1];
+
+    case 5:
+        for (uint8_t i = 0; i < 5; i++) p[i] = v[i];
+        DSP_SORT(p[0], p[1]); DSP_SORT(p[3], p[4]); DSP_SORT(p[0], p[3]);
+        DSP_SORT(p[1], p[4]); DSP_SORT(p[1], p[2]); DSP_SORT(p[2], p[3]);
+        DSP_SORT(p[1], p[2]);
+        return p[2];
+
+    case 7:
+        for (uint8_t i = 0; i < 7; i++) p[i] = v[i];
+        DSP_SORT(p[0], p[5]); DSP_SORT(p[0], p[3]); DSP_SORT(p[1], p[6]);
+        DSP_SORT(p[2], p[4]); DSP_SORT(p[0], p[1]); DSP_SORT(p[3], p[5]);
+        DSP_SORT(p[2], p[6]); DSP_SORT(p[2], p[3]); DSP_SORT(p[3], p[6]);
+        DSP_SORT(p[4], p[5]); DSP_SORT(p[1], p[4]); DSP_SORT(p[1], p[3]);
+        DSP_SORT(p[3], p[4]);
+        return p[3];
+
+    default:
+        return v[0];
+    }
+}
+
+uint8_t dsp_median_init(dsp_median_t* m, uint8_t taps, int16_t initial)
+{
+    if (taps != 3 && taps != 5 && taps != 7) return 1;
+
+    m->taps = taps;
+    m->pos = 0;
+    for (uint8_t i = 0; i < DSP_MEDIAN_MAX; i++) m->window[i] = initial;
+    return 0;
+}
+
+RAMFUNC void dsp_median_process(dsp_median_t* m, const int16_t* in, int16_t* out, uint16_t n)
+{
+    for (uint16_t i = 0; i < n; i++) {
+        m->window[m->pos] = in[i];              // En eskinin yerine yaz; medyan sıradan bağımsız
+        if (++m->pos >= m->taps) m->pos = 0;
+        out[i] = dsp_median_of(m->window, m->taps);
+    }
+}
+
+/*
+
+Medyan (3 / 5 / 7):
+	Pencere tam sıralanmaz; sadece ortadaki elemanı doğru yere getiren sabit karşılaştır-değiştir ağları kullanılır
+	(3 → 3, 5 → 7, 7 → 13 karşılaştırma). Dallanmasız min/max'a derlenir ve süre veriden bağımsızdır.
+	Medyan sıraya bakmadığı için pencere kaydırılmaz, halkada en eski örneğin üzerine yazılır.
+	Tek örneklik sıçramaları (ADC gürültüsü, röle anahtarlama paraziti) basamak kenarlarını yumuşatmadan siler;
+	(taps - 1) / 2 örneğe kadar kısa darbeler tamamen kaybolur.
+
+*/
+
+#if PROF_ENABLE
+
+#define DSP_BENCH_BLOCK     128
+#define DSP_BENCH_TAPS_MAX  64
+
+static int16_t dsp_bench_in[DSP_BENCH_BLOCK];
+static int16_t dsp_bench_out[DSP_BENCH_BLOCK];
+static int16_t dsp_bench_coeffs[DSP_BENCH_TAPS_MAX];
+static int16_t dsp_bench_state[DSP_BENCH_TAPS_MAX - 1 + DSP_BENCH_BLOCK];
+static const int16_t dsp_bench_biquad[2 * 6] = { 512, 0, 1023, 512, 23618, -9281, 512, 0, 1023, 512, 23618, -9281 };
+
+static void dsp_bench_row(void (*put)(char), const char* name, uint16_t taps, uint32_t simd_cycles, uint32_t c_cycles)
+{
+    char line[32];
+    uint8_t n = 0;
+
+    while (*name) line[n++] = *name++;
+    fmt_u32(&line[n], 4, taps, FMT_ALIGN_RIGHT, ' ');
+    n += 4;
+    fmt_fixed(&line[n], 9, (int32_t)(simd_cycles * 10 / DSP_BENCH_BLOCK), 1, FMT_ALIGN_RIGHT, ' ');  // cycle / örnek
+    n += 9;
+    fmt_fixed(&line[n], 9, (int32_t)(c_cycles * 10 / DSP_BENCH_BLOCK), 1, FMT_ALIGN_RIGHT, ' ');
+    n += 9;
+    line[n++] = '\n';
+
+    for (uint8_t i = 0; i < n; i++) put(line[i]);
+}
+
+void dsp_filter_bench(void (*put)(char c))
+{
+    static const uint16_t fir_taps[] = { 8, 16, 31, 32, 64 };
+    dsp_fir_t fir;
+    dsp_biquad_t iir;
+    dsp_median_t med;
+    int16_t iir_state[2 * 4];
+    uint32_t t0, t1, t2;
+
+    for (uint16_t i = 0; i < DSP_BENCH_BLOCK; i++) dsp_bench_in[i] = (int16_t)(i * 997);     // Sözde rastgele, doymayan giriş
+    for (uint16_t i = 0; i < DSP_BENCH_TAPS_MAX; i++) dsp_bench_coeffs[i] = (int16_t)(32767 / DSP_BENCH_TAPS_MAX);
+
+    const char* header = "kernel  taps     simd        c   (cycle/ornek)\n";
+    while (*header) put(*header++);
+
+    for (uint8_t k = 0; k < sizeof(fir_taps) / sizeof(fir_taps[0]); k++) {
+        dsp_fir_init(&fir, dsp_bench_coeffs, fir_taps[k], dsp_bench_state, DSP_BENCH_BLOCK);
+        t0 = PROF_CYCLES();
+        dsp_fir_process(&fir, dsp_bench_in, dsp_bench_out, DSP_BENCH_BLOCK);
+        t1 = PROF_CYCLES();
+        dsp_fir_process_c(&fir, dsp_bench_in, dsp_bench_out, DSP_BENCH_BLOCK);
+        t2 = PROF_CYCLES();
+        dsp_bench_row(put, "fir   ", fir_taps[k], t1 - t0, t2 - t1);
+    }
+
+    for (uint8_t stages = 1; stages <= 2; stages++) {
+        dsp_biquad_init(&iir, dsp_bench_biquad, stages, iir_state, 1);
+        t0 = PROF_CYCLES();
+        dsp_biquad_process(&iir, dsp_bench_in, dsp_bench_out, DSP_BENCH_BLOCK);
+        t1 = PROF_CYCLES();
+        dsp_biquad_process_c(&iir, dsp_bench_in, dsp_bench_out, DSP_BENCH_BLOCK);
+        t2 = PROF_CYCLES();
+        dsp_bench_row(put, "biquad", stages, t1 - t0, t2 - t1);    // taps yerine kat sayısı
+    }
+
+    for (uint8_t taps = 3; taps <= 7; taps += 2) {
+        dsp_median_init(&med, taps, 0);
+        t0 = PROF_CYCLES();
+        dsp_median_process(&med, dsp_bench_in, dsp_bench_out, DSP_BENCH_BLOCK);
+        t1 = PROF_CYCLES();
+        dsp_bench_row(put, "median", taps, t1 - t0, t1 - t0);      // Tek yol: SIMD sürümü yok
+    }
+}
+
+#endif  // PROF_ENABLE
+
+/*
+
+dsp_filter_bench():
+	Her çekirdeği 128 örneklik tek blok üzerinde hem DSP komutlu hem taşınabilir yoldan çalıştırır ve DWT CYCCNT ile
+	örnek başına cycle yazar (bir ondalık). prof_dump() gibi çıktıyı verilen fonksiyona karakter karakter verir;
+	main() PROF_ENABLE ile açılışta dsp_filter_bench(prof_itm_put) çağırır, tablo SWO'dan okunur. Sonuç önbellek / flash bekleme
+	durumundan etkilenir: RAMFUNC olan dsp_*_process() SRAM'den, _c sürümleri flash'tan çalışır.
+	Tek sayıdaki 31 katsayı, son skaler çarpımın maliyetini görmek için listededir.
+
+*/
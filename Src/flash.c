@@ -0,0 +1,139 @@
+#include <stdint.h>
+#include "stm32f4xx.h"
+#include "flash.h"
+#include "mem_sections.h"
+
+#define FLASH_KEY1              0x45670123U     // Referans manuel: FLASH_KEYR kilit açma dizisi
+#define FLASH_KEY2              0xCDEF89ABU
+#define FLASH_SR_ERRORS         (FLASH_SR_WRPERR | FLASH_SR_PGAERR | FLASH_SR_PGPERR | FLASH_SR_PGSERR)
+#define FLASH_NVIC_WORDS        3               // 82 kesme: ISER / ICER[0..2]
+
+#ifndef FLASH_ERASE_KEEP_IRQ
+#define FLASH_ERASE_KEEP_IRQ    ADC_IRQn        // Silme boyunca açık kalan tek kesme: bütün yolu SRAM'de (gas_alarm.c)
+#endif
+
+RAMFUNC static void flash_wait(void)
+{
+    while (FLASH->SR & FLASH_SR_BSY);           // Önceki işlem bitene kadar bekle
+}
+
+RAMFUNC static uint8_t flash_check_errors(void)
+{
+    uint32_t errors = FLASH->SR & FLASH_SR_ERRORS;
+
+    if (errors) {
+        FLASH->SR = errors;                     // Hata bayrakları 1 yazılarak temizlenir
+        return 1;
+    }
+    return 0;
+}
+
+void flash_unlock(void)
+{
+    if (FLASH->CR & FLASH_CR_LOCK) {
+        FLASH->KEYR = FLASH_KEY1;
+        FLASH->KEYR = FLASH_KEY2;
+    }
+}
+
+void flash_lock(void)
+{
+    FLASH->CR |= FLASH_CR_LOCK;
+}
+
+RAMFUNC uint8_t flash_erase_sector(uint8_t sector)
+{
+    uint32_t enabled[FLASH_NVIC_WORDS];
+
+    for (uint8_t i = 0; i < FLASH_NVIC_WORDS; i++) {                       // Flash'tan çalışan kesmeler silme bitince gelsin
+        uint32_t keep = (i == (FLASH_ERASE_KEEP_IRQ >> 5)) ? (1U << (FLASH_ERASE_KEEP_IRQ & 31)) : 0;
+        enabled[i] = NVIC->ISER[i];
+        NVIC->ICER[i] = enabled[i] & ~keep;                                 // Kapalıyken gelen istekler bekleyen olarak kalır
+    }
+    __DSB();
+    __ISB();
+
+    flash_wait();
+    FLASH->SR = FLASH_SR_ERRORS;                                            // Eski hataları temizle
+
+    FLASH->CR &= ~(FLASH_CR_PSIZE | FLASH_CR_SNB);
+    FLASH->CR |= FLASH_CR_PSIZE_1 |                                         // x32 paralellik (VDD 2.7-3.6 V)
+                 FLASH_CR_SER |                                             // Sektör silme
+                 ((uint32_t)sector << FLASH_CR_SNB_Pos);                    // Silinecek sektör numarası
+    FLASH->CR |= FLASH_CR_STRT;                                             // Silmeyi başlat
+
+    flash_wait();
+    FLASH->CR &= ~(FLASH_CR_SER | FLASH_CR_SNB);
+
+    for (uint8_t i = 0; i < FLASH_NVIC_WORDS; i++) {
+        NVIC->ISER[i] = enabled[i];
+    }
+
+    return flash_check_errors();
+}
+
+RAMFUNC uint8_t flash_program_word(uint32_t address, uint32_t data)
+{
+    flash_wait();
+    FLASH->SR = FLASH_SR_ERRORS;
+
+    FLASH->CR &= ~FLASH_CR_PSIZE;
+    FLASH->CR |= FLASH_CR_PSIZE_1 | FLASH_CR_PG;                            // x32 programlama modu
+
+    *(volatile uint32_t*)address = data;                                    // Yazma işlemi bu store ile başlar
+
+    flash_wait();
+    FLASH->CR &= ~FLASH_CR_PG;
+
+    if (flash_check_errors()) return 1;
+    return (*(volatile uint32_t*)address == data) ? 0 : 1;                  // Geri okuyarak doğrula
+}
+
+uint32_t flash_read_word(uint32_t address)
+{
+    return *(volatile uint32_t*)address;
+}
+
+uint32_t flash_sector_address(uint8_t sector)
+{
+    if (sector < 4)  return 0x08000000U + (uint32_t)sector * 0x4000U;          // 0-3: 16 KB
+    if (sector == 4) return 0x08010000U;                                        // 4: 64 KB
+    return 0x08020000U + (uint32_t)(sector - 5) * 0x20000U;                     // 5-11: 128 KB
+}
+
+uint32_t flash_sector_size(uint8_t sector)
+{
+    if (sector < 4)  return 0x4000U;
+    if (sector == 4) return 0x10000U;
+    return 0x20000U;
+}
+
+/*
+
+STM32F407VG'nin 1 MB flash'ı 12 sektöre bölünmüştür: 4 × 16 KB, 1 × 64 KB, 7 × 128 KB.
+Flash'a yazmadan önce ilgili bölge silinmiş olmalıdır (silinmiş flash = 0xFF). Programlama sadece 1 → 0 yönünde bit değiştirebilir;
+0 olan bir biti tekrar 1 yapmak için tüm sektörün silinmesi gerekir.
+
+flash_unlock():
+	Reset sonrası FLASH->CR kilitlidir. KEYR register'ına sırasıyla iki anahtar yazılınca kilit açılır.
+	Yanlış sıra veya değer yazılırsa bir sonraki reset'e kadar kilit açılamaz.
+
+FLASH_CR_PSIZE_1 (x32):
+	Besleme 2.7-3.6 V iken bir seferde 32 bit programlanabilir. Discovery kartı 3 V ile çalıştığı için uygundur.
+
+Dikkat:
+	Programlama ve silme sürerken flash'tan okuma (kod çalıştırma dahil) bekletilir. 128 KB'lık bir sektörün silinmesi 1-2 saniye sürebilir.
+	Silme / programlama fonksiyonları ve BSY bekleme döngüsü RAMFUNC'tur: CPU beklerken SRAM'den çalıştığı için kesmeler alınabilir.
+	Fakat flash'tan tek bir komut okuyan kesme (DMA örnek hattı, TIM2'nin LCD / scheduler callback'leri) silme bitene kadar
+	o okumada takılır; aynı veya düşük öncelikteki ADC watchdog kesmesi de onun arkasında bekler. Bu yüzden flash_erase_sector()
+	silme boyunca NVIC'te FLASH_ERASE_KEEP_IRQ (ADC, bütün yolu SRAM'de) dışındaki kesmeleri kapatır ve sonra eski haline
+	getirir. Kapalıyken gelen istekler bekleyen olarak kalır ve silme bitince çalışır; DMA o sürede tamponu dairesel yazmaya
+	devam ettiği için blokların çoğu işlenmeden üzerine yazılır. SysTick NVIC'te değildir, kapatılmaz; yolu da SRAM'dedir.
+	Röleyi gaz gelince süren ADC kesmesi böylece silme sırasında da birkaç µs'de çalışır; röleyi bırakan TIM2 kesmesi ise silme
+	bitene kadar bekler (röle o süre fazladan açık kalır). Hangi fonksiyonların SRAM'de olduğu linker script'te ve
+	tools/ramfunc_check.sh ile denetlenir. MEM_PLACEMENT=0 ile bu güvence yoktur.
+	Programlama (~16 µs / kelime) kesmeleri kapatmaz; flash'tan çalışan kesme en fazla bir kelime süresi gecikir.
+	Silme işlemleri yine de seyrek, ana döngüden ve önceden (flash_log_service(), sadece alarm yokken) yapılmalıdır.
+	Kullanılan sektörler linker script'te uygulama kodu için ayrılmamalıdır (FLASH bölgesi 0x08080000'dan önce, yani 512 KB'ta bitmeli).
+
+*/
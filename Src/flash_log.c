@@ -0,0 +1,339 @@
+#include <stdint.h>
+#include "flash.h"
+#include "flash_log.h"
+#include "mem_sections.h"
+
+#define FLASH_LOG_ERASED        0xFFFFFFFFU
+
+static uint32_t log_sector_seq[FLASH_SECTOR_LOG_COUNT];    // Geçerli başlığı olan sektörün sırası (0: geçersiz / boş)
+static uint8_t log_active;                                 // Yazılan sektör (indeks)
+static uint32_t log_next;                                  // Bir sonraki kaydın adresi
+static uint8_t log_ready;
+static uint8_t log_spare_blank;                            // 1: sıradaki sektör silinmiş, dönüşte sadece başlık yazılır
+
+static CCMRAM flash_log_record_t log_stage[FLASH_LOG_STAGE_RECORDS];  // RAM sayfası (CCM)
+static uint8_t log_stage_count;
+
+static uint32_t log_base(uint8_t index)
+{
+    return flash_sector_address(FLASH_SECTOR_LOG_FIRST + index);
+}
+
+static uint32_t log_end(uint8_t index)
+{
+    return log_base(index) + flash_sector_size(FLASH_SECTOR_LOG_FIRST + index);
+}
+
+static uint32_t log_read_header(uint8_t index)
+{
+    uint32_t base = log_base(index);
+    uint32_t seq = flash_read_word(base + 4);
+
+    if (flash_read_word(base) != FLASH_LOG_MAGIC || flash_read_word(base + 8) != ~seq || seq == 0 || seq == FLASH_LOG_ERASED) {
+        return 0;
+    }
+    return seq;
+}
+
+static uint8_t log_slot_erased(uint32_t address)
+{
+    for (uint8_t i = 0; i < FLASH_LOG_RECORD_SIZE; i += 4) {
+        if (flash_read_word(address + i) != FLASH_LOG_ERASED) return 0;
+    }
+    return 1;
+}
+
+static uint8_t log_sector_blank(uint8_t index)
+{
+    for (uint32_t a = log_base(index); a < log_end(index); a += 4) {
+        if (flash_read_word(a) != FLASH_LOG_ERASED) return 0;
+    }
+    return 1;
+}
+
+static uint8_t log_spare(void)
+{
+    return (log_active + 1) % FLASH_SECTOR_LOG_COUNT;          // Dönüşte yazılacak (en eski) sektör
+}
+
+static uint8_t log_slot_read(uint32_t address, flash_log_record_t* record)
+{
+    uint32_t w0 = flash_read_word(address);
+    uint32_t w1 = flash_read_word(address + 4);
+    uint32_t w2 = flash_read_word(address + 8);
+
+    if (flash_read_word(address + 12) != (w0 ^ w1 ^ w2 ^ FLASH_LOG_COMMIT_KEY)) return 1;   // Yarım kalmış yazım
+
+    record->timestamp_s = w0;
+    record->min = (uint16_t)w1;
+    record->max = (uint16_t)(w1 >> 16);
+    record->mean = (uint16_t)w2;
+    record->count = (uint16_t)(w2 >> 16);
+    return 0;
+}
+
+static uint8_t log_start_sector(uint8_t index, uint32_t seq, uint8_t erase)
+{
+    uint32_t base = log_base(index);
+
+    log_sector_seq[index] = 0;
+    if (erase && flash_erase_sector(FLASH_SECTOR_LOG_FIRST + index)) return 1;
+
+    if (flash_program_word(base + 4, seq) ||                    // Sıra numarası önce,
+        flash_program_word(base + 8, ~seq) ||
+        flash_program_word(base, FLASH_LOG_MAGIC)) {            // magic en son: başlık ya tamdır ya geçersiz
+        return 1;
+    }
+
+    log_sector_seq[index] = seq;
+    log_active = index;
+    log_next = base + FLASH_LOG_HEADER_SIZE;
+    return 0;
+}
+
+uint8_t flash_log_init(void)
+{
+    uint32_t newest = 0;
+
+    log_ready = 0;
+    log_stage_count = 0;
+
+    for (uint8_t i = 0; i < FLASH_SECTOR_LOG_COUNT; i++) {
+        log_sector_seq[i] = log_read_header(i);
+        if (log_sector_seq[i] > newest) {
+            newest = log_sector_seq[i];
+            log_active = i;
+        }
+    }
+
+    if (newest == 0) {                                          // İlk açılış: hiç geçerli sektör yok
+        flash_unlock();
+        uint8_t err = log_start_sector(0, 1, !log_sector_blank(0));
+        flash_lock();
+        if (err) return 1;
+    } else {
+        uint32_t end = log_end(log_active);
+        log_next = log_base(log_active) + FLASH_LOG_HEADER_SIZE;
+        while (log_next < end && !log_slot_erased(log_next)) {  // Yazılmış (geçerli veya yarım) slotları atla
+            log_next += FLASH_LOG_RECORD_SIZE;
+        }
+    }
+
+    log_spare_blank = log_sector_seq[log_spare()] == 0 && log_sector_blank(log_spare());  // Önceden silinmiş mi (128 KB okuma, < 1 ms)
+    log_ready = 1;
+    return 0;
+}
+
+static uint8_t log_rotate(void)
+{
+    uint8_t erase = !log_spare_blank;                           // Normalde flash_log_service() önceden sildi
+
+    log_spare_blank = 0;
+    return log_start_sector(log_spare(), log_sector_seq[log_active] + 1, erase);
+}
+
+uint8_t flash_log_service(void)
+{
+    uint8_t spare = log_spare();
+
+    if (!log_ready) return 1;
+    if (log_spare_blank) return 0;
+
+    uint32_t used = log_next - log_base(log_active);
+    if ((uint64_t)used * 100 < (uint64_t)flash_sector_size(FLASH_SECTOR_LOG_FIRST + log_active) * FLASH_LOG_PREERASE_PERCENT) {
+        return 0;                                               // Eski sektörün geçmişi henüz gerekli
+    }
+
+    log_sector_seq[spare] = 0;                                  // Silme yarıda kesilirse de geçersiz sayılır
+    flash_unlock();
+    uint8_t err = flash_erase_sector(FLASH_SECTOR_LOG_FIRST + spare);
+    flash_lock();
+    if (err) return 1;
+
+    log_spare_blank = 1;
+    return 0;
+}
+
+uint8_t flash_log_flush(void)
+{
+    uint8_t done = 0;
+    uint8_t err = 0;
+
+    if (!log_ready || log_stage_count == 0) return log_ready ? 0 : 1;
+
+    flash_unlock();
+
+    while (done < log_stage_count) {
+        if (log_next + FLASH_LOG_RECORD_SIZE > log_end(log_active)) {
+            if (log_rotate()) { err = 1; break; }
+        }
+
+        const flash_log_record_t* r = &log_stage[done];
+        uint32_t w0 = r->timestamp_s;
+        uint32_t w1 = r->min | ((uint32_t)r->max << 16);
+        uint32_t w2 = r->mean | ((uint32_t)r->count << 16);
+        uint32_t address = log_next;
+
+        log_next += FLASH_LOG_RECORD_SIZE;                      // Yazım yarıda kalsa bile bu slot bir daha kullanılmaz
+        if (flash_program_word(address, w0) ||
+            flash_program_word(address + 4, w1) ||
+            flash_program_word(address + 8, w2) ||
+            flash_program_word(address + 12, w0 ^ w1 ^ w2 ^ FLASH_LOG_COMMIT_KEY)) {   // Onay kelimesi en son
+            err = 1;
+            break;
+        }
+        done++;
+    }
+
+    flash_lock();
+
+    for (uint8_t i = done; i < log_stage_count; i++) {          // Yazılamayanlar sayfada kalır, sonra tekrar denenir
+        log_stage[i - done] = log_stage[i];
+    }
+    log_stage_count -= done;
+    return err;
+}
+
+uint8_t flash_log_append(const flash_log_record_t* record)
+{
+    if (log_stage_count >= FLASH_LOG_STAGE_RECORDS) {           // Önceki yazım başarısız olduysa önce onu dene
+        if (flash_log_flush()) return 1;
+    }
+
+    log_stage[log_stage_count++] = *record;
+
+    if (log_stage_count == FLASH_LOG_STAGE_RECORDS) {
+        return flash_log_flush();
+    }
+    return 0;
+}
+
+uint8_t flash_log_staged(void)
+{
+    return log_stage_count;
+}
+
+static uint8_t log_sector_after(uint32_t seq, uint8_t* index)
+{
+    uint32_t best = 0;
+
+    for (uint8_t i = 0; i < FLASH_SECTOR_LOG_COUNT; i++) {
+        uint32_t s = log_sector_seq[i];
+        if (s > seq && (best == 0 || s < best)) {
+            best = s;
+            *index = i;
+        }
+    }
+    return best != 0;
+}
+
+void flash_log_iter_begin(flash_log_iter_t* it)
+{
+    it->staged = 0;
+    it->seq = 0;
+
+    if (log_sector_after(0, &it->sector)) {
+        it->seq = log_sector_seq[it->sector];
+        it->address = log_base(it->sector) + FLASH_LOG_HEADER_SIZE;
+    } else {
+        it->staged = 1;                                         // Flash'ta hiç sektör yok
+        it->address = 0;
+    }
+}
+
+uint8_t flash_log_iter_next(flash_log_iter_t* it, flash_log_record_t* record)
+{
+    while (!it->staged) {
+        uint32_t end = log_end(it->sector);
+
+        while (it->address < end && !log_slot_erased(it->address)) {
+            uint32_t address = it->address;
+            it->address += FLASH_LOG_RECORD_SIZE;
+            if (log_slot_read(address, record) == 0) return 0;  // Yarım kayıtlar atlanır
+        }
+
+        if (log_sector_after(it->seq, &it->sector)) {           // Bir sonraki (daha yeni) sektöre geç
+            it->seq = log_sector_seq[it->sector];
+            it->address = log_base(it->sector) + FLASH_LOG_HEADER_SIZE;
+        } else {
+            it->staged = 1;
+            it->address = 0;
+        }
+    }
+
+    if (it->address < log_stage_count) {                        // Henüz flash'a yazılmamış kayıtlar en yenileridir
+        *record = log_stage[it->address++];
+        return 0;
+    }
+    return 1;
+}
+
+void flash_log_acc_reset(flash_log_acc_t* acc)
+{
+    acc->sum = 0;
+    acc->min = 0xFFFF;
+    acc->max = 0;
+    acc->count = 0;
+}
+
+void flash_log_acc_add(flash_log_acc_t* acc, uint16_t value)
+{
+    acc->sum += value;
+    if (value < acc->min) acc->min = value;
+    if (value > acc->max) acc->max = value;
+    acc->count++;
+}
+
+void flash_log_acc_take(flash_log_acc_t* acc, uint32_t timestamp_s, flash_log_record_t* record)
+{
+    record->timestamp_s = timestamp_s;
+    record->min = acc->count ? acc->min : 0;
+    record->max = acc->max;
+    record->mean = acc->count ? (uint16_t)(acc->sum / acc->count) : 0;
+    record->count = acc->count;
+    flash_log_acc_reset(acc);
+}
+
+/*
+
+Amaç: Alarm anından önceki dakikaların geçmişini kalıcı olarak saklamak.
+
+Yerleşim (sektör 8 ve 9, her biri 128 KB):
+	| başlık 16 B: MAGIC, seq, ~seq, FFFFFFFF | kayıt 16 B | kayıt 16 B | ... |
+	Kayıt: timestamp_s | min, max | mean, count | onay = w0 ^ w1 ^ w2 ^ FLASH_LOG_COMMIT_KEY
+	Sektör başına 8191 kayıt vardır; saniyede bir kayıtla bir sektör ≈ 2.3 saat, iki sektör ≈ 4.5 saat geçmiş tutar.
+
+Halka ve aşınma dengeleme:
+	Kayıtlar hep sona eklenir, hiçbir kelime iki kez yazılmaz. Aktif sektör dolunca diğerine (en eskisine) bir büyük seq ile
+	başlık yazılır. Böylece her sektör sırayla ve eşit sayıda silinir (F4 flash'ı sektör başına 10 000 silme garanti eder;
+	2 sektörle ≈ 5 yıl).
+
+Önceden silme:
+	Sektör silme 1-2 saniye sürer ve bu sürede flash'tan çalışan her şey durur (flash.c). Bu yüzden silme kayıt yazımının içinde
+	yapılmaz: aktif sektör %FLASH_LOG_PREERASE_PERCENT dolunca flash_log_service() sıradaki sektörü önceden siler. Ana döngü
+	bunu sadece alarm yokken çağırır; dönüş anında sadece üç kelimelik başlık yazılır. Bedeli geçmişin bir kısmıdır: eski sektör
+	dönüşten önce gider, en az %FLASH_LOG_PREERASE_PERCENT sektör (≈ 1.7 saat) geçmiş her zaman kalır.
+	Servis hiç çağrılmazsa (veya alarm dönüşe kadar sürerse) dönüş eskisi gibi silerek yapılır; kayıt kaybolmaz, sadece bekleme olur.
+	Açılışta sıradaki sektörün tamamen silinmiş olup olmadığı okunarak bulunur; silme yarıda kesildiyse tekrar silinir.
+
+Elektrik kesintisine dayanıklılık:
+	Kaydın onay kelimesi en son yazılır. Kesinti ilk üç kelimenin herhangi birinde olursa onay kelimesi FFFFFFFF kalır ve kayıt
+	okunurken atlanır; slot silinmiş olmadığı için bir sonraki açılışta yazma bu slotun arkasından devam eder.
+	Başlıkta da magic en son yazılır. Silme ile başlık arasında kesilirse sektör başlıksız kalır, geçersiz sayılır ve
+	diğer sektör aktif olarak devam eder; sıra ona geldiğinde yeniden silinir.
+
+RAM sayfası:
+	flash_log_append() kaydı sadece RAM'e kopyalar. 16 kayıt birikince (saniyede bir kayıtla 16 sn'de bir) hepsi art arda yazılır:
+	64 kelime × ~16 µs ≈ 1 ms. Her kelimenin beklemesi SRAM'den yapılır ve kelimeler arasında kesmeler çalışır; flash'tan çalışan
+	DMA örnek kesmesi en fazla ~1 ms gecikir, DMA tamponunun yarısı (1 kHz'de 64 ms) bunu karşılar.
+	Sektör silmeyi ise DMA tamponu karşılamaz: flash_erase_sector() 1-2 saniye boyunca ADC watchdog dışındaki kesmeleri kapatır
+	(flash.c), örnek hattı (flash'ta) çalışmaz ve o sürenin örnekleri kaybolur; gas_trend de o sürede yeni örnek görmez.
+	Röleyi açan ADC watchdog kesmesi ve çağırdığı her şey SRAM'dedir (gas_alarm.c), silme sırasında da çalışır; en kısa açık
+	kalma süresinden sonra röleyi bırakan TIM2 kesmesi silme bitince gelir. Silme ~2 saatte bir ve sadece alarm yokken yapılır.
+	Yazılmamış kayıtlar iterator ile flash kayıtlarının sonunda verilir.
+
+Bilgisayarda:
+	Dosya sadece flash.h fonksiyonlarını kullanır (flash_read_word dahil). Bunlar RAM üzerinde silmeden yazmayı reddeden ve istenen
+	kelimede kesinti taklit eden bir NOR modeliyle değiştirilerek test edilebilir.
+
+*/
@@ -0,0 +1,91 @@
+#include <stdint.h>
+#include "fmt.h"
+
+static uint8_t fmt_field(char* dst, uint8_t width, uint32_t mag, uint8_t neg, uint8_t decimals, fmt_align_t align, char pad)
+{
+    uint8_t digits[FMT_MAX_DIGITS];
+    uint8_t ndig = 1;
+
+    for (uint8_t i = 0; i < FMT_MAX_DIGITS; i++) {                  // Her zaman 10 tur: süre sayının değerine bağlı değil
+        uint32_t q = (uint32_t)(((uint64_t)mag * 0xCCCCCCCDu) >> 35);  // mag / 10 (çarp-kaydır, bütün 32-bit değerler için tam)
+        digits[i] = (uint8_t)(mag - q * 10);
+        mag = q;
+    }
+    for (uint8_t i = 1; i < FMT_MAX_DIGITS; i++) {
+        if (digits[i]) ndig = i + 1;                                // En anlamlı sıfır olmayan basamak
+    }
+
+    if (decimals >= FMT_MAX_DIGITS) decimals = FMT_MAX_DIGITS - 1;
+    if (ndig < decimals + 1) ndig = decimals + 1;                   // 0.05 gibi değerlerde baştaki sıfır
+
+    uint8_t len = ndig + (decimals ? 1 : 0) + neg;
+    if (len > width) {
+        for (uint8_t i = 0; i < width; i++) dst[i] = FMT_OVERFLOW_CHAR;
+        return 1;
+    }
+
+    uint8_t fill = width - len;
+    uint8_t pos = 0;
+
+    if (align == FMT_ALIGN_RIGHT) {
+        if (pad == '0') {                                           // -0042: işaret sıfırlardan önce gelir
+            if (neg) dst[pos++] = '-';
+            while (fill--) dst[pos++] = '0';
+        } else {
+            while (fill--) dst[pos++] = pad;
+            if (neg) dst[pos++] = '-';
+        }
+    } else if (neg) {
+        dst[pos++] = '-';
+    }
+
+    for (uint8_t i = ndig; i > 0; i--) {
+        if (decimals && i == decimals) dst[pos++] = '.';
+        dst[pos++] = '0' + digits[i - 1];
+    }
+
+    while (pos < width) dst[pos++] = (pad == '0') ? ' ' : pad;      // Sola yaslıda sağa sıfır eklemek değeri değiştirir
+
+    return 0;
+}
+
+uint8_t fmt_u32(char* dst, uint8_t width, uint32_t value, fmt_align_t align, char pad)
+{
+    return fmt_field(dst, width, value, 0, 0, align, pad);
+}
+
+uint8_t fmt_i32(char* dst, uint8_t width, int32_t value, fmt_align_t align, char pad)
+{
+    return fmt_fixed(dst, width, value, 0, align, pad);
+}
+
+uint8_t fmt_fixed(char* dst, uint8_t width, int32_t value, uint8_t decimals, fmt_align_t align, char pad)
+{
+    uint8_t neg = value < 0;
+    uint32_t mag = neg ? (0u - (uint32_t)value) : (uint32_t)value;  // INT32_MIN da taşmadan çevrilir
+
+    return fmt_field(dst, width, mag, neg, decimals, align, pad);
+}
+
+/*
+
+Amaç: sprintf yerine küçük, yığın kullanmayan ve süresi belli bir sayı → metin dönüşümü.
+
+Neden:
+	newlib printf ailesi flash'ta on kilobaytlarca yer ve yüzlerce bayt yığın kullanır; buffer[5] gibi bir hedefte
+	5 basamaklı bir sayı da sonundaki '\0' ile taşmaya yol açar. Burada hedef alanın genişliği parametredir ve
+	fonksiyon asla width karakterden fazla yazmaz.
+
+Sabit süre:
+	Basamaklar her zaman 10 turda çıkarılır. Bölme yerine 0xCCCCCCCD ile 64-bit çarpım ve 35 bit kaydırma kullanılır;
+	Cortex-M4'te UDIV değere göre 2-12 cycle sürerken UMULL sabit sürelidir. Böylece çağrının süresi sadece width'e bağlıdır.
+
+Örnekler (width = 6):
+	fmt_u32(d, 6, 42, FMT_ALIGN_RIGHT, ' ')       → "    42"
+	fmt_i32(d, 6, -42, FMT_ALIGN_RIGHT, '0')      → "-00042"
+	fmt_fixed(d, 6, 1234, 2, FMT_ALIGN_LEFT, ' ') → "12.34 "
+	fmt_u32(d, 3, 12345, FMT_ALIGN_RIGHT, ' ')    → "***" (dönüş 1)
+
+C string olarak kullanmak için çağıran taraf dst[width] = '\0' yazmalıdır.
+
+*/
@@ -0,0 +1,231 @@
+#include <stdint.h>
+#include "stm32f4xx.h"
+#include "gas_alarm.h"
+#include "clock_config.h"
+#include "mem_sections.h"
+#include "prof.h"
+#include "timebase.h"
+#include "hrtimer.h"
+
+#define GAS_ALARM_ADC_MAX   0xFFF           // 12-bit ölçek sonu (watchdog eşiği hiç aşılamaz)
+
+#define GAS_ALARM_LOCK()    uint32_t gas_alarm_primask = __get_PRIMASK(); __disable_irq()
+#define GAS_ALARM_UNLOCK()  __set_PRIMASK(gas_alarm_primask)
+
+static uint16_t gas_alarm_high;
+static uint16_t gas_alarm_low;
+static volatile uint8_t gas_alarm_state;            // 1: watchdog gaz görüyor (histerezis durumu)
+static volatile uint8_t gas_alarm_trend;            // 1: gas_trend alarm kademesinde
+static volatile uint8_t gas_alarm_relay;            // 1: röle gaz konumunda (LOW)
+static uint32_t gas_alarm_on_at;                    // Rölenin gaz konumuna geçtiği an (hrtimer µs)
+static timer_wheel_timer_t gas_alarm_release_timer; // En kısa açık kalma süresi dolunca röleyi bırakır
+static volatile uint32_t gas_alarm_trip_count;
+static volatile uint32_t gas_alarm_lat_last;
+static volatile uint32_t gas_alarm_lat_max;
+static gas_alarm_event_t gas_alarm_events[GAS_ALARM_EVENTS];  // Röle geçiş kuyruğu
+static volatile uint8_t gas_alarm_event_head;       // Sadece gas_alarm_relay_set() değiştirir
+static volatile uint8_t gas_alarm_event_tail;       // Sadece ana döngü değiştirir
+static volatile uint32_t gas_alarm_event_lost;      // Kuyruk doluyken kaybolan geçiş
+
+RAMFUNC static void gas_alarm_arm(uint8_t active)
+{
+    if (active) {                                   // Alarmdayken sadece alt eşiğin altına inmek kesme üretsin
+        ADC1->HTR = GAS_ALARM_ADC_MAX;
+        ADC1->LTR = gas_alarm_low;
+    } else {                                        // Normalde sadece üst eşiği aşmak kesme üretsin
+        ADC1->HTR = gas_alarm_high;
+        ADC1->LTR = 0;
+    }
+}
+
+RAMFUNC static void gas_alarm_relay_set(uint8_t on)       // ADC kesmesinden (öncelik 0) veya kilit altında: yazanlar sıralı
+{
+    if (on) {
+        GPIOD->BSRR = (1 << (GAS_ALARM_RELAY_PIN + 16));    // Gaz var: röle LOW
+        gas_alarm_on_at = hrtimer_now();
+    } else {
+        GPIOD->BSRR = (1 << GAS_ALARM_RELAY_PIN);           // Gaz kalktı: röle HIGH
+    }
+    gas_alarm_relay = on;
+
+    uint8_t head = gas_alarm_event_head;
+    uint8_t next = (head + 1) & (GAS_ALARM_EVENTS - 1);
+    if (next == gas_alarm_event_tail) {             // Dolu: en eski geçişler korunur, yenisi sayılır
+        gas_alarm_event_lost++;
+        return;
+    }
+    gas_alarm_events[head].cycles = timebase_cycles();
+    gas_alarm_events[head].trips = gas_alarm_trip_count;
+    gas_alarm_events[head].state = on;
+    gas_alarm_event_head = next;                    // Kayıt yazıldıktan sonra görünür yap
+}
+
+RAMFUNC static void gas_alarm_apply(void)           // ADC kesmesinden veya kilit altında çağrılır
+{
+    if (gas_alarm_state || gas_alarm_trend) {       // Kaynaklardan biri gaz görüyor
+        if (!gas_alarm_relay) {
+            gas_alarm_relay_set(1);                 // Röle kapalıyken bırakma zamanlayıcısı kurulu olamaz
+        } else {
+            hrtimer_cancel(&gas_alarm_release_timer);   // Bırakma beklerken tekrar alarm: röle kalır
+        }
+    } else if (gas_alarm_relay) {                   // İkisi de gaz görmüyor
+        uint32_t held = hrtimer_now() - gas_alarm_on_at;
+        if (held >= GAS_ALARM_MIN_ON_US) {
+            gas_alarm_relay_set(0);
+        } else {
+            hrtimer_start(&gas_alarm_release_timer, GAS_ALARM_MIN_ON_US - held, 0);   // Kalan süre dolunca bırak
+        }
+    }
+}
+
+RAMFUNC static void gas_alarm_release(void* arg)
+{
+    (void)arg;
+    GAS_ALARM_LOCK();                               // ADC kesmesi bu kesmeyi bölebilir
+    if (!gas_alarm_state && !gas_alarm_trend && gas_alarm_relay) gas_alarm_relay_set(0);  // Bu arada tekrar alarm olduysa röle kalır
+    GAS_ALARM_UNLOCK();
+}
+
+void gas_alarm_init(uint8_t channel, uint16_t high, uint16_t low)
+{
+    gas_alarm_high = high;
+    gas_alarm_low = low;
+    gas_alarm_state = 0;
+    gas_alarm_trend = 0;
+    gas_alarm_relay = 0;
+    gas_alarm_arm(0);
+    timer_wheel_timer_init(&gas_alarm_release_timer, gas_alarm_release, 0);   // hrtimer_init() daha önce çağrılmış olmalı
+
+    GPIOD->BSRR = (1 << GAS_ALARM_RELAY_PIN);       // Başlangıçta gaz yok (röle HIGH)
+
+    ADC1->CR1 = (ADC1->CR1 & ~ADC_CR1_AWDCH) |
+                ((uint32_t)channel << ADC_CR1_AWDCH_Pos) |   // İzlenecek kanal
+                ADC_CR1_AWDSGL |                    // Sadece bu kanalı izle (tarama sırasındaki diğer sensörleri değil)
+                ADC_CR1_AWDEN |                     // Regular kanallarda watchdog'u aç
+                ADC_CR1_AWDIE;                      // Watchdog kesmesi
+    ADC1->SR = ~ADC_SR_AWD;                         // rc_w0: sadece AWD temizlenir
+
+    NVIC_SetPriority(ADC_IRQn, 0);                  // Alarm her şeyden önce gelir (DMA ve LCD kesmelerinden de)
+    NVIC_EnableIRQ(ADC_IRQn);
+}
+
+void gas_alarm_set_trend(uint8_t alarm)
+{
+    alarm = alarm ? 1 : 0;
+    if (alarm == gas_alarm_trend) return;
+
+    GAS_ALARM_LOCK();                               // DMA kesmesinden gelir; ADC ve TIM2 kesmeleri aynı durumu değiştirir
+    gas_alarm_trend = alarm;
+    if (alarm) gas_alarm_trip_count++;
+    gas_alarm_apply();
+    GAS_ALARM_UNLOCK();
+}
+
+uint8_t gas_alarm_active(void)
+{
+    return gas_alarm_relay;
+}
+
+uint32_t gas_alarm_trips(void)
+{
+    return gas_alarm_trip_count;
+}
+
+uint32_t gas_alarm_latency_last(void)
+{
+    return gas_alarm_lat_last;
+}
+
+uint32_t gas_alarm_latency_max(void)
+{
+    return gas_alarm_lat_max;
+}
+
+uint8_t gas_alarm_event_pop(gas_alarm_event_t* event)
+{
+    uint8_t tail = gas_alarm_event_tail;
+
+    if (tail == gas_alarm_event_head) return 1;
+    *event = gas_alarm_events[tail];                // Yazan, tail ilerlemeden bu kayda dokunmaz
+    gas_alarm_event_tail = (tail + 1) & (GAS_ALARM_EVENTS - 1);
+    return 0;
+}
+
+uint32_t gas_alarm_events_lost(void)
+{
+    return gas_alarm_event_lost;
+}
+
+RAMFUNC void ADC_IRQHandler(void)
+{
+    if (!(ADC1->SR & ADC_SR_AWD)) return;           // ADC1/2/3 aynı kesmeyi paylaşır
+
+    PROF_BEGIN(isr_adc_awd);
+
+    uint8_t relay_was = gas_alarm_relay;
+
+    gas_alarm_state ^= 1;                           // Gaz geldi / kalktı
+    if (gas_alarm_state) gas_alarm_trip_count++;    // Geçiş kaydı bu alarmı da saysın
+    gas_alarm_apply();                              // En yüksek öncelik: kilit gerekmez
+
+    uint32_t ticks = TIM3->CNT;                     // Dönüşümü başlatan TIM3 update'inden beri geçen tick
+
+    gas_alarm_arm(gas_alarm_state);                 // Histerezis: ters yöndeki eşiği kur
+    ADC1->SR = ~ADC_SR_AWD;                         // Eşikler değiştikten sonra temizle (okuyup yazmak arada gelen EOC / OVR'yi silerdi)
+
+    if (gas_alarm_relay != relay_was && (TIM3->CR1 & TIM_CR1_CEN)) {  // Sadece röle bu kesmede değiştiyse ve timer tetikliyse
+        uint32_t cycles = ticks * (TIM3->PSC + 1) * (CLOCK_SYSCLK_HZ / CLOCK_APB1_TIMER_HZ);  // Timer tick → CPU cycle
+        gas_alarm_lat_last = cycles;
+        if (cycles > gas_alarm_lat_max) gas_alarm_lat_max = cycles;
+    }
+    PROF_END(isr_adc_awd);
+}
+
+/*
+
+Amaç: Röleyi ana döngüden bağımsız, örnek alınır alınmaz sürmek.
+
+Eskiden eşik kontrolü while(1) içindeydi; delay_ms(500) + delay_ms(50) + LCD süresi yüzünden röle yarım saniyeden fazla gecikebiliyordu.
+ADC'nin analog watchdog'u her dönüşüm sonunda değeri HTR/LTR ile donanımda karşılaştırır ve pencere dışındaysa kesme üretir.
+Kesme en yüksek öncelikte olduğu için röle, dönüşüm bittikten birkaç µs sonra değişir; ana döngü sadece ekranı günceller.
+
+Histerezis:
+	Watchdog tek bir pencere (LTR ≤ değer ≤ HTR) izler. Alarm yokken pencere [0, HIGH], alarm varken [LOW, 4095] yapılır.
+	Böylece her kesme sadece durum değişiminde gelir; eşik çevresinde gezinen değer röleyi titretmez.
+	Not: watchdog ham (filtresiz) örnekleri görür ve eski davranıştaki gibi GAS_ALARM_HIGH / LOW (2300 / 2200) ile kurulur;
+	seviye eşiği hiçbir zaman filtre gecikmesini beklemez. gas_trend bunun yerine geçmez, yükselme hızıyla daha erken alarm ekler.
+
+İki kaynak:
+	Röle, watchdog (ham örnek, µs gecikme) VEYA gas_trend (filtrelenmiş seviye + yükselme hızı, bekleme süreli) alarmdayken
+	gaz konumundadır; ikisi de gaz görmeyince bırakılır. gas_alarm_set_trend() DMA kesmesinden gelir; ADC kesmesi (öncelik 0)
+	ve TIM2 bırakma kesmesi aynı durumu değiştirdiği için kısa bir PRIMASK kilidi altında çalışır. Röle pinine tek yazan
+	gas_alarm_relay_set()'tir, gas_alarm_trips() iki kaynağın alarm girişlerini birlikte sayar.
+
+En kısa açık kalma süresi:
+	Röle gaz konumuna geçtikten sonra en az GAS_ALARM_MIN_ON_US açık kalır; lamba / fan gürültü yüzünden açılıp kapanmaz.
+	Gaz bu süre dolmadan kalkarsa watchdog hemen normal pencereye döner, fakat röle kalan süre için hrtimer'a kurulan
+	tek atımlık zamanlayıcıyla bırakılır. O sırada tekrar alarm gelirse zamanlayıcı iptal edilir ve röle hiç bırakılmaz.
+	Bekleme meşgul döngü değildir; ADC kesmesi birkaç µs içinde çıkar, bırakma TIM2 compare kesmesinden yapılır.
+	gas_alarm_active() watchdog durumunu değil, rölenin gerçek konumunu döndürür.
+
+Yerleşim:
+	ADC_IRQHandler ve çağırdığı her şey (bu dosyanın statik fonksiyonları, hrtimer, timer_wheel, timebase_cycles) RAMFUNC'tur;
+	değişkenler SRAM / CCM'dedir. Kesme flash'tan tek bir kelime okumadan röleyi sürer; flash sektörü silinirken açık kalan tek
+	NVIC kesmesi budur (flash.c). Linker script ve tools/ramfunc_check.sh bu fonksiyonların .RamFunc içinde olduğunu denetler.
+
+Geçiş kuyruğu:
+	Ana döngü röleyi 250 ms'de bir yoklasaydı, bırakma ile yeni alarm arasındaki kısa aralıklar (veya tersi) hiç görülmezdi.
+	Bu yüzden her geçiş, röle pini yazılırken gas_alarm_relay_set() içinde GAS_ALARM_EVENTS kayıtlık bir halkaya
+	{ zaman (timebase_cycles), durum, o anki alarm sayısı } olarak eklenir; telemetri görevi gas_alarm_event_pop() ile
+	hepsini sırayla boşaltır. Halkaya yazan tek fonksiyon zaten ya en yüksek öncelikli ADC kesmesinde ya da PRIMASK
+	kilidi altında çalışır, okuyan sadece ana döngüdür: tek yazan / tek okuyan, ek kilit gerekmez. Halka doluysa yeni
+	geçiş yazılmaz, gas_alarm_events_lost() ile sayılır.
+
+Gecikme ölçümü:
+	TIM3 her update olayında sıfırdan sayar ve aynı anda ADC dönüşümünü başlatır. Röle pini yazıldıktan hemen sonra okunan
+	TIM3->CNT, tetikten röle kenarına kadar geçen süredir (örnekleme + dönüşüm + kesme girişi + ISR).
+	(PSC + 1) ile timer saatine, SYSCLK / APB1 timer saati (168 MHz'de 2) ile CPU cycle'a çevrilir.
+	168 MHz'de ADC 21 MHz'de çalışır; 480 cycle örnekleme + 12 cycle dönüşüm ≈ 23.4 µs, beklenen değer ≈ 4000 cycle (≈ 24 µs).
+	Sürekli (CONT) modda tetik zamanı bilinmediği için ölçüm yapılmaz.
+
+*/
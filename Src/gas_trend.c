@@ -0,0 +1,166 @@
+#include <stdint.h>
+#include "gas_trend.h"
+
+static uint16_t gas_trend_ms_to_samples(uint16_t ms, uint32_t rate_mhz)
+{
+    uint32_t n = (uint32_t)(((uint64_t)ms * rate_mhz + 999999) / 1000000);   // Yukarı yuvarla: süre hiç kısalmaz
+
+    if (n == 0) n = 1;
+    if (n > 0xFFFF) n = 0xFFFF;
+    return (uint16_t)n;
+}
+
+uint8_t gas_trend_init(gas_trend_t* t, const gas_trend_config_t* cfg, uint16_t initial)
+{
+    if (cfg->rate_mhz == 0) return 1;
+    if (cfg->slope_window == 0 || cfg->slope_window > GAS_TREND_WINDOW_MAX) return 1;
+    if (cfg->accel_window == 0 || cfg->accel_window > GAS_TREND_ACCEL_MAX) return 1;
+    if (cfg->level_pre > cfg->level_alarm || cfg->slope_pre > cfg->slope_alarm) return 1;
+
+    t->cfg = *cfg;
+    t->raise_samples = gas_trend_ms_to_samples(cfg->raise_ms, cfg->rate_mhz);
+    t->clear_samples = gas_trend_ms_to_samples(cfg->clear_ms, cfg->rate_mhz);
+    gas_trend_reset(t, initial);
+    return 0;
+}
+
+void gas_trend_reset(gas_trend_t* t, uint16_t value)
+{
+    uint8_t w = t->cfg.slope_window;
+
+    for (uint8_t i = 0; i < 2 * w; i++) t->hist[i] = value;   // Düz geçmiş: eğim 0'dan başlar, hiç fazla tahmin edilmez
+    for (uint8_t i = 0; i < t->cfg.accel_window; i++) t->slopes[i] = 0;
+    t->hist_pos = 0;
+    t->slope_pos = 0;
+    t->sum_new = (int32_t)w * value;
+    t->sum_old = (int32_t)w * value;
+    t->warmup = 2 * w + t->cfg.accel_window;
+    t->rising = 0;
+    t->slope = 0;
+    t->accel = 0;
+    t->value = value;
+    t->streak = 0;
+    t->streak_target = GAS_TREND_NORMAL;
+    t->level = GAS_TREND_NORMAL;
+}
+
+void gas_trend_hold_rates(gas_trend_t* t)
+{
+    t->warmup = 2 * t->cfg.slope_window + t->cfg.accel_window;   // Geçmiş korunur; sayım her çağrıda baştan başlar
+    t->rising = 0;
+}
+
+static gas_trend_level_t gas_trend_classify(const gas_trend_t* t)
+{
+    const gas_trend_config_t* c = &t->cfg;
+    uint8_t slope_valid = t->warmup <= c->accel_window;    // Geçmiş tamamen gerçek örneklerle doldu
+    uint8_t accel_valid = t->warmup == 0;                  // İvme penceresindeki eğimler de geçerli
+    uint8_t settled = t->rising >= 2 * c->slope_window + c->accel_window;  // Yükselişin başlangıç geçişi ivme penceresinin dışında
+
+    // Histerezis: bulunulan kademenin sınırı hyst kadar aşağı çekilir
+    int32_t level_pre = (int32_t)c->level_pre - (t->level >= GAS_TREND_PREALARM ? c->level_hyst : 0);
+    int32_t level_alarm = (int32_t)c->level_alarm - (t->level >= GAS_TREND_ALARM ? c->level_hyst : 0);
+    int32_t slope_pre = c->slope_pre - (t->level >= GAS_TREND_PREALARM ? c->slope_hyst : 0);
+    int32_t slope_alarm = c->slope_alarm - (t->level >= GAS_TREND_ALARM ? c->slope_hyst : 0);
+
+    if (t->value >= level_alarm) return GAS_TREND_ALARM;
+    if (slope_valid && t->slope >= slope_alarm) return GAS_TREND_ALARM;
+    if (accel_valid && settled && c->accel_alarm && t->accel >= c->accel_alarm) return GAS_TREND_ALARM;  // Süren yükseliş hızlanıyor
+
+    if (t->value >= level_pre) return GAS_TREND_PREALARM;
+    if (slope_valid && t->slope >= slope_pre) return GAS_TREND_PREALARM;
+
+    return GAS_TREND_NORMAL;
+}
+
+gas_trend_level_t gas_trend_update(gas_trend_t* t, uint16_t adc)
+{
+    const gas_trend_config_t* c = &t->cfg;
+    uint8_t w = c->slope_window;
+    uint8_t mid_pos = t->hist_pos + w;
+
+    if (mid_pos >= 2 * w) mid_pos -= 2 * w;
+
+    uint16_t oldest = t->hist[t->hist_pos];     // x[n - 2W]
+    uint16_t mid = t->hist[mid_pos];            // x[n - W]: yeni pencereden eski pencereye geçer
+
+    t->sum_new += (int32_t)adc - mid;
+    t->sum_old += (int32_t)mid - oldest;
+    t->hist[t->hist_pos] = adc;
+    if (++t->hist_pos >= 2 * w) t->hist_pos = 0;
+    t->value = adc;
+
+    // Pencere ortalamalarının merkezleri W örnek aralıklı: eğim = (Σyeni - Σeski) / W² örnek başına
+    t->slope = (int32_t)((int64_t)(t->sum_new - t->sum_old) * 60 * c->rate_mhz / (1000LL * w * w));
+
+    int32_t prev = t->slopes[t->slope_pos];     // A örnek önceki eğim
+    t->slopes[t->slope_pos] = t->slope;
+    if (++t->slope_pos >= c->accel_window) t->slope_pos = 0;
+    t->accel = (int32_t)((int64_t)(t->slope - prev) * 60 * c->rate_mhz / (1000LL * c->accel_window));
+
+    if (t->slope < c->slope_pre) t->rising = 0;
+    else if (t->rising < 0xFFFF) t->rising++;
+    if (t->warmup) t->warmup--;
+
+    gas_trend_level_t target = gas_trend_classify(t);
+
+    if (target == t->level) {
+        t->streak = 0;                          // Kesinti: bekleme baştan başlar
+        return t->level;
+    }
+
+    uint8_t up = target > t->level;
+    if (t->streak == 0 || up != (t->streak_target > t->level)) {
+        t->streak = 0;                          // Yön değişti: yeni bekleme
+        t->streak_target = target;
+    } else if (up ? target < t->streak_target : target > t->streak_target) {
+        t->streak_target = target;              // Bekleme boyunca istenen, mevcut kademeye en yakın kademe
+    }
+
+    if (++t->streak >= (up ? t->raise_samples : t->clear_samples)) {
+        t->level = t->streak_target;
+        t->streak = 0;
+    }
+    return t->level;
+}
+
+/*
+
+Amaç: Sabit bir eşiği (2300) beklemeden hızlı kaçağı erken, yavaş kaymayı ise alarm vermeden ayırt etmek.
+
+Eğim (O(1)):
+	Son 2W örnek halkada tutulur. Son W örneğin toplamı ile ondan önceki W örneğin toplamı, her örnekte sadece
+	halkadan çıkan iki örnekle güncellenir (x[n-W] yeni pencereden eski pencereye geçer, x[n-2W] düşer).
+	İki pencerenin ortalaması arasındaki fark, merkezleri arasındaki W örneğe bölünerek eğim bulunur; ortalama alındığı
+	için tek örnek gürültüsü W² oranında bastırılır. Sonuç ADC / dakika cinsindendir (rate_mhz ile örnek hızından bağımsız).
+
+İvme (O(1)):
+	Son A eğim ikinci bir halkada tutulur; ivme = (eğim[n] - eğim[n-A]) / A süresi (ADC / dakika²).
+	Eğim en az 2W + A örnektir kesintisiz ön alarm sınırındaysa ve ivme accel_alarm'ı aşıyorsa süren bir yükseliş
+	hızlanıyor demektir (kaçak açılıyor) ve eğim henüz alarm sınırına gelmeden alarm verilir.
+	Bu şart olmasaydı her yükselişin başlangıcı ivme gibi görünürdü: sabit hızlı bir rampada eğim tahmini 2W örnekte
+	0'dan rampa hızına S biçiminde çıkar ve bu sürede ivme büyüktür. 2W + A örnek sonra bu geçiş ivme penceresinden
+	çıkmıştır; sabit hızlı rampa bu yüzden sadece eğim / seviye sınırlarıyla alarm verir, başlangıcı ön alarmdır.
+
+Kademeler:
+	Alarm: seviye ≥ level_alarm, veya eğim ≥ slope_alarm, veya (2W + A örnektir eğim ≥ slope_pre ve ivme ≥ accel_alarm)
+	Ön alarm: seviye ≥ level_pre veya eğim ≥ slope_pre
+	Yavaş kayma (sensör yaşlanması, sıcaklık / nem) dakikada birkaç ADC'dir, eğim sınırlarına ulaşmaz; sadece seviye
+	sınırlarını geçerse alarm verir. Mutlak seviyenin kaymaya karşı düzeltilmesi mq2_calib'in R0 takibinin işidir.
+
+Histerezis ve bekleme:
+	Bulunulan kademenin seviye ve eğim sınırları hyst kadar aşağı çekilir; sınır çevresinde gezinen değer kademe değiştirmez.
+	Yeni bir kademe raise_ms (yükselirken) veya clear_ms (inerken) boyunca kesintisiz istenmedikçe onaylanmaz.
+	Bekleme sırasında istenen kademeler farklıysa (örn. ön alarm ve alarm arasında gidip geliyorsa) mevcut kademeye en yakın
+	olanına geçilir; tek örneklik bir alarm isteği ön alarm beklemesini bozmaz.
+
+Isınma:
+	gas_trend_reset() geçmişi sabit değerle doldurur, eğim 0 görünür. Eğim kriteri 2W örnek, ivme kriteri 2W + A örnek
+	sonra devreye girer; bu süre boyunca sadece seviye kriterleri çalışır.
+	gas_trend_hold_rates() aynı sayımı geçmişe dokunmadan baştan başlatır. Sensör ısıtıcısı ısınırken okumalar hızla kayar:
+	main her örnekte önce bunu, sonra gas_trend_update()'i çağırır; eğim / ivme susar, seviye kriterleri ve kademe
+	bekleme süreleri çalışmaya devam eder. Isınma bitince eğim kriteri 2W, ivme kriteri 2W + A örnek sonra devreye girer.
+
+Donanıma erişmez; bilgisayarda sentetik kaçak / kayma / gürültü senaryolarıyla doğrudan sürülebilir.
+
+*/
@@ -0,0 +1,136 @@
+#include <stdint.h>
+#include <stddef.h>
+#include "stm32f4xx.h"
+#include "hrtimer.h"
+#include "clock_config.h"
+#include "mem_sections.h"
+#include "prof.h"
+
+#define HRTIMER_LOCK()      uint32_t hrtimer_primask = __get_PRIMASK(); __disable_irq()
+#define HRTIMER_UNLOCK()    __set_PRIMASK(hrtimer_primask)
+
+static CCMRAM timer_wheel_t hrtimer_wheel;
+
+void hrtimer_init(void)
+{
+    RCC->APB1ENR |= RCC_APB1ENR_TIM2EN;                 // TIM2 clock'unu aktif et
+
+    TIM2->CR1 = 0;
+    TIM2->PSC = (CLOCK_APB1_TIMER_HZ / HRTIMER_TICK_HZ) - 1;   // 1 tick = 1 µs
+    TIM2->ARR = 0xFFFFFFFF;                             // TIM2 32 bittir: tam aralıkta serbest sayar
+    TIM2->CCMR1 = 0;                                    // CC1 çıkış karşılaştırma, pine bağlı değil (frozen)
+    TIM2->CNT = 0;
+    TIM2->EGR = TIM_EGR_UG;                             // PSC'yi hemen yükle
+    TIM2->SR = 0;
+    TIM2->DIER = 0;                                     // CC1IE sadece bekleyen zamanlayıcı varken açık
+
+    timer_wheel_init(&hrtimer_wheel, 0);
+
+    NVIC_SetPriority(TIM2_IRQn, HRTIMER_IRQ_PRIO);
+    NVIC_EnableIRQ(TIM2_IRQn);
+    TIM2->CR1 = TIM_CR1_CEN;
+}
+
+RAMFUNC uint32_t hrtimer_now(void)
+{
+    return TIM2->CNT;
+}
+
+RAMFUNC static void hrtimer_program(void)
+{
+    uint32_t when;
+
+    if (timer_wheel_next(&hrtimer_wheel, &when)) {
+        TIM2->DIER &= ~TIM_DIER_CC1IE;                  // Bekleyen yok: kesme de yok
+        return;
+    }
+
+    TIM2->CCR1 = when;                                  // En yakın olay (süre dolumu veya seviye taşıma anı)
+    TIM2->SR = ~TIM_SR_CC1IF;
+    TIM2->DIER |= TIM_DIER_CC1IE;
+
+    if ((int32_t)(when - TIM2->CNT) <= 0) {             // Yazarken sayaç geçtiyse eşleşme bir sonraki turu beklerdi
+        TIM2->EGR = TIM_EGR_CC1G;                       // Kesmeyi elle üret
+    }
+}
+
+RAMFUNC uint8_t hrtimer_start(timer_wheel_timer_t* t, uint32_t delay_us, uint32_t period_us)
+{
+    if (delay_us > TIMER_WHEEL_MAX_DELAY) return 1;
+
+    HRTIMER_LOCK();
+    uint8_t err = timer_wheel_add(&hrtimer_wheel, t, TIM2->CNT + delay_us, period_us);
+    if (!err) hrtimer_program();
+    HRTIMER_UNLOCK();
+    return err;
+}
+
+RAMFUNC void hrtimer_cancel(timer_wheel_timer_t* t)
+{
+    HRTIMER_LOCK();
+    timer_wheel_cancel(&hrtimer_wheel, t);
+    hrtimer_program();                                  // Compare artık daha geç bir olaya kurulabilir
+    HRTIMER_UNLOCK();
+}
+
+uint32_t hrtimer_pending(void)
+{
+    return hrtimer_wheel.pending;
+}
+
+RAMFUNC static uint8_t hrtimer_expire(timer_wheel_fn_t* fn, void** arg)   // 0: süresi dolan çarktan çıkarıldı, 1: yok (compare kuruldu)
+{
+    HRTIMER_LOCK();                                     // Daha öncelikli kesme (ADC) zamanlayıcı kurabilir
+    timer_wheel_timer_t* e = timer_wheel_expire(&hrtimer_wheel, TIM2->CNT);
+    if (e != NULL) {
+        *fn = e->fn;                                    // Kilit bırakılınca zamanlayıcı yeniden kurulabilir
+        *arg = e->arg;
+    } else {
+        hrtimer_program();
+    }
+    HRTIMER_UNLOCK();
+    return e != NULL ? 0 : 1;
+}
+
+RAMFUNC void TIM2_IRQHandler(void)
+{
+    timer_wheel_fn_t fn;
+    void* arg;
+
+    PROF_BEGIN(isr_hrtimer);
+    TIM2->SR = ~TIM_SR_CC1IF;                           // rc_w0: sadece CC1IF temizlenir
+
+    while (hrtimer_expire(&fn, &arg) == 0) {
+        fn(arg);                                        // Kesmeler açık: ADC / DMA callback sürerken de gelir
+    }
+    PROF_END(isr_hrtimer);
+}
+
+/*
+
+Amaç: µs mertebesindeki beklemeleri DWT_Delay_us() gibi meşgul döngülerle değil, kesme ile yapmak.
+
+Donanım:
+	TIM2 APB1'de 32 bitlik genel amaçlı bir timer'dır. 1 MHz'e bölünüp ARR = 0xFFFFFFFF ile serbest saydırılır,
+	yani sayaç hiç sıfırlanmaz ve her an "şu anki µs"i verir. CC1 kanalı çıkış karşılaştırma modunda, pine bağlı değildir;
+	CNT == CCR1 olduğunda CC1IF kesmesi gelir.
+
+Akış:
+	hrtimer_start() → zamanlayıcıyı çarka ekler (timer_wheel.c) ve CCR1'i en yakın olaya kurar.
+	TIM2_IRQHandler → çarkı TIM2->CNT'ye kadar ilerletir (süresi dolan callback'ler burada çağrılır) ve CCR1'i tekrar kurar.
+	Bekleyen zamanlayıcı yoksa CC1IE kapatılır; boştayken hiç kesme gelmez.
+
+Kilit:
+	Çark hem ana döngüden hem de kesmelerden (TIM2, ADC watchdog) değiştirilir. Her değişiklik PRIMASK ile birkaç µs'lik
+	kritik bölgede yapılır. Kesme süresi dolan zamanlayıcıları timer_wheel_expire() ile kilit altında tek tek çarktan
+	çıkarır, callback'i kilidi bıraktıktan sonra çağırır. Böylece PRIMASK = 1 süresi callback sayısından ve süresinden
+	bağımsızdır; uzun bir callback ADC watchdog'u veya DMA kesmesini geciktirmez. Callback hrtimer_start() /
+	hrtimer_cancel() çağırabilir; compare en son, süresi dolan kalmayınca kurulur.
+
+Yerleşim:
+	hrtimer_now / _start / _cancel, kesme ve çarkın kullandığı timer_wheel fonksiyonları RAMFUNC'tur: ADC watchdog kesmesi
+	röle bırakma zamanlayıcısını flash'a dokunmadan kurar / iptal eder. Callback'ler kaydedenin yerleştirdiği yerdedir.
+
+Callback'ler yine de TIM2 kesme bağlamında çalışır ve sürdükçe diğer zamanlayıcıları geciktirir. Uzun iş gerekiyorsa callback bir bayrak kurup işi scheduler görevine bırakmalıdır.
+
+*/
@@ -0,0 +1,259 @@
+#include <stdint.h>
+#include "stm32f4xx.h"
+#include "lcd_config.h"
+#include "lcd_async.h"
+#include "lcd_timing.h"
+#include "lcd_transport.h"
+#include "hrtimer.h"
+
+#define LCD_ASYNC_MASK      (LCD_ASYNC_QUEUE_SIZE - 1)
+#define LCD_ASYNC_RS        0x100       // Kuyruk elemanında RS bitinin yeri (1: veri, 0: komut)
+#define LCD_ASYNC_NS_TO_US(ns)  (((ns) + 999) / 1000)     // Timer 1 µs çözünürlüklü, ns süreleri yukarı yuvarlanır
+
+typedef enum {
+    LCD_ASYNC_IDLE,         // Kuyruktan yeni bayt alınacak
+    LCD_ASYNC_HI_E_HIGH,    // Yüksek nibble (8-bit bağlantıda bütün bayt) pinlerde, E yükselecek
+    LCD_ASYNC_HI_E_LOW,     // E düşecek (yüksek nibble okunur; 8-bit'te bayt biter)
+    LCD_ASYNC_LO_SETUP,     // Düşük nibble pinlere yazılacak
+    LCD_ASYNC_LO_E_HIGH,    // E yükselecek
+    LCD_ASYNC_LO_E_LOW      // E düşecek, ardından LCD komutu işlerken beklenecek
+} lcd_async_state_t;
+
+static volatile uint16_t lcd_async_queue[LCD_ASYNC_QUEUE_SIZE];    // Bekleyen baytlar (bit 8 = RS)
+static volatile uint8_t lcd_async_head;                             // Sadece uygulama (ekleyen taraf) değiştirir
+static volatile uint8_t lcd_async_tail;                             // Sadece ISR (tüketen taraf) değiştirir
+static volatile uint8_t lcd_async_running;                          // Timer çalışıyor ve kuyruk tüketiliyorsa 1
+#if LCD_TRANSPORT != LCD_TRANSPORT_PCF8574
+static lcd_async_state_t lcd_async_state = LCD_ASYNC_IDLE;
+static uint16_t lcd_async_current;                                  // Şu an gönderilen eleman
+static const lcd_timing_t* lcd_async_timing;                        // Şu anki baytın zamanlama profili satırı
+#endif
+static void (*lcd_async_callback)(void);
+static timer_wheel_timer_t lcd_async_timer;                         // hrtimer servisindeki tek atımlık zamanlayıcı
+
+static void lcd_async_fire(void* arg);
+
+static void lcd_async_timer_start(uint32_t us)
+{
+    if (us < 1) us = 1;             // En az bir tick sonra
+
+    hrtimer_start(&lcd_async_timer, us, 0);     // Süre dolunca lcd_async_fire() TIM2 kesmesinden çağrılır
+}
+
+void lcd_async_init(void)
+{
+    timer_wheel_timer_init(&lcd_async_timer, lcd_async_fire, 0);    // hrtimer_init() daha önce çağrılmış olmalı
+}
+
+/*
+
+Bekleme süreleri eskiden TIM6'nın tek atımlık moduyla üretiliyordu; artık ortak µs zamanlayıcı servisinden (hrtimer.c, TIM2)
+tek atımlık bir zamanlayıcı kullanılır. TIM6 boşa çıkar ve LCD beklemeleri röle / diğer zamanlayıcılarla aynı compare
+kesmesini paylaşır. Çözünürlük yine 1 µs'dir; ns süreleri yukarı yuvarlanır.
+
+*/
+
+static uint8_t lcd_async_push(uint16_t entry)
+{
+    uint8_t next = (lcd_async_head + 1) & LCD_ASYNC_MASK;
+
+    if (next == lcd_async_tail) {       // Kuyruk dolu
+        return 1;
+    }
+
+    lcd_async_queue[lcd_async_head] = entry;
+    lcd_async_head = next;              // Eleman yazıldıktan sonra görünür yap
+
+    if (!lcd_async_running) {           // Durum makinesi boştaysa timer'ı başlat
+        lcd_async_running = 1;
+        lcd_async_timer_start(2);
+    }
+
+    return 0;
+}
+
+uint8_t lcd_async_command(uint8_t command)
+{
+    return lcd_async_push(command);                     // RS = 0
+}
+
+uint8_t lcd_async_data(uint8_t data)
+{
+    return lcd_async_push(LCD_ASYNC_RS | data);         // RS = 1
+}
+
+uint8_t lcd_async_pending(void)
+{
+    return (lcd_async_head - lcd_async_tail) & LCD_ASYNC_MASK;
+}
+
+uint8_t lcd_async_free(void)
+{
+    return LCD_ASYNC_MASK - lcd_async_pending();        // Bir yer dolu/boş ayrımı için hep boş bırakılır
+}
+
+uint8_t lcd_async_busy(void)
+{
+    return lcd_async_running;
+}
+
+void lcd_async_wait(void)
+{
+    while (lcd_async_running) {         // Son bayt da gidip LCD'nin çalışma süresi dolunca ISR 0 yapar
+        __WFI();                        // Sıradaki adım bir kesmeden gelir; en geç SysTick uyandırır
+    }
+}
+
+void lcd_async_set_callback(void (*callback)(void))
+{
+    lcd_async_callback = callback;
+}
+
+/*
+
+Kuyruk tek üretici (ana döngü) / tek tüketici (TIM2 hrtimer kesmesi) halkasıdır, bu yüzden kesmeleri kapatmaya gerek yoktur:
+	lcd_async_head sadece lcd_async_push() içinde, lcd_async_tail sadece ISR içinde değişir.
+	Kapasite LCD_ASYNC_QUEUE_SIZE - 1'dir; head == tail "boş", head + 1 == tail "dolu" anlamına gelir.
+
+lcd_async_running:
+	ISR kuyruğu boş bulup durduğunda 0 yapılır. Yeni bayt eklendiğinde 0 ise timer 2 µs sonra ilk adımı atacak şekilde başlatılır.
+	Bayt kuyruğa kontrolden önce yazıldığı için, ISR araya girse bile ya yeni baytı görür ya da running'i 0 yapıp çıkar.
+
+lcd_async_wait():
+	Bloklayan lcd_send_command() / lcd_send_data() pinleri (veya I2C1'i) doğrudan sürer. Kuyruk o sırada gönderim
+	yapıyorsa iki taraf aynı nibble'ın ortasında pinleri değiştirir; LCD yarım bayt alır ve 4-bit senkronu kaybolur.
+	Bu yüzden bloklayan yazımlar önce kuyruğun boşalmasını bekler. Kuyruğa sadece ana döngü eklediği için bekleme
+	sırasında yeni bayt gelmez. TIM2'den (ve PCF8574'te I2C1'den) daha yüksek öncelikli bir kesmede çağrılırsa
+	kuyruk hiç ilerlemez; LCD kesmeden sürülmez.
+
+*/
+
+#if LCD_TRANSPORT != LCD_TRANSPORT_PCF8574
+
+uint32_t lcd_async_step(void)
+{
+    uint8_t rs = (lcd_async_current & LCD_ASYNC_RS) ? 1 : 0;
+    uint8_t byte = (uint8_t)lcd_async_current;
+
+    switch (lcd_async_state) {
+    case LCD_ASYNC_IDLE:
+        if (lcd_async_tail == lcd_async_head) {             // Gönderilecek bir şey kalmadı
+            if (lcd_async_callback) lcd_async_callback();
+            return 0;
+        }
+        lcd_async_current = lcd_async_queue[lcd_async_tail];
+        rs = (lcd_async_current & LCD_ASYNC_RS) ? 1 : 0;
+        byte = (uint8_t)lcd_async_current;
+        lcd_async_timing = lcd_timing_for(rs, byte);       // Senkron sürücü ile aynı profil tablosu
+        lcd_bus_set(rs, LCD_BUS_BITS == 8 ? byte : byte >> 4);  // Yüksek nibble (8-bit: bütün bayt)
+        lcd_async_state = LCD_ASYNC_HI_E_HIGH;
+        return LCD_ASYNC_NS_TO_US(lcd_async_timing->setup_ns);
+
+    case LCD_ASYNC_HI_E_HIGH:
+        lcd_bus_enable(1);
+        lcd_async_state = LCD_ASYNC_HI_E_LOW;
+        return LCD_ASYNC_NS_TO_US(lcd_async_timing->e_pulse_ns);
+
+    case LCD_ASYNC_HI_E_LOW:
+        lcd_bus_enable(0);                                  // LCD yüksek nibble'ı E'nin düşen kenarında okur
+        if (LCD_BUS_BITS == 8) {                            // Bayt tek darbede gitti: düşük nibble adımları yok
+            lcd_async_tail = (lcd_async_tail + 1) & LCD_ASYNC_MASK;
+            lcd_async_state = LCD_ASYNC_IDLE;
+            return lcd_async_timing->exec_us;
+        }
+        lcd_async_state = LCD_ASYNC_LO_SETUP;
+        return LCD_ASYNC_NS_TO_US(lcd_async_timing->e_low_ns);
+
+    case LCD_ASYNC_LO_SETUP:
+        lcd_bus_set(rs, byte & 0x0F);                       // Düşük nibble
+        lcd_async_state = LCD_ASYNC_LO_E_HIGH;
+        return LCD_ASYNC_NS_TO_US(lcd_async_timing->setup_ns);
+
+    case LCD_ASYNC_LO_E_HIGH:
+        lcd_bus_enable(1);
+        lcd_async_state = LCD_ASYNC_LO_E_LOW;
+        return LCD_ASYNC_NS_TO_US(lcd_async_timing->e_pulse_ns);
+
+    case LCD_ASYNC_LO_E_LOW:
+    default:
+        lcd_bus_enable(0);
+        lcd_async_tail = (lcd_async_tail + 1) & LCD_ASYNC_MASK;    // Bayt tamamlandı, kuyruktan çıkar
+        lcd_async_state = LCD_ASYNC_IDLE;
+        return lcd_async_timing->exec_us;                   // Clear/Home 1.52 ms, diğerleri 37-41 µs (lcd_timing.h)
+    }
+}
+
+/*
+
+lcd_send_nibble() içindeki her DWT_Delay_us() bekleme, burada durum makinesinin bir adımına dönüşür.
+Her adım pinleri değiştirir ve bir sonraki adıma kadar kaç µs beklenmesi gerektiğini döndürür:
+
+	IDLE      → RS + yüksek nibble pinlere yazılır       → setup süresi
+	HI_E_HIGH → E = 1                                   → darbe süresi
+	HI_E_LOW  → E = 0 (LCD yüksek nibble'ı okur)         → hold süresi
+	LO_SETUP  → düşük nibble pinlere yazılır             → setup süresi
+	LO_E_HIGH → E = 1                                   → darbe süresi
+	LO_E_LOW  → E = 0, bayt kuyruktan çıkar              → komutun çalışma süresi (37 µs veya 1.52 ms)
+
+Süreler lcd_timing_for() ile senkron sürücünün kullandığı profil tablosundan alınır.
+8-bit bağlantıda (LCD_TRANSPORT_GPIO8) IDLE bütün baytı yazar ve HI_E_LOW baytı bitirir; bayt başına 6 yerine 3 kesme.
+
+Bekleme sırasında CPU serbesttir; örnekleme ve kontrol kodu çalışmaya devam eder.
+Fonksiyon timer register'larına dokunmaz, bu yüzden bilgisayarda sahte bir zamanlayıcı ile adım adım sürülebilir.
+
+*/
+
+#else   // LCD_TRANSPORT_PCF8574
+
+static void lcd_async_batch_done(void)
+{
+    lcd_async_timer_start(LCD_PCF_BUS_FREE_US);         // I2C kesmesinden: STOP'un bitmesini bekle, sonra sıradaki parti
+}
+
+uint32_t lcd_async_step(void)
+{
+    if (lcd_pcf_batch_abort()) {                        // Zaman aşımı: parti bitmedi, done() sıradakini planladı
+        return LCD_ASYNC_WAIT_DMA;
+    }
+    if (lcd_async_tail == lcd_async_head) {             // Gönderilecek bir şey kalmadı
+        if (lcd_async_callback) lcd_async_callback();
+        return 0;
+    }
+
+    lcd_pcf_batch_begin();
+    for (uint8_t n = 0; n < LCD_PCF_LINE_BYTES && lcd_async_tail != lcd_async_head; n++) {
+        uint16_t entry = lcd_async_queue[lcd_async_tail];
+        if (lcd_pcf_batch_add((entry & LCD_ASYNC_RS) ? 1 : 0, (uint8_t)entry)) break;
+        lcd_async_tail = (lcd_async_tail + 1) & LCD_ASYNC_MASK;    // Kodlandı: kuyruktaki yer serbest
+    }
+    return lcd_pcf_batch_send(lcd_async_batch_done);   // Bu süre içinde done() zamanlayıcıyı yeniden kurar
+}
+
+/*
+
+PCF8574 bağlantısında E darbesi ve bekleme süreleri pin pin zamanlanmaz; hepsi I2C yazımlarının içine kodlanır
+(lcd_transport.c). Bu yüzden durum makinesi tek adımdır:
+	Kuyruktan en fazla bir satırlık bayt (imleç + 16 karakter) DMA tamponuna kodlanır ve tek transfer başlatılır.
+	Transfer bitince I2C kesmesi lcd_async_batch_done() ile zamanlayıcıyı kurar, sıradaki parti oradan başlar.
+	Gönderirken zamanlayıcı partinin en geç bitiş süresine kurulur. I2C kesmesi gelmezse (hat takıldı) zamanlayıcı
+	dolar, lcd_pcf_batch_abort() hattı kurtarıp partiyi atar ve kuyruk sıradakiyle devam eder.
+lcd_flush_async() satır başına bir imleç komutu + değişen karakterleri eklediği için, değişen her satır tek DMA transferidir.
+
+*/
+
+#endif
+
+static void lcd_async_fire(void* arg)
+{
+    (void)arg;
+
+    uint32_t us = lcd_async_step();
+    if (us == LCD_ASYNC_WAIT_DMA) {
+        return;                             // Devamı taşıma katmanının kesmesinden gelecek
+    }
+    if (us) {
+        lcd_async_timer_start(us);          // Bir sonraki adımı planla
+    } else {
+        lcd_async_running = 0;              // Kuyruk boş, timer durur
+    }
+}
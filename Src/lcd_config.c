@@ -2,7 +2,12 @@
 #include <stdint.h>
 #include "stm32f4xx.h"
 #include "lcd_config.h"
+#include "lcd_transport.h"
 #include "delay.h"
+#include "lcd_async.h"
+#include "lcd_timing.h"
+#include "prof.h"
+#include "mem_sections.h"
 
 /*
 
@@ -14,7 +19,7 @@ VO			Kontrast Ayarı					- 10kΩ Potansiyometre (Ortadaki bacak, diğer uçlar V
 RS			Register Select (Komut/Veri)	GPIOA Pin 1
 RW			Read/Write (Okuma/Yazma)		GND (Sürekli yazma modunda kalması için)
 E			Enable (Etkinleştirme)			GPIOA Pin 3
-D0-D3		Veri Pinleri (Kullanılmıyor)	-
+D0-D3		Veri Pinleri 0-3				GPIOB Pin 12-15 (sadece LCD_TRANSPORT_GPIO8, 4-bit modda boş)
 D4			Veri Pini 4						GPIOB Pin 4
 D5			Veri Pini 5						GPIOB Pin 5
 D6			Veri Pini 6						GPIOB Pin 6
@@ -22,131 +27,172 @@ D7			Veri Pini 7						GPIOB Pin 7
 A (LED+)	Arka Işık (+)					5V (Seri bir 220Ω-330Ω dirençle birlikte)
 K (LED-)	Arka Işık (-)					GND
 
+PCF8574 sırt kartında (LCD_TRANSPORT_PCF8574) LCD pinleri kartın kendisine lehimlidir; STM32'ye sadece
+SCL → PB6, SDA → PB9, VCC → 5V ve GND bağlanır. Pin numaraları lcd_transport.h içinde tanımlıdır.
+
 */
 
-void lcd_gpio_config(void)
-{
+#define LCD_ADDR_UNKNOWN    0xFF    // LCD adres sayacının değeri bilinmiyor (ör. CGRAM yazımı, shift komutu sonrası)
+#define LCD_FLUSH_MERGE_GAP 1       // İki değişik bölge arasındaki bu kadar aynı hücre, imleç taşımak yerine yeniden yazılır
 
-	RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN | RCC_AHB1ENR_GPIOBEN; // GPIOA ve GPIOB'nin clock'larını etkinleştir
+static CCMRAM char lcd_frame[LCD_ROWS][LCD_COLS];   // Uygulamanın çizdiği hedef görüntü (RAM çerçevesi, CCM)
+static CCMRAM char lcd_shadow[LCD_ROWS][LCD_COLS];  // Panelin DDRAM'inde şu an gerçekten bulunan karakterler
+static uint8_t lcd_addr = LCD_ADDR_UNKNOWN;  // LCD'nin dahili adres sayacının (imlecin) bilinen değeri
+static uint32_t lcd_errors_seen;             // Gölgenin en son doğrulandığı andaki lcd_transport_errors()
 
-	GPIOA->MODER &= ~(GPIO_MODER_MODE1 | GPIO_MODER_MODE2 | GPIO_MODER_MODE3); 		// GPIOA pin 1,2,3'ün mod bitlerini temizle
-	GPIOA->MODER |= (GPIO_MODER_MODE1_0 | GPIO_MODER_MODE2_0 | GPIO_MODER_MODE3_0); // GPIOA pin 1,2,3'ü çıkış moduna ayarla
+#define LCD_GLYPH_CODE(slot)    (0x08 + (slot))     // CGRAM karakterleri 0x00-0x07 ve 0x08-0x0F'te tekrarlanır; '\0' ile karışmasın
+#define LCD_BAR_FULL            0xFF                // A00 karakter ROM'unda tamamen dolu blok (CGRAM gerektirmez)
+#define LCD_BAR_SLOT            0                   // Slot 0-3: soldan 1-4 sütunu dolu kısmi hücreler
+#define LCD_SPARK_SLOT          4                   // Slot 4-7: sparkline hücreleri
 
-    GPIOB->MODER &= ~(GPIO_MODER_MODE4 | GPIO_MODER_MODE5 | GPIO_MODER_MODE6 | GPIO_MODER_MODE7); 		// GPIOB pin 4,5,6,7'nin mod bitlerini temizle
-    GPIOB->MODER |= (GPIO_MODER_MODE4_0 | GPIO_MODER_MODE5_0 | GPIO_MODER_MODE6_0 | GPIO_MODER_MODE7_0); // GPIOB pin 4,5,6,7'yi çıkış moduna ayarla
+static uint8_t lcd_glyph_want[LCD_CGRAM_SLOTS][LCD_GLYPH_ROWS];  // Widget'ların istediği desenler
+static uint8_t lcd_glyph_have[LCD_CGRAM_SLOTS][LCD_GLYPH_ROWS];  // CGRAM'de gerçekten bulunan desenler
+static uint8_t lcd_glyph_loaded;            // have[] geçerli olan slotlar (bit maskesi)
+static uint32_t lcd_glyph_uploads;
+static uint8_t lcd_spark[LCD_SPARK_SAMPLES];    // Sparkline örnek yükseklikleri (0-8), halka
+static uint8_t lcd_spark_head;                  // En eski örneğin indeksi
 
-    GPIOA->ODR &= ~(GPIO_ODR_OD1 | GPIO_ODR_OD3); 								// GPIOA pin 1 ve 3'ü LOW seviyesine ayarla
-    GPIOB->ODR &= ~(GPIO_ODR_OD4 | GPIO_ODR_OD5 | GPIO_ODR_OD6 | GPIO_ODR_OD7); // GPIOB pin 4,5,6,7'yi LOW seviyesine ayarla
+#define LCD_TIMING_ROW(exec_us) { LCD_TIMING(E_PULSE_NS), LCD_TIMING(E_CYCLE_NS) - LCD_TIMING(E_PULSE_NS), LCD_TIMING(SETUP_NS), (exec_us) }
 
+static const lcd_timing_t lcd_timing[LCD_CLASS_COUNT] = {   // Seçili profilin (lcd_timing.h) komut sınıfı başına süreleri
+    [LCD_CLASS_CLEAR_HOME]   = LCD_TIMING_ROW(LCD_TIMING(EXEC_CLEAR_US)),
+    [LCD_CLASS_SET_ADDRESS]  = LCD_TIMING_ROW(LCD_TIMING(EXEC_ADDR_US)),
+    [LCD_CLASS_WRITE_DATA]   = LCD_TIMING_ROW(LCD_TIMING(EXEC_DATA_US)),
+    [LCD_CLASS_FUNCTION_SET] = LCD_TIMING_ROW(LCD_TIMING(EXEC_FUNC_US)),
+};
+
+const lcd_timing_t* lcd_timing_for(uint8_t rs, uint8_t byte)
+{
+    if (rs) {
+        return &lcd_timing[LCD_CLASS_WRITE_DATA];
+    }
+    if (byte == 0x01 || (byte & 0xFE) == 0x02) {        // Clear Display / Return Home
+        return &lcd_timing[LCD_CLASS_CLEAR_HOME];
+    }
+    if ((byte & 0xE0) == 0x20) {                        // Function Set
+        return &lcd_timing[LCD_CLASS_FUNCTION_SET];
+    }
+    return &lcd_timing[LCD_CLASS_SET_ADDRESS];          // DDRAM/CGRAM adresi, display control, entry mode, shift
 }
 
 /*
 
-Bu fonksiyonun amacı: LCD’nin RS, E ve veri pinleri (D4–D7) için gerekli GPIO ayarlarını yapmak.
-
-RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN | RCC_AHB1ENR_GPIOBEN;
-	GPIOA ve GPIOB portlarının clock’u açılır. Bu yapılmadan pinler kullanılamaz.
+Eskiden her nibble için 3 × 100 µs, her komuttan sonra 2 ms (lcd_clear'da ayrıca 2 ms) bekleniyordu.
+Oysa datasheet'e göre imleç taşıma gibi komutlar 37 µs, E darbesi ise 450 ns yeterlidir.
 
-GPIOA->MODER &= ~(GPIO_MODER_MODE1 | GPIO_MODER_MODE2 | GPIO_MODER_MODE3);
-	Önce PA1, PA2, PA3 pinlerinin mod register’ları temizlenir (resetlenir).
-	PA1 = RS pini, PA2 = kullanılmıyor (boş bırakılmış), PA3 = E pini.
+Artık her gönderimde önce bayt sınıflandırılır (lcd_timing_for), sonra o sınıfın süreleri kullanılır:
+	e_pulse_ns → E HIGH süresi
+	e_low_ns   → E düştükten sonra bir sonraki darbeye kadar bekleme (tcycE - PWEH)
+	setup_ns   → pinler ayarlandıktan sonra E yükselmeden önceki bekleme
+	exec_us    → ikinci nibble'dan sonra LCD'nin komutu işlemesi için bekleme
 
-GPIOA->MODER |= (GPIO_MODER_MODE1_0 | GPIO_MODER_MODE2_0 | GPIO_MODER_MODE3_0);
-	Bu satır ile PA1, PA2 ve PA3 çıkış (output) olarak ayarlanır.
-
-GPIOB->MODER &= ~(GPIO_MODER_MODE4 | GPIO_MODER_MODE5 | GPIO_MODER_MODE6 | GPIO_MODER_MODE7);
-	LCD’nin veri pinleri olan PB4–PB7 temizlenir.
-
-GPIOB->MODER |= (GPIO_MODER_MODE4_0 | GPIO_MODER_MODE5_0 | GPIO_MODER_MODE6_0 | GPIO_MODER_MODE7_0);
-	PB4–PB7 çıkış moda alınır. Bu pinler LCD’ye veri göndermek için kullanılacak.
-
-GPIOA->ODR &= ~(GPIO_ODR_OD1 | GPIO_ODR_OD3);
-	RS ve E pinleri başta LOW seviyeye çekilir. Böylece LCD yanlış tetiklenmez.
-
-GPIOB->ODR &= ~(GPIO_ODR_OD4 | GPIO_ODR_OD5 | GPIO_ODR_OD6 | GPIO_ODR_OD7);
-	Veri pinleri başlangıçta LOW yapılır.
-
-Özet: Bu fonksiyon, LCD’nin ihtiyaç duyduğu tüm GPIO pinlerini çıkış moduna getirir ve hepsini LOW yaparak temiz bir başlangıç sağlar.
+Profil lcd_timing.h içindeki LCD_TIMING_PROFILE ile derleme anında seçilir (ör. -DLCD_TIMING_PROFILE=1).
+Her iki profil de aynı header'da _Static_assert ile datasheet sınırlarına karşı kontrol edilir; sınırı
+ihlal eden bir değer yazılırsa proje derlenmez.
 
 */
 
 void lcd_send_nibble(uint8_t nibble)
 {
-
-	GPIOA->ODR &= ~GPIO_ODR_OD3; // Enable pinini (PA3) LOW yap
-
-	GPIOB->ODR &= ~(GPIO_ODR_OD4 | GPIO_ODR_OD5 | GPIO_ODR_OD6 | GPIO_ODR_OD7); // Veri pinlerini temizle
-
-	if (nibble & 0x01) GPIOB->ODR |= GPIO_ODR_OD4; // Nibble'ın 0. biti set ise PB4'ü HIGH yap
-	if (nibble & 0x02) GPIOB->ODR |= GPIO_ODR_OD5; // Nibble'ın 1. biti set ise PB5'i HIGH yap
-	if (nibble & 0x04) GPIOB->ODR |= GPIO_ODR_OD6; // Nibble'ın 2. biti set ise PB6'yı HIGH yap
-    if (nibble & 0x08) GPIOB->ODR |= GPIO_ODR_OD7; // Nibble'ın 3. biti set ise PB7'yi HIGH yap
-
-    DWT_Delay_us(100); // Gecikme
-
-    // E pinine darbe gönder (HIGH-LOW)
-    GPIOA->ODR |= GPIO_ODR_OD3;  // E pinini HIGH yap
-    DWT_Delay_us(100);
-    GPIOA->ODR &= ~GPIO_ODR_OD3; // E pinini LOW yap
-    DWT_Delay_us(100); // Gecikme
-
+    lcd_async_wait();                       // Kuyruk gönderiyorsa pinler onundur
+    lcd_transport_reset_nibble(nibble);     // Tek nibble sadece başlatmada gönderilir (RS = 0)
 }
 
 /*
 
-Bu fonksiyonun amacı: LCD’ye 4-bitlik veri (nibble) göndermektir.
+Pinlere dokunan kod artık lcd_transport.c içindedir; bu dosya sadece LCD'nin "ne" gönderdiğini bilir, "nasıl" gittiğini bilmez.
+Taşıma katmanı derleme anında LCD_TRANSPORT ile seçilir (lcd_transport.h):
+	LCD_TRANSPORT_GPIO4   → RS, E, D4-D7: her bayt iki nibble, veri pinleri arama tablosundan tek BSRR yazımı
+	LCD_TRANSPORT_GPIO8   → D0-D3 de bağlı: her bayt tek E darbesi
+	LCD_TRANSPORT_PCF8574 → I2C sırt kartı: lcd_async bir satırlık kuyruğu tek DMA transferiyle yollar
 
-GPIOA->ODR &= ~GPIO_ODR_OD3;
-	Önce Enable (E) pini LOW yapılır. LCD’ye veri yazmadan önce E pininin kapalı olması gerekir.
+lcd_send_nibble() sadece başlatma dizisindeki (0x03, 0x03, 0x03, 0x02) yarım komutlar için kalmıştır.
 
-GPIOB->ODR &= ~(GPIO_ODR_OD4 | GPIO_ODR_OD5 | GPIO_ODR_OD6 | GPIO_ODR_OD7);
-	Veri pinleri sıfırlanır.
+*/
 
-Daha sonra nibble’ın bitleri tek tek kontrol edilir:
+static void lcd_shadow_fill(char c)
+{
+    for (uint8_t r = 0; r < LCD_ROWS; r++)
+        for (uint8_t c2 = 0; c2 < LCD_COLS; c2++)
+            lcd_shadow[r][c2] = c;
+}
 
-	if (nibble & 0x01) GPIOB->ODR |= GPIO_ODR_OD4;
-		Eğer nibble’ın 0. biti (LSB) 1 ise PB4 HIGH yapılır.
+static void lcd_shadow_invalidate(void)
+{
+    lcd_shadow_fill('\0');                 // Çerçevede '\0' yoktur: her hücre farklı görünür, sonraki flush hepsini yazar
+    lcd_addr = LCD_ADDR_UNKNOWN;            // İlk yazımdan önce açık DDRAM adresi gider
+    lcd_glyph_loaded = 0;                   // CGRAM yüklemesi de yarım kalmış olabilir
+}
 
-	if (nibble & 0x02) GPIOB->ODR |= GPIO_ODR_OD5;
-		Eğer nibble’ın 1. biti 1 ise PB5 HIGH yapılır.
+static void lcd_shadow_check(void)
+{
+    uint32_t errors = lcd_transport_errors();
 
-	if (nibble & 0x04) GPIOB->ODR |= GPIO_ODR_OD6;
-		Eğer nibble’ın 2. biti 1 ise PB6 HIGH yapılır.
+    if (errors != lcd_errors_seen) {        // Son flush'tan beri atılan bir parti veya yazım var: panelde ne olduğu bilinmiyor
+        lcd_errors_seen = errors;
+        lcd_shadow_invalidate();
+    }
+}
 
-	if (nibble & 0x08) GPIOB->ODR |= GPIO_ODR_OD7;
-		Eğer nibble’ın 3. biti 1 ise PB7 HIGH yapılır.
+static void lcd_track_command(uint8_t command)
+{
+    if (command & 0x80) {                   // Set DDRAM Address: imleç yeni adrese gider
+        lcd_addr = command & 0x7F;
+    } else if (command == 0x01) {           // Clear Display: DDRAM boşluk olur, adres 0
+        lcd_shadow_fill(' ');
+        lcd_addr = 0x00;
+    } else if ((command & 0xFE) == 0x02) {  // Return Home: adres 0
+        lcd_addr = 0x00;
+    } else if ((command & 0xC0) == 0x40 || (command & 0xF0) == 0x10) {  // CGRAM adresi veya cursor/display shift: DDRAM adresi artık bilinmiyor
+        lcd_addr = LCD_ADDR_UNKNOWN;
+    }
+}
 
-DWT_Delay_us(100);
+static void lcd_track_data(uint8_t data)
+{
+    if (lcd_addr == LCD_ADDR_UNKNOWN) return;
 
-	Veri pinleri ayarlandıktan sonra küçük bir gecikme verilir (LCD bu süre içinde girişleri algılar).
+    if (lcd_addr < LCD_COLS) {                                      // 1. satır: 0x00-0x0F
+        lcd_shadow[0][lcd_addr] = (char)data;
+    } else if (lcd_addr >= 0x40 && lcd_addr < 0x40 + LCD_COLS) {    // 2. satır: 0x40-0x4F
+        lcd_shadow[1][lcd_addr - 0x40] = (char)data;
+    }
 
-Enable darbesi (tetikleme):
-	GPIOA->ODR |= GPIO_ODR_OD3; → E pini HIGH yapılır.
-	DWT_Delay_us(100); → Kısa süre beklenir.
-	GPIOA->ODR &= ~GPIO_ODR_OD3; → E pini tekrar LOW yapılır.
-	Bu işlem LCD’nin gönderilen 4-bit veriyi “okumasını” sağlar.
+    lcd_addr++;                                  // Entry mode 0x06: her yazımda adres bir artar
+    if (lcd_addr == 0x28) lcd_addr = 0x40;       // 2 satırlı modda 1. satır 0x27'de biter, 0x40'tan devam eder
+    else if (lcd_addr == 0x68) lcd_addr = 0x00;  // 2. satırın sonundan başa sarar
+}
 
-Son bir küçük DWT_Delay_us(100); beklenir.
+/*
 
-Özet: lcd_send_nibble fonksiyonu, parametreyle gelen 4 bitlik değeri PB4–PB7 pinlerine yazar ve Enable pinine darbe göndererek LCD’nin bu 4 biti okumasını sağlar.
+lcd_track_command() / lcd_track_data()
+	LCD'ye giden her komut ve karakter burada "taklit" edilir. Böylece panelden geri okuma yapmadan (RW pini GND'de)
+	DDRAM'de ne yazdığını ve imlecin nerede olduğunu biliriz. lcd_flush() bu bilgiyle sadece gerçekten değişen hücreleri gönderir.
+	İmleci bilinmeyen bir yere götüren komutlardan (CGRAM adresi, shift) sonra lcd_addr = LCD_ADDR_UNKNOWN yapılır,
+	bir sonraki flush ilk yazımdan önce mutlaka lcd_set_cursor() çağırır.
+	Takip yazım kuyruğa eklenirken yapılır, panel onayladığında değil. PCF8574'te bir parti NACK, zaman aşımı veya bus
+	hatasıyla atılırsa (lcd_transport_errors() artar) gölge yazılmamış metni "yazıldı" sanır ve fark bu hücreleri bir daha
+	göndermez. Bu yüzden her flush önce hata sayacına bakar (lcd_shadow_check); sayaç değiştiyse bütün gölge '\0' ile
+	geçersiz yapılır, lcd_addr bilinmiyor olur ve CGRAM yeniden yüklenir: panel ilk başarılı flush'ta tamamen yeniden çizilir.
+	Senkron yazımda lcd_transport_write() hatayı doğrudan döndürür, gölge aynı anda geçersiz yapılır.
+	Sayaç kesmede artar, gölgeye sadece ana bağlam dokunur; flush sırasında gelen bir hata bir sonraki flush'ta görülür.
 
 */
 
 void lcd_send_command(uint8_t command)
 {
-    // RS (Register Select) pinini LOW yaparak komut modunu seç
-    // GPIOA->ODR &= ~GPIO_ODR_ODR1; // RS pinini LOW yap
-    GPIOA->BSRR = (1 << (1 + 16)); // GPIOA Pin 1'i LOW yapmak için BSRR kullanmak daha temiz bir yöntemdir.
+    PROF_BEGIN(lcd_send_command);
 
-    lcd_send_nibble(command >> 4);	// Komutun yüksek 4 bitini gönder
+    lcd_async_wait();                   // Kuyruktaki baytlar önce gitmeli: pinler tek sürücü tarafından değiştirilir
 
-    lcd_send_nibble(command & 0x0F);	// Komutun düşük 4 bitini gönder
+    // RS = 0 (komut); taşıma katmanı komut bitene kadar bekler
+    // Clear Display / Return Home 1.52 ms, diğer komutlar 37 µs sürer (lcd_timing.h)
+    uint8_t failed = lcd_transport_write(0, command);
 
-    // Komut sonrası bekleme süresi
-    // Bazı komutlar (Clear Display gibi) daha uzun bekleme gerektirebilir.
-    // Datasheet'e göre 1.52ms (veya daha fazla) bekleme önerilir.
-    // Bu yüzden burada yaklaşık 2ms bekleme ekleyelim.
-    delay_ms(2);
+    lcd_track_command(command);         // Gölge bellek ve imleç takibini komuta göre güncelle
+    if (failed) lcd_shadow_invalidate();    // Komut panele ulaşmadı: gölge ve imleç artık bilinmiyor
+
+    PROF_END(lcd_send_command);
 }
 
 /*
@@ -154,9 +200,8 @@ void lcd_send_command(uint8_t command)
 Bu fonksiyon LCD’ye komut göndermek için kullanılır (örneğin ekran temizleme, imleci kaydırma, mod ayarı).
 
 Açıklamalar:
-	GPIO_ResetBits(GPIOx, RS_PIN) → RS=0 yapılır, yani LCD’ye “bu bir komut” denir.
-	cmd >> 4 → Komutun yüksek 4 bitini çıkarır, LCD’ye gönderir.
-	cmd & 0x0F → Komutun düşük 4 bitini çıkarır, ikinci adımda gönderir.
+	RS=0 yapılır, yani LCD’ye “bu bir komut” denir.
+	4-bit bağlantıda önce komutun yüksek 4 biti, sonra düşük 4 biti gönderilir; 8-bit bağlantıda tek seferde gider.
 	delay_us(40) → LCD komutu işleyene kadar bekleme süresi (her komut en az 37 µs sürer).
 	Özel durum: 0x01 (clear display) veya 0x02 (return home) komutları 1.52 ms sürer, bu durumda daha uzun bekleme yapılır.
 
@@ -164,15 +209,11 @@ Açıklamalar:
 
 void lcd_send_data(uint8_t data)
 {
-    // RS (Register Select) pinini HIGH yaparak veri modunu seç
-    // GPIOA->ODR |= GPIO_ODR_ODR1; // RS pinini HIGH yap
-    GPIOA->BSRR = (1 << 1); // BSRR ile Pin 1'i HIGH yapmak daha temiz bir yöntemdir.
-
-    lcd_send_nibble(data >> 4);	// Verinin yüksek 4 bitini gönder
+    lcd_async_wait();               // Kuyruk boşalmadan pinlere dokunma
+    uint8_t failed = lcd_transport_write(1, data);  // RS = 1 (veri), karakter yazma süresi (37 µs + 4 µs) dahil
 
-    lcd_send_nibble(data & 0x0F);	// Verinin düşük 4 bitini gönder
-
-    DWT_Delay_us(100);
+    lcd_track_data(data);           // Yazılan karakteri gölge belleğe işle, imleci ilerlet
+    if (failed) lcd_shadow_invalidate();
 }
 
 /*
@@ -180,9 +221,8 @@ void lcd_send_data(uint8_t data)
 Bu fonksiyon LCD’ye ekrana yazılacak karakteri göndermek için kullanılır (örneğin 'A' karakterini yazdırmak).
 
 Açıklamalar:
-	GPIO_SetBits(GPIOx, RS_PIN) → RS=1 yapılır, yani LCD’ye “bu bir karakter” denir.
-	data >> 4 → Karakterin ASCII kodunun üst 4 bitini gönder.
-	data & 0x0F → Alt 4 bitini gönder.
+	RS=1 yapılır, yani LCD’ye “bu bir karakter” denir.
+	4-bit bağlantıda karakterin ASCII kodunun önce üst 4 biti, sonra alt 4 biti gönderilir.
 	delay_us(40) → Karakter işleme süresi (37 µs) için bekleme yapılır.
 
 Örnek Çalışma Senaryosu
@@ -199,7 +239,7 @@ Açıklamalar:
 void lcd_init(void)
 {
 
-    lcd_gpio_config(); // GPIO pinlerini yapılandır
+    lcd_transport_init(); // Seçili taşıma katmanının pinlerini / I2C'sini yapılandır
 
     delay_ms(20);	// Güç açılışından sonra stabilizasyon için bekleme
 
@@ -212,15 +252,18 @@ void lcd_init(void)
     lcd_send_command_nibble_only(0x03);	// Üçüncü reset komutu
     DWT_Delay_us(150);
 
+#if LCD_BUS_BITS == 4
     lcd_send_command_nibble_only(0x02); // 4-bit modunu etkinleştir
     DWT_Delay_us(100);
+#endif
 
     // Şimdi normal 8-bit komutlar kullanılabilir
-    lcd_send_command(0x28); // 4-bit arayüz, 2 satır, 5x8 font
+    lcd_send_command(LCD_FUNCTION_SET); // 4-bit (0x28) veya 8-bit (0x38) arayüz, 2 satır, 5x8 font
     lcd_send_command(0x0C); // Display ON, Cursor OFF, Blink OFF
     lcd_send_command(0x06); // Entry Mode: Increment, no shift
-    lcd_send_command(0x01); // Ekranı temizle
-    delay_ms(2);
+    lcd_send_command(0x01); // Ekranı temizle (bekleme lcd_send_command içinde yapılır)
+
+    lcd_glyph_loaded = 0;   // Güç açılışında CGRAM içeriği bilinmez
 }
 
 /*
@@ -238,9 +281,10 @@ Açıklamalar:
 
 	lcd_send_command_nibble_only(0x02)
 	→ LCD’ye "4-bit mod kullanacağım" denir. Artık komut ve veri gönderimi 4-bitlik iki parça halinde yapılacaktır.
+	  8-bit bağlantıda (LCD_TRANSPORT_GPIO8) bu adım atlanır; LCD zaten 8-bit modda kalır.
 
-	lcd_send_command(0x28)
-	→ Function set: 4-bit mod, 2 satır, 5x8 karakter boyutu.
+	lcd_send_command(LCD_FUNCTION_SET)
+	→ Function set: 4-bit (0x28) veya 8-bit (0x38) mod, 2 satır, 5x8 karakter boyutu.
 
 	lcd_send_command(0x0C)
 	→ Display control: ekran açık, imleç kapalı, yanıp sönme kapalı.
@@ -259,10 +303,7 @@ Bu dizilim HD44780 LCD datasheet’inde önerilen initialize sequence’tir.
 // Başlatma sırasında sadece 4 bit gönderilmesi gerektiği için kullanılır.
 void lcd_send_command_nibble_only(uint8_t nibble)
 {
-    // RS pinini LOW yap
-    GPIOA->BSRR = (1 << (1 + 16));
-
-    // Sadece yüksek 4 bit gönder
+    // RS = 0, sadece yüksek 4 bit gönder
     lcd_send_nibble(nibble);
 }
 
@@ -279,17 +320,23 @@ Açıklamalar:
 		3 gönder
 		2 gönder → "artık 4-bit moda geçiyorum"
 
+8-bit bağlantıda aynı fonksiyon 0x30 baytını tek darbede gönderir ve 0x02 adımı atlanır.
+
 Bu adımlar bittiğinde LCD artık 4-bit modda çalışmaya hazır olur. Sonrasında normal lcd_send_command() ve lcd_send_data() kullanılmaya başlanır.
 
 */
 
 void lcd_print_string(const char* str)
 {
+    PROF_BEGIN(lcd_print_string);
+
     // Dizinin sonuna (null karakter) ulaşana kadar döngüyü sürdür
     while (*str) {
         // Her bir karakteri LCD'ye gönder
         lcd_send_data(*str++);
     }
+
+    PROF_END(lcd_print_string);
 }
 
 /*
@@ -335,9 +382,8 @@ Açıklama:
 void lcd_clear(void)
 {
     // Clear Display komutunu gönder
+    // Bu komutun tamamlanması için gereken uzun gecikme (datasheet'e göre > 1.52 ms) lcd_send_command içinde yapılır
     lcd_send_command(0x01);
-    // Bu komutun tamamlanması için uzun bir gecikme gerekir (datasheet'e göre > 1.52 ms)
-    delay_ms(2);
 }
 
 /*
@@ -352,6 +398,257 @@ Açıklama:
 
 */
 
+void lcd_fb_clear(void)
+{
+    for (uint8_t r = 0; r < LCD_ROWS; r++)
+        for (uint8_t c = 0; c < LCD_COLS; c++)
+            lcd_frame[r][c] = ' ';      // Çerçeveyi boşluklarla doldur (panele hiçbir şey gönderilmez)
+}
+
+void lcd_fb_write(uint8_t row, uint8_t col, const char* str)
+{
+    if (row >= LCD_ROWS) return;
+
+    while (*str && col < LCD_COLS) {    // Satır sonunu aşan karakterler kırpılır
+        lcd_frame[row][col++] = *str++;
+    }
+}
+
+char* lcd_fb_region(uint8_t row, uint8_t col, uint8_t width)
+{
+    if (row >= LCD_ROWS || col >= LCD_COLS || width > LCD_COLS - col) return 0;
+
+    return &lcd_frame[row][col];        // Alan satır içinde kalır, fmt_*() en fazla width hücre yazar
+}
+
+static void lcd_glyph_set(uint8_t slot, const uint8_t* rows)
+{
+    for (uint8_t i = 0; i < LCD_GLYPH_ROWS; i++) {
+        lcd_glyph_want[slot][i] = rows[i];
+    }
+}
+
+void lcd_bar_graph(uint8_t row, uint8_t col, uint8_t width, uint16_t value, uint16_t max)
+{
+    char* cells = lcd_fb_region(row, col, width);
+    if (!cells || max == 0) return;
+    if (value > max) value = max;
+
+    uint16_t pixels = ((uint32_t)value * width * 5 + max / 2) / max;   // Toplam dolu piksel sütunu
+
+    for (uint8_t i = 0; i < width; i++) {
+        uint16_t start = i * 5;
+
+        if (pixels >= start + 5) {
+            cells[i] = (char)LCD_BAR_FULL;
+        } else if (pixels <= start) {
+            cells[i] = ' ';
+        } else {
+            uint8_t filled = pixels - start;                            // 1-4 sütun
+            uint8_t rows[LCD_GLYPH_ROWS];
+            for (uint8_t r = 0; r < LCD_GLYPH_ROWS; r++) {
+                rows[r] = (0x1F << (5 - filled)) & 0x1F;
+            }
+            lcd_glyph_set(LCD_BAR_SLOT + filled - 1, rows);
+            cells[i] = LCD_GLYPH_CODE(LCD_BAR_SLOT + filled - 1);
+        }
+    }
+}
+
+void lcd_sparkline_push(uint16_t value, uint16_t max)
+{
+    uint8_t height = 0;
+
+    if (max) {
+        if (value > max) value = max;
+        height = ((uint32_t)value * LCD_GLYPH_ROWS + max / 2) / max;   // 0-8 piksel
+    }
+
+    lcd_spark[lcd_spark_head] = height;                                 // En eskinin yerine yaz
+    lcd_spark_head = (lcd_spark_head + 1) % LCD_SPARK_SAMPLES;
+}
+
+void lcd_sparkline_draw(uint8_t row, uint8_t col)
+{
+    char* cells = lcd_fb_region(row, col, LCD_SPARK_CELLS);
+    if (!cells) return;
+
+    for (uint8_t cell = 0; cell < LCD_SPARK_CELLS; cell++) {
+        uint8_t rows[LCD_GLYPH_ROWS] = { 0 };
+
+        for (uint8_t x = 0; x < 5; x++) {
+            uint8_t height = lcd_spark[(lcd_spark_head + cell * 5 + x) % LCD_SPARK_SAMPLES];
+            for (uint8_t r = LCD_GLYPH_ROWS - height; r < LCD_GLYPH_ROWS; r++) {
+                rows[r] |= 0x10 >> x;                                   // Alttan yukarı dolu sütun
+            }
+        }
+
+        lcd_glyph_set(LCD_SPARK_SLOT + cell, rows);
+        cells[cell] = LCD_GLYPH_CODE(LCD_SPARK_SLOT + cell);
+    }
+}
+
+const uint8_t* lcd_glyph_bitmap(uint8_t slot)
+{
+    return (slot < LCD_CGRAM_SLOTS) ? lcd_glyph_want[slot] : 0;
+}
+
+uint32_t lcd_cgram_uploads(void)
+{
+    return lcd_glyph_uploads;
+}
+
+static uint8_t lcd_glyph_used(void)
+{
+    uint8_t used = 0;
+
+    for (uint8_t r = 0; r < LCD_ROWS; r++) {
+        for (uint8_t c = 0; c < LCD_COLS; c++) {
+            uint8_t code = (uint8_t)lcd_frame[r][c];
+            if (code >= LCD_GLYPH_CODE(0) && code < LCD_GLYPH_CODE(LCD_CGRAM_SLOTS)) {
+                used |= 1 << (code - LCD_GLYPH_CODE(0));
+            }
+        }
+    }
+    return used;
+}
+
+static uint8_t lcd_glyph_sync(void (*send_command)(uint8_t), void (*send_data)(uint8_t))
+{
+    uint8_t sent = 0;
+    uint8_t used = lcd_glyph_used();    // Sadece bu çerçevede görünen slotlar yüklenir
+    uint8_t next = LCD_CGRAM_SLOTS;     // CGRAM adres sayacının bulunduğu slot (ardışık slotlarda adres komutu tekrar gönderilmez)
+
+    for (uint8_t slot = 0; slot < LCD_CGRAM_SLOTS; slot++) {
+        uint8_t bit = 1 << slot;
+        if (!(used & bit)) continue;
+
+        uint8_t same = (lcd_glyph_loaded & bit) != 0;
+        for (uint8_t r = 0; same && r < LCD_GLYPH_ROWS; r++) {
+            same = lcd_glyph_have[slot][r] == lcd_glyph_want[slot][r];
+        }
+        if (same) continue;             // Desen değişmediyse 8 baytlık yüklemeyi atla
+
+        if (slot != next) {
+            send_command(0x40 | (slot << 3));   // CGRAM adresi; takip bunu görünce lcd_addr'ı bilinmiyor yapar
+            sent++;
+        }
+        for (uint8_t r = 0; r < LCD_GLYPH_ROWS; r++) {
+            send_data(lcd_glyph_want[slot][r]);
+            lcd_glyph_have[slot][r] = lcd_glyph_want[slot][r];
+            sent++;
+        }
+        lcd_glyph_loaded |= bit;
+        lcd_glyph_uploads++;
+        next = slot + 1;
+    }
+
+    return sent;
+}
+
+static uint8_t lcd_flush_with(void (*send_command)(uint8_t), void (*send_data)(uint8_t))
+{
+    lcd_shadow_check();                                         // Atılan I2C partileri: gölge panele güvenilmez
+    uint8_t sent = lcd_glyph_sync(send_command, send_data);    // Önce değişen glyph'ler, sonra DDRAM farkı
+
+    for (uint8_t r = 0; r < LCD_ROWS; r++) {
+        uint8_t c = 0;
+
+        while (c < LCD_COLS) {
+            if (lcd_frame[r][c] == lcd_shadow[r][c]) {  // Değişmeyen hücreyi atla
+                c++;
+                continue;
+            }
+
+            // Değişen bölgenin sonunu bul; arada LCD_FLUSH_MERGE_GAP kadar aynı hücre varsa bölgeleri birleştir
+            uint8_t end = c;
+            uint8_t gap = 0;
+            for (uint8_t k = c + 1; k < LCD_COLS; k++) {
+                if (lcd_frame[r][k] != lcd_shadow[r][k]) {
+                    end = k;
+                    gap = 0;
+                } else if (++gap > LCD_FLUSH_MERGE_GAP) {
+                    break;
+                }
+            }
+
+            uint8_t address = (r == 0 ? 0x00 : 0x40) + c;
+            if (lcd_addr != address) {          // İmleç zaten doğru yerdeyse komut gönderme
+                send_command(0x80 | address);   // lcd_set_cursor(r, c) ile aynı komut
+                sent++;
+            }
+
+            for (; c <= end; c++) {
+                send_data((uint8_t)lcd_frame[r][c]);
+                sent++;
+            }
+        }
+    }
+
+    return sent;
+}
+
+uint8_t lcd_flush(void)
+{
+    return lcd_flush_with(lcd_send_command, lcd_send_data);     // Bloklayan gönderim
+}
+
+static void lcd_async_command_tracked(uint8_t command)
+{
+    lcd_async_command(command);     // Kuyruğa ekle, ISR gönderecek
+    lcd_track_command(command);     // Panel bu komutu kuyruk boşalınca işlemiş olacak
+}
+
+static void lcd_async_data_tracked(uint8_t data)
+{
+    lcd_async_data(data);
+    lcd_track_data(data);
+}
+
+uint8_t lcd_flush_async(void)
+{
+    if (lcd_async_free() < LCD_FLUSH_MAX_BYTES) {   // En kötü durum sığmıyorsa bu kareyi atla, gölge bozulmasın
+        return 0;
+    }
+
+    return lcd_flush_with(lcd_async_command_tracked, lcd_async_data_tracked);
+}
+
+/*
+
+Bu üç fonksiyon LCD için bir "gölge çerçeve" (shadow framebuffer) oluşturur.
+
+Neden gerekli:
+	Eski döngüde her turda lcd_clear() (0x01 + ~4 ms bekleme) çağrılıyor, ardından bütün alanlar tekrar yazılıyordu.
+	Bu hem ekranın titremesine hem de her turda onlarca ms kaybedilmesine sebep oluyordu.
+
+Nasıl çalışır:
+	lcd_frame  → uygulamanın o an görmek istediği ekran. lcd_fb_clear() ve lcd_fb_write() sadece bu diziyi değiştirir.
+	lcd_shadow → panelde gerçekten yazan karakterler. lcd_send_data() her karakterde bu diziyi günceller.
+	lcd_flush() iki diziyi karşılaştırır, farklı hücreleri bölgeler halinde gönderir:
+		- İmleç zaten bölgenin başındaysa (önceki yazımın devamıysa) lcd_set_cursor() çağrılmaz.
+		- İki bölge arasında tek bir aynı hücre varsa o hücre de yeniden yazılır; bir imleç komutu ile bir veri
+		  baytı aynı bus maliyetindedir ama komut bekleme süresi daha uzundur.
+	Dönüş değeri gönderilen toplam bayt sayısıdır; hiçbir şey değişmediyse 0 döner ve LCD'ye hiç dokunulmaz.
+	lcd_flush_async() aynı farkı lcd_async kuyruğuna yazar ve hemen döner. Kuyrukta en kötü durum için
+	(LCD_FLUSH_MAX_BYTES) yer yoksa hiçbir şey eklemez ve 0 döner; çerçeve bir sonraki çağrıda tekrar denenir.
+
+Örnek: Sadece sensör değerinin son iki hanesi değiştiyse flush 1 imleç komutu + 2 karakter gönderir.
+
+Özel karakterler (CGRAM):
+	HD44780'de 8 adet 5x8 kullanıcı karakteri vardır. Komut 0x40 | (slot << 3) CGRAM adresini seçer, ardından gelen
+	8 veri baytı karakterin satırlarıdır (bit 4 en soldaki piksel). Çerçevede bu karakterler 0x08-0x0F kodlarıyla yazılır.
+	lcd_bar_graph() → tam hücreler ROM'daki 0xFF bloğu, son kısmi hücre 1-4 sütunluk slot 0-3 ile çizilir; 16 hücrede 80 adım çözünürlük.
+	lcd_sparkline_draw() → son 20 örnek slot 4-7'de piksel sütunları olarak çizilir; her yeni örnekte desenler değişir,
+	DDRAM'deki kodlar aynı kaldığı için sadece glyph'ler yüklenir.
+	Bir glyph yüklemesi 8 veri + (gerekirse) 1 adres komutu demektir. lcd_glyph_sync() CGRAM'de olanı (have) istenenle (want)
+	karşılaştırır ve sadece değişen slotları gönderir; ardışık slotlar tek adres komutuyla yazılır. Hangi slotların gerektiği her
+	flush'ta çerçevedeki 0x08-0x0F kodlarından bulunur: çubuk kısaldığında veya widget kaldırıldığında artık görünmeyen slot
+	yüklenmez, lcd_init() sonrasında da sadece ekrandaki glyph'ler yeniden gönderilir. CGRAM'e yazdıktan sonra
+	adres sayacı CGRAM'de kalır, bu yüzden takip lcd_addr'ı bilinmiyor yapar ve ilk DDRAM yazımından önce imleç komutu gider.
+
+*/
+
 //------------------------------------------------------------------------------------------------------------------------------
 
 /*
@@ -389,13 +686,13 @@ LCD 16x2’nin Çalışma Mantığı
 
 Fonksiyonlarla Bağlantısı
 
-	lcd_gpio_config()
+	lcd_transport_init() (lcd_transport.c)
 		LCD’nin RS, E ve D4–D7 pinlerini çıkış yapar. Çünkü mikrodenetleyici sürekli LCD’ye yazacak.
 
-	lcd_send_nibble()
-		Verilen 4-bit değeri D4–D7 pinlerine koyar.
+	lcd_transport_write() (lcd_transport.c)
+		4-bit değeri D4–D7 pinlerine koyar.
 		Sonra E pinine darbe göndererek LCD’ye “oku artık” der.
-		Bu işlem bir komutun veya bir karakterin yarısıdır (çünkü 4 bit gönderildi).
+		Bu işlem bir komutun veya bir karakterin yarısıdır (çünkü 4 bit gönderildi); aynısı ikinci nibble için tekrarlanır.
 
 	lcd_send_command() (ileride göreceğiz)
 		RS = 0 yapılır → LCD’ye bu bir komut denir.
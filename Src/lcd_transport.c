@@ -0,0 +1,426 @@
+#include <stdint.h>
+#include "stm32f4xx.h"
+#include "lcd_transport.h"
+#include "lcd_timing.h"
+#include "clock_config.h"
+#include "delay.h"
+#include "prof.h"
+
+static volatile uint32_t lcd_transport_error_count;
+
+uint32_t lcd_transport_errors(void)
+{
+    return lcd_transport_error_count;
+}
+
+#if LCD_TRANSPORT != LCD_TRANSPORT_PCF8574
+
+#define LCD_CTRL_PORT   GPIOA           // RS, E
+#define LCD_DATA_PORT   GPIOB           // D0-D7
+
+// Bir nibble'ın 4 bitini 4 pine dağıtan BSRR değeri: 1 olan bitin pini set (alt 16 bit), 0 olanınki reset (üst 16 bit)
+#define LCD_BSRR_BIT(n, bit, pin)   (((n) >> (bit) & 1) ? (1UL << (pin)) : (1UL << ((pin) + 16)))
+#define LCD_BSRR(n, p0, p1, p2, p3) (LCD_BSRR_BIT(n, 0, p0) | LCD_BSRR_BIT(n, 1, p1) | LCD_BSRR_BIT(n, 2, p2) | LCD_BSRR_BIT(n, 3, p3))
+#define LCD_BSRR_TABLE(p0, p1, p2, p3) { \
+    LCD_BSRR(0,  p0, p1, p2, p3), LCD_BSRR(1,  p0, p1, p2, p3), LCD_BSRR(2,  p0, p1, p2, p3), LCD_BSRR(3,  p0, p1, p2, p3), \
+    LCD_BSRR(4,  p0, p1, p2, p3), LCD_BSRR(5,  p0, p1, p2, p3), LCD_BSRR(6,  p0, p1, p2, p3), LCD_BSRR(7,  p0, p1, p2, p3), \
+    LCD_BSRR(8,  p0, p1, p2, p3), LCD_BSRR(9,  p0, p1, p2, p3), LCD_BSRR(10, p0, p1, p2, p3), LCD_BSRR(11, p0, p1, p2, p3), \
+    LCD_BSRR(12, p0, p1, p2, p3), LCD_BSRR(13, p0, p1, p2, p3), LCD_BSRR(14, p0, p1, p2, p3), LCD_BSRR(15, p0, p1, p2, p3) }
+
+static const uint32_t lcd_bsrr_hi[16] = LCD_BSRR_TABLE(LCD_D4_PIN, LCD_D5_PIN, LCD_D6_PIN, LCD_D7_PIN);    // D4-D7
+#if LCD_BUS_BITS == 8
+static const uint32_t lcd_bsrr_lo[16] = LCD_BSRR_TABLE(LCD_D0_PIN, LCD_D1_PIN, LCD_D2_PIN, LCD_D3_PIN);    // D0-D3
+#endif
+
+static void lcd_pin_output(GPIO_TypeDef* port, uint8_t pin)
+{
+    port->MODER = (port->MODER & ~(3UL << (pin * 2))) | (1UL << (pin * 2));    // Genel amaçlı çıkış
+    port->BSRR = 1UL << (pin + 16);                                              // LOW ile başla
+}
+
+void lcd_transport_init(void)
+{
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN | RCC_AHB1ENR_GPIOBEN;     // GPIOA ve GPIOB'nin clock'larını etkinleştir
+
+    lcd_pin_output(LCD_CTRL_PORT, LCD_RS_PIN);
+    lcd_pin_output(LCD_CTRL_PORT, LCD_E_PIN);
+    lcd_pin_output(LCD_DATA_PORT, LCD_D4_PIN);
+    lcd_pin_output(LCD_DATA_PORT, LCD_D5_PIN);
+    lcd_pin_output(LCD_DATA_PORT, LCD_D6_PIN);
+    lcd_pin_output(LCD_DATA_PORT, LCD_D7_PIN);
+#if LCD_BUS_BITS == 8
+    lcd_pin_output(LCD_DATA_PORT, LCD_D0_PIN);
+    lcd_pin_output(LCD_DATA_PORT, LCD_D1_PIN);
+    lcd_pin_output(LCD_DATA_PORT, LCD_D2_PIN);
+    lcd_pin_output(LCD_DATA_PORT, LCD_D3_PIN);
+#endif
+}
+
+void lcd_bus_set(uint8_t rs, uint8_t value)
+{
+    LCD_CTRL_PORT->BSRR = rs ? (1UL << LCD_RS_PIN) : (1UL << (LCD_RS_PIN + 16));    // RS pinini ayarla (E'ye dokunma)
+#if LCD_BUS_BITS == 8
+    LCD_DATA_PORT->BSRR = lcd_bsrr_lo[value & 0x0F] | lcd_bsrr_hi[value >> 4];       // D0-D7 tek yazımda
+#else
+    LCD_DATA_PORT->BSRR = lcd_bsrr_hi[value & 0x0F];                                 // D4-D7 tek yazımda
+#endif
+}
+
+void lcd_bus_enable(uint8_t level)
+{
+    LCD_CTRL_PORT->BSRR = level ? (1UL << LCD_E_PIN) : (1UL << (LCD_E_PIN + 16));   // E pinini HIGH veya LOW yap
+}
+
+static void lcd_strobe(uint8_t rs, uint8_t value, const lcd_timing_t* t)
+{
+    PROF_BEGIN(lcd_send_nibble);
+
+    lcd_bus_set(rs, value);
+    DWT_Delay_ns(t->setup_ns);      // Setup süresi
+
+    lcd_bus_enable(1);              // E darbesi: LCD veriyi düşen kenarda okur
+    DWT_Delay_ns(t->e_pulse_ns);
+    lcd_bus_enable(0);
+    DWT_Delay_ns(t->e_low_ns);      // Bir sonraki darbeye kadar bekleme
+
+    PROF_END(lcd_send_nibble);
+}
+
+uint8_t lcd_transport_write(uint8_t rs, uint8_t byte)
+{
+    const lcd_timing_t* t = lcd_timing_for(rs, byte);      // Baytın sınıfına göre süreler
+
+#if LCD_BUS_BITS == 8
+    lcd_strobe(rs, byte, t);                    // Bütün bayt tek darbede
+#else
+    lcd_strobe(rs, byte >> 4, t);               // Yüksek nibble
+    lcd_strobe(rs, byte & 0x0F, t);             // Düşük nibble
+#endif
+
+    DWT_Delay_us(t->exec_us);                   // Clear/Home 1.52 ms, diğerleri 37-41 µs (lcd_timing.h)
+    return 0;                                   // Paralel yolda onay yok: yazım hep gitmiş sayılır
+}
+
+void lcd_transport_reset_nibble(uint8_t nibble)
+{
+#if LCD_BUS_BITS == 8
+    lcd_strobe(0, nibble << 4, lcd_timing_for(0, 0x20));   // 8-bit arayüzde 0x30 = "8-bit mod" komutunun tamamı
+#else
+    lcd_strobe(0, nibble, lcd_timing_for(0, 0x20));        // Function set sınıfının süreleri
+#endif
+}
+
+/*
+
+Paralel taşıma katmanı (LCD_TRANSPORT_GPIO4 / LCD_TRANSPORT_GPIO8)
+
+Eski lcd_send_nibble():
+	Veri pinlerini ODR üzerinden önce temizliyor, sonra her biti ayrı bir if + read-modify-write ile kuruyordu.
+	Bir nibble 5 ODR okuma-yazma çifti, E darbesi için 2 tane daha demekti; kesme araya girerse aynı porttaki
+	başka bir pinin değişikliği de ezilebilirdi.
+
+Arama tablosu:
+	lcd_bsrr_hi[n] derleme anında hesaplanmış BSRR değeridir: nibble'da 1 olan bitlerin pinleri alt 16 bitte (set),
+	0 olanlarınki üst 16 bitte (reset). Tek bir store ile 4 pin aynı anda ve atomik olarak kurulur, okuma yapılmaz.
+	Pinler port içinde ardışık olmak zorunda değildir; LCD_D4_PIN..LCD_D7_PIN değiştirilince tablo kendiliğinden değişir.
+	8-bit modda ikinci tablo (D0-D3) ile OR'lanır: bütün bayt yine tek store.
+
+8-bit mod:
+	D0-D3 de bağlanınca (PB12-PB15) her bayt tek E darbesiyle gider, nibble ikiye bölünmez. Başlatmada 0x02
+	(4-bit'e geç) gönderilmez, function set 0x38 olur. LCD'nin komutu işleme süresi (37-41 µs) değişmediği için
+	senkron yazımda kazanç bayt başına bir E periyodudur (~1.2 µs); asıl kazanç lcd_async tarafında,
+	bayt başına kesme sayısının 6'dan 3'e inmesidir.
+
+*/
+
+#else   // LCD_TRANSPORT_PCF8574
+
+#define LCD_PCF_SCL_PIN     6           // PB6, AF4 = I2C1_SCL
+#define LCD_PCF_SDA_PIN     9           // PB9, AF4 = I2C1_SDA
+
+_Static_assert(CLOCK_PCLK1_HZ % 1000000 == 0 && CLOCK_PCLK1_HZ >= 2000000, "I2C FREQ alanı tam MHz ve en az 2 MHz ister");
+
+static uint8_t lcd_pcf_dma_buf[LCD_PCF_BATCH_SIZE];    // DMA buradan okur (CCM'de olmamalı)
+static uint16_t lcd_pcf_batch_len;
+static volatile uint8_t lcd_pcf_batch_active;          // Parti gönderiliyor: done() henüz çağrılmadı
+static void (*lcd_pcf_done)(void);
+
+static void lcd_pcf_pin_af(uint8_t pin)
+{
+    GPIOB->MODER = (GPIOB->MODER & ~(3UL << (pin * 2))) | (2UL << (pin * 2));         // Alternatif fonksiyon
+    GPIOB->OTYPER |= 1UL << pin;                                                        // Açık akaç (I2C)
+    GPIOB->AFR[pin >> 3] = (GPIOB->AFR[pin >> 3] & ~(0xFUL << ((pin & 7) * 4))) | (4UL << ((pin & 7) * 4));   // AF4 = I2C1
+}
+
+static void lcd_pcf_pin_gpio(uint8_t pin)
+{
+    GPIOB->BSRR = 1UL << pin;                                                           // Açık akaç HIGH: hat serbest
+    GPIOB->MODER = (GPIOB->MODER & ~(3UL << (pin * 2))) | (1UL << (pin * 2));         // Genel amaçlı çıkış
+}
+
+static void lcd_pcf_i2c_setup(void)
+{
+    I2C1->CR1 = I2C_CR1_SWRST;                  // Yarım kalmış bir transferden kalan BUSY durumunu temizle
+    I2C1->CR1 = 0;
+    I2C1->CR2 = CLOCK_PCLK1_HZ / 1000000;       // FREQ: APB1 saati (MHz)
+    I2C1->CCR = CLOCK_PCLK1_HZ / (2 * LCD_PCF_I2C_HZ);     // Standard mode: SCL HIGH = LOW = CCR × TPCLK1
+    I2C1->TRISE = CLOCK_PCLK1_HZ / 1000000 + 1;           // 1000 ns en uzun yükselme süresi
+    I2C1->CR1 = I2C_CR1_PE;
+}
+
+static void lcd_pcf_recover(void)
+{
+    const uint32_t half = 500000 / LCD_PCF_I2C_HZ;         // Yarım SCL periyodu (µs)
+
+    I2C1->CR1 = 0;                              // Pinleri çevre biriminden al
+    lcd_pcf_pin_gpio(LCD_PCF_SDA_PIN);
+    lcd_pcf_pin_gpio(LCD_PCF_SCL_PIN);
+
+    for (uint8_t i = 0; i < 9 && !(GPIOB->IDR & (1UL << LCD_PCF_SDA_PIN)); i++) {
+        GPIOB->BSRR = 1UL << (LCD_PCF_SCL_PIN + 16);      // Yarım kalan baytı bitirmesi için köle SDA'yı bırakana kadar saat
+        DWT_Delay_us(half);
+        GPIOB->BSRR = 1UL << LCD_PCF_SCL_PIN;
+        DWT_Delay_us(half);
+    }
+    GPIOB->BSRR = 1UL << (LCD_PCF_SDA_PIN + 16);          // STOP: SCL HIGH iken SDA yükselir
+    DWT_Delay_us(half);
+    GPIOB->BSRR = 1UL << LCD_PCF_SDA_PIN;
+    DWT_Delay_us(half);
+
+    lcd_pcf_pin_af(LCD_PCF_SCL_PIN);
+    lcd_pcf_pin_af(LCD_PCF_SDA_PIN);
+    lcd_pcf_i2c_setup();
+    lcd_transport_error_count++;
+}
+
+static uint8_t lcd_pcf_expired(uint32_t start)
+{
+    if (DWT->CYCCNT - start < LCD_PCF_TIMEOUT_US * CLOCK_CYCLES_PER_US) return 0;
+
+    lcd_pcf_recover();                          // Hat takıldı veya köle cevap vermiyor
+    return 1;
+}
+
+static uint8_t lcd_pcf_wait(uint32_t flag)
+{
+    uint32_t start = DWT->CYCCNT;
+    uint32_t sr1;
+
+    while (!((sr1 = I2C1->SR1) & (flag | I2C_SR1_AF))) {
+        if (lcd_pcf_expired(start)) return 1;
+    }
+    if (sr1 & I2C_SR1_AF) {                     // Cevap yok (NACK): kart takılı değil veya adres yanlış
+        I2C1->SR1 = ~I2C_SR1_AF;
+        I2C1->CR1 |= I2C_CR1_STOP;
+        lcd_transport_error_count++;
+        return 1;
+    }
+    return 0;
+}
+
+static uint8_t lcd_pcf_write(const uint8_t* buf, uint16_t len)
+{
+    uint32_t start = DWT->CYCCNT;
+
+    while (I2C1->CR1 & I2C_CR1_STOP) {          // Önceki STOP bitmeden yeni START verme
+        if (lcd_pcf_expired(start)) return 1;
+    }
+
+    I2C1->CR1 |= I2C_CR1_START;
+    if (lcd_pcf_wait(I2C_SR1_SB)) return 1;     // SDA LOW'da kalmışsa START hiç oluşmaz
+    I2C1->DR = LCD_PCF_ADDR << 1;               // Yazma
+    if (lcd_pcf_wait(I2C_SR1_ADDR)) return 1;
+    (void)I2C1->SR2;                            // SR1 + SR2 okuması ADDR'yi temizler
+
+    for (uint16_t i = 0; i < len; i++) {
+        if (lcd_pcf_wait(I2C_SR1_TXE)) return 1;
+        I2C1->DR = buf[i];
+    }
+    if (lcd_pcf_wait(I2C_SR1_BTF)) return 1;    // Son bayt da hatta çıktı
+    I2C1->CR1 |= I2C_CR1_STOP;
+    return 0;
+}
+
+void lcd_transport_init(void)
+{
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPIOBEN | RCC_AHB1ENR_DMA1EN;
+    RCC->APB1ENR |= RCC_APB1ENR_I2C1EN;
+
+    lcd_pcf_pin_af(LCD_PCF_SCL_PIN);
+    lcd_pcf_pin_af(LCD_PCF_SDA_PIN);
+
+    lcd_pcf_i2c_setup();
+
+    DMA1_Stream6->CR = 0;
+    while (DMA1_Stream6->CR & DMA_SxCR_EN);
+    DMA1_Stream6->PAR = (uint32_t)&I2C1->DR;
+    DMA1_Stream6->CR = (1UL << DMA_SxCR_CHSEL_Pos) |   // Kanal 1 = I2C1_TX
+                       DMA_SxCR_DIR_0 |                 // Bellekten çevre birimine
+                       DMA_SxCR_MINC;                   // Bitiş I2C BTF kesmesinden anlaşılır, DMA kesmesi gerekmez
+
+    NVIC_SetPriority(I2C1_EV_IRQn, LCD_PCF_IRQ_PRIO);
+    NVIC_SetPriority(I2C1_ER_IRQn, LCD_PCF_IRQ_PRIO);
+    NVIC_EnableIRQ(I2C1_EV_IRQn);
+    NVIC_EnableIRQ(I2C1_ER_IRQn);
+
+    uint8_t idle = LCD_PCF_BL;                  // PCF8574 açılışta bütün çıkışları HIGH verir (E = 1): önce E'yi düşür
+    lcd_pcf_write(&idle, 1);
+}
+
+uint16_t lcd_pcf_encode(uint8_t rs, uint8_t byte, uint8_t* out)
+{
+    const lcd_timing_t* t = lcd_timing_for(rs, byte);
+    uint8_t ctrl = LCD_PCF_BL | (rs ? LCD_PCF_RS : 0);
+    uint8_t hi = (byte & 0xF0) | ctrl;
+    uint8_t lo = (uint8_t)(byte << 4) | ctrl;
+    uint16_t n = 0;
+
+    out[n++] = hi;                  // Veri + RS, E = 0 (setup)
+    out[n++] = hi | LCD_PCF_E;      // E yükselir
+    out[n++] = hi;                  // E düşer: yüksek nibble okunur, veri bir yazım daha sabit kalır (hold)
+    out[n++] = lo;
+    out[n++] = lo | LCD_PCF_E;
+    out[n++] = lo;                  // Düşük nibble okunur, komut çalışmaya başlar
+
+    for (uint16_t pad = LCD_PCF_PAD(t->exec_us); pad; pad--) {
+        out[n++] = lo;              // Çıkışı değiştirmeyen yazımlar: komut bitene kadar hattı meşgul eder
+    }
+    return n;
+}
+
+uint8_t lcd_transport_write(uint8_t rs, uint8_t byte)
+{
+    uint8_t buf[LCD_PCF_BYTE_MAX];
+
+    return lcd_pcf_write(buf, lcd_pcf_encode(rs, byte, buf));  // Bekleme süresi doldurma yazımlarının içinde; 1: NACK / zaman aşımı
+}
+
+void lcd_transport_reset_nibble(uint8_t nibble)
+{
+    uint8_t v = (uint8_t)(nibble << 4) | LCD_PCF_BL;      // RS = 0
+    uint8_t buf[3] = { v, v | LCD_PCF_E, v };
+
+    lcd_pcf_write(buf, 3);
+}
+
+void lcd_pcf_batch_begin(void)
+{
+    lcd_pcf_batch_len = 0;
+}
+
+uint8_t lcd_pcf_batch_add(uint8_t rs, uint8_t byte)
+{
+    if (LCD_PCF_BATCH_SIZE - lcd_pcf_batch_len < LCD_PCF_BYTE_MAX) {   // En uzun bayt sığmıyorsa dolu say
+        return 1;
+    }
+
+    lcd_pcf_batch_len += lcd_pcf_encode(rs, byte, &lcd_pcf_dma_buf[lcd_pcf_batch_len]);
+    return 0;
+}
+
+uint32_t lcd_pcf_batch_send(void (*done)(void))
+{
+    lcd_pcf_done = done;
+
+    if (lcd_pcf_batch_len == 0) {
+        if (done) done();
+        return 0;
+    }
+
+    DMA1->HIFCR = DMA_HIFCR_CTCIF6 | DMA_HIFCR_CHTIF6 | DMA_HIFCR_CTEIF6 | DMA_HIFCR_CDMEIF6 | DMA_HIFCR_CFEIF6;
+    DMA1_Stream6->M0AR = (uint32_t)lcd_pcf_dma_buf;
+    DMA1_Stream6->NDTR = lcd_pcf_batch_len;
+    DMA1_Stream6->CR |= DMA_SxCR_EN;
+
+    lcd_pcf_batch_active = 1;
+    I2C1->CR2 |= I2C_CR2_DMAEN | I2C_CR2_ITEVTEN | I2C_CR2_ITERREN;
+    I2C1->CR1 |= I2C_CR1_START;                 // Gerisi I2C1_EV_IRQHandler'da
+    return 2 * (lcd_pcf_batch_len + 2) * (uint32_t)(LCD_PCF_BYTE_NS / 1000) + LCD_PCF_TIMEOUT_US;   // Adres + STOP dahil, iki kat pay
+}
+
+static void lcd_pcf_finish(void)
+{
+    lcd_pcf_batch_active = 0;
+    I2C1->CR1 |= I2C_CR1_STOP;
+    I2C1->CR2 &= ~(I2C_CR2_DMAEN | I2C_CR2_ITEVTEN | I2C_CR2_ITERREN);
+    DMA1_Stream6->CR &= ~DMA_SxCR_EN;
+
+    if (lcd_pcf_done) lcd_pcf_done();
+}
+
+uint8_t lcd_pcf_batch_abort(void)
+{
+    if (!lcd_pcf_batch_active) return 0;
+
+    I2C1->CR2 &= ~(I2C_CR2_DMAEN | I2C_CR2_ITEVTEN | I2C_CR2_ITERREN);
+    DMA1_Stream6->CR &= ~DMA_SxCR_EN;
+    lcd_pcf_recover();                          // START oluşmadı veya BTF gelmedi: kesme de gelmeyecek
+    lcd_pcf_finish();
+    return 1;
+}
+
+void I2C1_EV_IRQHandler(void)
+{
+    uint32_t sr1 = I2C1->SR1;
+
+    if (sr1 & I2C_SR1_SB) {
+        I2C1->DR = LCD_PCF_ADDR << 1;           // START gitti: adres + yazma
+    } else if (sr1 & I2C_SR1_ADDR) {
+        (void)I2C1->SR2;                        // ADDR temizlenir, TXE istekleri artık DMA'ya gider
+    } else if ((sr1 & I2C_SR1_BTF) && DMA1_Stream6->NDTR == 0) {
+        lcd_pcf_finish();                       // Son bayt hatta çıktı
+    }
+}
+
+void I2C1_ER_IRQHandler(void)
+{
+    I2C1->SR1 = ~(I2C_SR1_AF | I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_OVR);    // rc_w0: hata bayraklarını temizle
+    lcd_transport_error_count++;
+    lcd_pcf_finish();                           // Parti atılır; lcd_async kuyruğu bir sonrakiyle devam eder
+}
+
+/*
+
+PCF8574 taşıma katmanı (LCD_TRANSPORT_PCF8574)
+
+PCF8574, I2C'den yazılan baytı 8 çıkış pinine aynen koyan bir port genişleticidir. Yaygın LCD sırt kartlarında
+P0 = RS, P1 = RW, P2 = E, P3 = arka ışık, P4-P7 = D4-D7 bağlıdır; yani LCD her zaman 4-bit modda sürülür.
+
+Bir LCD baytı = 6 I2C yazımı:
+	[hi] [hi|E] [hi] [lo] [lo|E] [lo]
+	E darbesi ayrı bir yazımdır. Veri ile E aynı yazımda değişirse setup / hold süreleri sağlanmaz, bu yüzden
+	her nibble "veri, veri|E, veri" olarak gider. 100 kHz'de bir yazım 90 µs olduğu için E darbesi ve setup
+	süresi datasheet sınırlarının çok üstündedir.
+
+Komut süreleri (exec_us) gecikme ile değil, yazımla doldurulur:
+	Son yazımdan sonra, bir sonraki baytın E'si yükselene kadar en az exec_us geçmelidir. LCD_PCF_PAD(exec_us)
+	kadar aynı değer tekrar yazılır (çıkış değişmez, sadece hat meşgul kalır). 100 kHz'de 37-41 µs'lik komutlar
+	ek yazım gerektirmez; clear / home (1.52 ms) 16 ek yazım ister. Böylece bir satırlık kuyruk, arada hiçbir
+	zamanlayıcı beklemesi olmadan tek DMA transferine sığar.
+
+Satır toplama (lcd_async):
+	lcd_pcf_batch_add() kuyruktaki baytları sırayla DMA tamponuna kodlar; tampon bir satırı (imleç + 16 karakter)
+	her zaman alır. lcd_pcf_batch_send() START'ı verir ve döner:
+		SB   → adres yazılır
+		ADDR → temizlenir, DR'ye yazımı artık DMA1 Stream6 (Kanal 1 = I2C1_TX) yapar
+		BTF  → DMA bitmiş ve son bayt da hattan çıkmışsa STOP, ardından done()
+	Parti başına 2-3 kesme vardır; GPIO katmanında aynı satır yaklaşık 100 kesme demektir.
+	Hata (NACK, bus hatası) olursa parti atılır, hata sayacı artar ve kuyruk devam eder.
+	lcd_pcf_batch_send() partinin en geç bitmesi gereken süreyi döndürür; lcd_async zamanlayıcısı bu sürede dolarsa
+	(SDA LOW'da kalmış, START hiç oluşmadı; kesme de gelmeyecek) lcd_pcf_batch_abort() hattı kurtarıp partiyi atar.
+	I2C1 kesmeleri LCD_PCF_IRQ_PRIO (2) önceliğindedir: ADC watchdog (0), DMA ve TIM2 (1) her zaman önce gelir.
+
+Senkron yazım (lcd_transport_write) aynı kodlamayı kesmesiz, durum bayraklarını yoklayarak gönderir; başlatma ve
+lcd_async devreye girmeden önceki yazımlar içindir. Her bekleme DWT->CYCCNT ile LCD_PCF_TIMEOUT_US'de sınırlıdır;
+süre dolarsa yazım atılır ve hat kurtarılır. lcd_transport_write() bu durumda 1 döndürür; atılan partiler ise sadece
+hata sayacında görünür. lcd_config ikisinde de gölge çerçeveyi geçersiz yapar ve paneli yeniden çizer.
+
+Hat kurtarma (lcd_pcf_recover):
+	Köle bir baytın ortasında sıfırlanırsa (veya MCU transfer ortasında sıfırlanırsa) SDA'yı LOW tutmaya devam eder ve
+	I2C çevre birimi START üretemez. Pinler GPIO açık akaç çıkışa alınır, SDA serbest kalana kadar en fazla 9 SCL darbesi
+	verilir (köle yarım baytı bitirip ACK'i bırakır), elle STOP üretilir, pinler AF4'e döner ve I2C1 SWRST ile yeniden
+	kurulur. Süre 100 kHz'de ~100 µs'dir; kesme bağlamında da çağrılabilir. Her kurtarma hata sayacını bir artırır.
+
+*/
+
+#endif
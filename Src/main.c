@@ -1,10 +1,25 @@
 
 #include <stdint.h>
-#include <stdio.h>
 #include "stm32f4xx.h"
 #include "lcd_config.h"
 #include "delay.h"
+#include "clock_config.h"
 #include "mq2.h"
+#include "lcd_async.h"
+#include "oversample.h"
+#include "mq2_ppm.h"
+#include "mq2_calib.h"
+#include "gas_alarm.h"
+#include "scheduler.h"
+#include "prof.h"
+#include "fmt.h"
+#include "telemetry.h"
+#include "flash_log.h"
+#include "mem_sections.h"
+#include "timebase.h"
+#include "hrtimer.h"
+#include "dsp_filter.h"
+#include "gas_trend.h"
 
 
 void clock_config(void)
@@ -13,15 +28,24 @@ void clock_config(void)
 	RCC->CR |= RCC_CR_HSEON;						   // HSE (Harici osilatör) aktif et
 	while(!(RCC->CR & RCC_CR_HSERDY));				   // HSE hazır olana kadar bekle
 
+	RCC->APB1ENR |= RCC_APB1ENR_PWREN;				   // PWR clock'u aktif et
+	PWR->CR |= PWR_CR_VOS;							   // Regülatör Scale 1 (168 MHz için gerekli, reset değeri zaten 1)
+
 	FLASH->ACR = FLASH_ACR_DCEN | 	                   // Data Cache'i etkinleştir
 	             FLASH_ACR_ICEN | 	                   // Instruction Cache'i etkinleştir
-	             FLASH_ACR_LATENCY_2WS;                // 72MHz için 2 bekleme durumu ayarla
+	             FLASH_ACR_PRFTEN |	                   // Prefetch: sıralı kodda bir sonraki 128-bit satırı önceden oku
+	             (CLOCK_FLASH_WS << FLASH_ACR_LATENCY_Pos);	// SYSCLK'ya göre bekleme durumu (168 MHz: 5WS, 72 MHz: 2WS)
+	while (((FLASH->ACR & FLASH_ACR_LATENCY) >> FLASH_ACR_LATENCY_Pos) != CLOCK_FLASH_WS);	// Yeni gecikme etkin olana kadar bekle
+
+    RCC->CFGR = (RCC->CFGR & ~(RCC_CFGR_HPRE | RCC_CFGR_PPRE1 | RCC_CFGR_PPRE2)) |
+                (CLOCK_PPRE1_BITS << RCC_CFGR_PPRE1_Pos) |  // APB1 = HCLK / CLOCK_APB1_DIV (≤ 42 MHz)
+                (CLOCK_PPRE2_BITS << RCC_CFGR_PPRE2_Pos);   // APB2 = HCLK / CLOCK_APB2_DIV (≤ 84 MHz), AHB /1
 
-    RCC->PLLCFGR = (8 << RCC_PLLCFGR_PLLM_Pos) |       // PLLM = 8
-                   (144 << RCC_PLLCFGR_PLLN_Pos) |     // PLLN = 144
-                   (0 << RCC_PLLCFGR_PLLP_Pos) |       // PLLP = 2 (0: /2)
-                   (RCC_PLLCFGR_PLLSRC_HSE) |          // PLL kaynağı = HSE
-                   (7 << RCC_PLLCFGR_PLLQ_Pos);        // PLLQ = 7 (USB, SDIO vs. için)
+    RCC->PLLCFGR = (CLOCK_PLLM << RCC_PLLCFGR_PLLM_Pos) |       // PLLM: 8 MHz / 8 = 1 MHz VCO girişi
+                   (CLOCK_PLLN << RCC_PLLCFGR_PLLN_Pos) |       // PLLN: VCO = 2 × SYSCLK
+                   (CLOCK_PLLP_BITS << RCC_PLLCFGR_PLLP_Pos) |  // PLLP = 2 (0: /2)
+                   (RCC_PLLCFGR_PLLSRC_HSE) |                   // PLL kaynağı = HSE
+                   (CLOCK_PLLQ << RCC_PLLCFGR_PLLQ_Pos);        // PLLQ: VCO / 48 MHz (USB, SDIO vs. için)
 
     RCC->CR |= RCC_CR_PLLON;					// PLL'yi aktif et
     while(!(RCC->CR & RCC_CR_PLLRDY));			// PLL'nin stabil hale gelmesini bekle
@@ -42,18 +66,30 @@ Harici Osilatörü Etkinleştirme:
 
 Flash Bellek Ayarları:
 
-	FLASH->ACR = FLASH_ACR_DCEN | FLASH_ACR_ICEN | FLASH_ACR_LATENCY_2WS;
+	FLASH->ACR = FLASH_ACR_DCEN | FLASH_ACR_ICEN | FLASH_ACR_PRFTEN | (CLOCK_FLASH_WS << FLASH_ACR_LATENCY_Pos);
 	Bu adım, en kritik noktalardan biridir. Flash bellek, CPU'dan daha yavaş olduğu için, saat hızı arttığında CPU'nun veriyi doğru bir şekilde okuyabilmesi için bekleme süreleri (wait states) eklenir.
-	72 MHz için 2 bekleme durumu ayarlanır. Ayrıca, veri ve komut önbellekleri (DCEN ve ICEN) etkinleştirilerek, veri okuma işlemleri hızlandırılır.
+	2.7-3.6 V beslemede her 30 MHz için bir bekleme durumu gerekir: 168 MHz → 5WS, 72 MHz → 2WS. Değer clock_config.h'ta SYSCLK'dan hesaplanır.
+	Gecikme, saat yükseltilmeden önce yazılır ve geri okunarak etkin olduğu doğrulanır. Ayrıca veri ve komut önbellekleri (DCEN ve ICEN) etkinleştirilir.
+	PRFTEN ile ART hızlandırıcısı, CPU bir 128-bit satırı işlerken bir sonrakini okur; sıralı kod bekleme durumu görmeden akar.
+	Dallanmalarda yine bekleme olur; bu yüzden en sık çalışan kesmeler RAMFUNC ile SRAM'e alınmıştır (mem_sections.c).
+
+Bus Bölücüleri:
+
+	RCC->CFGR PPRE1 / PPRE2
+	APB1 en fazla 42 MHz, APB2 en fazla 84 MHz olabilir. 168 MHz'de APB1 /4 (42 MHz), APB2 /2 (84 MHz); 72 MHz'de APB1 /2 (36 MHz), APB2 /1.
+	Bölücü 1 değilse o bus'taki timer'lar PCLK'nın iki katıyla sayar (CLOCK_APB1_TIMER_HZ). TIM2, TIM3 ve USART3 hesapları bu makrolarla yapılır.
+	Eski kodda APB1 bölücüsü hiç ayarlanmadığı için APB1 72 MHz'de, yani sınırın üzerinde çalışıyordu.
 
 PLL Yapılandırması:
 
 	RCC->PLLCFGR = ...
 	PLL, giriş frekansını (HSE) bölerek, çarparak ve tekrar bölerek nihai bir frekans oluşturan bir frekans çarpanıdır.
-	Bu satırda, 72 MHz'lik sistem saatini elde etmek için gerekli matematiksel ayarlar yapılır:
+	Değerler clock_config.h'ta CLOCK_SYSCLK_HZ'den türetilir (168 MHz için):
 	Giriş frekansı 8'e bölünür (8MHz / 8 = 1 MHz).
-	Bu 1 MHz frekansı 144 ile çarpılır (1 MHz * 144 = 144 MHz).
-	Son olarak, elde edilen bu frekans 2'ye bölünerek nihai sistem saati olan 72 MHz elde edilir (144 MHz / 2 = 72 MHz).
+	Bu 1 MHz frekansı 336 ile çarpılır (1 MHz * 336 = 336 MHz, VCO 100-432 MHz aralığında olmalı).
+	Elde edilen bu frekans 2'ye bölünerek nihai sistem saati olan 168 MHz elde edilir (336 MHz / 2 = 168 MHz).
+	Q = 7 ile USB için 336 / 7 = 48 MHz elde edilir. 72 MHz ayarında N = 144, Q = 3'tür.
+	Geçersiz bir SYSCLK seçilirse (VCO aralık dışı, APB sınırı aşıldı, 48 MHz tam çıkmıyor vb.) derleme _Static_assert ile durur.
 
 PLL'yi Aktif Etme ve Bekleme:
 
@@ -184,62 +220,257 @@ Bu kısım, lambayı açıp kapamak için kullanılır ve 220V ile çalıştığ
 
 */
 
-int main(void)
+#define MQ2_OVERSAMPLE_RATIO	64			// ADC örnekleri / filtre çıkışı: hızlar ve periyotlar bundan türetilir
+
+static CCMRAM oversample_t mq2_oversample;	// ADC örneklerini 64× CIC ile seyrelten filtre durumu (CCM)
+static volatile uint16_t mq2_filtered;		// En son seyreltilmiş (15-bit) sensör değeri
+static CCMRAM dsp_median_t mq2_spike;		// Tek çıktılık sıçramaları silen 5'li medyan (CCM)
+static CCMRAM dsp_biquad_t mq2_smooth;		// 1 Hz Butterworth alçak geçiren (CCM)
+static CCMRAM int16_t mq2_smooth_state[4];
+static CCMRAM gas_trend_t mq2_trend;			// Seviye + yükselme hızı tespiti (CCM)
+static volatile uint8_t mq2_trend_level;		// gas_trend_level_t: ekran için son kademe
+static uint8_t mq2_trend_ok;					// 1: gas_trend_init() ayarı kabul etti (yoksa sadece watchdog çalışır)
+static const int16_t mq2_smooth_coeffs[6] = { 512, 0, 1023, 512, 23618, -9281 };	// Q14, fs = 15.625 Hz, fc = 1 Hz, DC kazancı tam 1
+
+static void adc_block_ready(const uint16_t* block, uint16_t count)
+{
+	uint16_t out[ADC_STREAM_BLOCK / 4 + 1];		// En küçük oran (4×) için bile yeterli
+
+	uint16_t n = oversample_process(&mq2_oversample, block, count, out, sizeof(out) / sizeof(out[0]));
+	uint8_t shift = oversample_output_bits(&mq2_oversample) - OVERSAMPLE_INPUT_BITS;
+	uint32_t rate = adc1_get_sample_rate();
+	uint32_t cycles_per_sample = rate ? CLOCK_HCLK_HZ / rate : 0;
+	uint64_t block_end = adc1_block_time();	// Bloğun son örneğinin dönüştürüldüğü an
+
+	dsp_median_process(&mq2_spike, (int16_t*)out, (int16_t*)out, n);		// 15-bit değerler int16'ya sığar, yerinde filtrelenir
+	dsp_biquad_process(&mq2_smooth, (int16_t*)out, (int16_t*)out, n);
+	for (uint16_t i = 0; i < n; i++)
+	{
+		if ((int16_t)out[i] < 0) out[i] = 0;	// Sıfıra yakın basamakta alt aşım (Butterworth ~%4 aşar)
+	}
+
+	for (uint16_t i = 0; i < n; i++)
+	{
+		uint32_t back = mq2_oversample.count + (uint32_t)(n - 1 - i) * mq2_oversample.ratio;	// Çıktıdan sonra gelen giriş örnekleri
+		uint64_t stamp = block_end - (uint64_t)back * cycles_per_sample;
+
+		uint16_t value = out[i] >> shift;
+
+		mq2_calib_update(value);				// Isınma ve R0 takibi her filtrelenmiş örneği görür
+		if (mq2_trend_ok)
+		{
+			if (mq2_calib_state() == MQ2_CALIB_WARMUP)
+			{
+				gas_trend_hold_rates(&mq2_trend);	// Isıtıcı ısınırken okumalar kayar: eğim / ivme susar, seviye kriterleri çalışır
+			}
+			mq2_trend_level = gas_trend_update(&mq2_trend, value);
+			gas_alarm_set_trend(mq2_trend_level == GAS_TREND_ALARM);	// Değişmediyse hemen döner
+		}
+		telemetry_push_sample(out[i], (uint32_t)timebase_cycles_to_ms(stamp));	// Tam çözünürlüklü (15-bit) değer seri porta gider
+	}
+
+	if (n)
+	{
+		mq2_filtered = out[n - 1];				// Sadece en güncel çıktı gösterilir
+	}
+}
+
+/*
+
+adc_block_ready() DMA yarım/tam transfer kesmesinden çağrılır.
+1 kHz örneklemede her 128 örneklik blok 2 çıktı üretir (64×), yani ~15.6 Hz'lik 15-bit bir akış elde edilir.
+Ana döngü bu değeri 3 bit sağa kaydırarak eski 12-bit ölçeğe çevirir; böylece 2300 eşiği ve ekran formatı değişmez,
+sadece tek ölçümün onlarca LSB'lik gürültüsü kaybolur.
+Her çıktının zamanı: bloğun son örneğinin zamanından, çıktıdan sonra filtreye giren örnek sayısı (os.count ve sonraki
+çıktılar için ratio) kadar örnekleme periyodu geri gidilerek bulunur; ana döngünün ne zaman çalıştığından bağımsızdır.
+CIC çıktısı önce 5'li medyandan (röle / motor kaynaklı tek örneklik sıçramalar), sonra 1 Hz'lik 2. dereceden Butterworth
+alçak geçirenden geçer. Kalibrasyon, telemetri ve ekran aynı temizlenmiş akışı görür; 15.6 Hz'de 1 Hz kesim gaz
+yükselişini (saniyeler mertebesi) geciktirmez, ~0.2 s grup gecikmesi ekler.
+Aynı akış gas_trend'e verilir: seviye veya yükselme hızı (eğim / ivme) sınırı geçince ön alarm / alarm kademesi,
+bekleme süresi ve histerezis ile onaylanır; alarm kademesi gas_alarm üzerinden röleyi sürer. Sensör ısınırken sadece
+eğim / ivme kriterleri susturulur; seviye kriterleri ve ham örnekteki 2300 watchdog'u ısınmada da çalışır.
+
+*/
+
+static uint16_t sensor_value;				// 12-bit ölçekte filtrelenmiş sensör değeri (sample_task günceller)
+static uint32_t sensor_ppm;					// LPG konsantrasyonu (ppm)
+static uint32_t sayac = 0;						// Ekran yenileme sayacı
+static flash_log_acc_t history_acc;				// Saniyelik min / ortalama / max özeti
+
+static uint32_t cycle_counter(void)
+{
+	return DWT->CYCCNT;
+}
+
+static void sample_task(void)
+{
+	sensor_value = mq2_filtered >> (oversample_output_bits(&mq2_oversample) - OVERSAMPLE_INPUT_BITS);	// 12-bit ölçeğe çevir
+	sensor_ppm = mq2_ppm(sensor_value, MQ2_GAS_LPG);
+	flash_log_acc_add(&history_acc, sensor_value);
+}
+
+static void control_task(void)
+{
+	flash_log_record_t record;
+
+	mq2_calib_service();	// Gerekirse yeni R0 değerini flash'a kaydet
+
+	if (!gas_alarm_active())
+	{
+		flash_log_service();	// Sıradaki geçmiş sektörünü önceden sil: dönüş anında bekleme olmaz (ekran 1-2 sn durur)
+	}
+
+	flash_log_acc_take(&history_acc, (uint32_t)(timebase_ms() / 1000), &record);
+	flash_log_append(&record);	// RAM sayfasına ekler, 16 kayıtta bir flash'a yazar
+}
+
+static void display_task(void)
 {
-	int sayac = 0;
-	char buffer[5];
-    uint16_t sensor_value;
-    char buffer2[16];
+	char* field;
+
+	lcd_fb_clear();	// Sadece RAM çerçevesini temizle, panele dokunma
+	sayac++;
+
+	field = lcd_fb_region(0, 0, 4);
+	if (field) fmt_u32(field, 4, sensor_value, FMT_ALIGN_LEFT, ' ');	// 12-bit değer en fazla 4 basamak
+
+	lcd_sparkline_push(sensor_value, 4095);	// Son 10 sn'nin eğilimi (her 500 ms'de bir örnek)
+	lcd_sparkline_draw(0, 5);
+
+	field = lcd_fb_region(0, 11, 5);
+	if (field) fmt_u32(field, 5, sayac % 100000, FMT_ALIGN_RIGHT, ' ');	// Sayaç sağ üst köşeye yaslanır, 5 basamakta başa döner
 
-    clock_config();	// Sistem saatini 72 MHz'e ayarla
+	if (mq2_calib_has_r0() && mq2_calib_state() != MQ2_CALIB_WARMUP)
+	{
+		lcd_fb_write(1, 0, "LPG");
+		field = lcd_fb_region(1, 4, 6);
+		if (field) fmt_u32(field, 6, sensor_ppm, FMT_ALIGN_LEFT, ' ');	// LPG konsantrasyonu (ppm)
+	}
+	else
+	{
+		lcd_fb_write(1, 0, "ISINIYOR");	// Sensör ısınıyor, ppm değeri henüz anlamlı değil
+	}
+
+	// Röleyi gas_alarm.c (watchdog + gas_trend) sürer, burada sadece durumu gösteriliyor
+	if (gas_alarm_active())
+	{
+		lcd_fb_write(1, 13, "ON");
+	}
+	else if (!mq2_trend_ok)
+	{
+		lcd_fb_write(1, 13, "ERR");	// gas_trend ayarı reddedildi: röleyi sadece 2300 watchdog'u sürüyor
+	}
+	else if (mq2_trend_level == GAS_TREND_PREALARM)
+	{
+		lcd_fb_write(1, 13, "PRE");	// Ön alarm: röle değişmez, sadece uyarı
+	}
+	else
+	{
+		lcd_fb_write(1, 13, "OFF");
+	}
+
+	lcd_flush_async();	// Sadece değişen hücreleri kuyruğa ekle, gönderim arka planda sürer
+}
+
+static void telemetry_task(void)
+{
+	static uint8_t status_div;
+	gas_alarm_event_t event;
+	uint32_t now = millis();
+	uint8_t alarm = gas_alarm_active();
+
+	uint32_t rate = adc1_get_sample_rate();
+
+	telemetry_service(rate ? (uint16_t)(1000000UL * MQ2_OVERSAMPLE_RATIO / rate) : 0);	// Filtre çıkış periyodu (µs)
+
+	while (gas_alarm_event_pop(&event) == 0)	// Yoklamalar arasındaki kısa geçişler dahil hepsi, sırayla
+	{
+		telemetry_send_relay((uint32_t)timebase_cycles_to_ms(event.cycles), event.state, event.trips);	// Zaman damgası kesmedeki geçiş anı
+	}
+
+	if (++status_div >= 4)	// Saniyede bir durum çerçevesi
+	{
+		status_div = 0;
+		telemetry_send_status(now, alarm, gas_alarm_trips(), gas_alarm_latency_max(), sensor_ppm, (uint8_t)mq2_calib_state());
+	}
+}
+
+/*
+
+Görevler (scheduler.c):
+	sample_task   → 100 ms: filtrelenmiş değeri 12-bit ölçeğe çevirir ve ppm hesaplar.
+	control_task  → 1 s: kalibrasyon kaydı ve saniyelik geçmiş özeti (flash yazımı uzun sürebileceği için ekrandan ayrı tutulur).
+	display_task  → 500 ms: çerçeveyi hazırlar ve değişen hücreleri LCD kuyruğuna ekler.
+	telemetry_task → 250 ms: biriken örnekleri, röle geçişlerini ve saniyede bir durumu USART3'e (PD8, 115200) gönderir.
+	Röle ve örnekleme zaten kesmelerde (analog watchdog, DMA) çalıştığı için döngüde bekleme yoktur;
+	eskiden delay_ms(500) bütün işleri ekranın hızına bağlıyordu.
+
+*/
+
+int main(void)
+{
+    mem_sections_init();	// .ccmram'i doldur, vektör tablosunu SRAM'e taşı (her şeyden önce)
+    clock_config();	// Sistem saatini CLOCK_SYSCLK_HZ'e ayarla (varsayılan 168 MHz)
     systick_config();
     DWT_Delay_Init();
+    timebase_init();	// 64-bit cycle / µs / ms zaman tabanı (SysTick ile genişletilir)
+    hrtimer_init();	// TIM2: µs çözünürlüklü zamanlayıcı servisi (LCD beklemeleri, röle süresi)
     gpioD_config();
-    lcd_init();	// LCD'yi başlat ve 4-bit moda ayarla
+    lcd_init();	// LCD'yi başlat (4-bit / 8-bit / I2C: LCD_TRANSPORT)
     gpio_pa0_analog_init();
     adc1_init();
+    adc1_set_sample_rate(1000);	// ADC1 TIM3 tetiği ile saniyede 1000 örnek alır
+    oversample_init(&mq2_oversample, MQ2_OVERSAMPLE_RATIO, OVERSAMPLE_CIC2);	// 64× aşırı örnekleme → 15 bit
+    dsp_median_init(&mq2_spike, 5, 0);
+    dsp_biquad_init(&mq2_smooth, mq2_smooth_coeffs, 1, mq2_smooth_state, 1);
+    mq2_calib_init(adc1_get_sample_rate() * 1000 / MQ2_OVERSAMPLE_RATIO);	// Flash'taki R0'ı yükle (gerekirse yedek sektörü siler: akış başlamadan); filtre çıkış hızı (mHz, 1 kHz / 64 = 15625)
+    flash_log_init();	// Sektör 8-9'daki geçmiş halkasında yazma konumunu bul (ilk açılışta sektörü siler)
+    flash_log_acc_reset(&history_acc);
+    telemetry_init(115200);	// USART3 TX (PD8) + DMA, örnekler kesmeden kuyruğa yazılır
+    gas_alarm_init(0, GAS_ALARM_HIGH, GAS_ALARM_LOW);	// PA0 (kanal 0) ham örnekleri analog watchdog ile 2300 / 2200 eşiğinde
+
+    gas_trend_config_t trend_cfg = {
+        .rate_mhz = adc1_get_sample_rate() * 1000 / MQ2_OVERSAMPLE_RATIO,	// Filtre çıkış hızı (mHz)
+        .slope_window = GAS_TREND_SLOPE_WINDOW,
+        .accel_window = GAS_TREND_ACCEL_WINDOW,
+        .level_pre = GAS_TREND_LEVEL_PRE,
+        .level_alarm = GAS_ALARM_HIGH,
+        .level_hyst = GAS_ALARM_HIGH - GAS_ALARM_LOW,
+        .slope_pre = GAS_TREND_SLOPE_PRE,
+        .slope_alarm = GAS_TREND_SLOPE_ALARM,
+        .slope_hyst = GAS_TREND_SLOPE_HYST,
+        .accel_alarm = GAS_TREND_ACCEL_ALARM,
+        .raise_ms = GAS_TREND_RAISE_MS,
+        .clear_ms = GAS_TREND_CLEAR_MS,
+    };
+    mq2_trend_ok = gas_trend_init(&mq2_trend, &trend_cfg, 0) == 0;	// Kademeli alarm: seviye + yükselme hızı (filtrelenmiş akış)
+    adc1_stream_start(adc_block_ready);	// DMA örnekleri tampona yazar, her dolan yarım filtreye verilir
 
     lcd_set_cursor(0, 0);
     lcd_print_string("Merhaba Dunya!");	// Ekrana "Merhaba Dunya!" yazdır
     delay_ms(500);
     lcd_clear();
 
-    while(1)
-    {
-
-    	lcd_clear();
-    	sayac++;
-
-    	sensor_value = adc1_read();
+    lcd_async_init();	// Bundan sonra LCD'ye yazımlar hrtimer (TIM2) kesmesi ile arka planda yapılır
 
-    	sprintf(buffer, "%d", sensor_value);
-    	sprintf(buffer2, "%d", sayac);
+#if PROF_ENABLE
+    mem_sections_bench(prof_itm_put);	// Flash / SRAM önce-sonra cycle tablosu (SWO)
+    dsp_filter_bench(prof_itm_put);	// FIR / biquad / medyan: DSP komutlu ve taşınabilir yol, cycle / örnek (SWO)
+#endif
 
-    	lcd_set_cursor(0, 0);
-    	lcd_print_string(buffer);
+    uint32_t now = millis();
+    sched_init(cycle_counter, CLOCK_CYCLES_PER_MS);	// Çalışma süreleri CPU cycle cinsinden ölçülür
+    sched_add_periodic("sample", sample_task, now, 100, 0, 0);
+    sched_add_periodic("control", control_task, now, 1000, 50, 0);
+    sched_add_periodic("display", display_task, now, 500, 10, 0);	// Örnekleme görevinden sonra çalışsın
+    sched_add_periodic("telemetry", telemetry_task, now, 250, 20, 0);
 
-    	lcd_set_cursor(0, 15);
-    	lcd_print_string(buffer2);
-
-        // Belirli bir eşik değeri kontrolü yap
-        // Bu eşik değerini kendi denemelerinize göre ayarlayabilirsiniz.
-        if (sensor_value > 2300) // Örnek bir eşik değeri
-        {
-            relay_pd12(0); // Gaz algılandığında lambayı yak
-            lcd_set_cursor(1, 13);
-            lcd_print_string("ON");
-            delay_ms(50);
-        }
-        else
-        {
-            relay_pd12(1); // Gaz yoksa lambayı söndür
-            lcd_set_cursor(1, 13);
-            lcd_print_string("OFF");
-            delay_ms(50);
-        }
-
-        // Ölçümler arasında kısa bir gecikme ekle
-        delay_ms(500);
+    while(1)
+    {
+    	PROF_TRACE(main_loop_period);	// Ardışık iki tur arasındaki süre
+    	PROF_BEGIN(main_loop);
+    	sched_dispatch(millis());	// Zamanı gelen görevleri çalıştır
+    	PROF_END(main_loop);
 
     	/*
     	delay_ms(100);
@@ -249,6 +480,7 @@ int main(void)
     	               	(0x1 << GPIO_ODR_OD15_Pos) );
 
 		*/
+
     }
 
 }
@@ -0,0 +1,223 @@
+#include <stdint.h>
+#include "stm32f4xx.h"
+#include "mem_sections.h"
+#include "prof.h"
+#include "fmt.h"
+
+#if MEM_PLACEMENT
+
+extern uint32_t _siccmram;      // .ccmram'in flash'taki ilk değerleri (linker script)
+extern uint32_t _sccmram;       // CCM'deki başlangıç adresi
+extern uint32_t _eccmram;       // CCM'deki bitiş adresi
+extern uint32_t _sramfunc;      // .data içindeki .RamFunc'in başı / sonu (STM32F407VGTX_FLASH.ld); tanımlı değilse link hatası
+extern uint32_t _eramfunc;
+
+static void (*mem_vectors[MEM_VECTOR_COUNT])(void) __attribute__((aligned(MEM_VECTOR_ALIGN)));   // SRAM'deki vektör tablosu
+static uint32_t mem_ramfunc_size;
+
+void mem_sections_init(void)
+{
+    RCC->AHB1ENR |= RCC_AHB1ENR_CCMDATARAMEN;           // CCM clock'u (reset değeri zaten açık)
+    mem_ramfunc_size = (uint32_t)&_eramfunc - (uint32_t)&_sramfunc;
+
+    const uint32_t* src = &_siccmram;
+    for (uint32_t* dst = &_sccmram; dst < &_eccmram; ) {
+        *dst++ = *src++;                                // Startup sadece .data / .bss'i hazırlar, .ccmram'i biz kopyalarız
+    }
+
+    void (* const* flash_vectors)(void) = (void (* const*)(void))SCB->VTOR;  // Açılışta 0x08000000 (flash)
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    for (uint32_t i = 0; i < MEM_VECTOR_COUNT; i++) {
+        mem_vectors[i] = flash_vectors[i];
+    }
+    SCB->VTOR = (uint32_t)mem_vectors;                  // Bundan sonra kesme adresleri SRAM'den okunur
+    __DSB();
+    __ISB();
+    __set_PRIMASK(primask);
+}
+
+uint8_t mem_vector_set(int32_t irq, void (*handler)(void))
+{
+    int32_t index = irq + 16;                           // IRQn_Type: çekirdek istisnaları negatif, kesmeler 0'dan başlar
+
+    if (index < 1 || index >= MEM_VECTOR_COUNT) return 1;   // 0. eleman başlangıç yığın adresidir
+    if (SCB->VTOR != (uint32_t)mem_vectors) return 1;       // Tablo henüz flash'ta, değiştirilemez
+
+    mem_vectors[index] = handler;
+    __DSB();
+    return 0;
+}
+
+uint32_t mem_ramfunc_bytes(void)
+{
+    return mem_ramfunc_size;
+}
+
+#else
+
+void mem_sections_init(void)
+{
+}
+
+uint8_t mem_vector_set(int32_t irq, void (*handler)(void))
+{
+    (void)irq;
+    (void)handler;
+    return 1;
+}
+
+uint32_t mem_ramfunc_bytes(void)
+{
+    return 0;
+}
+
+#endif
+
+#if PROF_ENABLE
+
+#define MEM_BENCH_BLOCK     64
+
+static uint16_t mem_bench_in[MEM_BENCH_BLOCK];
+
+static inline __attribute__((always_inline)) uint32_t mem_bench_body(const uint16_t* in, uint16_t n)
+{
+    uint32_t acc = 0;
+
+    for (uint16_t i = 0; i < n; i++) {                  // Kesme yolu gibi: kısa döngü, veriye bağlı dallar
+        switch (in[i] & 7) {
+        case 0: acc += in[i]; break;
+        case 1: acc ^= (uint32_t)in[i] << 3; break;
+        case 2: acc -= in[i] >> 1; break;
+        case 3: acc = (acc << 1) | (acc >> 31); break;
+        case 4: acc += (uint32_t)in[i] * 3; break;
+        case 5: if (acc & 1) acc >>= 1; else acc += 7; break;
+        case 6: acc ^= 0x5A5A; break;
+        default: acc += i; break;
+        }
+    }
+    return acc;
+}
+
+static __attribute__((noinline)) uint32_t mem_bench_flash(const uint16_t* in, uint16_t n)
+{
+    return mem_bench_body(in, n);
+}
+
+RAMFUNC static uint32_t mem_bench_sram(const uint16_t* in, uint16_t n)
+{
+    return mem_bench_body(in, n);
+}
+
+static void mem_bench_art_flush(void)                   // ART önbelleklerini boşalt: kesme girişindeki gibi soğuk başla
+{
+    uint32_t acr = FLASH->ACR;
+
+    FLASH->ACR = acr & ~(FLASH_ACR_ICEN | FLASH_ACR_DCEN);
+    FLASH->ACR = (acr & ~(FLASH_ACR_ICEN | FLASH_ACR_DCEN)) | FLASH_ACR_ICRST | FLASH_ACR_DCRST;
+    FLASH->ACR = acr;
+}
+
+static void mem_bench_row(void (*put)(char), const char* name, uint32_t cold, uint32_t warm)
+{
+    char line[32];
+    uint8_t n = 0;
+
+    while (*name) line[n++] = *name++;
+    fmt_u32(&line[n], 8, cold, FMT_ALIGN_RIGHT, ' ');
+    n += 8;
+    fmt_u32(&line[n], 8, warm, FMT_ALIGN_RIGHT, ' ');
+    n += 8;
+    line[n++] = '\n';
+
+    for (uint8_t i = 0; i < n; i++) put(line[i]);
+}
+
+void mem_sections_bench(void (*put)(char c))
+{
+    volatile uint32_t sink;
+    uint32_t t0, t1, t2;
+
+    for (uint16_t i = 0; i < MEM_BENCH_BLOCK; i++) mem_bench_in[i] = (uint16_t)(i * 997);   // Dalları karıştıran giriş
+
+    const char* header = "yol       soguk   sicak   (cycle / 64 ornek)\n";
+    while (*header) put(*header++);
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();                                    // Kesme araya girip önbelleği ısıtmasın / süreyi uzatmasın
+
+    mem_bench_art_flush();
+    t0 = PROF_CYCLES();
+    sink = mem_bench_flash(mem_bench_in, MEM_BENCH_BLOCK);
+    t1 = PROF_CYCLES();
+    sink = mem_bench_flash(mem_bench_in, MEM_BENCH_BLOCK);
+    t2 = PROF_CYCLES();
+    uint32_t flash_cold = t1 - t0, flash_warm = t2 - t1;
+
+    mem_bench_art_flush();
+    t0 = PROF_CYCLES();
+    sink = mem_bench_sram(mem_bench_in, MEM_BENCH_BLOCK);
+    t1 = PROF_CYCLES();
+    sink = mem_bench_sram(mem_bench_in, MEM_BENCH_BLOCK);
+    t2 = PROF_CYCLES();
+
+    __set_PRIMASK(primask);
+    (void)sink;
+
+    mem_bench_row(put, "flash ", flash_cold, flash_warm);
+    mem_bench_row(put, "sram  ", t1 - t0, t2 - t1);  // MEM_PLACEMENT=0 iken bu da flash'tan çalışır
+}
+
+#endif  // PROF_ENABLE
+
+/*
+
+Amaç: Sık çalışan kesme kodunu flash bekleme durumlarından, CPU'ya özel verileri de DMA ile bus çekişmesinden kurtarmak.
+
+168 MHz'de flash 5 bekleme durumuyla okunur. ART hızlandırıcısı (ICEN / DCEN / PRFTEN) sıralı kodu ve döngüleri iyi örter,
+fakat kesme girişi gibi dallanmalarda önbellek kaçırırsa her satır için 5 cycle beklenir. Bu yüzden:
+
+RAMFUNC (.RamFunc):
+	Linker script'te .data bölümünün içinde yer alır; startup kodu .data'yı kopyalarken bu fonksiyonları da SRAM'e taşır.
+	Flash'taki kod ile SRAM'deki kod arasındaki uzak çağrılar için ld otomatik olarak "veneer" ekler, ayrıca bir şey gerekmez.
+	Kullanılan yerler:
+		ADC watchdog → röle yolunun tamamı: ADC_IRQHandler, gas_alarm_arm / _relay_set / _apply / _release, hrtimer_now /
+		_start / _cancel ve çarkın ekleme / iptal / tarama fonksiyonları (timer_wheel.c), timebase_cycles. TIM2_IRQHandler da
+		SRAM'dedir; çağırdığı callback'lerden sadece gas_alarm_release SRAM'de, diğerleri (LCD, scheduler) flash'tadır.
+		SysTick_Handler + timebase_tick, prof_record (PROF_ENABLE=1 iken kesmelerden çağrılır), flash.c silme / yazma.
+		DMA2_Stream0_IRQHandler + adc_dispatch + oversample_process + dsp_*_process: sadece kesme girişi ve sık döngüler.
+		Kanal callback'i (main.c adc_block_ready) ve ondan çağrılanlar (kalibrasyon, gas_trend, telemetri) flash'tadır;
+		örnek hattının tamamı SRAM'de değildir.
+	Denetim: linker script'teki ASSERT'ler global olanları, tools/ramfunc_check.sh ELF sembol tablosundan static olanlar
+	dahil hepsini .RamFunc aralığında arar. RAMFUNC noinline'dır; static bir yardımcı flash'taki bir çağırana gömülmez.
+
+CCMRAM (.ccmram):
+	CCM sadece çekirdeğin D-bus'ına bağlıdır. DMA, CCM'e erişemez; bu yüzden adc_dma_buffer ve telemetry_tx SRAM'de kalır.
+	Buna karşılık CPU'nun CCM erişimleri, DMA2'nin ADC örneklerini SRAM'e yazmasıyla hiç çakışmaz.
+	Linker script'teki bölüm (STM32F407VGTX_FLASH.ld):
+		_siccmram = LOADADDR(.ccmram);
+		.ccmram : { . = ALIGN(4); _sccmram = .; *(.ccmram) *(.ccmram*) . = ALIGN(4); _eccmram = .; } >CCMRAM AT> FLASH
+	Startup kodu bu bölümü kopyalamadığı için mem_sections_init() main()'in ilk satırında çağrılmalıdır;
+	ilk değer verilmemiş değişkenler de flash görüntüsünde sıfır olarak durduğu için sıfırlanmış olur.
+
+Vektör tablosu:
+	Flash'taki tablo SRAM'deki 512 bayt hizalı bir diziye kopyalanır ve VTOR oraya çevrilir. Vektör okuması flash bekleme durumuna
+	takılmaz ve mem_vector_set() ile bir kesmenin fonksiyonu çalışma anında değiştirilebilir.
+	Tablo CCM'e konmaz: 0x1000_0000 code bölgesinde olduğu için vektör okuması I-bus'tan yapılır, CCM ise sadece D-bus'a bağlıdır.
+
+Linker script:
+	Depodaki STM32F407VGTX_FLASH.ld .RamFunc'i .data'nın içine (_sramfunc / _eramfunc ile) ve .ccmram'i CCM'e koyar; FLASH'ı
+	512 KB ile sınırlar. mem_sections_init() bu sembollerin hepsini kullanır: bölümleri tanımlamayan bir linker script ile
+	MEM_PLACEMENT=1 derleme link aşamasında "undefined reference" ile durur, RAMFUNC sessizce flash'ta kalmaz. Script'teki
+	ASSERT'ler de bölümlerin gerçekten SRAM / CCM'de olduğunu denetler. mem_ramfunc_bytes() taşınan kodun boyutunu verir.
+
+Ölçüm:
+	mem_sections_bench() aynı kısa, dallı döngüyü (kesme yolu benzeri) bir kez flash'tan bir kez SRAM'den, ART önbellekleri
+	boşaltılmış (soğuk: kesme girişindeki durum) ve dolu (sıcak) olarak çalıştırır ve DWT CYCCNT ile tek derlemede önce / sonra
+	tablosu yazar. PROF_ENABLE=1 iken main() açılışta bu tabloyu ITM'e (SWO) gönderir.
+	Gerçek kesmeler için PROF_BEGIN / PROF_END noktaları vardır (isr_systick, isr_adc_dma, isr_adc_awd, isr_hrtimer):
+	-DPROF_ENABLE=1 ile bir kez MEM_PLACEMENT=0 (her şey flash'ta), bir kez varsayılan ayarla derlenip prof_dump_itm()
+	çıktısındaki min / ortalama / max cycle değerleri karşılaştırılır.
+
+*/
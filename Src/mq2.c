@@ -1,9 +1,30 @@
 
 #include "stm32f4xx.h"
 #include "mq2.h"
+#include "clock_config.h"
+#include "prof.h"
+#include "mem_sections.h"
+#include "timebase.h"
 
 uint16_t adc_value;
 
+static volatile uint16_t adc_dma_buffer[2 * ADC_STREAM_BLOCK];   // DMA'nın dairesel olarak doldurduğu çift tampon (CCM'de olmamalı)
+static adc_block_callback_t adc_pipelines[ADC_MAX_CHANNELS];     // Her kanalın kendi örneklerini işleyecek fonksiyon
+static adc_channel_cfg_t adc_scan_table[ADC_MAX_CHANNELS] = {     // Tarama sırası (varsayılan: sadece PA0 / kanal 0)
+    { 0, ADC_SMP_480 }
+};
+static uint8_t adc_scan_count = 1;                               // Sıradaki kanal sayısı
+static uint16_t adc_stream_half;                                 // Yarım tampondaki örnek sayısı (kanal sayısının katı)
+static CCMRAM uint16_t adc_channel_scratch[ADC_STREAM_BLOCK];    // Ayrıştırılmış tek kanal örnekleri (sadece CPU)
+static volatile uint8_t adc_streaming;                           // Sürekli örnekleme açıksa 1
+static volatile uint32_t adc_dma_errors;                         // DMA transfer hatası sayacı
+static volatile uint8_t adc_stream_wrapped;                      // DMA tamponun sonuna en az bir kez ulaştı (TC)
+static uint32_t adc_sample_rate_hz;                              // TIM3 ile tetiklenen örnekleme hızı (0: tetik yok)
+static volatile uint64_t adc_block_cycles;                        // Dağıtılan bloğun son örneğinin zamanı (timebase_cycles)
+
+#define ADC_TRIGGER_TIMER_CLK   CLOCK_APB1_TIMER_HZ // TIM3 APB1'de; APB1 bölücüsü 1 değilse timer clock'u = 2 × PCLK1
+#define ADC_EXTSEL_TIM3_TRGO    8                   // ADC_CR2 EXTSEL: 1000 = Timer 3 TRGO olayı
+
 void gpio_pa0_analog_init(void) {
     RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN;               // GPIOA clock'u aktif et
     GPIOA->MODER |= (3 << (0 * 2));                    // PA0 modunu '11' (Analog) yap
@@ -36,6 +57,8 @@ Ek notlar:
 void adc1_init(void) {
     RCC->APB2ENR |= RCC_APB2ENR_ADC1EN;                // ADC1 clock'unu aktif et
     ADC1->CR1 = 0;                                     // CR1 varsayılan (8-bit çözünürlük yok, default 12-bit)
+    ADC->CCR = (ADC->CCR & ~ADC_CCR_ADCPRE) |
+               (CLOCK_ADCPRE_BITS << ADC_CCR_ADCPRE_Pos);  // ADC saati = PCLK2 / CLOCK_ADC_DIV (≤ 36 MHz)
     ADC1->CR2 = ADC_CR2_ADON;                          // ADC1'i aktif et
     ADC1->SMPR2 |= (3 << (3 * 0));                     // Kanal 0 için örnekleme süresi = 56 cycle
 }
@@ -79,20 +102,36 @@ Ek önemli noktalar (uygulamada göz önünde bulundurulmalı):
 */
 
 uint16_t adc1_read(void) {
-    ADC1->SQR3 = 0;                                    // Sadece Kanal 0 seçildi
-    ADC1->CR2 |= ADC_CR2_SWSTART;                      // Yazılım ile dönüşümü başlat
-    while (!(ADC1->SR & ADC_SR_EOC));                  // Dönüşüm tamamlanana kadar bekle
-    return (uint16_t)ADC1->DR;                         // Ölçüm sonucunu döndür
+    uint16_t value;
+    PROF_BEGIN(adc1_read);
+
+    if (adc_streaming) {                                                    // DMA akışı açıksa dönüşüm başlatma
+        value = adc1_read_index(0);                                         // Sıranın ilk kanalının en son örneği
+    } else {
+        ADC1->SQR3 = 0;                                // Sadece Kanal 0 seçildi
+        ADC1->SR = ~(ADC_SR_EOC | ADC_SR_OVR);         // Akıştan / yarım kalan dönüşümden kalmış bayrak eski DR'yi döndürtmesin
+        ADC1->CR2 |= ADC_CR2_SWSTART;                  // Yazılım ile dönüşümü başlat
+        while (!(ADC1->SR & ADC_SR_EOC));              // Dönüşüm tamamlanana kadar bekle
+        value = (uint16_t)ADC1->DR;                    // Ölçüm sonucunu al
+    }
+
+    PROF_END(adc1_read);
+    return value;                                      // Ölçüm sonucunu döndür
 }
 
 /*
 
 Amaç: ADC1 kanal0 için yazılım başlatmalı (polling) tek dönüşüm yapmak ve sonucu döndürmek.
+Not: adc1_stream_start() çağrıldıysa dönüşüm başlatılmaz; DMA tamponundaki en son örnek beklemeden döndürülür.
 
 ADC1->SQR3 = 0;
 	Ne yapar: Regular sequence register 3 (SQR3) içindeki SQ1 alanına 0 yazar; yani yapılacak ilk (ve tek) dönüşüm kanalı 0 olarak seçilir. SQR3'ün SQ1 alanı bit[4:0]'tadır.
 	Dikkat: Eğer birden fazla kanal okunacaksa SQR1/SQR2/SQR3 register'larında SQx sırasına göre kanal numaralarını yerlestirirsiniz; ayrıca L[3:0] alanıyla sıra uzunluğu belirlenir.
 
+ADC1->SR = ~(ADC_SR_EOC | ADC_SR_OVR);
+	Ne yapar: EOC ve OVR rc_w0 bitleridir; 0 yazılan bit temizlenir, 1 yazılanlar değişmez. Akış durdurulduğunda (özellikle DMA hatasından
+	sonra) DR'de okunmamış eski bir örnek ve EOC = 1 kalabilir; temizlenmezse aşağıdaki döngü hemen çıkar ve eski değer döner.
+
 ADC1->CR2 |= ADC_CR2_SWSTART;
 	Ne yapar: Yazılım komutu ile ADC'yi başlatır (SWSTART). Eğer ADC CR2'de CONT=0 ise tek dönüşüm yapılır.
 	Önemli: ADC'nin ADON bitinin zaten set olduğundan ve ADC stabilize olduğundan emin olun; aksi halde SWSTART etkisiz olabilir.
@@ -113,6 +152,318 @@ Ek tavsiyeler:
 
 */
 
+uint8_t adc_sequence_encode(const adc_channel_cfg_t* table, uint8_t count, adc_sequence_regs_t* regs) {
+    if (count == 0 || count > ADC_MAX_CHANNELS) return 1;
+
+    regs->sqr1 = (uint32_t)(count - 1) << 20;                       // L[3:0]: dönüşüm sayısı - 1
+    regs->sqr2 = 0;
+    regs->sqr3 = 0;
+    regs->smpr1 = 0;
+    regs->smpr2 = 0;
+
+    uint32_t seen = 0;                                              // Örnekleme süresi yazılmış kanallar
+
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t ch = table[i].channel;
+        uint8_t smp = table[i].sample_time;
+        if (ch > 18 || smp > 7) return 1;
+
+        if (i < 6)       regs->sqr3 |= (uint32_t)ch << (5 * i);             // SQ1-SQ6
+        else if (i < 12) regs->sqr2 |= (uint32_t)ch << (5 * (i - 6));       // SQ7-SQ12
+        else             regs->sqr1 |= (uint32_t)ch << (5 * (i - 12));      // SQ13-SQ16
+
+        uint32_t* smpr = (ch < 10) ? &regs->smpr2 : &regs->smpr1;
+        uint8_t pos = (ch < 10) ? (3 * ch) : (3 * (ch - 10));
+        if (seen & (1UL << ch)) {
+            if (((*smpr >> pos) & 7) != smp) return 1;              // Aynı kanal iki farklı süreyle istenemez
+        }
+        *smpr |= (uint32_t)smp << pos;
+        seen |= 1UL << ch;
+    }
+    return 0;
+}
+
+static void adc_gpio_analog(uint8_t channel) {
+    GPIO_TypeDef* port;
+    uint8_t pin;
+
+    if (channel < 8)       { port = GPIOA; pin = channel;      RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN; }  // PA0-PA7
+    else if (channel < 10) { port = GPIOB; pin = channel - 8;  RCC->AHB1ENR |= RCC_AHB1ENR_GPIOBEN; }  // PB0-PB1
+    else if (channel < 16) { port = GPIOC; pin = channel - 10; RCC->AHB1ENR |= RCC_AHB1ENR_GPIOCEN; }  // PC0-PC5
+    else return;                                                                                      // 16-18: dahili
+
+    port->MODER |= (3UL << (pin * 2));                              // Analog mod
+    port->PUPDR &= ~(3UL << (pin * 2));                             // Pull-up/down yok
+}
+
+uint8_t adc1_scan_config(const adc_channel_cfg_t* table, uint8_t count) {
+    adc_sequence_regs_t regs;
+
+    if (adc_streaming || adc_sequence_encode(table, count, &regs)) return 1;
+
+    for (uint8_t i = 0; i < count; i++) {
+        adc_scan_table[i] = table[i];
+        adc_gpio_analog(table[i].channel);
+    }
+    adc_scan_count = count;
+    return 0;
+}
+
+void adc1_scan_set_pipeline(uint8_t index, adc_block_callback_t callback) {
+    if (index < ADC_MAX_CHANNELS) adc_pipelines[index] = callback;
+}
+
+/*
+
+adc_sequence_encode():
+	Kanal tablosunu ADC register değerlerine çevirir; donanıma dokunmadığı için bilgisayarda doğrulanabilir.
+	SQR3 → 1.-6. dönüşümün kanalı (her biri 5 bit), SQR2 → 7.-12., SQR1 → 13.-16. ve L alanı (bit 23:20 = sayı - 1).
+	SMPR2 → kanal 0-9, SMPR1 → kanal 10-18 için 3'er bitlik örnekleme süresi. Örnekleme süresi kanala aittir, sıraya değil;
+	bu yüzden aynı kanal sırada iki kez farklı sürelerle geçerse hata döner.
+
+adc1_scan_config():
+	Tabloyu saklar ve kanal pinlerini analog moda alır. Dikkat: PA1 (RS) ve PA3 (E) LCD'ye, PA2 boşta bırakılmıştır;
+	kanal 1-3 LCD ile birlikte kullanılamaz. Kanal 0 (PA0) MQ2'dir, ek sensörler için PA4-PA7, PB0-PB1 veya PC0-PC5 kullanılabilir.
+
+*/
+
+void adc1_stream_start(adc_block_callback_t callback) {
+    adc_sequence_regs_t regs;
+
+    adc_pipelines[0] = callback;
+    adc_sequence_encode(adc_scan_table, adc_scan_count, &regs);
+    adc_stream_half = (ADC_STREAM_BLOCK / adc_scan_count) * adc_scan_count;    // Her yarı tam sayıda sıra içermeli
+
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA2EN;                // DMA2 clock'unu aktif et
+
+    DMA2_Stream0->CR &= ~DMA_SxCR_EN;                  // Stream'i kapat
+    while (DMA2_Stream0->CR & DMA_SxCR_EN);            // Kapanana kadar bekle (register'lar ancak o zaman yazılabilir)
+    DMA2->LIFCR = DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTEIF0 |
+                  DMA_LIFCR_CDMEIF0 | DMA_LIFCR_CFEIF0; // Stream0'ın eski bayraklarını temizle
+
+    DMA2_Stream0->PAR  = (uint32_t)&ADC1->DR;          // Kaynak: ADC veri register'ı
+    DMA2_Stream0->M0AR = (uint32_t)adc_dma_buffer;     // Hedef: çift tampon
+    DMA2_Stream0->NDTR = 2 * adc_stream_half;          // Toplam örnek sayısı (iki yarı)
+    adc_stream_wrapped = 0;                            // Tamponun ikinci yarısı henüz yazılmadı
+    DMA2_Stream0->CR   = (0 << DMA_SxCR_CHSEL_Pos) |   // Kanal 0 = ADC1
+                         DMA_SxCR_PL_1 |               // Yüksek öncelik
+                         DMA_SxCR_MSIZE_0 |            // Bellek tarafı 16-bit
+                         DMA_SxCR_PSIZE_0 |            // Çevre birimi tarafı 16-bit
+                         DMA_SxCR_MINC |               // Her örnekte bellek adresini artır
+                         DMA_SxCR_CIRC |               // Sona gelince başa dön (dairesel)
+                         DMA_SxCR_HTIE |               // Yarım transfer kesmesi
+                         DMA_SxCR_TCIE |               // Tam transfer kesmesi
+                         DMA_SxCR_TEIE;                // Transfer hatası kesmesi
+    DMA2_Stream0->CR  |= DMA_SxCR_EN;                  // Stream'i başlat
+
+    NVIC_EnableIRQ(DMA2_Stream0_IRQn);
+
+    ADC1->SMPR1 = regs.smpr1;                                           // Kanal başına örnekleme süreleri
+    ADC1->SMPR2 = regs.smpr2;
+    ADC1->SQR1  = regs.sqr1;                                            // Sıra uzunluğu ve kanalları
+    ADC1->SQR2  = regs.sqr2;
+    ADC1->SQR3  = regs.sqr3;
+    ADC1->SR    = ~(ADC_SR_EOC | ADC_SR_OVR);                           // Önceki akış DMA hatasıyla durduysa OVR kalmış olabilir
+    if (adc_scan_count > 1) {
+        ADC1->CR1 |= ADC_CR1_SCAN;                                      // Tek tetikte bütün sırayı dönüştür
+    } else {
+        ADC1->CR1 &= ~ADC_CR1_SCAN;
+    }
+    adc_streaming = 1;
+
+    if (adc_sample_rate_hz) {
+        ADC1->CR2 |= ADC_CR2_DMA | ADC_CR2_DDS;                         // Dönüşümleri TIM3 başlatır
+    } else {
+        ADC1->CR2 |= ADC_CR2_DMA | ADC_CR2_DDS | ADC_CR2_CONT;          // DMA isteği, sürekli DMA, sürekli dönüşüm
+        ADC1->CR2 |= ADC_CR2_SWSTART;                                   // İlk dönüşümü başlat, gerisi kendiliğinden gelir
+    }
+}
+
+void adc1_stream_stop(void) {
+    ADC1->CR2 &= ~(ADC_CR2_CONT | ADC_CR2_DMA | ADC_CR2_DDS);          // Sürekli dönüşümü ve DMA isteğini kapat
+    DMA2_Stream0->CR &= ~DMA_SxCR_EN;
+    while (DMA2_Stream0->CR & DMA_SxCR_EN);
+    NVIC_DisableIRQ(DMA2_Stream0_IRQn);
+    adc_streaming = 0;
+}
+
+RAMFUNC static void adc_dispatch(const uint16_t* block) {
+    if (adc_scan_count == 1) {                                          // Tek kanal: ayrıştırmaya gerek yok
+        if (adc_pipelines[0]) adc_pipelines[0](block, adc_stream_half);
+        return;
+    }
+
+    uint16_t per_channel = adc_stream_half / adc_scan_count;
+
+    for (uint8_t k = 0; k < adc_scan_count; k++) {                      // Örnekler kanal kanal sıralanmış: c0 c1 c2 c0 c1 c2 ...
+        if (!adc_pipelines[k]) continue;
+        for (uint16_t i = 0; i < per_channel; i++) {
+            adc_channel_scratch[i] = block[i * adc_scan_count + k];
+        }
+        adc_pipelines[k](adc_channel_scratch, per_channel);
+    }
+}
+
+uint16_t adc1_read_index(uint8_t index) {
+    if (index >= adc_scan_count) return ADC_NOT_READY;                 // Sırada böyle bir kanal yok: 0 geçerli bir örnek sanılırdı
+
+    uint8_t wrapped = adc_stream_wrapped;                               // NDTR'den önce oku: arada TC olursa sadece bir kez fazladan "hazır değil"
+    uint32_t total = 2 * adc_stream_half;
+    uint32_t next = total - DMA2_Stream0->NDTR;                         // DMA'nın bir sonraki yazacağı indeks
+    uint32_t seq_start = next - (next % adc_scan_count);                // Devam eden sıranın başı
+    uint32_t pos = seq_start + index;
+
+    if (pos >= next) {                                                  // Bu sırada henüz dönüştürülmedi: bir önceki sıra
+        if (seq_start == 0 && !wrapped) return ADC_NOT_READY;           // Önceki sıra tamponun sonunda, orası hiç yazılmadı
+        pos = (pos + total - adc_scan_count) % total;
+    }
+    return adc_dma_buffer[pos];
+}
+
+uint32_t adc1_dma_errors(void) {
+    return adc_dma_errors;
+}
+
+RAMFUNC void DMA2_Stream0_IRQHandler(void) {
+    PROF_BEGIN(isr_adc_dma);
+    uint32_t flags = DMA2->LISR;
+
+    if (flags & DMA_LISR_HTIF0) {                                       // İlk yarı doldu, DMA ikinci yarıya yazıyor
+        DMA2->LIFCR = DMA_LIFCR_CHTIF0;
+        adc_block_cycles = timebase_cycles();
+        adc_dispatch((const uint16_t*)&adc_dma_buffer[0]);
+    }
+
+    if (flags & DMA_LISR_TCIF0) {                                       // İkinci yarı doldu, DMA başa döndü
+        DMA2->LIFCR = DMA_LIFCR_CTCIF0;
+        adc_stream_wrapped = 1;
+        adc_block_cycles = timebase_cycles();
+        adc_dispatch((const uint16_t*)&adc_dma_buffer[adc_stream_half]);
+    }
+
+    if (flags & DMA_LISR_TEIF0) {
+        DMA2->LIFCR = DMA_LIFCR_CTEIF0;
+        adc_dma_errors++;
+    }
+    PROF_END(isr_adc_dma);
+}
+
+/*
+
+Amaç: CPU'yu her örnekte meşgul etmeden ADC1'den sürekli örnek almak.
+
+Çift tampon (double buffer / ping-pong):
+	adc_dma_buffer iki yarıdan oluşur. DMA dairesel modda tamponun tamamını baştan sona doldurur ve başa döner.
+	Birinci yarı dolunca HTIF (Half Transfer) kesmesi gelir: DMA o sırada ikinci yarıya yazdığı için birinci yarı güvenle işlenebilir.
+	İkinci yarı dolunca TCIF (Transfer Complete) kesmesi gelir: bu kez ikinci yarı işlenir.
+	Callback'in bir yarıyı, DMA diğer yarıyı doldurmadan (ADC_STREAM_BLOCK örnek süresi içinde) bitirmesi gerekir.
+
+ADC_CR2_DDS:
+	Son transferden sonra da DMA isteği üretmeye devam eder; dairesel modda bu bit olmadan ADC ilk turdan sonra durur.
+
+ADC_CR2_CONT:
+	Her dönüşüm bittiğinde bir sonrakini otomatik başlatır. 480 cycle örnekleme + 12 cycle dönüşüm ile
+	ADCCLK = 36 MHz (PCLK2 / 2) için yaklaşık 73 kSps elde edilir; her yarım tampon ~1.75 ms'de bir dolar.
+
+adc1_read():
+	Akış açıkken NDTR (kalan transfer sayısı) register'ından DMA'nın nerede olduğu bulunur ve son yazılan örnek döndürülür.
+	Böylece eski kodu değiştirmeden adc1_read() beklemesiz hale gelir.
+	Akış yeni başladıysa istenen kanal henüz hiç dönüştürülmemiş olabilir; o zaman "bir önceki sıra" tamponun sonundadır
+	ve DMA oraya daha yazmamıştır. Bu durumda ADC_NOT_READY (12-bit ADC'nin üretemeyeceği 0xFFFF) döner; tampon bir kez
+	dolup başa dönünce (ilk TC) her kanalın en az bir örneği vardır ve bu bir daha olmaz.
+	adc1_read_index() sıranın dışındaki bir indeks için de ADC_NOT_READY döndürür; 0 gerçek bir ölçüm (0 V) olabilir.
+
+adc_dma_errors:
+	Sadece bu dosyada, DMA kesmesinde artar; diğer modüller adc1_dma_errors() ile okur.
+
+Çok kanallı tarama:
+	adc1_scan_config() ile birden fazla kanal verilmişse, tek tetik (timer veya CONT) bütün sırayı dönüştürür ve DMA
+	sonuçları sırayla (c0 c1 c2 c0 c1 c2 ...) tampona yazar. Yarım tampon her zaman kanal sayısının katı olacak şekilde kısaltılır.
+	adc_dispatch() her kanalın örneklerini ayrı bir diziye toplar ve o kanala kayıtlı fonksiyona verir; böylece her sensörün
+	kendi filtre / kalibrasyon hattı olur. N sensör için N ayrı yazılım tetiklemeli dönüşüm yerine tek bir sıra yeterlidir.
+
+Yerleşim:
+	DMA2_Stream0_IRQHandler ve adc_dispatch RAMFUNC'tur (SRAM), kanal callback'leri ise çağıranın yerleştirdiği yerdedir
+	(main.c'deki hat flash'ta). Kesmenin tamamı SRAM'de çalışmaz; flash sektörü silinirken bu kesme kapalı tutulur (flash.c)
+	ve o sürenin blokları işlenmez.
+
+*/
+
+uint8_t adc_timer_calc(uint32_t timer_clk, uint32_t hz, uint16_t* psc, uint16_t* arr) {
+    if (hz == 0 || hz > timer_clk / 2) return 1;                    // En az 2 tick'lik periyot gerekir
+
+    uint32_t ticks = (timer_clk + hz / 2) / hz;                     // Bir örnek periyodundaki timer tick sayısı (yuvarlanmış)
+    uint32_t prescaler = (ticks - 1) / 65536;                       // ARR 16 bite sığacak en küçük bölücü (PSC + 1 = prescaler + 1)
+    if (prescaler > 0xFFFF) return 1;                               // Çok düşük hız, 16-bit PSC yetmez
+
+    uint32_t reload = (ticks + (prescaler + 1) / 2) / (prescaler + 1);
+    if (reload < 2) reload = 2;
+    if (reload > 65536) reload = 65536;
+
+    *psc = (uint16_t)prescaler;
+    *arr = (uint16_t)(reload - 1);
+    return 0;
+}
+
+uint32_t adc1_set_sample_rate(uint32_t hz) {
+    uint16_t psc, arr;
+
+    if (adc_timer_calc(ADC_TRIGGER_TIMER_CLK, hz, &psc, &arr)) {
+        return 0;
+    }
+
+    RCC->APB1ENR |= RCC_APB1ENR_TIM3EN;                             // TIM3 clock'unu aktif et
+
+    TIM3->CR1 = 0;                                                  // Ayar sırasında timer'ı durdur
+    TIM3->PSC = psc;
+    TIM3->ARR = arr;
+    TIM3->CR2 = (TIM3->CR2 & ~TIM_CR2_MMS) | TIM_CR2_MMS_1;         // MMS = 010: update olayı TRGO çıkışına verilir
+    TIM3->EGR = TIM_EGR_UG;                                         // PSC/ARR'yi hemen yükle
+
+    ADC1->CR2 &= ~(ADC_CR2_CONT | ADC_CR2_EXTSEL | ADC_CR2_EXTEN);  // Sürekli modu kapat, eski tetik ayarını temizle
+    ADC1->CR2 |= (ADC_EXTSEL_TIM3_TRGO << ADC_CR2_EXTSEL_Pos) |     // Tetik kaynağı: TIM3 TRGO
+                 ADC_CR2_EXTEN_0;                                   // Yükselen kenarda dönüşüm başlat
+
+    TIM3->CR1 = TIM_CR1_CEN;                                        // Timer'ı başlat
+
+    adc_sample_rate_hz = ADC_TRIGGER_TIMER_CLK / (((uint32_t)psc + 1) * ((uint32_t)arr + 1));
+    return adc_sample_rate_hz;
+}
+
+uint64_t adc1_block_time(void) {
+    return adc_block_cycles;
+}
+
+uint32_t adc1_get_sample_rate(void) {
+    return adc_sample_rate_hz;
+}
+
+/*
+
+Amaç: Örnekleme hızını ana döngünün gecikmelerinden bağımsız, sabit ve bilinen bir değere oturtmak.
+
+Neden:
+	Eskiden örnekleme hızı, döngüdeki delay_ms() ve LCD yazımlarının toplamına bağlıydı; ekran ne kadar meşgulse o kadar değişiyordu.
+	Sayısal filtreler ve yükselme hızı (rate-of-rise) hesapları örnekler arası sürenin sabit olduğunu varsayar.
+	Timer ile tetiklenince n. örneğin zamanı doğrudan n / hz olur, ayrıca zaman damgası tutmaya gerek kalmaz.
+
+adc_timer_calc():
+	ticks = timer_clk / hz → bir periyottaki tick sayısı (en yakın tam sayıya yuvarlanır).
+	TIM3'ün PSC ve ARR register'ları 16 bittir. ARR'ye sığması için ticks, (PSC + 1)'e bölünür;
+	en küçük PSC seçilir ki çözünürlük (ve dolayısıyla frekans doğruluğu) en yüksek olsun.
+	Örnek (168 MHz, TIM3 saati 84 MHz): 1 kHz → ticks = 84000 → PSC = 1, ARR = 41999 → tam 1000 Hz.
+	                10 Hz → ticks = 8.4 M → PSC = 128, ARR = 65115 → ≈ 9.99995 Hz.
+	Fonksiyon donanıma dokunmaz; hesap bilgisayarda da kontrol edilebilir.
+
+TIM3->CR2 MMS = 010:
+	Timer her taşmada (update) TRGO çıkışında darbe üretir. ADC bu darbeyi EXTSEL = TIM3_TRGO ile dinler.
+
+Dikkat:
+	Periyot, örnekleme + dönüşüm süresinden (480 + 12 cycle / 21 MHz ≈ 23.4 µs, 168 MHz'de) uzun olmalıdır; yani hız ≈ 40 kHz'i aşmamalıdır.
+	Hız ayarlanmışsa adc1_stream_start() CONT modunu açmaz ve SWSTART göndermez; dönüşümleri sadece timer başlatır.
+
+*/
+
 //-------------------------------------------------------------------------------------------------------------------------------------------------
 
 /*
@@ -0,0 +1,296 @@
+#include <stdint.h>
+#include "flash.h"
+#include "mq2_ppm.h"
+#include "mq2_calib.h"
+#include "telemetry_frame.h"
+
+#define MQ2_CALIB_RECORD_SIZE   8                       // Kayıt: R0 | seq (16 bit), CRC16 (16 bit)
+#define MQ2_CALIB_ERASED        0xFFFFFFFFU
+
+static mq2_calib_state_t calib_state = MQ2_CALIB_WARMUP;
+static uint32_t calib_update_mhz;                       // mq2_calib_update() çağrılma hızı (mHz)
+static uint32_t calib_window_sum;                       // Mevcut 1 sn'lik pencerenin toplamı
+static uint32_t calib_window_count;
+static uint32_t calib_window_phase;                     // Pencerede geçen süre: örnek başına 1000, hız (mHz) kadar olunca 1 sn
+static uint16_t calib_prev_mean;                        // Önceki pencerenin ortalaması
+static uint16_t calib_stable_windows;                   // Ardışık kararlı pencere sayısı
+static uint16_t calib_stable_ref;                       // Kararlı serinin başladığı pencerenin ortalaması
+static uint32_t calib_elapsed_s;                        // Açılıştan beri geçen süre (pencere sayısı)
+static uint8_t  calib_has_r0;
+static uint32_t calib_r0;                               // Takip edilen R0 / RL, Q16
+static int64_t  calib_r0_acc;                           // calib_r0 << MQ2_CALIB_TRACK_SHIFT: ortalamanın kesir bitleri kaybolmaz
+static uint32_t calib_saved_r0;                         // Flash'taki son değer
+static uint32_t calib_last_save_s;
+static volatile uint8_t calib_save_pending;             // ISR'dan ana döngüye "flash'a yaz" isteği
+static uint8_t  calib_active;                           // Kayıtların eklendiği sektör (FLASH_SECTOR_CALIB_FIRST'e göre indeks)
+static uint8_t  calib_spare_blank;                      // Diğer sektör silinmiş ve kullanıma hazır
+static uint32_t calib_next_slot;                        // Aktif sektörde bir sonraki boş kayıt adresi
+static uint16_t calib_seq;                              // Son geçerli kaydın sıra numarası
+
+static uint32_t calib_base(uint8_t index)
+{
+    return flash_sector_address(FLASH_SECTOR_CALIB_FIRST + index);
+}
+
+static uint32_t calib_end(uint8_t index)
+{
+    return calib_base(index) + flash_sector_size(FLASH_SECTOR_CALIB_FIRST + index);
+}
+
+static uint16_t calib_crc(uint32_t r0, uint16_t seq)
+{
+    uint8_t raw[6] = { (uint8_t)r0, (uint8_t)(r0 >> 8), (uint8_t)(r0 >> 16), (uint8_t)(r0 >> 24), (uint8_t)seq, (uint8_t)(seq >> 8) };
+
+    return telemetry_crc16(raw, sizeof(raw));
+}
+
+typedef struct {
+    uint8_t  found;                                     // Sektörde en az bir geçerli kayıt var
+    uint16_t seq;                                       // Son geçerli kaydın sırası
+    uint32_t r0;
+    uint32_t next;                                      // İlk silinmiş slot (dolu sektörde calib_end)
+    uint8_t  blank;                                     // Bütün sektör silinmiş
+} calib_scan_t;
+
+static void calib_scan(uint8_t index, calib_scan_t* scan)
+{
+    uint32_t end = calib_end(index);
+    uint32_t addr;
+
+    scan->found = 0;
+    scan->next = end;
+    for (addr = calib_base(index); addr + MQ2_CALIB_RECORD_SIZE <= end; addr += MQ2_CALIB_RECORD_SIZE) {
+        uint32_t r0 = flash_read_word(addr);
+        uint32_t check = flash_read_word(addr + 4);
+
+        if (r0 == MQ2_CALIB_ERASED && check == MQ2_CALIB_ERASED) {
+            break;                                      // İlk boş slot: kayıtların sonu
+        }
+        if ((check >> 16) == calib_crc(r0, (uint16_t)check) && r0 != 0) {     // Yarım kalmış (güç kesintisi) kayıtları atla
+            scan->found = 1;
+            scan->seq = (uint16_t)check;
+            scan->r0 = r0;
+        }
+    }
+    scan->next = addr;
+
+    scan->blank = (addr == calib_base(index));
+    for (; scan->blank && addr < end; addr += 4) {      // Yarım kalan silme işleminden kalıntı olmamalı
+        if (flash_read_word(addr) != MQ2_CALIB_ERASED) scan->blank = 0;
+    }
+}
+
+static void calib_load(void)
+{
+    calib_scan_t scan[FLASH_SECTOR_CALIB_COUNT];
+
+    for (uint8_t i = 0; i < FLASH_SECTOR_CALIB_COUNT; i++) {
+        calib_scan(i, &scan[i]);
+    }
+
+    calib_active = 0;
+    if (scan[1].found && (!scan[0].found || (int16_t)(scan[1].seq - scan[0].seq) > 0)) {
+        calib_active = 1;                               // Sıra numarası taşmaya dayanıklı karşılaştırılır
+    }
+
+    uint8_t spare = calib_active ^ 1;
+    calib_has_r0 = scan[calib_active].found;
+    calib_r0 = calib_has_r0 ? scan[calib_active].r0 : 0;
+    calib_seq = calib_has_r0 ? scan[calib_active].seq : 0;
+    calib_next_slot = scan[calib_active].next;
+    calib_saved_r0 = calib_r0;
+    calib_r0_acc = (int64_t)calib_r0 << MQ2_CALIB_TRACK_SHIFT;
+
+    flash_unlock();
+    if (!calib_has_r0 && !scan[calib_active].blank &&
+        flash_erase_sector(FLASH_SECTOR_CALIB_FIRST + calib_active) == 0) {   // Kayıt yok, çöp var: baştan başla
+        calib_next_slot = calib_base(calib_active);
+    }
+    calib_spare_blank = scan[spare].blank;
+    if (!calib_spare_blank) {                                                 // Eski kayıtlar: aktif sektörde yenisi var
+        calib_spare_blank = (flash_erase_sector(FLASH_SECTOR_CALIB_FIRST + spare) == 0);
+    }
+    flash_lock();
+}
+
+void mq2_calib_init(uint32_t update_mhz)
+{
+    calib_update_mhz = update_mhz ? update_mhz : 1000;
+    calib_state = MQ2_CALIB_WARMUP;
+    calib_window_sum = 0;
+    calib_window_count = 0;
+    calib_window_phase = 0;
+    calib_prev_mean = 0;
+    calib_stable_windows = 0;
+    calib_stable_ref = 0;
+    calib_elapsed_s = 0;
+    calib_last_save_s = 0;
+    calib_save_pending = 0;
+
+    calib_load();
+    if (calib_has_r0) {
+        mq2_set_r0(calib_r0);                           // Önceki çalışmadan öğrenilen R0 ile hemen başla
+    }
+}
+
+/*
+
+Kayıt formatı:
+	FLASH_SECTOR_CALIB_FIRST'ten başlayan iki sektörden biri aktiftir; kayıtlar aktif sektöre art arda eklenir:
+	{ R0, seq | CRC16 << 16 }. CRC (telemetry_crc16) R0 ve 16 bitlik seq üzerinden hesaplanır ve ikinci kelimeyle birlikte en son
+	yazılır. Açılışta iki sektör de taranır; her sektörün CRC'si tutan son kaydı bulunur, seq'i daha yeni olan (taşmaya dayanıklı,
+	int16_t farkı) R0'ı verir. Programlama yarıda kesilirse CRC tutmaz, kayıt atlanır ve bir önceki değer kullanılır.
+
+Silme sadece açılışta:
+	128 KB'lık sektör silmek 1-2 saniye CPU'yu durdurur (flash'tan kod okunamaz). Bu yüzden mq2_calib_service() hiç silme yapmaz:
+	aktif sektör dolunca kayıt, önceden silinmiş yedek sektörün başına yazılır ve o sektör aktif olur. Eskisi bir sonraki açılışta,
+	mq2_calib_init() içinde silinir; bu sırada ADC akışı ve kesmeler henüz başlamamıştır ve ısıtıcı zaten dakikalarca ısınacaktır.
+	Silme yarıda kesilirse yeni R0 diğer sektörde durduğu için kaybolmaz, silme sonraki açılışta tekrarlanır.
+	Sektör başına 16384 kayıt vardır; saatte en fazla bir yazımla iki sektör resetsiz ≈ 3.7 yıl yeter. İkisi de doluysa
+	yeni değer RAM'de kullanılmaya devam eder ve bir sonraki açılıştaki silmeden sonra kaydedilir.
+
+*/
+
+static void calib_window_done(uint16_t mean)
+{
+    uint16_t diff = (mean > calib_prev_mean) ? (mean - calib_prev_mean) : (calib_prev_mean - mean);
+    calib_prev_mean = mean;
+    calib_elapsed_s++;
+
+    uint16_t run = (mean > calib_stable_ref) ? (mean - calib_stable_ref) : (calib_stable_ref - mean);
+    if (run <= MQ2_CALIB_STABLE_DELTA) {                            // Serinin ilk penceresine göre: yavaş sürünme de birikir
+        if (calib_stable_windows < 0xFFFF) calib_stable_windows++;
+    } else {
+        calib_stable_windows = 0;
+        calib_stable_ref = mean;
+    }
+
+    switch (calib_state) {
+    case MQ2_CALIB_WARMUP:
+        if (calib_elapsed_s >= MQ2_CALIB_MIN_WARMUP_S) {
+            calib_state = MQ2_CALIB_SETTLING;
+        }
+        break;
+
+    case MQ2_CALIB_SETTLING:
+        if (calib_stable_windows >= MQ2_CALIB_STABLE_WINDOWS) {
+            calib_state = MQ2_CALIB_READY;
+            if (!calib_has_r0) {                                    // İlk açılış: mevcut ortamı temiz hava kabul et
+                calib_r0 = (uint32_t)((uint64_t)mq2_rs_rl_q16(mean) * 100 / 983);   // R0 / RL = (Rs / RL) / 9.83
+                calib_r0_acc = (int64_t)calib_r0 << MQ2_CALIB_TRACK_SHIFT;
+                calib_has_r0 = 1;
+                mq2_set_r0(calib_r0);
+                calib_save_pending = 1;
+            }
+        }
+        break;
+
+    case MQ2_CALIB_READY:
+    default:
+        if (diff > MQ2_CALIB_STABLE_DELTA) {
+            break;                                                  // Değişen ortamda baz çizgisi güncellenmez
+        }
+
+        uint32_t ratio = mq2_ratio_q16(mean);                       // Mevcut R0 ile Rs / R0
+        uint32_t lo = MQ2_Q16(MQ2_CLEAN_AIR_RATIO * (100 - MQ2_CALIB_CLEAN_TOLERANCE) / 100);
+        uint32_t hi = MQ2_Q16(MQ2_CLEAN_AIR_RATIO * (100 + MQ2_CALIB_CLEAN_TOLERANCE) / 100);
+        if (ratio < lo || ratio > hi) {
+            break;                                                  // Gaz var (veya sensör bozuk): temiz hava değil
+        }
+
+        int64_t target = (int64_t)((uint64_t)mq2_rs_rl_q16(mean) * 100 / 983);
+        calib_r0_acc += target - (calib_r0_acc >> MQ2_CALIB_TRACK_SHIFT);      // Çok yavaş üstel ortalama
+        calib_r0 = (uint32_t)(calib_r0_acc >> MQ2_CALIB_TRACK_SHIFT);
+        mq2_set_r0(calib_r0);
+
+        uint32_t drift = (calib_r0 > calib_saved_r0) ? (calib_r0 - calib_saved_r0) : (calib_saved_r0 - calib_r0);
+        if (drift > calib_saved_r0 / 100 * MQ2_CALIB_SAVE_DRIFT &&
+            calib_elapsed_s - calib_last_save_s >= MQ2_CALIB_SAVE_INTERVAL_S) {
+            calib_save_pending = 1;
+        }
+        break;
+    }
+}
+
+void mq2_calib_update(uint16_t adc)
+{
+    calib_window_sum += adc;
+
+    calib_window_count++;
+    calib_window_phase += 1000;
+
+    if (calib_window_phase >= calib_update_mhz) {                   // 1 saniyelik pencere doldu
+        calib_window_done((uint16_t)(calib_window_sum / calib_window_count));
+        calib_window_phase -= calib_update_mhz;                     // Artan kesir bir sonraki pencereye kalır: saniyeler kaymaz
+        if (calib_window_phase >= calib_update_mhz) calib_window_phase = 0;     // 1 Hz'in altı: pencere > 1 sn
+        calib_window_sum = 0;
+        calib_window_count = 0;
+    }
+}
+
+/*
+
+Isınma durum makinesi:
+	WARMUP   → açılıştan itibaren en az MQ2_CALIB_MIN_WARMUP_S saniye. Isıtıcı soğukken okumalar hızla değişir.
+	SETTLING → art arda MQ2_CALIB_STABLE_WINDOWS tane 1 sn'lik pencere ortalaması, serinin ilk penceresinden en fazla
+	           MQ2_CALIB_STABLE_DELTA uzaklaşmadan kalınca READY. Sadece ardışık pencereler karşılaştırılsaydı ısıtıcının üstel
+	           oturması (τ ≈ 1 dk) saniyede 3 ADC'nin altına indiğinde, yani hedefe daha ~180 ADC varken READY olunurdu;
+	           ilk açılışta öğrenilen R0 %15'ten fazla sapar ve oran temiz hava aralığının dışında kaldığı için takip hiç düzeltemezdi.
+	READY    → sensör kararlı. Flash'ta R0 yoksa, o anki ortam temiz hava kabul edilir ve R0 bundan hesaplanır.
+
+Pencere:
+	mq2_calib_update() filtre çıkış hızında çağrılır; hız mHz olarak verilir (1 kHz / 64 = 15625 mHz). Her örnek pencereye
+	1000 ekler, toplam hıza ulaşınca 1 sn'lik pencere kapanır ve artan kısım bir sonrakine kalır. 15.625 Hz'de pencereler
+	15 veya 16 örnektir ama ortalaması tam 1 sn'dir; Hz'e yuvarlanıp 15 örnekte kapansaydı her "saniye" 0.96 sn olur,
+	ısınma ve kayıt aralıkları %4 kısalırdı.
+
+R0 takibi:
+	Sensörün temiz havadaki direnci haftalar içinde kayar. READY durumunda, pencere kararlıysa ve mevcut R0 ile hesaplanan
+	Rs/R0 temiz hava değerine (9.83) yakınsa, R0 hedef değere doğru çok yavaş (farkın 1/4096'sı kadar) çekilir.
+	Ortalama calib_r0_acc'de 12 kesir bitiyle tutulur; Q16 R0'a doğrudan >> 12 uygulansaydı 4096 LSB'den (≈ %7) küçük
+	farklar hiç kapanmaz, negatif farklar ise aritmetik kaydırma yüzünden hep -1 ile aşağı kayardı.
+	Gaz varken oran bu aralığın dışına çıkar ve baz çizgisi kirlenmez; ani sıçramalar da kararlılık şartıyla elenir.
+
+Flash yazımı:
+	Kesme içinde flash'a yazılmaz (programlama sırasında CPU durur); sadece calib_save_pending bayrağı kaldırılır,
+	asıl yazımı ana döngüdeki mq2_calib_service() yapar.
+
+*/
+
+void mq2_calib_service(void)
+{
+    if (!calib_save_pending) return;
+    calib_save_pending = 0;
+
+    uint32_t r0 = calib_r0;
+    uint16_t seq = (uint16_t)(calib_seq + 1);
+
+    if (calib_next_slot + MQ2_CALIB_RECORD_SIZE > calib_end(calib_active)) {    // Sektör dolu: yedek sektöre geç
+        if (!calib_spare_blank) return;                                        // Silme yok; bir sonraki açılışa kalır
+        calib_active ^= 1;
+        calib_spare_blank = 0;
+        calib_next_slot = calib_base(calib_active);
+    }
+
+    uint32_t slot = calib_next_slot;
+    calib_next_slot += MQ2_CALIB_RECORD_SIZE;                      // Hatalı slot da atlanır, tekrar yazılmaz
+
+    flash_unlock();
+    if (flash_program_word(slot, r0) == 0 &&
+        flash_program_word(slot + 4, seq | ((uint32_t)calib_crc(r0, seq) << 16)) == 0) {  // CRC kelimesi en son yazılır
+        calib_seq = seq;
+        calib_saved_r0 = r0;
+        calib_last_save_s = calib_elapsed_s;
+    }
+    flash_lock();
+}
+
+mq2_calib_state_t mq2_calib_state(void)
+{
+    return calib_state;
+}
+
+uint8_t mq2_calib_has_r0(void)
+{
+    return calib_has_r0;
+}
@@ -0,0 +1,268 @@
+#include <stdint.h>
+#include "mq2_ppm.h"
+
+/*
+
+Derleme anında log2 hesabı:
+	Gaz eğrileri datasheet'teki (ppm, Rs/R0) noktaları olarak yazılır; log-log uzayındaki değerleri ve segment eğimleri
+	aşağıdaki makrolarla derleyici tarafından hesaplanır. Makrolar sadece sabit sayılarla çalışır, kod üretmez, libm gerektirmez.
+	x = 2^e · m (1 <= m < 2) ayrıştırması ?: zinciriyle, ln(m) ise t = (m - 1) / (m + 1) serisiyle (t <= 1/3, hata < 1e-6) bulunur.
+	Geçerli aralık: 2^-5 <= x < 2^15.
+
+*/
+
+#define MQ2_MANT_(x)  ( \
+    (x) >= 16384 ? (x) / 16384.0 : \
+    (x) >= 8192 ? (x) / 8192.0 : \
+    (x) >= 4096 ? (x) / 4096.0 : \
+    (x) >= 2048 ? (x) / 2048.0 : \
+    (x) >= 1024 ? (x) / 1024.0 : \
+    (x) >= 512 ? (x) / 512.0 : \
+    (x) >= 256 ? (x) / 256.0 : \
+    (x) >= 128 ? (x) / 128.0 : \
+    (x) >= 64 ? (x) / 64.0 : \
+    (x) >= 32 ? (x) / 32.0 : \
+    (x) >= 16 ? (x) / 16.0 : \
+    (x) >= 8 ? (x) / 8.0 : \
+    (x) >= 4 ? (x) / 4.0 : \
+    (x) >= 2 ? (x) / 2.0 : \
+    (x) >= 1 ? (x) / 1.0 : \
+    (x) >= 0.5 ? (x) / 0.5 : \
+    (x) >= 0.25 ? (x) / 0.25 : \
+    (x) >= 0.125 ? (x) / 0.125 : \
+    (x) >= 0.0625 ? (x) / 0.0625 : \
+    (x) >= 0.03125 ? (x) / 0.03125 : \
+    (x) / 0.03125)
+
+#define MQ2_EXPO_(x)  ( \
+    (x) >= 16384 ? 14 : \
+    (x) >= 8192 ? 13 : \
+    (x) >= 4096 ? 12 : \
+    (x) >= 2048 ? 11 : \
+    (x) >= 1024 ? 10 : \
+    (x) >= 512 ? 9 : \
+    (x) >= 256 ? 8 : \
+    (x) >= 128 ? 7 : \
+    (x) >= 64 ? 6 : \
+    (x) >= 32 ? 5 : \
+    (x) >= 16 ? 4 : \
+    (x) >= 8 ? 3 : \
+    (x) >= 4 ? 2 : \
+    (x) >= 2 ? 1 : \
+    (x) >= 1 ? 0 : \
+    (x) >= 0.5 ? -1 : \
+    (x) >= 0.25 ? -2 : \
+    (x) >= 0.125 ? -3 : \
+    (x) >= 0.0625 ? -4 : \
+    (x) >= 0.03125 ? -5 : \
+    -5)
+
+#define MQ2_T_(m)       (((m) - 1.0) / ((m) + 1.0))
+#define MQ2_LN_T_(t)    (2.0 * (t) * (1.0 + (t) * (t) * (1.0 / 3 + (t) * (t) * (1.0 / 5 + (t) * (t) * (1.0 / 7 + (t) * (t) / 9.0)))))
+#define MQ2_LN2         0.69314718055994531
+#define MQ2_LOG2F(x)    (MQ2_EXPO_(x) + MQ2_LN_T_(MQ2_T_(MQ2_MANT_(x))) / MQ2_LN2)
+
+#define MQ2_EXP_(u)     (1.0 + (u) * (1.0 + (u) / 2 * (1.0 + (u) / 3 * (1.0 + (u) / 4 * (1.0 + (u) / 5 * \
+                        (1.0 + (u) / 6 * (1.0 + (u) / 7 * (1.0 + (u) / 8 * (1.0 + (u) / 9 * (1.0 + (u) / 10))))))))))
+
+#define MQ2_LOG2_TAB_(i)    ((uint32_t)MQ2_Q16(MQ2_LN_T_(MQ2_T_(1.0 + (i) / 32.0)) / MQ2_LN2))      // log2(1 + i/32), Q16
+#define MQ2_EXP2_TAB_(i)    ((uint32_t)(MQ2_EXP_((i) / 32.0 * MQ2_LN2) * 1073741824.0 + 0.5))     // 2^(i/32), Q30
+
+static const uint32_t mq2_log2_table[33] = {
+    MQ2_LOG2_TAB_(0), MQ2_LOG2_TAB_(1), MQ2_LOG2_TAB_(2), MQ2_LOG2_TAB_(3),
+    MQ2_LOG2_TAB_(4), MQ2_LOG2_TAB_(5), MQ2_LOG2_TAB_(6), MQ2_LOG2_TAB_(7),
+    MQ2_LOG2_TAB_(8), MQ2_LOG2_TAB_(9), MQ2_LOG2_TAB_(10), MQ2_LOG2_TAB_(11),
+    MQ2_LOG2_TAB_(12), MQ2_LOG2_TAB_(13), MQ2_LOG2_TAB_(14), MQ2_LOG2_TAB_(15),
+    MQ2_LOG2_TAB_(16), MQ2_LOG2_TAB_(17), MQ2_LOG2_TAB_(18), MQ2_LOG2_TAB_(19),
+    MQ2_LOG2_TAB_(20), MQ2_LOG2_TAB_(21), MQ2_LOG2_TAB_(22), MQ2_LOG2_TAB_(23),
+    MQ2_LOG2_TAB_(24), MQ2_LOG2_TAB_(25), MQ2_LOG2_TAB_(26), MQ2_LOG2_TAB_(27),
+    MQ2_LOG2_TAB_(28), MQ2_LOG2_TAB_(29), MQ2_LOG2_TAB_(30), MQ2_LOG2_TAB_(31),
+    MQ2_LOG2_TAB_(32)
+};
+
+static const uint32_t mq2_exp2_table[33] = {
+    MQ2_EXP2_TAB_(0), MQ2_EXP2_TAB_(1), MQ2_EXP2_TAB_(2), MQ2_EXP2_TAB_(3),
+    MQ2_EXP2_TAB_(4), MQ2_EXP2_TAB_(5), MQ2_EXP2_TAB_(6), MQ2_EXP2_TAB_(7),
+    MQ2_EXP2_TAB_(8), MQ2_EXP2_TAB_(9), MQ2_EXP2_TAB_(10), MQ2_EXP2_TAB_(11),
+    MQ2_EXP2_TAB_(12), MQ2_EXP2_TAB_(13), MQ2_EXP2_TAB_(14), MQ2_EXP2_TAB_(15),
+    MQ2_EXP2_TAB_(16), MQ2_EXP2_TAB_(17), MQ2_EXP2_TAB_(18), MQ2_EXP2_TAB_(19),
+    MQ2_EXP2_TAB_(20), MQ2_EXP2_TAB_(21), MQ2_EXP2_TAB_(22), MQ2_EXP2_TAB_(23),
+    MQ2_EXP2_TAB_(24), MQ2_EXP2_TAB_(25), MQ2_EXP2_TAB_(26), MQ2_EXP2_TAB_(27),
+    MQ2_EXP2_TAB_(28), MQ2_EXP2_TAB_(29), MQ2_EXP2_TAB_(30), MQ2_EXP2_TAB_(31),
+    MQ2_EXP2_TAB_(32)
+};
+
+int32_t mq2_log2_q16(uint32_t x)
+{
+    if (x == 0) return INT32_MIN;                       // log2(0) tanımsız, en küçük değer döner
+
+    uint32_t e = 31 - (uint32_t)__builtin_clz(x);       // En yüksek 1 bitinin yeri (Cortex-M4'te tek CLZ komutu)
+    uint32_t norm = x << (31 - e);                      // Mantisi 1.xxx biçiminde 31. bite hizala
+    uint32_t idx = (norm >> 26) & 31;                   // Mantisin ilk 5 kesir biti → tablo indeksi
+    uint32_t frac = (norm >> 10) & 0xFFFF;              // Sonraki 16 bit → doğrusal ara değer
+
+    uint32_t l = mq2_log2_table[idx] + (((mq2_log2_table[idx + 1] - mq2_log2_table[idx]) * frac) >> 16);
+
+    return (int32_t)((e << 16) + l);
+}
+
+uint32_t mq2_exp2_q16(int32_t y)
+{
+    int32_t n = y >> 16;                                // Tam kısım (aritmetik kaydırma: negatifte aşağı yuvarlar)
+    uint32_t f = (uint32_t)y & 0xFFFF;                  // Kesir kısmı
+    uint32_t idx = f >> 11;                             // 5 bit tablo indeksi
+    uint32_t frac = f & 0x7FF;                          // 11 bit ara değer
+
+    uint64_t m = mq2_exp2_table[idx] +                  // 2^(f) Q30
+                 (((uint64_t)(mq2_exp2_table[idx + 1] - mq2_exp2_table[idx]) * frac) >> 11);
+
+    int32_t shift = n - 14;                             // Q30 → Q16 ve 2^n çarpımı tek kaydırmada
+    if (shift >= 0) {
+        if (shift > 32 || (m << shift) > 0xFFFFFFFFu) return 0xFFFFFFFFu;   // Doyum
+        return (uint32_t)(m << shift);
+    }
+    if (shift < -62) return 0;
+    return (uint32_t)(m >> -shift);
+}
+
+/*
+
+mq2_log2_q16() / mq2_exp2_q16():
+	powf / logf yerine tam sayı aritmetiği ile çalışır. log2 için CLZ ile üs bulunur, mantisin log2'si 33 elemanlı tablodan
+	doğrusal ara değerle okunur (hata < 2e-4). exp2 için tam kısım kaydırmaya, kesir kısmı yine 33 elemanlı tabloya gider.
+	Her iki tablo da derleme anında yukarıdaki sabit makrolarla hesaplanır.
+
+*/
+
+// Datasheet (Hanwei MQ-2, Şekil 3) eğrilerinden okunan noktalar: ppm, Rs/R0
+#define MQ2_LPG_0       200,   1.60
+#define MQ2_LPG_1       500,   1.15
+#define MQ2_LPG_2       1000,  0.85
+#define MQ2_LPG_3       2000,  0.62
+#define MQ2_LPG_4       5000,  0.41
+#define MQ2_LPG_5       10000, 0.28
+
+#define MQ2_CO_0        200,   5.10
+#define MQ2_CO_1        500,   3.90
+#define MQ2_CO_2        1000,  3.00
+#define MQ2_CO_3        2000,  2.35
+#define MQ2_CO_4        5000,  1.60
+#define MQ2_CO_5        10000, 1.30
+
+#define MQ2_SMOKE_0     200,   3.40
+#define MQ2_SMOKE_1     500,   2.50
+#define MQ2_SMOKE_2     1000,  1.95
+#define MQ2_SMOKE_3     2000,  1.50
+#define MQ2_SMOKE_4     5000,  0.95
+#define MQ2_SMOKE_5     10000, 0.62
+
+#define MQ2_H2_0        200,   2.10
+#define MQ2_H2_1        500,   1.55
+#define MQ2_H2_2        1000,  1.20
+#define MQ2_H2_3        2000,  0.92
+#define MQ2_H2_4        5000,  0.60
+#define MQ2_H2_5        10000, 0.36
+
+#define MQ2_CURVE_SEGMENTS  5
+
+typedef struct {
+    int32_t log2_ratio;         // Segment başlangıcı: log2(Rs/R0), Q16
+    int32_t log2_ppm;           // Segment başlangıcı: log2(ppm), Q16
+    int32_t slope;              // d log2(ppm) / d log2(Rs/R0), Q16
+} mq2_segment_t;
+
+#define MQ2_SEG_(ppm0, r0, ppm1, r1) \
+    { MQ2_Q16(MQ2_LOG2F(r0)), MQ2_Q16(MQ2_LOG2F(ppm0)), \
+      MQ2_Q16((MQ2_LOG2F(ppm1) - MQ2_LOG2F(ppm0)) / (MQ2_LOG2F(r1) - MQ2_LOG2F(r0))) }
+#define MQ2_SEG(a, b)   MQ2_SEG_(a, b)
+
+#define MQ2_CURVE(G) { \
+    MQ2_SEG(MQ2_##G##_0, MQ2_##G##_1), MQ2_SEG(MQ2_##G##_1, MQ2_##G##_2), MQ2_SEG(MQ2_##G##_2, MQ2_##G##_3), \
+    MQ2_SEG(MQ2_##G##_3, MQ2_##G##_4), MQ2_SEG(MQ2_##G##_4, MQ2_##G##_5) }
+
+static const mq2_segment_t mq2_curves[MQ2_GAS_COUNT][MQ2_CURVE_SEGMENTS] = {
+    [MQ2_GAS_LPG]   = MQ2_CURVE(LPG),
+    [MQ2_GAS_CO]    = MQ2_CURVE(CO),
+    [MQ2_GAS_SMOKE] = MQ2_CURVE(SMOKE),
+    [MQ2_GAS_H2]    = MQ2_CURVE(H2),
+};
+
+static uint32_t mq2_r0_rl_q16 = 65536;                  // R0 / RL (Q16); kalibrasyon yapılana kadar R0 = RL varsayılır
+static int32_t mq2_log2_r0 = 16 << 16;                  // log2(mq2_r0_rl_q16), her dönüşümde tekrar hesaplanmasın
+
+void mq2_set_r0(uint32_t r0_rl_q16)
+{
+    if (r0_rl_q16 == 0) return;
+    mq2_r0_rl_q16 = r0_rl_q16;
+    mq2_log2_r0 = mq2_log2_q16(r0_rl_q16);
+}
+
+uint32_t mq2_get_r0(void)
+{
+    return mq2_r0_rl_q16;
+}
+
+uint32_t mq2_rs_rl_q16(uint16_t adc)
+{
+    if (adc == 0) return 0xFFFFFFFFu;                   // Çıkış 0 V: Rs sonsuz
+    if (adc >= MQ2_SUPPLY_COUNTS) return 0;             // Çıkış besleme geriliminde: Rs = 0
+
+    uint32_t rs_rl = ((uint32_t)(MQ2_SUPPLY_COUNTS - adc) << 16) / adc;    // Rs / RL = (Vc - Vout) / Vout
+    return rs_rl;
+}
+
+int32_t mq2_log2_ratio_q16(uint16_t adc)
+{
+    if (adc == 0) adc = 1;                              // Uç değerleri sınırla, log2(0) oluşmasın
+    if (adc >= MQ2_SUPPLY_COUNTS) adc = MQ2_SUPPLY_COUNTS - 1;
+
+    // log2(Rs / R0) = log2(Vc - Vout) - log2(Vout) - log2(R0 / RL); bölme yok
+    return mq2_log2_q16(MQ2_SUPPLY_COUNTS - adc) - mq2_log2_q16(adc) - (mq2_log2_r0 - (16 << 16));
+}
+
+uint32_t mq2_ratio_q16(uint16_t adc)
+{
+    return mq2_exp2_q16(mq2_log2_ratio_q16(adc));
+}
+
+uint32_t mq2_ppm(uint16_t adc, mq2_gas_t gas)
+{
+    if (gas >= MQ2_GAS_COUNT) return 0;
+
+    const mq2_segment_t* seg = mq2_curves[gas];
+    int32_t r = mq2_log2_ratio_q16(adc);
+
+    uint8_t i = 0;                                      // Oran azaldıkça ppm artar; r'nin düştüğü segmenti bul
+    while (i < MQ2_CURVE_SEGMENTS - 1 && r < seg[i + 1].log2_ratio) {
+        i++;
+    }
+
+    // log2(ppm) = log2(ppm_i) + eğim · (r - log2(ratio_i)); aralık dışında uç segmentler ile uzatılır
+    int32_t log2_ppm = seg[i].log2_ppm + (int32_t)(((int64_t)(r - seg[i].log2_ratio) * seg[i].slope) >> 16);
+
+    uint32_t ppm = mq2_exp2_q16(log2_ppm - (16 << 16)); // Q16 yerine tam sayı ppm
+    return ppm > MQ2_PPM_MAX ? MQ2_PPM_MAX : ppm;
+}
+
+/*
+
+Amaç: ADC değerini gerçek bir gaz konsantrasyonuna (ppm) çevirmek.
+
+1) Rs / R0:
+	MQ2 modülünde sensör direnci Rs ile yük direnci RL bir gerilim bölücü oluşturur: Vout = Vc · RL / (Rs + RL).
+	Buradan Rs / RL = (Vc - Vout) / Vout = (MQ2_SUPPLY_COUNTS - adc) / adc.
+	R0, sensörün temiz havadaki direncinin 9.83'e bölünmüş halidir (datasheet); mq2_set_r0() ile R0 / RL olarak verilir.
+
+2) Eğri:
+	Datasheet'teki her gaz eğrisi log-log eksende neredeyse düz bir çizgidir. Noktalar arası log2 uzayında doğrusal ara değer alınır.
+	Segmentlerin başlangıç noktaları ve eğimleri derleme anında hesaplanır; çalışma anında bölme yoktur,
+	sadece bir 32×32→64 çarpma (SMULL), iki log2 ve bir exp2 tablo okuması yapılır.
+	Tablo aralığı (200-10000 ppm) dışındaki değerler uç segmentlerin doğrusu ile uzatılır.
+	Uzatma çıkışı 0 V'a yaklaşırken sınırsız büyür (adc = 4094'te LPG eğrisi milyonlarca ppm verir, exp2 0xFFFFFFFF'e doyar);
+	sonuç MQ2_PPM_MAX'te kesilir. Böylece ekrandaki 6 hanelik alan ve telemetri alanları her zaman yeter.
+
+Doğruluk:
+	log2/exp2 tablolarının hatası < 2e-4 (log2 biriminde), bu da ppm'de %0.05'ten küçük bağıl hata demektir;
+	asıl belirsizlik datasheet eğrisinden nokta okumasından ve sensörün kendisinden gelir.
+
+*/
@@ -0,0 +1,190 @@
+#include <stdint.h>
+#include <stddef.h>
+#include "prof.h"
+#include "mem_sections.h"
+
+#if PROF_ENABLE
+
+#ifndef PROF_HOST
+#include "stm32f4xx.h"
+#define PROF_LOCK()         uint32_t prof_primask = __get_PRIMASK(); __disable_irq()
+#define PROF_UNLOCK()       __set_PRIMASK(prof_primask)
+#else
+#define PROF_LOCK()         ((void)0)   // Bilgisayarda kesme yok
+#define PROF_UNLOCK()       ((void)0)
+#endif
+
+#define PROF_TRACE_MASK     (PROF_TRACE_SIZE - 1)
+
+static CCMRAM prof_trace_t prof_trace[PROF_TRACE_SIZE];
+static uint32_t prof_trace_head;                // Toplam yazılan kayıt; indeks = head & MASK
+static prof_site_t* prof_site_list;
+
+RAMFUNC static uint8_t prof_bin(uint32_t cycles)
+{
+    if (cycles == 0) return 0;
+
+    uint8_t bin = 32 - __builtin_clz(cycles);   // En yüksek bitin konumu + 1
+    return (bin >= PROF_HIST_BINS) ? (PROF_HIST_BINS - 1) : bin;
+}
+
+RAMFUNC static void prof_add(prof_site_t* site, uint32_t start, uint32_t end)    // Kilit altında çağrılır
+{
+    uint32_t cycles = end - start;              // CYCCNT taşması (168 MHz'de ~25 sn) işaretsiz farkla sorun olmaz
+
+    if (!site->registered) {
+        site->registered = 1;
+        site->min = 0xFFFFFFFF;
+        site->next = prof_site_list;
+        prof_site_list = site;
+    }
+
+    prof_trace_t* t = &prof_trace[prof_trace_head & PROF_TRACE_MASK];
+    t->site = site;
+    t->start = start;
+    t->end = end;
+    prof_trace_head++;
+
+    site->count++;
+    site->total += cycles;
+    if (cycles < site->min) site->min = cycles;
+    if (cycles > site->max) site->max = cycles;
+    site->hist[prof_bin(cycles)]++;
+}
+
+RAMFUNC void prof_record(prof_site_t* site, uint32_t start, uint32_t end)
+{
+    PROF_LOCK();                                // Aynı nokta kesmeden de çağrılabilir
+    prof_add(site, start, end);
+    PROF_UNLOCK();
+}
+
+void prof_trace_point(prof_site_t* site, uint32_t now)
+{
+    PROF_LOCK();                                // last okunup yazılırken başka bir bağlam aynı noktadan geçebilir
+    if (site->last || site->registered) {       // İlk geçişte sadece zaman tutulur
+        prof_add(site, site->last, now);
+    }
+    site->last = now ? now : 1;                 // 0 "hiç geçilmedi" anlamına gelir
+    PROF_UNLOCK();
+}
+
+void prof_reset(void)
+{
+    PROF_LOCK();
+
+    for (prof_site_t* s = prof_site_list; s; s = s->next) {
+        s->count = 0;
+        s->total = 0;
+        s->min = 0xFFFFFFFF;
+        s->max = 0;
+        for (uint8_t i = 0; i < PROF_HIST_BINS; i++) s->hist[i] = 0;
+    }
+    prof_trace_head = 0;
+
+    PROF_UNLOCK();
+}
+
+prof_site_t* prof_sites(void)
+{
+    return prof_site_list;
+}
+
+uint32_t prof_trace_count(void)
+{
+    return prof_trace_head;
+}
+
+const prof_trace_t* prof_trace_get(uint32_t age)
+{
+    if (age >= prof_trace_head || age >= PROF_TRACE_SIZE) return NULL;
+    return &prof_trace[(prof_trace_head - 1 - age) & PROF_TRACE_MASK];
+}
+
+static void prof_put_str(void (*put)(char), const char* s)
+{
+    while (*s) put(*s++);
+}
+
+static void prof_put_u32(void (*put)(char), uint32_t v)
+{
+    char digits[10];
+    uint8_t n = 0;
+
+    do {
+        digits[n++] = '0' + (v % 10);
+        v /= 10;
+    } while (v);
+
+    while (n) put(digits[--n]);
+}
+
+void prof_dump(void (*put)(char c))
+{
+    prof_put_str(put, "name count min max mean | log2 histogram\n");
+
+    for (prof_site_t* s = prof_site_list; s; s = s->next) {
+        uint32_t count = s->count;              // Yazdırılırken değişebilir; bir tutarlı kopya yeterli
+        uint32_t mean = count ? (uint32_t)(s->total / count) : 0;
+
+        prof_put_str(put, s->name);
+        put(' ');
+        prof_put_u32(put, count);
+        put(' ');
+        prof_put_u32(put, count ? s->min : 0);
+        put(' ');
+        prof_put_u32(put, s->max);
+        put(' ');
+        prof_put_u32(put, mean);
+        prof_put_str(put, " |");
+        for (uint8_t i = 0; i < PROF_HIST_BINS; i++) {
+            put(' ');
+            prof_put_u32(put, s->hist[i]);
+        }
+        put('\n');
+    }
+}
+
+#ifndef PROF_HOST
+void prof_itm_put(char c)
+{
+    ITM_SendChar((uint32_t)c);                  // Debugger bağlı değilse ITM kapalıdır ve karakter atılır
+}
+
+void prof_dump_itm(void)
+{
+    prof_dump(prof_itm_put);
+}
+#endif
+
+#endif  // PROF_ENABLE
+
+/*
+
+Amaç: Hedef üzerinde zamanın nereye gittiğini görmek. DWT_Delay_Init() zaten CYCCNT'yi açıyor, sayaç her CPU cycle'ında bir artar.
+
+Kullanım:
+	PROF_BEGIN(isim);  ...ölçülen kod...  PROF_END(isim);
+		Giriş ve çıkıştaki CYCCNT değerleri kaydedilir. Nokta (site) statik bir değişkendir ve ilk kullanımda listeye eklenir,
+		yani nokta sayısı için sabit bir sınır yoktur.
+	PROF_TRACE(isim);
+		Tek bir noktadır; ardışık iki geçiş arasındaki süre kaydedilir (ör. döngü periyodu). last'ın okunması, kaydı ve
+		güncellenmesi tek kilit altındadır; nokta birden fazla bağlamdan geçilse de her aralık bir kez sayılır.
+
+Toplama:
+	Her kayıt hem PROF_TRACE_SIZE'lık halkaya (son olayların sırası, debugger ile veya prof_trace_get() ile okunur) yazılır
+	hem de noktanın min / max / ortalama ve log2 histogramına eklenir. Histogram kutuları 2'nin kuvvetleridir:
+	kutu 7 → 64-127 cycle, kutu 10 → 512-1023 cycle. Böylece nadir uzun çalışmalar (kuyruk) ortalamanın içinde kaybolmaz.
+
+Çıktı:
+	prof_dump_itm() satır başına bir nokta yazar; SWO görüntüleyicide (ITM port 0) okunur. printf kullanılmaz,
+	sayılar prof_put_u32() ile basamak basamak yazılır.
+
+Kapalıyken:
+	PROF_ENABLE = 0 iken makrolar ((void)0) olur ve bu dosyanın içi derlenmez; ne kod ne RAM harcanır.
+
+Bilgisayarda:
+	-DPROF_ENABLE=1 -DPROF_HOST "-DPROF_CYCLES()=sahte_sayac()" ile derlenir; toplama kodu sahte sayaçla çalıştırılabilir.
+	test/test_prof.c emülatörün sanal CPU saatini (fake_cycles) kullanır.
+
+*/
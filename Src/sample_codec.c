@@ -0,0 +1,182 @@
+#include <stdint.h>
+#include "sample_codec.h"
+#include "prof.h"
+
+typedef struct {
+    uint8_t* buf;
+    uint16_t max;
+    uint16_t pos;           // Yazılan tam bayt sayısı
+    uint32_t acc;           // Henüz yazılmamış bitler (sağa yaslı)
+    uint8_t bits;
+    uint8_t overflow;
+} codec_writer_t;
+
+typedef struct {
+    const uint8_t* buf;
+    uint16_t len;
+    uint16_t pos;
+    uint32_t acc;
+    uint8_t bits;
+    uint8_t underflow;
+} codec_reader_t;
+
+static void codec_put(codec_writer_t* w, uint32_t value, uint8_t bits)     // bits ≤ 24
+{
+    w->acc = (w->acc << bits) | (value & ((1UL << bits) - 1));
+    w->bits += bits;
+    while (w->bits >= 8) {
+        w->bits -= 8;
+        if (w->pos < w->max) w->buf[w->pos++] = (uint8_t)(w->acc >> w->bits);
+        else w->overflow = 1;
+    }
+}
+
+static uint32_t codec_get(codec_reader_t* r, uint8_t bits)                 // bits ≤ 24
+{
+    while (r->bits < bits) {
+        uint8_t byte = 0;
+        if (r->pos < r->len) byte = r->buf[r->pos++];
+        else r->underflow = 1;
+        r->acc = (r->acc << 8) | byte;
+        r->bits += 8;
+    }
+    r->bits -= bits;
+    return (r->acc >> r->bits) & ((1UL << bits) - 1);
+}
+
+static int32_t codec_predict(const uint16_t* x, uint16_t i, uint8_t order)
+{
+    if (order == SAMPLE_CODEC_ORDER2 && i >= 2) {
+        return 2 * (int32_t)x[i - 1] - (int32_t)x[i - 2];
+    }
+    return x[i - 1];                                    // İkinci örnek her iki derecede de delta ile kodlanır
+}
+
+static uint32_t codec_zigzag(int32_t v)
+{
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);   // 0, -1, 1, -2 → 0, 1, 2, 3
+}
+
+static int32_t codec_unzigzag(uint32_t u)
+{
+    return (int32_t)(u >> 1) ^ -(int32_t)(u & 1);
+}
+
+static uint8_t codec_rice_k(uint32_t sum, uint16_t n)
+{
+    uint8_t k = 0;
+
+    while (k < 16 && ((uint32_t)n << (k + 1)) <= sum) k++;     // k ≈ log2(ortalama artık)
+    return k;
+}
+
+uint16_t sample_codec_encode(const uint16_t* in, uint16_t count, sample_codec_order_t order,
+                             uint8_t* out, uint16_t out_max)
+{
+    if (count == 0 || count > SAMPLE_CODEC_BLOCK_MAX || out_max < SAMPLE_CODEC_HEADER_LEN) return 0;
+    if ((uint32_t)order > SAMPLE_CODEC_ORDER2) return 0;   // Başlıkta 2 bit: 3 çözücüde bozuk blok sayılır
+
+    PROF_BEGIN(codec_encode);
+
+    uint32_t sum1 = 0, sum2 = 0;                        // 1. geçiş: iki tahminin artık büyüklüğü
+    for (uint16_t i = 1; i < count; i++) {
+        sum1 += codec_zigzag((int32_t)in[i] - codec_predict(in, i, SAMPLE_CODEC_DELTA));
+        sum2 += codec_zigzag((int32_t)in[i] - codec_predict(in, i, SAMPLE_CODEC_ORDER2));
+    }
+    if (order == SAMPLE_CODEC_AUTO) {
+        order = (sum2 < sum1) ? SAMPLE_CODEC_ORDER2 : SAMPLE_CODEC_DELTA;
+    }
+
+    uint16_t n = count - 1;
+    uint8_t k = codec_rice_k(order == SAMPLE_CODEC_ORDER2 ? sum2 : sum1, n ? n : 1);
+
+    out[0] = (uint8_t)in[0];                            // Başlık: yeniden senkronizasyon noktası
+    out[1] = (uint8_t)(in[0] >> 8);
+    out[2] = (uint8_t)(count - 1);
+    out[3] = (uint8_t)((order << 6) | k);
+
+    codec_writer_t w = { out + SAMPLE_CODEC_HEADER_LEN, (uint16_t)(out_max - SAMPLE_CODEC_HEADER_LEN), 0, 0, 0, 0 };
+
+    for (uint16_t i = 1; i < count; i++) {              // 2. geçiş: Rice kodlama
+        uint32_t u = codec_zigzag((int32_t)in[i] - codec_predict(in, i, order));
+        uint32_t q = u >> k;
+
+        if (q >= SAMPLE_CODEC_ESCAPE_Q) {               // Ani sıçrama: tekli kod çok uzun olur
+            codec_put(&w, (1UL << SAMPLE_CODEC_ESCAPE_Q) - 1, SAMPLE_CODEC_ESCAPE_Q);
+            codec_put(&w, u, SAMPLE_CODEC_RAW_BITS);
+        } else {
+            codec_put(&w, ((1UL << q) - 1) << 1, q + 1);   // q adet 1, ardından 0
+            if (k) codec_put(&w, u, k);
+        }
+        if (w.overflow) return 0;
+    }
+    if (w.bits) codec_put(&w, 0, 8 - w.bits);          // Son baytı doldur; blok bayt sınırında biter
+    if (w.overflow) return 0;
+
+    PROF_END(codec_encode);
+    return SAMPLE_CODEC_HEADER_LEN + w.pos;
+}
+
+uint16_t sample_codec_decode(const uint8_t* in, uint16_t in_len, uint16_t* out, uint16_t out_max,
+                             uint16_t* consumed)
+{
+    if (in_len < SAMPLE_CODEC_HEADER_LEN) return 0;
+
+    uint16_t count = (uint16_t)in[2] + 1;
+    uint8_t order = in[3] >> 6;
+    uint8_t k = in[3] & 0x1F;
+    if (count > out_max || k > 16 || (order != SAMPLE_CODEC_DELTA && order != SAMPLE_CODEC_ORDER2)) return 0;
+
+    out[0] = (uint16_t)(in[0] | (in[1] << 8));
+
+    codec_reader_t r = { in + SAMPLE_CODEC_HEADER_LEN, (uint16_t)(in_len - SAMPLE_CODEC_HEADER_LEN), 0, 0, 0, 0 };
+
+    for (uint16_t i = 1; i < count; i++) {
+        uint32_t q = 0;
+        uint32_t u;
+
+        while (q < SAMPLE_CODEC_ESCAPE_Q && codec_get(&r, 1)) q++;
+        if (q == SAMPLE_CODEC_ESCAPE_Q) {
+            u = codec_get(&r, SAMPLE_CODEC_RAW_BITS);
+        } else {
+            u = (q << k) | (k ? codec_get(&r, k) : 0);
+        }
+        if (r.underflow) return 0;
+
+        int32_t v = codec_predict(out, i, order) + codec_unzigzag(u);
+        if (v < 0 || v > 0xFFFF) return 0;             // Geçerli bir akışta olamaz
+        out[i] = (uint16_t)v;
+    }
+
+    *consumed = SAMPLE_CODEC_HEADER_LEN + r.pos;
+    return count;
+}
+
+/*
+
+Amaç: Yavaş değişen MQ2 okumalarını ham 16-bit kelimeler yerine birkaç bitle saklamak / göndermek.
+
+Blok yapısı:
+	| ilk örnek (2 B, ham) | sayı - 1 | derece (2 bit) · k (5 bit) | Rice kodlu artıklar ... | bayt sınırına dolgu |
+	Her blok ilk örneği ham taşıdığı için bağımsız çözülür; bozuk bir blok sadece kendisini etkiler (yeniden senkronizasyon noktası).
+
+Tahmin:
+	DELTA  → x[i] - x[i-1]. Sabit veya gürültülü sinyalde en iyisi.
+	ORDER2 → x[i] - (2·x[i-1] - x[i-2]). Isınma ve gaz yükselişi gibi düzgün eğimlerde artık sıfıra yakın kalır.
+	AUTO iki tahminin artık toplamını karşılaştırır ve bloğa küçük olanı seçer.
+
+Zig-zag + Rice:
+	İşaretli artık zig-zag ile işaretsize çevrilir (küçük mutlak değer → küçük sayı). Rice(k): üst kısım (u >> k) tekli (unary),
+	alt k bit olduğu gibi yazılır. k, ortalama artığın log2'si olarak blok başına seçilir. Ani sıçramalarda tekli kod
+	24 bitte kesilir ve değer 18 bit ham yazılır, böylece en kötü durum sınırlıdır (SAMPLE_CODEC_MAX_BYTES).
+
+Durum:
+	Kodlayıcı ve çözücü sadece yığında birkaç kelimelik bit okuyucu/yazıcı kullanır; heap ve tablo yoktur.
+	Kodlama iki geçişlidir (önce k ve derece seçimi, sonra yazım), bu yüzden blok girişi RAM'de olmalıdır.
+
+Süre:
+	Hedefteki süre PROF_ENABLE=1 ile ölçülür: başarılı her kodlama codec_encode noktasına blok başına CPU cycle olarak
+	yazılır (prof_dump()). Bilgisayardaki süre Cortex-M4'ün (tek çevrim çarpma, flash bekleme durumu) yerine geçmez.
+	Sıkıştırma oranı ve tam geri dönüşüm test/test_codec.c ile denetlenir.
+
+*/
@@ -0,0 +1,132 @@
+#include <stdint.h>
+#include <stddef.h>
+#include "scheduler.h"
+
+static sched_task_t sched_tasks[SCHED_MAX_TASKS];
+static sched_clock_t sched_clock;               // Çalışma süresini ölçen sayaç
+static uint32_t sched_clock_per_ms;
+
+#define SCHED_DUE(now, t)   ((int32_t)((now) - (t)) >= 0)      // millis() taşmasına (49.7 gün) dayanıklı karşılaştırma
+
+void sched_init(sched_clock_t clock, uint32_t clock_per_ms)
+{
+    for (uint8_t i = 0; i < SCHED_MAX_TASKS; i++) {
+        sched_tasks[i].active = 0;
+    }
+    sched_clock = clock;
+    sched_clock_per_ms = clock_per_ms;
+}
+
+static uint8_t sched_add(const char* name, sched_fn_t fn, uint32_t release_ms, uint32_t period_ms, uint32_t deadline_ms)
+{
+    if (fn == NULL) return SCHED_INVALID;
+
+    for (uint8_t i = 0; i < SCHED_MAX_TASKS; i++) {
+        sched_task_t* t = &sched_tasks[i];
+        if (t->active) continue;
+
+        t->name = name;
+        t->fn = fn;
+        t->period_ms = period_ms;
+        t->deadline_ms = deadline_ms;
+        t->release_ms = release_ms;
+        t->runs = 0;
+        t->wcet = 0;
+        t->missed = 0;
+        t->active = 1;
+        return i;
+    }
+    return SCHED_INVALID;
+}
+
+uint8_t sched_add_periodic(const char* name, sched_fn_t fn, uint32_t now_ms,
+                           uint32_t period_ms, uint32_t offset_ms, uint32_t deadline_ms)
+{
+    if (period_ms == 0) return SCHED_INVALID;
+    if (deadline_ms == 0) deadline_ms = period_ms;      // Varsayılan: bir sonraki tetiklenmeden önce bitmeli
+
+    return sched_add(name, fn, now_ms + offset_ms, period_ms, deadline_ms);
+}
+
+uint8_t sched_add_oneshot(const char* name, sched_fn_t fn, uint32_t now_ms,
+                          uint32_t delay_ms, uint32_t deadline_ms)
+{
+    return sched_add(name, fn, now_ms + delay_ms, 0, deadline_ms);
+}
+
+void sched_cancel(uint8_t id)
+{
+    if (id < SCHED_MAX_TASKS) sched_tasks[id].active = 0;
+}
+
+const sched_task_t* sched_task(uint8_t id)
+{
+    if (id >= SCHED_MAX_TASKS || !sched_tasks[id].active) return NULL;
+    return &sched_tasks[id];
+}
+
+uint8_t sched_dispatch(uint32_t now_ms)
+{
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < SCHED_MAX_TASKS; i++) {     // Düşük numara = yüksek öncelik
+        sched_task_t* t = &sched_tasks[i];
+        if (!t->active || !SCHED_DUE(now_ms, t->release_ms)) continue;
+
+        uint32_t late_ms = now_ms - t->release_ms;
+        uint32_t start = sched_clock ? sched_clock() : 0;
+
+        t->fn();
+
+        uint32_t elapsed = sched_clock ? (sched_clock() - start) : 0;
+        t->runs++;
+        if (elapsed > t->wcet) t->wcet = elapsed;
+
+        if (t->deadline_ms && sched_clock_per_ms) {     // Tetiklenmeden bitişe kadar geçen süre, sayaç biriminde
+            if ((uint64_t)late_ms * sched_clock_per_ms + elapsed > (uint64_t)t->deadline_ms * sched_clock_per_ms) {
+                t->missed++;                            // Geç başladı ve/veya çok uzun sürdü
+            }
+        } else if (t->deadline_ms && late_ms > t->deadline_ms) {
+            t->missed++;
+        }
+
+        if (t->period_ms == 0) {
+            t->active = 0;                              // Tek seferlik görev bitti
+        } else {
+            t->release_ms += t->period_ms;              // Faz kaymasın diye ideal zamana göre ilerle
+            if (SCHED_DUE(now_ms, t->release_ms)) {     // Bir periyottan fazla geride: aradakileri atla
+                uint32_t behind = (now_ms - t->release_ms) / t->period_ms + 1;
+                t->missed += behind;
+                t->release_ms += behind * t->period_ms;
+            }
+        }
+        count++;
+    }
+    return count;
+}
+
+/*
+
+Amaç: Örnekleme, kontrol ve ekran işlerini tek bir bloklayan döngü yerine her biri kendi hızında çalışan görevlere bölmek.
+
+İşbirlikçi zamanlayıcı:
+	Görevler birbirini kesmez; her görev kısa sürede işini bitirip geri döner. Ana döngü sadece sched_dispatch(millis()) çağırır.
+	Bu yüzden görevler arasında paylaşılan değişkenler için kilit gerekmez (kesme ile paylaşılanlar hariç).
+	Tablo sırası önceliktir: aynı milisaniyede tetiklenen iki görevden numarası küçük olan önce çalışır.
+
+Zamanlama:
+	release_ms her çalışmada period_ms kadar ilerletilir (now + period değil). Böylece görev bir miktar geç çalışsa bile
+	ortalama hızı kaymaz. Bir periyottan fazla gecikilirse aradaki tetiklenmeler toplu çalıştırılmaz, atlanır ve missed'e eklenir.
+
+İstatistikler:
+	runs   → kaç kez çalıştığı
+	wcet   → en uzun çalışma süresi; sched_init() ile verilen sayaç biriminde (hedefte CPU cycle)
+	missed → geç başlama + çalışma süresi son tarihi aştıysa veya periyot atlandıysa artar. Tam son tarihte biten görev
+	         kaçırmış sayılmaz (>). Karşılaştırma sayaç biriminde yapılır; çalışma süresi ms'ye bölünseydi 1 ms'nin altındaki
+	         aşımlar kaybolurdu.
+
+Bilgisayarda test:
+	Dosya donanıma dokunmaz. sched_dispatch() zamanı parametre olarak aldığı için sahte bir milisaniye sayacı ve
+	sched_init()'e verilen sahte bir cycle sayacı ile bütün durumlar (taşma dahil) adım adım sürülebilir.
+
+*/
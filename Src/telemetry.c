@@ -0,0 +1,198 @@
+#include <stdint.h>
+#include "stm32f4xx.h"
+#include "telemetry.h"
+#include "clock_config.h"
+#include "mem_sections.h"
+
+#define TELEMETRY_TX_MASK       (TELEMETRY_TX_SIZE - 1)
+#define TELEMETRY_SAMPLE_MASK   (TELEMETRY_SAMPLE_SIZE - 1)
+
+static uint8_t telemetry_tx[TELEMETRY_TX_SIZE];         // DMA buradan okur (CCM'de olmamalı)
+static volatile uint16_t telemetry_tx_head;             // Sadece ana döngü değiştirir
+static volatile uint16_t telemetry_tx_tail;             // Sadece DMA kesmesi değiştirir
+static volatile uint16_t telemetry_tx_len;              // Devam eden DMA transferinin uzunluğu (0: boşta)
+static uint8_t telemetry_seq;
+
+static volatile CCMRAM uint16_t telemetry_samples[TELEMETRY_SAMPLE_SIZE];
+static volatile CCMRAM uint32_t telemetry_sample_ms[TELEMETRY_SAMPLE_SIZE];   // Her örneğin zaman damgası
+static volatile uint8_t telemetry_sample_head;          // Sadece kesme değiştirir
+static volatile uint8_t telemetry_sample_tail;          // Sadece ana döngü değiştirir
+static volatile uint32_t telemetry_drop_frames;        // Sadece ana döngü değiştirir (telemetry_send)
+static volatile uint32_t telemetry_drop_tx;            // Sadece DMA1 Stream3 kesmesi değiştirir
+static volatile uint32_t telemetry_drop_samples;       // Sadece örnek kesmesi değiştirir (telemetry_push_sample)
+
+void telemetry_init(uint32_t baud)
+{
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPIODEN | RCC_AHB1ENR_DMA1EN;
+    RCC->APB1ENR |= RCC_APB1ENR_USART3EN;
+
+    GPIOD->MODER = (GPIOD->MODER & ~(3UL << (8 * 2))) | (2UL << (8 * 2));  // PD8 alternatif fonksiyon
+    GPIOD->AFR[1] = (GPIOD->AFR[1] & ~(0xFUL << 0)) | (7UL << 0);           // AF7 = USART3_TX
+
+    USART3->BRR = (CLOCK_PCLK1_HZ + baud / 2) / baud;   // USART3 APB1'de: USART clock = PCLK1
+    USART3->CR3 = USART_CR3_DMAT;                       // TX DMA isteği
+    USART3->CR1 = USART_CR1_TE | USART_CR1_UE;          // Sadece gönderici
+
+    DMA1_Stream3->CR = 0;
+    while (DMA1_Stream3->CR & DMA_SxCR_EN);
+    DMA1_Stream3->PAR = (uint32_t)&USART3->DR;
+    DMA1_Stream3->CR = (4UL << DMA_SxCR_CHSEL_Pos) |   // Kanal 4 = USART3_TX
+                       DMA_SxCR_DIR_0 |                 // Bellekten çevre birimine
+                       DMA_SxCR_MINC |
+                       DMA_SxCR_TCIE |
+                       DMA_SxCR_TEIE;
+
+    NVIC_EnableIRQ(DMA1_Stream3_IRQn);
+}
+
+static void telemetry_dma_start(void)
+{
+    uint16_t tail = telemetry_tx_tail;
+    uint16_t head = telemetry_tx_head;
+
+    if (head == tail) {
+        telemetry_tx_len = 0;                           // Gönderilecek bir şey yok
+        return;
+    }
+
+    uint16_t len = (head > tail) ? (head - tail) : (TELEMETRY_TX_SIZE - tail);  // Halka sonuna kadar bitişik kısım
+    telemetry_tx_len = len;
+
+    DMA1->LIFCR = DMA_LIFCR_CTCIF3 | DMA_LIFCR_CHTIF3 | DMA_LIFCR_CTEIF3 | DMA_LIFCR_CDMEIF3 | DMA_LIFCR_CFEIF3;
+    DMA1_Stream3->M0AR = (uint32_t)&telemetry_tx[tail];
+    DMA1_Stream3->NDTR = len;
+    DMA1_Stream3->CR |= DMA_SxCR_EN;
+}
+
+uint8_t telemetry_send(uint8_t type, const uint8_t* payload, uint8_t len, uint32_t timestamp_ms)
+{
+    uint8_t frame[TELEMETRY_FRAME_MAX];
+    uint16_t n = telemetry_frame_build(type, telemetry_seq, timestamp_ms, payload, len, frame);
+
+    uint16_t used = (telemetry_tx_head - telemetry_tx_tail) & TELEMETRY_TX_MASK;
+    if (n == 0 || n > TELEMETRY_TX_MASK - used) {       // Yarım çerçeve göndermektense hiç gönderme
+        telemetry_drop_frames++;
+        return 1;
+    }
+    telemetry_seq++;
+
+    uint16_t head = telemetry_tx_head;
+    for (uint16_t i = 0; i < n; i++) {
+        telemetry_tx[head] = frame[i];
+        head = (head + 1) & TELEMETRY_TX_MASK;
+    }
+    telemetry_tx_head = head;                           // Bayt yazıldıktan sonra görünür yap
+
+    NVIC_DisableIRQ(DMA1_Stream3_IRQn);                 // Boşta kontrolü ile kesmenin yeniden başlatması çakışmasın
+    if (telemetry_tx_len == 0) {
+        telemetry_dma_start();
+    }
+    NVIC_EnableIRQ(DMA1_Stream3_IRQn);
+
+    return 0;
+}
+
+void DMA1_Stream3_IRQHandler(void)
+{
+    uint32_t flags = DMA1->LISR;
+
+    if (flags & DMA_LISR_TEIF3) {
+        DMA1->LIFCR = DMA_LIFCR_CTEIF3;
+        telemetry_drop_tx++;                            // Baytlar gitti sayılır, akış bir sonraki 0x00'da toparlanır
+    }
+
+    if (flags & (DMA_LISR_TCIF3 | DMA_LISR_TEIF3)) {
+        DMA1->LIFCR = DMA_LIFCR_CTCIF3;
+        telemetry_tx_tail = (telemetry_tx_tail + telemetry_tx_len) & TELEMETRY_TX_MASK;
+        telemetry_dma_start();                          // Halkada kalan varsa devam et
+    }
+}
+
+void telemetry_push_sample(uint16_t value, uint32_t timestamp_ms)
+{
+    uint8_t next = (telemetry_sample_head + 1) & TELEMETRY_SAMPLE_MASK;
+
+    if (next == telemetry_sample_tail) {                // Dolu: ana döngü yetişemiyor, örnek atılır
+        telemetry_drop_samples++;
+        return;
+    }
+    telemetry_samples[telemetry_sample_head] = value;
+    telemetry_sample_ms[telemetry_sample_head] = timestamp_ms;
+    telemetry_sample_head = next;
+}
+
+void telemetry_service(uint16_t period_us)
+{
+    uint8_t payload[4 + 2 * TELEMETRY_SAMPLES_MAX];
+
+    while (telemetry_sample_tail != telemetry_sample_head) {
+        uint8_t count = (telemetry_sample_head - telemetry_sample_tail) & TELEMETRY_SAMPLE_MASK;
+        if (count > TELEMETRY_SAMPLES_MAX) count = TELEMETRY_SAMPLES_MAX;
+
+        uint8_t* p = payload;
+        *p++ = 0;                                       // Kanal (şimdilik sadece MQ2)
+        *p++ = count;
+        p = telemetry_put_u16(p, period_us);
+        for (uint8_t i = 0; i < count; i++) {
+            p = telemetry_put_u16(p, telemetry_samples[(telemetry_sample_tail + i) & TELEMETRY_SAMPLE_MASK]);
+        }
+
+        uint32_t last_ms = telemetry_sample_ms[(telemetry_sample_tail + count - 1) & TELEMETRY_SAMPLE_MASK];
+        telemetry_send(TELEMETRY_SAMPLES, payload, (uint8_t)(p - payload), last_ms);   // Bloğun son örneğinin zamanı
+
+        telemetry_sample_tail = (telemetry_sample_tail + count) & TELEMETRY_SAMPLE_MASK;
+    }
+}
+
+uint8_t telemetry_send_status(uint32_t now_ms, uint8_t alarm, uint32_t trips, uint32_t latency_max, uint32_t ppm, uint8_t calib_state)
+{
+    uint8_t payload[14];
+    uint8_t* p = payload;
+
+    *p++ = alarm;
+    p = telemetry_put_u32(p, trips);
+    p = telemetry_put_u32(p, latency_max);
+    p = telemetry_put_u32(p, ppm);
+    *p++ = calib_state;
+    return telemetry_send(TELEMETRY_STATUS, payload, (uint8_t)(p - payload), now_ms);
+}
+
+uint8_t telemetry_send_relay(uint32_t now_ms, uint8_t state, uint32_t trips)
+{
+    uint8_t payload[5];
+
+    payload[0] = state;
+    telemetry_put_u32(&payload[1], trips);
+    return telemetry_send(TELEMETRY_RELAY, payload, sizeof(payload), now_ms);
+}
+
+uint32_t telemetry_dropped(void)
+{
+    return telemetry_drop_frames + telemetry_drop_tx + telemetry_drop_samples;
+}
+
+/*
+
+Amaç: Sahadaki cihazlardan örnek verisi toplamak. Tek çıkış LCD olduğu için şimdiye kadar veri kaydedilemiyordu.
+
+Donanım:
+	USART3 TX → PD8 (AF7), 8N1. DMA1 Stream3 Kanal 4 baytları USART3->DR'ye taşır; CPU bayt başına kesme görmez.
+	Bir USB-seri dönüştürücünün RX ucu PD8'e, GND'si karta bağlanır.
+
+Akış:
+	telemetry_push_sample() → DMA/ADC kesmesinden çağrılır, örneği küçük bir halkaya yazar ve döner. Yer yoksa örneği atar;
+	                          örnekleme yolu seri port yüzünden asla beklemez.
+	telemetry_service()     → ana döngüde biriken örnekleri en fazla 16'lık SAMPLES çerçevelerine çevirir.
+	                          Zaman damgası bloğun son örneğine aittir (örnekle birlikte kesmede kaydedilir, timebase.c);
+	                          önceki örneklerin zamanı period_us ile geriye doğru hesaplanır.
+	telemetry_send()        → çerçeveyi (telemetry_frame.c) TX halkasına kopyalar. Halka boşta ise DMA'yı başlatır.
+	DMA1_Stream3_IRQHandler → biten parçayı halkadan düşer ve kalan bitişik kısmı yeni transfer olarak başlatır.
+
+Çerçeveler halkaya bütün olarak yazılır ya da hiç yazılmaz; yarım çerçeve COBS ayırıcısına kadar çöpe gider ama
+yine de bant genişliği harcar. Atılan her şey telemetry_dropped() ile sayılır.
+Sayaç üç parçadır ve her birini tek bir bağlam artırır (ana döngü, DMA1 kesmesi, örnek kesmesi). Tek sayaçta `++`
+oku-değiştir-yaz olduğu için bir kesme araya girince artışlardan biri kaybolurdu; toplam okunurken alınır.
+
+Bant genişliği: 115200 baud ≈ 11.5 kB/s. 15.6 Hz filtrelenmiş akış + 1 Hz durum ≈ 150 B/s, halka sadece %1 meşgul.
+
+*/
@@ -0,0 +1,138 @@
+#include <stdint.h>
+#include "telemetry_frame.h"
+
+uint16_t telemetry_crc16(const uint8_t* data, uint16_t len)
+{
+    uint16_t crc = 0xFFFF;
+
+    while (len--) {
+        crc ^= (uint16_t)(*data++) << 8;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+uint16_t telemetry_cobs_encode(const uint8_t* in, uint16_t len, uint8_t* out)
+{
+    uint16_t code_pos = 0;              // Bir sonraki sıfıra kadar olan mesafenin yazılacağı yer
+    uint16_t pos = 1;
+    uint8_t code = 1;
+
+    for (uint16_t i = 0; i < len; i++) {
+        if (in[i] == 0) {
+            out[code_pos] = code;       // Sıfırın yerine mesafe yazılır
+            code_pos = pos++;
+            code = 1;
+        } else {
+            out[pos++] = in[i];
+            if (++code == 0xFF) {       // 254 sıfırsız bayttan sonra yeni blok
+                out[code_pos] = code;
+                code_pos = pos++;
+                code = 1;
+            }
+        }
+    }
+    out[code_pos] = code;
+    return pos;
+}
+
+uint8_t telemetry_cobs_decode(const uint8_t* in, uint16_t len, uint8_t* out, uint16_t* out_len)
+{
+    uint16_t i = 0;
+    uint16_t n = 0;
+
+    while (i < len) {
+        uint8_t code = in[i++];
+        if (code == 0 || i + code - 1 > len) return 1;     // Çerçeve içinde sıfır olamaz / blok taşıyor
+
+        for (uint8_t k = 1; k < code; k++) {
+            if (in[i] == 0) return 1;
+            out[n++] = in[i++];
+        }
+        if (code != 0xFF && i < len) {
+            out[n++] = 0;               // Blok sonu, kaynakta bir sıfır vardı
+        }
+    }
+
+    *out_len = n;
+    return 0;
+}
+
+uint8_t* telemetry_put_u16(uint8_t* p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+uint8_t* telemetry_put_u32(uint8_t* p, uint32_t v)
+{
+    p = telemetry_put_u16(p, (uint16_t)v);
+    return telemetry_put_u16(p, (uint16_t)(v >> 16));
+}
+
+uint16_t telemetry_get_u16(const uint8_t* p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+uint32_t telemetry_get_u32(const uint8_t* p)
+{
+    return telemetry_get_u16(p) | ((uint32_t)telemetry_get_u16(p + 2) << 16);
+}
+
+uint16_t telemetry_frame_build(uint8_t type, uint8_t seq, uint32_t timestamp_ms,
+                               const uint8_t* payload, uint8_t len, uint8_t* out)
+{
+    uint8_t raw[TELEMETRY_RAW_MAX];
+    uint8_t* p = raw;
+
+    if (len > TELEMETRY_MAX_PAYLOAD) return 0;
+
+    *p++ = type;
+    *p++ = seq;
+    p = telemetry_put_u32(p, timestamp_ms);
+    for (uint8_t i = 0; i < len; i++) *p++ = payload[i];
+    p = telemetry_put_u16(p, telemetry_crc16(raw, (uint16_t)(p - raw)));
+
+    uint16_t n = telemetry_cobs_encode(raw, (uint16_t)(p - raw), out);
+    out[n++] = TELEMETRY_DELIMITER;
+    return n;
+}
+
+uint8_t telemetry_frame_parse(const uint8_t* in, uint16_t len, telemetry_frame_t* frame)
+{
+    uint8_t raw[TELEMETRY_FRAME_MAX];
+    uint16_t n;
+
+    if (len > TELEMETRY_FRAME_MAX || telemetry_cobs_decode(in, len, raw, &n)) return 1;
+    if (n < TELEMETRY_HEADER_LEN + TELEMETRY_CRC_LEN || n > TELEMETRY_RAW_MAX) return 1;
+    if (telemetry_crc16(raw, n - TELEMETRY_CRC_LEN) != telemetry_get_u16(&raw[n - TELEMETRY_CRC_LEN])) return 1;
+
+    frame->type = raw[0];
+    frame->seq = raw[1];
+    frame->timestamp_ms = telemetry_get_u32(&raw[2]);
+    frame->len = (uint8_t)(n - TELEMETRY_HEADER_LEN - TELEMETRY_CRC_LEN);
+    for (uint8_t i = 0; i < frame->len; i++) frame->payload[i] = raw[TELEMETRY_HEADER_LEN + i];
+    return 0;
+}
+
+/*
+
+Çerçeve yapısı (kodlamadan önce, little-endian):
+
+	| type | seq | timestamp_ms (4) | payload (0-64) | crc16 (2) |
+
+	seq her çerçevede bir artar; alıcı atlanan numaralardan kayıp çerçeveleri sayabilir.
+	CRC-16/CCITT-FALSE type'tan payload sonuna kadar hesaplanır.
+
+COBS (Consistent Overhead Byte Stuffing):
+	Çerçevenin içindeki bütün 0x00 baytları, bir sonraki sıfıra olan uzaklıkla değiştirilir. Böylece veri içinde hiç sıfır kalmaz
+	ve her çerçeve tek bir 0x00 ile biter. Alıcı akışın ortasından başlasa bile ilk 0x00'da senkronize olur.
+	Ek yük en fazla 254 baytta 1 bayttır (SLIP'te en kötü durum 2 kattır).
+
+Bu dosya donanıma dokunmaz; hem firmware'de hem de tools/telemetry_decode.c ile bilgisayarda derlenir.
+
+*/
@@ -0,0 +1,139 @@
+#include <stdint.h>
+#include "timebase.h"
+#include "clock_config.h"
+#include "mem_sections.h"
+
+#ifndef TIMEBASE_COUNTER
+#include "stm32f4xx.h"
+#define TIMEBASE_COUNTER()      (DWT->CYCCNT)   // Bilgisayarda sahte bir sayaçla değiştirilebilir
+#endif
+
+#define TIMEBASE_US_RECIP       ((0xFFFFFFFFFFFFFFFFull / CLOCK_CYCLES_PER_US) + 1)    // ⌈2^64 / f⌉
+#define TIMEBASE_MS_RECIP       ((0xFFFFFFFFFFFFFFFFull / 1000) + 1)                   // ⌈2^64 / 1000⌉
+
+typedef struct {
+    uint32_t hi;                        // CYCCNT'nin taşma sayısı (64-bit sayacın üst yarısı)
+    uint32_t lo;                        // Bu kopya yazılırken okunan CYCCNT
+} timebase_snapshot_t;
+
+static volatile uint32_t timebase_seq;                  // Her yazımda iki kez artar; çift/tek hangi kopyanın okunacağını seçer
+static volatile timebase_snapshot_t timebase_copy[2];   // Yazıcı her an sadece birini değiştirir
+static volatile uint32_t timebase_retry_count;
+
+static void timebase_store(uint32_t hi, uint32_t lo)
+{
+    timebase_seq++;                     // Tek: okuyucular copy[1]'i kullanır
+    timebase_copy[0].hi = hi;
+    timebase_copy[0].lo = lo;
+    timebase_seq++;                     // Çift: okuyucular copy[0]'ı kullanır
+    timebase_copy[1].hi = hi;
+    timebase_copy[1].lo = lo;
+}
+
+void timebase_init(void)
+{
+    timebase_store(0, TIMEBASE_COUNTER());
+    timebase_store(0, TIMEBASE_COUNTER());  // İki kopya da aynı başlangıcı görsün
+    timebase_retry_count = 0;
+}
+
+RAMFUNC void timebase_tick(void)
+{
+    uint32_t s = timebase_seq;
+    uint32_t hi = timebase_copy[s & 1].hi;
+    uint32_t lo = TIMEBASE_COUNTER();
+
+    if (lo < timebase_copy[s & 1].lo) hi++;    // Son güncellemeden beri CYCCNT taştı
+    timebase_store(hi, lo);
+}
+
+RAMFUNC uint64_t timebase_cycles(void)
+{
+    uint32_t s, hi, last, lo;
+
+    for (;;) {
+        s = timebase_seq;
+        hi = timebase_copy[s & 1].hi;
+        last = timebase_copy[s & 1].lo;
+        lo = TIMEBASE_COUNTER();
+        if (timebase_seq == s) break;           // Okuma sırasında yazıcı çalışmadı
+        timebase_retry_count++;
+    }
+
+    if (lo < last) hi++;                        // Taşma oldu, SysTick henüz işlemedi
+    return ((uint64_t)hi << 32) | lo;
+}
+
+/*
+
+Amaç: Taşmayan, kesme ve ana döngüden kilitsiz okunabilen 64-bit bir zaman damgası.
+
+DWT->CYCCNT 32 bittir ve 168 MHz'de ~25.6 sn'de bir taşar. SysTick kesmesi her 1 ms'de timebase_tick() çağırır;
+CYCCNT'nin bir önceki değerden küçük olması taşma demektir ve üst yarı (hi) bir artırılır. İki güncelleme arası
+(1 ms) taşma periyodundan çok kısa olduğu için en fazla bir taşma kaçabilir. 64 bit, 168 MHz'de ~3480 yıl yeter.
+
+Okuma (seqlock, "latch" biçimi):
+	Yazıcı önce sırayı tek yapıp copy[0]'ı, sonra çift yapıp copy[1]'i yazar. Okuyucu sıranın en düşük bitine göre
+	o an yazılmayan kopyayı okur, CYCCNT'yi okur ve sıra değişmediyse sonucu kabul eder; değiştiyse tekrar dener.
+	Ana döngüde okurken SysTick araya girerse sıra değişir ve okuma tekrarlanır.
+	Klasik seqlock'ta okuyucu "tek" sırayı görünce bekler; tek çekirdekte yazıcıyı kesen daha öncelikli bir kesme
+	(örn. ADC watchdog) sonsuza kadar beklerdi. Burada o kesme yazılmayan eski kopyayı okur; sıra o kesme sürerken
+	değişmeyeceği için tek denemede çıkar. Eski kopya en fazla 1 ms eskidir, taşma kontrolü (lo < last) bunu da düzeltir.
+	Kilit, kesme kapatma veya LDREX/STREX yoktur. Cortex-M4 tek çekirdekli ve bellek erişimlerini sırası dışında
+	yapmadığı için volatile erişimlerin derleyici tarafından sıralanması yeterlidir.
+
+timebase_init() CYCCNT'nin çalıştığını varsayar (DWT_Delay_Init()). Sayaç kesme kapalıyken 25 sn'den uzun beklenirse
+bir taşma kaybolur; bu firmware'de kesmeler en fazla birkaç µs kapalı kalır.
+
+*/
+
+static uint64_t timebase_mulhi64(uint64_t a, uint64_t b)
+{
+    uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+    uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+
+    uint64_t ll = a_lo * b_lo;                  // Her biri tek UMULL
+    uint64_t lh = a_lo * b_hi;
+    uint64_t hl = a_hi * b_lo;
+    uint64_t hh = a_hi * b_hi;
+
+    uint64_t mid = (ll >> 32) + (uint32_t)lh + (uint32_t)hl;
+    return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+}
+
+uint64_t timebase_cycles_to_us(uint64_t cycles)
+{
+    return timebase_mulhi64(cycles, TIMEBASE_US_RECIP);
+}
+
+uint64_t timebase_cycles_to_ms(uint64_t cycles)
+{
+    return timebase_mulhi64(timebase_cycles_to_us(cycles), TIMEBASE_MS_RECIP);
+}
+
+uint64_t timebase_us(void)
+{
+    return timebase_cycles_to_us(timebase_cycles());
+}
+
+uint64_t timebase_ms(void)
+{
+    return timebase_cycles_to_ms(timebase_cycles());
+}
+
+uint32_t timebase_retries(void)
+{
+    return timebase_retry_count;
+}
+
+/*
+
+Birim çevirme:
+	Cortex-M4'te 64-bit bölme donanımda yoktur; __aeabi_uldivmod yüzlerce cycle sürer. Bunun yerine x / f,
+	R = ⌈2^64 / f⌉ sabitiyle (x · R) >> 64 olarak hesaplanır: dört 32×32→64 çarpma ve birkaç toplama.
+	R · f - 2^64 = e < f olduğundan x · e < 2^64 iken sonuç tam x / f'ye eşittir:
+		µs: f = 168 (< 2^8) → x < 2^56 cycle (168 MHz'de ~13.6 yıl)
+		ms: µs değeri 1000'e bölünür (< 2^10) → µs < 2^54
+	f derleme anında CLOCK_CYCLES_PER_US'tan gelir; 72 MHz ayarında da aynı sınırlar geçerlidir.
+
+*/
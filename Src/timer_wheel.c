@@ -0,0 +1,206 @@
+#include <stdint.h>
+#include <stddef.h>
+#include "timer_wheel.h"
+#include "mem_sections.h"
+
+#define TW_MASK             (TIMER_WHEEL_SLOTS - 1)
+#define TW_SHIFT(level)     ((level) * TIMER_WHEEL_BITS)
+#define TW_DUE(now, t)      ((int32_t)((now) - (t)) >= 0)      // 32-bit sayaç taşmasına dayanıklı karşılaştırma
+
+void timer_wheel_init(timer_wheel_t* w, uint32_t now)
+{
+    for (uint8_t l = 0; l < TIMER_WHEEL_LEVELS; l++) {
+        for (uint8_t s = 0; s < TIMER_WHEEL_SLOTS; s++) {
+            w->slots[l][s] = NULL;
+        }
+        w->occupied[l] = 0;
+    }
+    w->now = now;
+    w->pending = 0;
+}
+
+void timer_wheel_timer_init(timer_wheel_timer_t* t, timer_wheel_fn_t fn, void* arg)
+{
+    t->next = t->prev = NULL;
+    t->expires = 0;
+    t->period = 0;
+    t->fn = fn;
+    t->arg = arg;
+    t->level = TIMER_WHEEL_IDLE;
+    t->slot = 0;
+}
+
+RAMFUNC static void tw_link(timer_wheel_t* w, timer_wheel_timer_t* t)
+{
+    uint32_t when = TW_DUE(w->now, t->expires) ? w->now : t->expires;   // Süresi geçmişse hemen çalışacak yuvaya
+    uint8_t level = TIMER_WHEEL_LEVELS - 1;
+    uint8_t slot = ((w->now >> TW_SHIFT(level)) + TW_MASK) & TW_MASK;  // Çok uzaksa en üst seviyenin en uzak yuvası
+
+    for (uint8_t l = 0; l < TIMER_WHEEL_LEVELS; l++) {
+        uint8_t shift = TW_SHIFT(l);
+        uint32_t diff = ((when >> shift) - (w->now >> shift)) & (0xFFFFFFFFu >> shift);  // Bu seviyede kaç yuva ileride
+        if (diff < TIMER_WHEEL_SLOTS) {
+            level = l;
+            slot = (when >> shift) & TW_MASK;
+            break;
+        }
+    }
+
+    timer_wheel_timer_t* head = w->slots[level][slot];
+    t->prev = NULL;
+    t->next = head;
+    if (head) head->prev = t;
+    w->slots[level][slot] = t;
+    w->occupied[level] |= (1u << slot);
+    t->level = level;
+    t->slot = slot;
+    w->pending++;
+}
+
+RAMFUNC static void tw_unlink(timer_wheel_t* w, timer_wheel_timer_t* t)
+{
+    if (t->prev) {
+        t->prev->next = t->next;
+    } else {
+        w->slots[t->level][t->slot] = t->next;
+    }
+    if (t->next) t->next->prev = t->prev;
+
+    if (w->slots[t->level][t->slot] == NULL) {
+        w->occupied[t->level] &= ~(1u << t->slot);      // Yuva boşaldı
+    }
+    t->next = t->prev = NULL;
+    t->level = TIMER_WHEEL_IDLE;
+    w->pending--;
+}
+
+RAMFUNC uint8_t timer_wheel_add(timer_wheel_t* w, timer_wheel_timer_t* t, uint32_t expires, uint32_t period)
+{
+    if (t->fn == NULL || period > TIMER_WHEEL_MAX_DELAY) return 1;
+
+    if (t->level != TIMER_WHEEL_IDLE) tw_unlink(w, t);  // Bekliyorsa yeniden kur
+    t->expires = expires;
+    t->period = period;
+    tw_link(w, t);
+    return 0;
+}
+
+RAMFUNC void timer_wheel_cancel(timer_wheel_t* w, timer_wheel_timer_t* t)
+{
+    if (t->level != TIMER_WHEEL_IDLE) tw_unlink(w, t);
+}
+
+uint8_t timer_wheel_is_pending(const timer_wheel_timer_t* t)
+{
+    return t->level != TIMER_WHEEL_IDLE;
+}
+
+RAMFUNC uint8_t timer_wheel_next(const timer_wheel_t* w, uint32_t* when)
+{
+    uint8_t found = 0;
+    uint32_t best = 0;
+
+    for (uint8_t l = 0; l < TIMER_WHEEL_LEVELS; l++) {
+        uint32_t bits = w->occupied[l];
+        if (!bits) continue;
+
+        uint8_t shift = TW_SHIFT(l);
+        uint8_t current = (w->now >> shift) & TW_MASK;
+        uint32_t rotated = current ? ((bits >> current) | (bits << (TIMER_WHEEL_SLOTS - current))) : bits;
+        uint32_t distance = (uint32_t)__builtin_ctz(rotated);          // Şu anki yuvadan itibaren ilk dolu yuva
+        uint32_t t = ((w->now >> shift) + distance) << shift;           // 0. seviyede tam zaman, üstte yuvanın başı
+
+        if (!TW_DUE(t, w->now)) t = w->now;             // Yuvanın başı geçmişte kaldıysa hemen işlenmeli
+        if (!found || (int32_t)(t - best) < 0) {
+            best = t;
+            found = 1;
+        }
+    }
+
+    if (found) *when = best;
+    return found ? 0 : 1;
+}
+
+RAMFUNC timer_wheel_timer_t* timer_wheel_expire(timer_wheel_t* w, uint32_t now)
+{
+    uint32_t t;
+
+    while (timer_wheel_next(w, &t) == 0 && TW_DUE(now, t)) {
+        w->now = t;
+
+        for (uint8_t l = TIMER_WHEEL_LEVELS - 1; l > 0; l--) {     // Üstten alta: inen zamanlayıcı bir alt seviyede de inebilir
+            uint8_t slot = (w->now >> TW_SHIFT(l)) & TW_MASK;
+            timer_wheel_timer_t* c;
+            while ((c = w->slots[l][slot]) != NULL) {
+                tw_unlink(w, c);
+                tw_link(w, c);                          // Artık daha yakın: daha ince bir seviyeye yerleşir
+            }
+        }
+
+        timer_wheel_timer_t* e = w->slots[0][w->now & TW_MASK];
+        if (e != NULL) {                                // Her seferinde baştan al: callback başka bir zamanlayıcıyı iptal edebilir
+            tw_unlink(w, e);
+            if (e->period) {
+                e->expires += e->period;                // Faz kaymasın diye ideal zamana göre ilerle
+                if (TW_DUE(w->now, e->expires)) {       // Bir periyottan fazla geride: aradakileri atla
+                    e->expires += ((w->now - e->expires) / e->period + 1) * e->period;
+                }
+                tw_link(w, e);                          // Callback'ten önce: callback kendini iptal edebilir
+            }
+            return e;
+        }
+    }
+
+    if (TW_DUE(now, w->now)) w->now = now;
+    return NULL;
+}
+
+uint32_t timer_wheel_advance(timer_wheel_t* w, uint32_t now)
+{
+    uint32_t fired = 0;
+    timer_wheel_timer_t* e;
+
+    while ((e = timer_wheel_expire(w, now)) != NULL) {
+        e->fn(e->arg);
+        fired++;
+    }
+    return fired;
+}
+
+/*
+
+Amaç: µs çözünürlüklü çok sayıda zamanlayıcıyı tek bir donanım sayacı ve tek bir compare kesmesiyle yönetmek.
+
+Seviyeler:
+	Her seviyede 32 yuva vardır; l. seviyenin bir yuvası 32^l tick genişliğindedir.
+		0: 1 µs × 32 = 32 µs        1: 32 µs × 32 = 1.024 ms      2: 1.024 ms × 32 = 32.8 ms
+		3: 32.8 ms × 32 = 1.05 s    4: 1.05 s × 32 = 33.5 s
+	Zamanlayıcı, (expires >> 5l) - (now >> 5l) < 32 olan en küçük seviyeye, (expires >> 5l) & 31 yuvasına konur.
+	0. seviyede yuva tam zamanı belirtir. Üst seviyelerde yuvanın başına gelindiğinde ("cascade") yuvadaki zamanlayıcılar
+	bir alt seviyeye taşınır; her zamanlayıcı en fazla 4 kez taşınır. 33.5 sn'den uzak olanlar en üst seviyenin en uzak
+	yuvasında bekler ve oraya gelince tekrar yerleşir.
+
+Ekleme / iptal O(1):
+	Yuvalar çift yönlü bağlı listedir; zamanlayıcı kendi seviye ve yuvasını bilir, listeden doğrudan çıkarılır.
+	Seviye seçimi en fazla 5 karşılaştırmadır. Dinamik bellek kullanılmaz; zamanlayıcı yapısını çağıran sağlar.
+
+En yakın olay:
+	Her seviyenin 32 bitlik doluluk maskesi, şu anki yuvaya göre döndürülüp ctz (Cortex-M4'te RBIT + CLZ) ile taranır.
+	En küçük zaman, ya 0. seviyede bir zamanlayıcının tam süresi ya da üst seviyedeki bir yuvanın taşınma anıdır.
+	Donanım compare register'ı bu değere kurulur; arada hiçbir şey yoksa kesme de gelmez.
+
+timer_wheel_advance():
+	Çarkın zamanını olaydan olaya atlatır; aradaki boş µs'ler tek tek işlenmez. Callback'ler bu fonksiyonun içinden,
+	süresi dolma sırasıyla çağrılır. Aynı µs'de dolanların sırası belirsizdir. Periyodik zamanlayıcı callback'ten önce
+	yeniden kurulur, bu yüzden callback içinden iptal edilebilir. Callback, 0 gecikmeyle kendini sürekli yeniden kurarsa
+	fonksiyon dönmez.
+
+timer_wheel_expire():
+	advance()'in tek adımı: süresi dolan ilk zamanlayıcıyı çarktan çıkarır (periyodikse yeniden kurar) ve döndürür,
+	callback'i çağırmaz. Çark bir kilit altında değiştiriliyorsa çağıran kilidi sadece bu adım için tutar, callback'i
+	kilit dışında çağırır (hrtimer.c). Dönen zamanlayıcının fn / arg alanları kilit bırakılmadan okunmalıdır.
+
+Zaman 32 bit ve taşmalıdır (1 MHz'de 71.6 dakika); karşılaştırmalar işaretli farkla yapıldığı için en uzun gecikme 2^31 tick'tir.
+Bu dosya donanıma dokunmaz; bilgisayarda rastgele zamanlayıcılarla sürülebilir.
+
+*/
@@ -0,0 +1,693 @@
+#include <stdint.h>
+#include <string.h>
+#include "stm32f4xx.h"
+#include "clock_config.h"
+#include "lcd_transport.h"
+#include "emu.h"
+
+#define EMU_STEP_CYCLES     32              // emu_run_us() adımı (~190 ns): modeller en az bu sıklıkla güncellenir
+#define EMU_VECTORS         (EMU_IRQ_COUNT + 16)
+#define EMU_VECTOR(irq)     ((int)(irq) + 16)
+#define EMU_THREAD_PRIO     256             // Kesme dışı (ana döngü)
+#define EMU_I2C_DR_EMPTY    0xFFFF0000u     // DR'ye yazılan bayt model tarafından alındı
+#define EMU_I2C_ERRORS      (I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_AF | I2C_SR1_OVR)    // rc_w0 bitleri
+
+typedef struct {
+    TIM_TypeDef* r;
+    uint64_t base;              // Sayacın cnt_base değerinde olduğu cycle
+    uint32_t cnt_base;
+    uint32_t cnt;               // Modelin en son yazdığı CNT (farklıysa yazılım değiştirmiştir)
+    uint64_t ticks;             // base'den beri geçen timer tick'i
+    uint64_t update_at;         // Son update olayının cycle'ı (adım içinde gerçekleştiği an)
+    uint32_t sr;                // Donanım bayrakları
+    uint32_t sr_shadow;         // SR'ye en son modelin yazdığı değer
+    uint8_t running;
+} emu_tim_t;
+
+typedef struct {
+    DMA_TypeDef* d;
+    DMA_Stream_TypeDef* s;
+    volatile uint32_t* isr;     // LISR / HISR
+    volatile uint32_t* ifcr;    // LIFCR / HIFCR
+    uint8_t shift;              // Stream bayraklarının ISR içindeki yeri
+    uint32_t flags;             // FE=0, DME=2, TE=3, HT=4, TC=5 (kaydırılmamış)
+    uint32_t total;
+    uint32_t pos;
+    uint8_t en;
+} emu_dma_t;
+
+#define EMU_DMA_HT          (1u << 4)
+#define EMU_DMA_TC          (1u << 5)
+#define EMU_DMA_TE          (1u << 3)
+
+typedef enum {
+    EMU_I2C_IDLE,
+    EMU_I2C_START,              // START koşulu oluşuyor
+    EMU_I2C_SB,                 // SB = 1, adres bekleniyor
+    EMU_I2C_ADDR_TX,            // Adres baytı hatta
+    EMU_I2C_ADDR_WAIT,          // ADDR = 1, SR1 + SR2 okuması bekleniyor
+    EMU_I2C_DATA,               // Veri aşaması
+    EMU_I2C_NACK                // Adres cevapsız kaldı, STOP bekleniyor
+} emu_i2c_state_t;
+
+static void (*emu_vector[EMU_VECTORS])(void);
+static emu_irq_stats_t emu_stats[EMU_VECTORS];
+static uint8_t emu_pending[EMU_VECTORS];
+static int emu_active_prio;
+static uint8_t emu_primask_was;
+static uint64_t emu_primask_since;
+static uint64_t emu_primask_max;
+
+static uint64_t emu_systick_next;
+static uint8_t emu_systick_pending;
+
+static emu_tim_t emu_tim2, emu_tim3;
+static emu_dma_t emu_dma_adc, emu_dma_i2c;
+
+static emu_adc_source_t emu_adc_source;
+static struct {
+    uint8_t busy;
+    uint8_t pos;                // Sıradaki dönüşüm
+    uint64_t done_at;
+    uint32_t sr;
+    uint32_t sr_shadow;
+} emu_adc;
+
+static hd44780_t* emu_lcd;
+static emu_lcd_wiring_t emu_lcd_wiring;
+static uint32_t emu_lcd_pins;   // RS | E << 1 | data << 8 (değişim tespiti)
+
+static struct {
+    emu_i2c_state_t state;
+    uint64_t until;
+    uint32_t sr1;
+    uint32_t sr1_shadow;
+    uint8_t addr_reads;
+    uint8_t shifting;
+    uint8_t shift_byte;
+    uint8_t dr_full;
+    uint8_t dr_byte;
+    uint8_t present;
+    uint8_t stuck;
+    uint32_t bytes;
+} emu_i2c;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// GPIO ve paralel LCD
+
+static void emu_lcd_update(void)
+{
+    if (!emu_lcd || emu_lcd_wiring == EMU_LCD_NONE || emu_lcd_wiring == EMU_LCD_PCF8574) return;
+
+    uint32_t a = fake_GPIOA.ODR;
+    uint32_t b = fake_GPIOB.ODR;
+    uint8_t data = (uint8_t)(((b >> LCD_D4_PIN) & 1) << 4 | ((b >> LCD_D5_PIN) & 1) << 5 |
+                             ((b >> LCD_D6_PIN) & 1) << 6 | ((b >> LCD_D7_PIN) & 1) << 7);
+    if (emu_lcd_wiring == EMU_LCD_GPIO8) {
+        data |= (uint8_t)(((b >> LCD_D0_PIN) & 1) | ((b >> LCD_D1_PIN) & 1) << 1 |
+                          ((b >> LCD_D2_PIN) & 1) << 2 | ((b >> LCD_D3_PIN) & 1) << 3);
+    }
+    uint8_t rs = (a >> LCD_RS_PIN) & 1;
+    uint8_t e = (a >> LCD_E_PIN) & 1;
+    uint32_t pins = rs | (uint32_t)e << 1 | (uint32_t)data << 8;
+
+    if (pins != emu_lcd_pins) {
+        emu_lcd_pins = pins;
+        hd44780_pins(emu_lcd, emu_ns(), rs, e, data);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// SysTick
+
+static void emu_systick_update(void)
+{
+    uint32_t period = (fake_SysTick.LOAD & 0xFFFFFF) + 1;
+
+    if (!(fake_SysTick.CTRL & SysTick_CTRL_ENABLE_Msk)) {
+        emu_systick_next = 0;
+        return;
+    }
+    if (emu_systick_next == 0) emu_systick_next = fake_cycles + period;     // Yeni açıldı
+
+    while (fake_cycles >= emu_systick_next) {
+        emu_systick_next += period;
+        fake_SysTick.CTRL |= 1u << 16;          // COUNTFLAG
+        if (fake_SysTick.CTRL & SysTick_CTRL_TICKINT_Msk) emu_systick_pending = 1;
+    }
+    fake_SysTick.VAL = (uint32_t)(emu_systick_next - fake_cycles - 1);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Genel amaçlı timer (TIM2, TIM3): sayaç, update, CC1 karşılaştırma
+
+static uint32_t emu_tim_update(emu_tim_t* t, uint8_t wide)
+{
+    TIM_TypeDef* r = t->r;
+    uint32_t updates = 0;
+
+    if (r->SR != t->sr_shadow) t->sr &= r->SR;  // rc_w0: yazılımın 0 yazdığı bayraklar temizlenir
+
+    if (!(r->CR1 & TIM_CR1_CEN)) {
+        t->running = 0;
+        t->cnt = r->CNT;
+    } else if (!t->running || r->CNT != t->cnt) {   // Yeni başladı veya yazılım CNT'yi değiştirdi
+        t->running = 1;
+        t->base = fake_cycles;
+        t->cnt_base = r->CNT;
+        t->ticks = 0;
+        t->cnt = r->CNT;
+    }
+
+    if (r->EGR) {
+        if (r->EGR & TIM_EGR_UG) {              // PSC yüklenir, sayaç sıfırlanır
+            t->base = fake_cycles;
+            t->cnt_base = 0;
+            t->ticks = 0;
+            t->cnt = 0;
+            r->CNT = 0;
+            if (!(r->CR1 & TIM_CR1_URS)) t->sr |= TIM_SR_UIF;
+        }
+        if (r->EGR & TIM_EGR_CC1G) t->sr |= TIM_SR_CC1IF;
+        r->EGR = 0;
+    }
+
+    if (t->running) {
+        uint64_t ticks = (uint64_t)((unsigned __int128)(fake_cycles - t->base) * CLOCK_APB1_TIMER_HZ /
+                                    CLOCK_SYSCLK_HZ / (r->PSC + 1));
+        uint32_t prev = t->cnt;
+        uint64_t top = wide ? 0x100000000ull : (uint64_t)(r->ARR & 0xFFFF) + 1;
+        uint64_t old_total = t->cnt_base + t->ticks;
+        uint64_t new_total = t->cnt_base + ticks;
+
+        updates = (uint32_t)(new_total / top - old_total / top);
+        t->ticks = ticks;
+        t->cnt = (uint32_t)(new_total % top);
+        if (updates) {
+            uint64_t at = new_total / top * top - t->cnt_base;     // base'den son update'e kadar tick
+            t->update_at = t->base + (uint64_t)(((unsigned __int128)at * (r->PSC + 1) * CLOCK_SYSCLK_HZ +
+                                                 CLOCK_APB1_TIMER_HZ - 1) / CLOCK_APB1_TIMER_HZ);
+            t->sr |= TIM_SR_UIF;
+        }
+        if (t->cnt != prev && (uint32_t)(r->CCR1 - prev - 1) < (uint32_t)(t->cnt - prev)) {
+            t->sr |= TIM_SR_CC1IF;              // Sayaç bu adımda CCR1'i geçti
+        }
+        r->CNT = t->cnt;
+    }
+
+    r->SR = t->sr;
+    t->sr_shadow = t->sr;
+    return updates;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// DMA stream
+
+static void emu_dma_flags(emu_dma_t* m)
+{
+    if (*m->ifcr) {
+        m->flags &= ~((*m->ifcr >> m->shift) & 0x3D);
+        *m->ifcr = 0;
+    }
+    *m->isr = (*m->isr & ~(0x3Du << m->shift)) | (m->flags << m->shift);
+
+    if (!(m->s->CR & DMA_SxCR_EN)) {
+        m->en = 0;
+    } else if (!m->en) {                        // Yeni etkinleşti: NDTR ve adres o anki değerlerinden başlar
+        m->en = 1;
+        m->total = m->s->NDTR;
+        m->pos = 0;
+    }
+}
+
+static uint8_t emu_dma_ready(const emu_dma_t* m)
+{
+    return m->en && m->s->NDTR;
+}
+
+static void* emu_dma_next(emu_dma_t* m, uint8_t size)
+{
+    uint32_t addr = m->s->M0AR + ((m->s->CR & DMA_SxCR_MINC) ? m->pos * size : 0);
+
+    m->pos++;
+    m->s->NDTR--;
+    if (m->s->NDTR == m->total / 2) m->flags |= EMU_DMA_HT;
+    if (m->s->NDTR == 0) {
+        m->flags |= EMU_DMA_TC;
+        if (m->s->CR & DMA_SxCR_CIRC) {
+            m->s->NDTR = m->total;
+            m->pos = 0;
+        } else {
+            m->s->CR &= ~DMA_SxCR_EN;
+            m->en = 0;
+        }
+    }
+    *m->isr = (*m->isr & ~(0x3Du << m->shift)) | (m->flags << m->shift);
+    return (void*)(uintptr_t)addr;             // Testler -no-pie ile bağlanır: statik tamponlar 32 bit adrese sığar
+}
+
+static uint8_t emu_dma_irq(const emu_dma_t* m)
+{
+    uint32_t cr = m->s->CR;
+
+    return ((m->flags & EMU_DMA_HT) && (cr & DMA_SxCR_HTIE)) ||
+           ((m->flags & EMU_DMA_TC) && (cr & DMA_SxCR_TCIE)) ||
+           ((m->flags & EMU_DMA_TE) && (cr & DMA_SxCR_TEIE));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// ADC1: yazılım / TIM3 TRGO / sürekli tetik, tarama sırası, analog watchdog, DMA2 Stream0
+
+static uint8_t emu_adc_channel(uint8_t i)
+{
+    ADC_TypeDef* r = &fake_ADC1;
+
+    if (i < 6) return (r->SQR3 >> (5 * i)) & 0x1F;
+    if (i < 12) return (r->SQR2 >> (5 * (i - 6))) & 0x1F;
+    return (r->SQR1 >> (5 * (i - 12))) & 0x1F;
+}
+
+static uint64_t emu_adc_conv_cycles(uint8_t ch)
+{
+    static const uint16_t smp[8] = { 3, 15, 28, 56, 84, 112, 144, 480 };
+    uint32_t code = ch < 10 ? (fake_ADC1.SMPR2 >> (3 * ch)) & 7 : (fake_ADC1.SMPR1 >> (3 * (ch - 10))) & 7;
+
+    return (uint64_t)(smp[code] + 12) * CLOCK_SYSCLK_HZ / CLOCK_ADC_HZ;     // Örnekleme + 12 bitlik çevrim
+}
+
+static void emu_adc_start(uint64_t at)          // at: tetiğin geldiği cycle (son adımın içinde, şimdiden önce olabilir)
+{
+    if (!(fake_ADC1.CR2 & ADC_CR2_ADON) || emu_adc.busy) return;
+
+    emu_adc.busy = 1;
+    emu_adc.pos = 0;
+    emu_adc.sr &= ~ADC_SR_EOC;
+    emu_adc.done_at = at + emu_adc_conv_cycles(emu_adc_channel(0));
+}
+
+static void emu_adc_update(uint32_t tim3_updates)
+{
+    ADC_TypeDef* r = &fake_ADC1;
+
+    if (r->SR != emu_adc.sr_shadow) emu_adc.sr &= r->SR;
+
+    if (r->CR2 & ADC_CR2_SWSTART) {
+        r->CR2 &= ~ADC_CR2_SWSTART;             // Donanım dönüşüm başlayınca temizler
+        emu_adc_start(fake_cycles);
+    }
+    if (tim3_updates && (r->CR2 & ADC_CR2_EXTEN) && ((r->CR2 & ADC_CR2_EXTSEL) >> ADC_CR2_EXTSEL_Pos) == 8 &&
+        (fake_TIM3.CR2 & TIM_CR2_MMS) == TIM_CR2_MMS_1) {
+        emu_adc_start(emu_tim3.update_at);      // TIM3 TRGO (update); meşgulken gelen tetik kaybolur
+    }
+
+    while (emu_adc.busy && fake_cycles >= emu_adc.done_at) {
+        uint8_t ch = emu_adc_channel(emu_adc.pos);
+        uint16_t v = emu_adc_source ? (emu_adc_source(ch, EMU_NS(emu_adc.done_at)) & 0xFFF) : 0;
+        uint8_t length = (r->CR1 & ADC_CR1_SCAN) ? ((r->SQR1 >> 20) & 0xF) + 1 : 1;
+
+        r->DR = v;
+        emu_adc.sr |= ADC_SR_EOC;
+        if ((r->CR1 & ADC_CR1_AWDEN) &&
+            (!(r->CR1 & ADC_CR1_AWDSGL) || ch == ((r->CR1 & ADC_CR1_AWDCH) >> ADC_CR1_AWDCH_Pos)) &&
+            (v > (r->HTR & 0xFFF) || v < (r->LTR & 0xFFF))) {
+            emu_adc.sr |= ADC_SR_AWD;
+        }
+        emu_dma_flags(&emu_dma_adc);
+        if ((r->CR2 & ADC_CR2_DMA) && emu_dma_ready(&emu_dma_adc)) {
+            *(volatile uint16_t*)emu_dma_next(&emu_dma_adc, 2) = v;
+            emu_adc.sr &= ~ADC_SR_EOC;          // DMA'nın DR okuması EOC'yi temizler
+        }
+
+        if (++emu_adc.pos < length) {
+            emu_adc.done_at += emu_adc_conv_cycles(emu_adc_channel(emu_adc.pos));
+        } else if (r->CR2 & ADC_CR2_CONT) {
+            emu_adc.pos = 0;
+            emu_adc.done_at += emu_adc_conv_cycles(emu_adc_channel(0));
+        } else {
+            emu_adc.busy = 0;
+        }
+    }
+
+    r->SR = emu_adc.sr;
+    emu_adc.sr_shadow = emu_adc.sr;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// I2C1 (master verici) + DMA1 Stream6 + PCF8574
+
+static uint64_t emu_i2c_byte_cycles(void)
+{
+    uint32_t ccr = fake_I2C1.CCR & 0xFFF;
+
+    if (ccr == 0) ccr = CLOCK_PCLK1_HZ / (2 * 100000);
+    return (uint64_t)18 * ccr * (CLOCK_SYSCLK_HZ / CLOCK_PCLK1_HZ);    // 9 bit, bit başına SCL HIGH + LOW = 2 × CCR
+}
+
+static void emu_pcf_output(uint8_t v)
+{
+    if (emu_lcd && emu_lcd_wiring == EMU_LCD_PCF8574) {
+        hd44780_pins(emu_lcd, emu_ns(), v & LCD_PCF_RS, v & LCD_PCF_E, v & 0xF0);
+    }
+}
+
+static void emu_i2c_shift(uint8_t byte)
+{
+    emu_i2c.shifting = 1;
+    emu_i2c.shift_byte = byte;
+    emu_i2c.until = fake_cycles + emu_i2c_byte_cycles();
+    emu_i2c.sr1 &= ~I2C_SR1_BTF;
+}
+
+static void emu_i2c_write_dr(uint8_t byte)
+{
+    if (emu_i2c.state == EMU_I2C_SB) {          // Adres baytı: SB, SR1 okuması + DR yazımıyla temizlenir
+        emu_i2c.sr1 &= ~I2C_SR1_SB;
+        emu_i2c.state = EMU_I2C_ADDR_TX;
+        emu_i2c.until = fake_cycles + emu_i2c_byte_cycles();
+        emu_i2c.bytes++;
+    } else if (emu_i2c.state == EMU_I2C_DATA) {
+        if (!emu_i2c.shifting) emu_i2c_shift(byte);
+        else if (!emu_i2c.dr_full) { emu_i2c.dr_full = 1; emu_i2c.dr_byte = byte; }
+        else emu_i2c.sr1 |= I2C_SR1_OVR;
+    }
+}
+
+static void emu_i2c_update(void* periph)
+{
+    I2C_TypeDef* r = &fake_I2C1;
+
+    if (!(r->CR1 & I2C_CR1_PE) || (r->CR1 & I2C_CR1_SWRST)) {
+        uint8_t present = emu_i2c.present, stuck = emu_i2c.stuck;
+        uint32_t bytes = emu_i2c.bytes;
+        memset(&emu_i2c, 0, sizeof(emu_i2c));
+        emu_i2c.present = present;
+        emu_i2c.stuck = stuck;
+        emu_i2c.bytes = bytes;
+        r->SR1 = r->SR2 = 0;
+        r->DR = EMU_I2C_DR_EMPTY;
+        r->CR1 &= ~(I2C_CR1_START | I2C_CR1_STOP);
+        return;
+    }
+
+    if (r->SR1 != emu_i2c.sr1_shadow) emu_i2c.sr1 &= r->SR1 | ~EMU_I2C_ERRORS;     // Sadece hata bitleri rc_w0
+
+    if (r->DR != EMU_I2C_DR_EMPTY) {            // Yazılım DR'ye yazdı
+        uint8_t byte = (uint8_t)r->DR;
+        r->DR = EMU_I2C_DR_EMPTY;
+        emu_i2c_write_dr(byte);
+    }
+
+    if ((r->CR1 & I2C_CR1_START) && emu_i2c.state != EMU_I2C_START && !emu_i2c.stuck) {
+        emu_i2c.state = EMU_I2C_START;
+        emu_i2c.shifting = 0;
+        emu_i2c.dr_full = 0;
+        emu_i2c.until = fake_cycles + emu_i2c_byte_cycles() / 9;
+    }
+    if (emu_i2c.stuck && (r->CR1 & I2C_CR1_START)) r->SR2 |= 2;    // BUSY: hat serbest kalmadığı için START bekler
+
+    switch (emu_i2c.state) {
+    case EMU_I2C_START:
+        if (fake_cycles >= emu_i2c.until) {
+            emu_i2c.sr1 |= I2C_SR1_SB;
+            emu_i2c.sr1 &= ~(I2C_SR1_BTF | I2C_SR1_TXE | I2C_SR1_ADDR);
+            r->SR2 = 3;                         // MSL | BUSY
+            r->CR1 &= ~I2C_CR1_START;
+            emu_i2c.state = EMU_I2C_SB;
+        }
+        break;
+
+    case EMU_I2C_ADDR_TX:
+        if (fake_cycles >= emu_i2c.until) {
+            if (emu_i2c.present) {
+                emu_i2c.sr1 |= I2C_SR1_ADDR;
+                emu_i2c.addr_reads = 0;
+                emu_i2c.state = EMU_I2C_ADDR_WAIT;
+            } else {
+                emu_i2c.sr1 |= I2C_SR1_AF;      // Adres cevapsız
+                emu_i2c.state = EMU_I2C_NACK;
+            }
+        }
+        break;
+
+    case EMU_I2C_ADDR_WAIT:
+        if (emu_i2c.addr_reads >= 2) {          // SR1 ve ardından SR2 okundu (bir önceki erişim SR2 idi)
+            emu_i2c.sr1 &= ~I2C_SR1_ADDR;
+            emu_i2c.state = EMU_I2C_DATA;
+        }
+        break;
+
+    case EMU_I2C_DATA:
+        if (emu_i2c.shifting && fake_cycles >= emu_i2c.until) {
+            emu_i2c.shifting = 0;
+            emu_i2c.bytes++;
+            emu_pcf_output(emu_i2c.shift_byte);     // PCF8574 çıkışı ACK ile değişir
+            if (emu_i2c.dr_full) {
+                emu_i2c.dr_full = 0;
+                emu_i2c_shift(emu_i2c.dr_byte);
+            } else {
+                emu_i2c.sr1 |= I2C_SR1_BTF;
+            }
+        }
+        emu_dma_flags(&emu_dma_i2c);
+        if ((r->CR2 & I2C_CR2_DMAEN) && !emu_i2c.dr_full && emu_dma_ready(&emu_dma_i2c)) {
+            emu_i2c_write_dr(*(volatile uint8_t*)emu_dma_next(&emu_dma_i2c, 1));
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    if (emu_i2c.state == EMU_I2C_ADDR_WAIT && periph == &fake_I2C1) emu_i2c.addr_reads++;
+
+    if ((r->CR1 & I2C_CR1_STOP) && !(emu_i2c.state == EMU_I2C_DATA && (emu_i2c.shifting || emu_i2c.dr_full))) {
+        emu_i2c.state = EMU_I2C_IDLE;           // Son bayt hatta çıktıktan sonra STOP
+        emu_i2c.sr1 &= ~(I2C_SR1_SB | I2C_SR1_ADDR | I2C_SR1_BTF | I2C_SR1_TXE);
+        r->SR2 = 0;
+        r->CR1 &= ~I2C_CR1_STOP;
+    }
+
+    if (emu_i2c.state == EMU_I2C_DATA && !emu_i2c.dr_full) emu_i2c.sr1 |= I2C_SR1_TXE;
+    else emu_i2c.sr1 &= ~I2C_SR1_TXE;
+
+    r->SR1 = emu_i2c.sr1;
+    emu_i2c.sr1_shadow = emu_i2c.sr1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// NVIC
+
+static int emu_priority(int v)
+{
+    return v < 16 ? fake_sys_priority[v] : fake_irq_priority[v - 16];
+}
+
+static void emu_set_pending(int v, uint8_t level)
+{
+    if (level && !emu_pending[v] && emu_stats[v].pending_since == 0) emu_stats[v].pending_since = fake_cycles | 1;
+    emu_pending[v] = level;
+}
+
+static void emu_dispatch(void)
+{
+    for (;;) {
+        if (fake_primask) return;
+
+        int best = -1;
+        int best_prio = emu_active_prio;
+        for (int v = 0; v < EMU_VECTORS; v++) {
+            if (!emu_pending[v] || !emu_vector[v]) continue;
+            if (v >= 16 && !fake_irq_enabled[v - 16]) continue;
+            if (emu_priority(v) < best_prio) {
+                best = v;
+                best_prio = emu_priority(v);
+            }
+        }
+        if (best < 0) return;
+
+        emu_irq_stats_t* s = &emu_stats[best];
+        uint64_t latency = EMU_NS(fake_cycles - (s->pending_since & ~1ull));
+        if (latency > s->latency_max_ns) s->latency_max_ns = latency;
+        s->pending_since = 0;
+        s->count++;
+        if (best == EMU_VECTOR(SysTick_IRQn)) emu_systick_pending = 0;     // İstisna girişte temizlenir
+        emu_pending[best] = 0;
+
+        int saved = emu_active_prio;
+        emu_active_prio = best_prio;
+        emu_vector[best]();
+        emu_active_prio = saved;
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+
+static void emu_hook(void* periph)
+{
+    if (fake_primask && !emu_primask_was) {
+        emu_primask_since = fake_cycles;
+    } else if (!fake_primask && emu_primask_was) {
+        uint64_t d = EMU_NS(fake_cycles - emu_primask_since);
+        if (d > emu_primask_max) emu_primask_max = d;
+    }
+    emu_primask_was = (uint8_t)fake_primask;
+
+    fake_gpio_apply(&fake_GPIOA);
+    fake_gpio_apply(&fake_GPIOB);
+    fake_gpio_apply(&fake_GPIOC);
+    fake_gpio_apply(&fake_GPIOD);
+    emu_lcd_update();
+
+    emu_systick_update();
+    emu_tim_update(&emu_tim2, 1);
+    emu_dma_flags(&emu_dma_adc);
+    emu_adc_update(emu_tim_update(&emu_tim3, 0));
+    emu_i2c_update(periph);
+
+    emu_set_pending(EMU_VECTOR(SysTick_IRQn), emu_systick_pending);
+    emu_set_pending(EMU_VECTOR(TIM2_IRQn), (emu_tim2.sr & fake_TIM2.DIER & (TIM_SR_UIF | TIM_SR_CC1IF)) != 0);
+    emu_set_pending(EMU_VECTOR(TIM3_IRQn), (emu_tim3.sr & fake_TIM3.DIER & (TIM_SR_UIF | TIM_SR_CC1IF)) != 0);
+    emu_set_pending(EMU_VECTOR(ADC_IRQn), ((emu_adc.sr & ADC_SR_AWD) && (fake_ADC1.CR1 & ADC_CR1_AWDIE)) ||
+                                          ((emu_adc.sr & ADC_SR_EOC) && (fake_ADC1.CR1 & (1u << 5))));
+    emu_set_pending(EMU_VECTOR(DMA2_Stream0_IRQn), emu_dma_irq(&emu_dma_adc));
+    emu_set_pending(EMU_VECTOR(DMA1_Stream6_IRQn), emu_dma_irq(&emu_dma_i2c));
+    emu_set_pending(EMU_VECTOR(I2C1_EV_IRQn), (fake_I2C1.CR2 & I2C_CR2_ITEVTEN) &&
+                                              (emu_i2c.sr1 & (I2C_SR1_SB | I2C_SR1_ADDR | I2C_SR1_BTF)));
+    emu_set_pending(EMU_VECTOR(I2C1_ER_IRQn), (fake_I2C1.CR2 & I2C_CR2_ITERREN) && (emu_i2c.sr1 & EMU_I2C_ERRORS));
+
+    emu_dispatch();
+}
+
+void emu_init(void)
+{
+    fake_reset();
+    memset(emu_vector, 0, sizeof(emu_vector));
+    memset(emu_stats, 0, sizeof(emu_stats));
+    memset(emu_pending, 0, sizeof(emu_pending));
+    memset(&emu_adc, 0, sizeof(emu_adc));
+    memset(&emu_i2c, 0, sizeof(emu_i2c));
+    emu_active_prio = EMU_THREAD_PRIO;
+    emu_primask_was = 0;
+    emu_primask_max = 0;
+    emu_systick_next = 0;
+    emu_systick_pending = 0;
+    emu_tim2 = (emu_tim_t){ .r = &fake_TIM2 };
+    emu_tim3 = (emu_tim_t){ .r = &fake_TIM3 };
+    emu_dma_adc = (emu_dma_t){ .d = &fake_DMA2, .s = &fake_DMA2_Stream0, .isr = &fake_DMA2.LISR, .ifcr = &fake_DMA2.LIFCR, .shift = 0 };
+    emu_dma_i2c = (emu_dma_t){ .d = &fake_DMA1, .s = &fake_DMA1_Stream6, .isr = &fake_DMA1.HISR, .ifcr = &fake_DMA1.HIFCR, .shift = 16 };
+    emu_adc_source = 0;
+    emu_lcd = 0;
+    emu_lcd_wiring = EMU_LCD_NONE;
+    emu_i2c.present = 1;
+    fake_I2C1.DR = EMU_I2C_DR_EMPTY;
+    fake_hook = emu_hook;
+}
+
+uint64_t emu_ns(void)
+{
+    return EMU_NS(fake_cycles);
+}
+
+void emu_run_us(uint32_t us)
+{
+    uint64_t end = fake_cycles + (uint64_t)us * CLOCK_CYCLES_PER_US;
+
+    while (fake_cycles < end) {
+        uint64_t step = end - fake_cycles;
+        fake_advance(step < EMU_STEP_CYCLES ? step : EMU_STEP_CYCLES);
+    }
+}
+
+void emu_irq_attach(IRQn_Type irq, void (*handler)(void))
+{
+    emu_vector[EMU_VECTOR(irq)] = handler;
+}
+
+const emu_irq_stats_t* emu_irq_stats(IRQn_Type irq)
+{
+    return &emu_stats[EMU_VECTOR(irq)];
+}
+
+uint64_t emu_primask_max_ns(void)
+{
+    return emu_primask_max;
+}
+
+void emu_adc_set_source(emu_adc_source_t source)
+{
+    emu_adc_source = source;
+}
+
+void emu_adc_dma_error(void)
+{
+    emu_dma_adc.flags |= EMU_DMA_TE;
+    fake_DMA2_Stream0.CR &= ~DMA_SxCR_EN;      // Donanım hata olunca stream'i kapatır
+    emu_dma_adc.en = 0;
+}
+
+void emu_lcd_attach(hd44780_t* lcd, emu_lcd_wiring_t wiring)
+{
+    emu_lcd = lcd;
+    emu_lcd_wiring = wiring;
+    emu_lcd_pins = 0;
+    hd44780_reset(lcd, wiring == EMU_LCD_GPIO8, emu_ns());
+}
+
+void emu_pcf_set_present(uint8_t present)
+{
+    emu_i2c.present = present;
+}
+
+void emu_i2c_set_stuck(uint8_t stuck)
+{
+    emu_i2c.stuck = stuck;
+}
+
+uint32_t emu_i2c_bytes(void)
+{
+    return emu_i2c.bytes;
+}
+
+void delay_ms(uint32_t ms)
+{
+    emu_run_us(ms * 1000);
+}
+
+uint32_t millis(void)
+{
+    return (uint32_t)(fake_cycles / (CLOCK_SYSCLK_HZ / 1000));
+}
+
+/*
+
+Çevre birimi modelleri
+
+fake_stm32.c her register erişiminde sanal saati 1 cycle ilerletir ve emu_hook()'u çağırır. Kanca erişimden önce
+çalışır; bu yüzden bir yazımın etkisi bir sonraki erişimde görülür (gerçek çekirdekte de store, veri yolu üzerinden
+birkaç cycle sonra çevre birimine ulaşır). Modeller fake_* yapılarına doğrudan erişir, kendi erişimleri saat ilerletmez.
+
+	GPIO      BSRR yazımı ODR'ye işlenir. Panel bağlıysa RS / E / veri pinleri HD44780 modeline verilir.
+	SysTick   LOAD + 1 cycle'da bir istisna (TICKINT açıksa).
+	TIM2/TIM3 Sayaç sanal saatten hesaplanır (APB1 timer saati, PSC). CNT'ye yazılım yazarsa oradan devam eder.
+	          TIM2: CCR1 geçilince CC1IF. TIM3: update olayı MMS = 010 ise ADC'yi tetikler (dönüşüm adımın
+	          sonundan değil update anından başlar). SR rc_w0'dır.
+	ADC1      SWSTART, TIM3 TRGO veya CONT ile başlar; her dönüşüm (SMPx + 12) ADC saati sürer. Değer
+	          emu_adc_set_source() ile verilen fonksiyondan (kanal, zaman) gelir. Analog watchdog HTR / LTR ile denetlenir,
+	          DMA biti açıksa DMA2 Stream0 dairesel tampona yazar (HT / TC bayrakları).
+	I2C1      START → SB, adres → ADDR (SR1 + SR2 okumasıyla temizlenir) veya AF (kart yok), veri → TXE / BTF,
+	          STOP son bayt hatta çıkınca işlenir. Bayt başına 9 bit süresi CCR'den hesaplanır. DMAEN açıksa
+	          DMA1 Stream6 TXE boşaldıkça DR'yi doldurur. Hatta çıkan her veri baytı PCF8574'ün çıkışıdır.
+	NVIC      Bayrak + etkinleştirme seviyesiyle bekleyen kesme bulunur. PRIMASK = 0 ise ve öncelik çalışan koddan
+	          yüksekse işleyici kancanın içinden çağrılır; işleyicinin kendi erişimleri de kancadan geçtiği için
+	          daha öncelikli bir kesme onu da kesebilir (iç içe kesme).
+
+DMA adresleri:
+	Firmware DMA adreslerini (uint32_t) olarak yazar. Testler -no-pie ile bağlandığı için statik tamponlar 4 GB'ın
+	altındadır ve M0AR'daki değer doğrudan işaretçiye çevrilebilir. Yığındaki tamponlar DMA'ya verilmemelidir.
+
+delay_ms():
+	delay.c'deki sürüm SysTick'in artırdığı bir RAM sayacını okur; register erişimi olmadığı için sanal saat ilerlemezdi.
+	Testler delay.c yerine buradaki sürümü bağlar: süre kadar sanal zaman ilerler, kesmeler bu sırada çalışır.
+	DWT_Delay_us() / DWT_Delay_ns() (delay.h) DWT->CYCCNT okuduğu için değişmeden kullanılır.
+
+*/
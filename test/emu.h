@@ -0,0 +1,45 @@
+#ifndef __EMU__               // Bilgisayar testleri için çevre birimi modelleri (header guard başlangıcı)
+#define __EMU__
+
+#include <stdint.h>
+#include "stm32f4xx.h"
+#include "clock_config.h"
+#include "hd44780.h"
+
+#define EMU_NS(cycles)          ((uint64_t)(cycles) * 1000000000ull / CLOCK_SYSCLK_HZ)
+#define EMU_CYCLES(ns)          ((uint64_t)(ns) * CLOCK_SYSCLK_HZ / 1000000000ull)
+#define EMU_IRQ_COUNT           96
+
+typedef uint16_t (*emu_adc_source_t)(uint8_t channel, uint64_t now_ns);   // 12-bit ADC girişi (senaryo)
+
+typedef enum {
+    EMU_LCD_NONE,
+    EMU_LCD_GPIO4,              // RS = PA1, E = PA3, D4-D7 = PB4-PB7
+    EMU_LCD_GPIO8,              // Ayrıca D0-D3 = PB12-PB15
+    EMU_LCD_PCF8574             // I2C1 üzerinde PCF8574 sırt kartı (P0 = RS, P2 = E, P4-P7 = D4-D7)
+} emu_lcd_wiring_t;
+
+typedef struct {
+    uint32_t count;             // İşleyicinin çağrılma sayısı
+    uint64_t latency_max_ns;    // Bekleme (pending) anından işleyiciye girişe kadar en uzun süre
+    uint64_t pending_since;     // cycle, 0: beklemiyor
+} emu_irq_stats_t;
+
+void emu_init(void);                                            // Register'ları, saati ve modelleri sıfırlar, kancayı kurar
+uint64_t emu_ns(void);                                          // Sanal zaman
+void emu_run_us(uint32_t us);                                   // CPU boşta bekler gibi zamanı ilerletir (kesmeler çalışır)
+void emu_irq_attach(IRQn_Type irq, void (*handler)(void));      // Vektör tablosu (SysTick_IRQn dahil)
+const emu_irq_stats_t* emu_irq_stats(IRQn_Type irq);
+uint64_t emu_primask_max_ns(void);                              // En uzun kesintisiz PRIMASK = 1 süresi
+void emu_adc_set_source(emu_adc_source_t source);
+void emu_adc_dma_error(void);                                   // DMA2 Stream0'da transfer hatası (TEIF0) oluşturur
+void emu_lcd_attach(hd44780_t* lcd, emu_lcd_wiring_t wiring);   // Paneli bağlar ve o anda gücü verir
+void emu_pcf_set_present(uint8_t present);                      // 0: adres NACK alır (kart takılı değil)
+void emu_i2c_set_stuck(uint8_t stuck);                          // 1: SDA LOW'da kalmış, START hiç oluşmaz
+uint32_t emu_i2c_bytes(void);                                   // Hatta çıkan bayt sayısı (adres dahil)
+
+// delay.c yerine: firmware'in ms beklemeleri CPU-dışı bir sayacı (systick_ms) okur, sanal saat ilerlemez
+void delay_ms(uint32_t ms);
+uint32_t millis(void);
+
+#endif  // __EMU__            // Header guard bitişi
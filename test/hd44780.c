@@ -0,0 +1,186 @@
+#include <stdint.h>
+#include <string.h>
+#include "hd44780.h"
+
+static void hd44780_violate(hd44780_t* m, hd44780_violation_t v, uint64_t now_ns)
+{
+    if (hd44780_violation_total(m) == 0) {
+        m->first_violation = v;
+        m->first_violation_ns = now_ns;
+    }
+    m->violations[v]++;
+}
+
+void hd44780_reset(hd44780_t* m, uint8_t wired8, uint64_t now_ns)
+{
+    memset(m, 0, sizeof(*m));
+    memset(m->ddram, 0xA5, sizeof(m->ddram));   // Açılışta DDRAM içeriği belirsizdir: clear gelmezse testte görünür
+    m->wired8 = wired8;
+    m->dl8 = 1;
+    m->inc = 1;
+    m->power_ns = now_ns;
+    m->t_rs = m->t_data = now_ns;
+}
+
+static uint8_t hd44780_next_ddram(uint8_t ac, uint8_t inc)
+{
+    if (inc) {
+        ac++;
+        if (ac == 0x28) return 0x40;            // 2 satırlı modda 1. satır 0x27'de biter
+        if (ac == 0x68) return 0x00;
+    } else {
+        if (ac == 0x00) return 0x67;
+        if (ac == 0x40) return 0x27;
+        ac--;
+    }
+    return ac;
+}
+
+static void hd44780_execute(hd44780_t* m, uint64_t now_ns, uint8_t rs, uint8_t v)
+{
+    uint64_t exec = HD44780_EXEC_NS;
+
+    if (rs) {
+        if (m->cg_mode) {
+            m->cgram[m->cg_addr] = v & 0x1F;
+            m->cg_addr = (m->cg_addr + (m->inc ? 1 : 63)) & 0x3F;
+        } else {
+            m->ddram[m->ac & 0x7F] = v;
+            m->ac = hd44780_next_ddram(m->ac, m->inc);
+        }
+        m->writes++;
+        exec = HD44780_EXEC_DATA_NS;
+    } else {
+        if (v & 0x80) {                         // Set DDRAM address
+            m->ac = v & 0x7F;
+            m->cg_mode = 0;
+        } else if (v & 0x40) {                  // Set CGRAM address
+            m->cg_addr = v & 0x3F;
+            m->cg_mode = 1;
+        } else if (v & 0x20) {                  // Function set
+            m->dl8 = (v >> 4) & 1;
+            m->lines2 = (v >> 3) & 1;
+            m->half = 0;
+            if (m->init_count < 2) exec = m->init_count == 0 ? HD44780_INIT1_NS : HD44780_INIT2_NS;
+            m->init_count++;
+        } else if (v & 0x10) {                  // Cursor / display shift: sadece imleç kaydırma modellenir
+            if (!(v & 0x08)) m->ac = hd44780_next_ddram(m->ac, (v >> 2) & 1);
+        } else if (v & 0x08) {                  // Display on/off
+            m->display_on = (v >> 2) & 1;
+        } else if (v & 0x04) {                  // Entry mode
+            m->inc = (v >> 1) & 1;
+        } else if (v & 0x02) {                  // Return home
+            m->ac = 0;
+            m->cg_mode = 0;
+            exec = HD44780_EXEC_CLEAR_NS;
+        } else if (v & 0x01) {                  // Clear display
+            memset(m->ddram, ' ', sizeof(m->ddram));
+            m->ac = 0;
+            m->inc = 1;
+            m->cg_mode = 0;
+            exec = HD44780_EXEC_CLEAR_NS;
+        }
+        m->commands++;
+    }
+
+    m->busy_until = now_ns + exec;
+}
+
+static void hd44780_latch(hd44780_t* m, uint64_t now_ns)
+{
+    uint8_t d = m->wired8 ? m->data : (m->data & 0xF0);    // 4-bit bağlantıda D0-D3 boşta: 0 okunur
+
+    if (m->dl8) {
+        hd44780_execute(m, now_ns, m->rs, d);   // 8-bit arayüz: her darbe bütün bayt
+        return;
+    }
+    if (!m->half) {
+        m->hi = d & 0xF0;
+        m->hi_rs = m->rs;
+        m->half = 1;
+        return;
+    }
+    m->half = 0;
+    if (m->rs != m->hi_rs) hd44780_violate(m, HD44780_V_SETUP, now_ns);    // İki nibble farklı RS ile geldi
+    hd44780_execute(m, now_ns, m->rs, m->hi | (d >> 4));
+}
+
+void hd44780_pins(hd44780_t* m, uint64_t now_ns, uint8_t rs, uint8_t e, uint8_t data)
+{
+    rs = rs ? 1 : 0;
+    e = e ? 1 : 0;
+    if (!m->wired8) data &= 0xF0;
+
+    if (rs != m->rs || data != m->data) {
+        if (m->rose && !m->e && now_ns - m->t_fall < HD44780_T_H_NS) hd44780_violate(m, HD44780_V_HOLD, now_ns);
+        if (rs != m->rs && m->e) hd44780_violate(m, HD44780_V_SETUP, now_ns);   // RS darbe sırasında değişmemeli
+        if (rs != m->rs) m->t_rs = now_ns;
+        if (data != m->data) m->t_data = now_ns;
+        m->rs = rs;
+        m->data = data;
+    }
+
+    if (e && !m->e) {                           // Yükselen kenar
+        if (now_ns < m->power_ns + HD44780_POWER_ON_NS) hd44780_violate(m, HD44780_V_POWER, now_ns);
+        else if (now_ns < m->busy_until) hd44780_violate(m, HD44780_V_BUSY, now_ns);
+        if (m->rose && now_ns - m->t_rise < HD44780_T_CYC_E_NS) hd44780_violate(m, HD44780_V_CYCLE, now_ns);
+        if (now_ns - m->t_rs < HD44780_T_AS_NS) hd44780_violate(m, HD44780_V_SETUP, now_ns);
+        m->t_rise = now_ns;
+        m->rose = 1;
+    } else if (!e && m->e) {                    // Düşen kenar: veri burada okunur
+        if (now_ns - m->t_rise < HD44780_PW_EH_NS) hd44780_violate(m, HD44780_V_PULSE, now_ns);
+        if (now_ns - m->t_data < HD44780_T_DSW_NS) hd44780_violate(m, HD44780_V_SETUP, now_ns);
+        m->t_fall = now_ns;
+        hd44780_latch(m, now_ns);
+    }
+    m->e = e;
+}
+
+uint32_t hd44780_violation_total(const hd44780_t* m)
+{
+    uint32_t n = 0;
+
+    for (int i = 0; i < HD44780_V_COUNT; i++) n += m->violations[i];
+    return n;
+}
+
+const char* hd44780_violation_name(hd44780_violation_t v)
+{
+    static const char* const names[HD44780_V_COUNT] = { "setup", "hold", "pulse", "cycle", "busy", "power-on" };
+
+    return v < HD44780_V_COUNT ? names[v] : "?";
+}
+
+void hd44780_row(const hd44780_t* m, uint8_t row, char* out, uint8_t cols)
+{
+    for (uint8_t c = 0; c < cols; c++) {
+        out[c] = (char)m->ddram[(row ? 0x40 : 0x00) + c];
+    }
+    out[cols] = '\0';
+}
+
+uint8_t hd44780_glyph_row(const hd44780_t* m, uint8_t slot, uint8_t row)
+{
+    return m->cgram[((slot & 7) << 3) | (row & 7)];
+}
+
+/*
+
+Davranışsal HD44780 modeli (sadece yazma, RW = GND)
+
+Girdi pin durumudur: emu.c her GPIO veya PCF8574 çıkış değişiminde hd44780_pins() çağırır. Model kenarları kendisi bulur:
+	E yükselen kenar → güç açılışı, meşguliyet (busy), tcycE ve tAS denetlenir
+	E düşen kenar   → PWEH ve tDSW denetlenir, veri okunur
+	E düştükten sonra tH içinde RS / veri değişirse hold ihlali sayılır
+
+Arayüz genişliği denetleyicinin kendi durumudur: açılışta 8-bit'tir, 4-bit bağlantıda D0-D3 0 okunur. Bu yüzden
+başlatma dizisindeki tek nibble'lık 0x3 / 0x2 komutları gerçek panelde olduğu gibi tam komut olarak çalışır ve
+0x2'den sonra nibble çiftlemesi başlar. Yanlış sırada gönderilen bir nibble, gerçek panelde olduğu gibi sonraki bütün
+baytları kaydırır ve DDRAM içeriğinde görünür.
+
+Komut süreleri (busy_until) son E düşen kenarından itibaren sayılır. İlk iki function set datasheet'teki
+"initialization by instruction" sürelerini (4.1 ms, 100 µs) ister.
+
+DDRAM açılışta 0xA5 ile doldurulur; clear görmeden yazılmamış bir hücre testte hemen fark edilir.
+
+*/
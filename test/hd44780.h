@@ -0,0 +1,69 @@
+#ifndef __HD44780_MODEL__     // Bilgisayar testleri için davranışsal HD44780 modeli (header guard başlangıcı)
+#define __HD44780_MODEL__
+
+#include <stdint.h>
+
+// Modelin denetlediği sınırlar: HD44780U datasheet, fosc = 270 kHz (sürücünün lcd_timing.h'ından bağımsız tutulur)
+#define HD44780_T_AS_NS         60          // RS, E yükselmeden önce sabit
+#define HD44780_T_DSW_NS        195         // Veri, E düşmeden önce sabit
+#define HD44780_T_H_NS          10          // Veri / RS, E düştükten sonra sabit
+#define HD44780_PW_EH_NS        450         // E HIGH darbe genişliği
+#define HD44780_T_CYC_E_NS      1000        // İki E yükselen kenarı arası
+#define HD44780_EXEC_CLEAR_NS   1520000     // Clear Display / Return Home
+#define HD44780_EXEC_NS         37000       // Diğer komutlar
+#define HD44780_EXEC_DATA_NS    41000       // Veri yazımı: 37 µs + adres sayacı güncellemesi (tADD) 4 µs
+#define HD44780_POWER_ON_NS     15000000ull // VCC 4.5 V'a çıktıktan sonra ilk komuta kadar
+#define HD44780_INIT1_NS        4100000     // "Initialization by instruction": ilk 0x3x'ten sonra
+#define HD44780_INIT2_NS        100000      // İkinci 0x3x'ten sonra
+
+typedef enum {
+    HD44780_V_SETUP,            // tAS / tDSW
+    HD44780_V_HOLD,             // tH: E düştükten hemen sonra pin değişti
+    HD44780_V_PULSE,            // PWEH
+    HD44780_V_CYCLE,            // tcycE
+    HD44780_V_BUSY,             // Önceki komut bitmeden E yükseldi
+    HD44780_V_POWER,            // Güç açılışı beklenmeden E yükseldi
+    HD44780_V_COUNT
+} hd44780_violation_t;
+
+typedef struct {
+    uint8_t wired8;             // D0-D3 bağlı (8-bit bağlantı); 0 ise D0-D3 okunurken 0 kabul edilir
+
+    // Pin durumu ve son değişim zamanları (ns)
+    uint8_t rs, e, data;
+    uint64_t t_rs, t_data, t_rise, t_fall;
+    uint8_t rose;               // En az bir E darbesi görüldü
+
+    // Denetleyicinin iç durumu
+    uint8_t dl8;                // Arayüz: 1 = 8-bit (açılıştaki durum), 0 = 4-bit
+    uint8_t half;               // 4-bit modda yüksek nibble alındı, düşük nibble bekleniyor
+    uint8_t hi;                 // Alınan yüksek nibble
+    uint8_t hi_rs;
+    uint8_t init_count;         // Açılıştan beri çalıştırılan function set sayısı (init-by-instruction süreleri)
+    uint8_t ac;                 // DDRAM adres sayacı
+    uint8_t cg_addr;            // CGRAM adres sayacı
+    uint8_t cg_mode;            // Son adres komutu CGRAM'i seçti
+    uint8_t inc;                // Entry mode I/D
+    uint8_t display_on;
+    uint8_t lines2;
+    uint8_t ddram[0x80];
+    uint8_t cgram[64];
+    uint64_t power_ns;          // Güç verildiği an
+    uint64_t busy_until;        // Son komutun bittiği an
+
+    // Sayaçlar
+    uint32_t commands;          // Çalıştırılan komut sayısı
+    uint32_t writes;            // Çalıştırılan veri yazımı
+    uint32_t violations[HD44780_V_COUNT];
+    uint64_t first_violation_ns;
+    hd44780_violation_t first_violation;
+} hd44780_t;
+
+void hd44780_reset(hd44780_t* m, uint8_t wired8, uint64_t now_ns);  // Güç açılışı: 8-bit mod, DDRAM boşluk değil (rastgele) kabul edilir
+void hd44780_pins(hd44780_t* m, uint64_t now_ns, uint8_t rs, uint8_t e, uint8_t data);  // Pin durumu (data: D7..D0)
+uint32_t hd44780_violation_total(const hd44780_t* m);
+const char* hd44780_violation_name(hd44780_violation_t v);
+void hd44780_row(const hd44780_t* m, uint8_t row, char* out, uint8_t cols);     // Görünen satır (kaydırma yok), out cols + 1 bayt
+uint8_t hd44780_glyph_row(const hd44780_t* m, uint8_t slot, uint8_t row);        // CGRAM deseni
+
+#endif  // __HD44780_MODEL__  // Header guard bitişi
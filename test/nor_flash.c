@@ -0,0 +1,130 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "nor_flash.h"
+
+// flash.h'nin RAM üzerindeki modeli: programlama sadece 1 → 0 yönünde bit değiştirir, silme sektörü FFFFFFFF yapar.
+// nor_cut_after() ile seçilen işlemin ortasında elektrik kesilir: programlanan kelimenin bitlerinin bir kısmı, silinen
+// sektörün kelimelerinin bir kısmı değişmiş kalır ve kontrol longjmp ile teste döner.
+
+static uint32_t nor_mem[NOR_SECTORS][NOR_SECTOR_SIZE / 4];
+static uint32_t nor_erase_count[NOR_SECTORS];
+static uint32_t nor_overwrite_count;
+static long nor_op_count;
+static long nor_cut = -1;
+static jmp_buf* nor_jump;
+static uint32_t nor_rand = 1;
+
+static uint32_t nor_random(void)
+{
+    nor_rand = nor_rand * 1664525u + 1013904223u;
+    return nor_rand;
+}
+
+static uint32_t* nor_word(uint32_t address)
+{
+    uint32_t sector;
+
+    for (sector = NOR_FIRST_SECTOR; sector < NOR_FIRST_SECTOR + NOR_SECTORS; sector++) {
+        uint32_t base = flash_sector_address((uint8_t)sector);
+        if (address >= base && address < base + NOR_SECTOR_SIZE) {
+            if (address & 3) break;
+            return &nor_mem[sector - NOR_FIRST_SECTOR][(address - base) / 4];
+        }
+    }
+    printf("nor: modellenmeyen adres %08x\n", address);
+    exit(1);
+}
+
+static uint8_t nor_cut_now(void)                // 1: bu işlem yarıda kesilecek
+{
+    nor_op_count++;
+    return nor_cut >= 0 && nor_cut-- == 0;
+}
+
+void nor_reset(uint32_t fill)
+{
+    for (int s = 0; s < NOR_SECTORS; s++) {
+        for (int i = 0; i < NOR_SECTOR_SIZE / 4; i++) nor_mem[s][i] = fill;
+        nor_erase_count[s] = 0;
+    }
+    nor_overwrite_count = 0;
+    nor_op_count = 0;
+    nor_cut = -1;
+}
+
+void nor_cut_after(long ops, jmp_buf* jump)
+{
+    nor_cut = ops;
+    nor_jump = jump;
+}
+
+long nor_ops(void)
+{
+    return nor_op_count;
+}
+
+uint32_t nor_erases(uint8_t sector)
+{
+    return nor_erase_count[sector - NOR_FIRST_SECTOR];
+}
+
+uint32_t nor_overwrites(void)
+{
+    return nor_overwrite_count;
+}
+
+void flash_unlock(void)
+{
+}
+
+void flash_lock(void)
+{
+}
+
+uint8_t flash_erase_sector(uint8_t sector)
+{
+    uint32_t* mem = nor_word(flash_sector_address(sector));
+
+    if (nor_cut_now()) {
+        for (int i = 0; i < NOR_SECTOR_SIZE / 4; i++) {
+            if (nor_random() & 0x100) mem[i] = 0xFFFFFFFFu;     // Kelimelerin bir kısmı silinmiş, kalanı eski
+        }
+        longjmp(*nor_jump, 1);
+    }
+    memset(mem, 0xFF, NOR_SECTOR_SIZE);
+    nor_erase_count[sector - NOR_FIRST_SECTOR]++;
+    return 0;
+}
+
+uint8_t flash_program_word(uint32_t address, uint32_t data)
+{
+    uint32_t* w = nor_word(address);
+
+    if (*w != 0xFFFFFFFFu) nor_overwrite_count++;
+    if (nor_cut_now()) {
+        *w &= data | nor_random();                              // Sıfırlanacak bitlerin bir kısmı sıfırlandı
+        longjmp(*nor_jump, 1);
+    }
+    *w &= data;
+    return (*w == data) ? 0 : 1;                                // flash.c gibi geri okuyarak doğrula
+}
+
+uint32_t flash_read_word(uint32_t address)
+{
+    return *nor_word(address);
+}
+
+uint32_t flash_sector_address(uint8_t sector)
+{
+    if (sector < 4)  return 0x08000000U + (uint32_t)sector * 0x4000U;
+    if (sector == 4) return 0x08010000U;
+    return 0x08020000U + (uint32_t)(sector - 5) * 0x20000U;
+}
+
+uint32_t flash_sector_size(uint8_t sector)
+{
+    (void)sector;
+    return NOR_SECTOR_SIZE;
+}
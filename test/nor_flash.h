@@ -0,0 +1,18 @@
+#ifndef __NOR_FLASH__         // Bilgisayar testleri için flash.h'nin NOR modeli (header guard başlangıcı)
+#define __NOR_FLASH__
+
+#include <stdint.h>
+#include <setjmp.h>
+#include "flash.h"
+
+#define NOR_FIRST_SECTOR        8               // Modellenen sektörler: 8-11 (geçmiş halkası + kalibrasyon)
+#define NOR_SECTORS             4
+#define NOR_SECTOR_SIZE         1024            // Gerçeği 128 KB; küçük sektör dolma / dönme durumlarını hızlandırır
+
+void nor_reset(uint32_t fill);                                  // Bütün sektörleri fill ile doldurur (FFFFFFFF: silinmiş)
+void nor_cut_after(long ops, jmp_buf* jump);                    // ops işlemden sonra kesinti: longjmp (-1: kapalı)
+long nor_ops(void);                                             // Toplam programlama + silme sayısı
+uint32_t nor_erases(uint8_t sector);                            // Sektörün silinme sayısı
+uint32_t nor_overwrites(void);                                  // Silinmemiş kelimeye programlama denemesi
+
+#endif  // __NOR_FLASH__      // Header guard bitişi
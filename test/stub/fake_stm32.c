@@ -0,0 +1,134 @@
+#include <stdint.h>
+#include <string.h>
+#include "stm32f4xx.h"
+
+GPIO_TypeDef fake_GPIOA, fake_GPIOB, fake_GPIOC, fake_GPIOD;
+RCC_TypeDef fake_RCC;
+ADC_TypeDef fake_ADC1;
+ADC_Common_TypeDef fake_ADC;
+DMA_TypeDef fake_DMA1, fake_DMA2;
+DMA_Stream_TypeDef fake_DMA1_Stream3, fake_DMA1_Stream6, fake_DMA2_Stream0;
+TIM_TypeDef fake_TIM2, fake_TIM3, fake_TIM6;
+FLASH_TypeDef fake_FLASH;
+PWR_TypeDef fake_PWR;
+USART_TypeDef fake_USART3;
+I2C_TypeDef fake_I2C1;
+SysTick_Type fake_SysTick;
+DWT_Type fake_DWT;
+CoreDebug_Type fake_CoreDebug;
+SCB_Type fake_SCB;
+
+uint64_t fake_cycles;
+uint32_t fake_cycles_per_access = 1;
+void (*fake_hook)(void* periph);
+
+uint32_t fake_primask;
+uint8_t fake_irq_enabled[96];
+uint8_t fake_irq_priority[96];
+uint8_t fake_sys_priority[16];
+
+void fake_advance(uint64_t cycles)
+{
+    fake_cycles += cycles;
+    fake_DWT.CYCCNT = (uint32_t)fake_cycles;    // 32-bit donanım sayacı gibi taşar
+    if (fake_hook) fake_hook(0);
+}
+
+void* fake_access(void* periph)
+{
+    fake_cycles += fake_cycles_per_access;
+    fake_DWT.CYCCNT = (uint32_t)fake_cycles;
+    if (fake_hook) fake_hook(periph);           // Kanca kesme işleyicisi çağırabilir; modeller fake_* yapılarına doğrudan erişir
+    return periph;
+}
+
+void fake_reset(void)
+{
+    memset(&fake_GPIOA, 0, sizeof(fake_GPIOA));
+    memset(&fake_GPIOB, 0, sizeof(fake_GPIOB));
+    memset(&fake_GPIOC, 0, sizeof(fake_GPIOC));
+    memset(&fake_GPIOD, 0, sizeof(fake_GPIOD));
+    memset(&fake_RCC, 0, sizeof(fake_RCC));
+    memset(&fake_ADC1, 0, sizeof(fake_ADC1));
+    memset(&fake_ADC, 0, sizeof(fake_ADC));
+    memset(&fake_DMA1, 0, sizeof(fake_DMA1));
+    memset(&fake_DMA2, 0, sizeof(fake_DMA2));
+    memset(&fake_DMA1_Stream3, 0, sizeof(fake_DMA1_Stream3));
+    memset(&fake_DMA1_Stream6, 0, sizeof(fake_DMA1_Stream6));
+    memset(&fake_DMA2_Stream0, 0, sizeof(fake_DMA2_Stream0));
+    memset(&fake_TIM2, 0, sizeof(fake_TIM2));
+    memset(&fake_TIM3, 0, sizeof(fake_TIM3));
+    memset(&fake_TIM6, 0, sizeof(fake_TIM6));
+    memset(&fake_FLASH, 0, sizeof(fake_FLASH));
+    memset(&fake_PWR, 0, sizeof(fake_PWR));
+    memset(&fake_USART3, 0, sizeof(fake_USART3));
+    memset(&fake_I2C1, 0, sizeof(fake_I2C1));
+    memset(&fake_SysTick, 0, sizeof(fake_SysTick));
+    memset(&fake_DWT, 0, sizeof(fake_DWT));
+    memset(&fake_CoreDebug, 0, sizeof(fake_CoreDebug));
+    memset(&fake_SCB, 0, sizeof(fake_SCB));
+    memset(fake_irq_enabled, 0, sizeof(fake_irq_enabled));
+    memset(fake_irq_priority, 0, sizeof(fake_irq_priority));
+    memset(fake_sys_priority, 0, sizeof(fake_sys_priority));
+    fake_cycles = 0;
+    fake_cycles_per_access = 1;
+    fake_hook = 0;
+    fake_primask = 0;
+}
+
+uint32_t fake_gpio_apply(GPIO_TypeDef* g)
+{
+    uint32_t b = g->BSRR;                       // Donanımda BSRR yazılınca hemen uygulanır ve 0 okunur
+
+    if (b) {
+        g->ODR = (g->ODR & ~(b >> 16)) | (b & 0xFFFFu);    // Set, reset'e göre önceliklidir (RM0090 8.4.7)
+        g->BSRR = 0;
+    }
+    return g->ODR;
+}
+
+void NVIC_EnableIRQ(IRQn_Type irq)
+{
+    if (irq >= 0) fake_irq_enabled[irq] = 1;
+}
+
+void NVIC_DisableIRQ(IRQn_Type irq)
+{
+    if (irq >= 0) fake_irq_enabled[irq] = 0;
+}
+
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority)
+{
+    if (irq >= 0) fake_irq_priority[irq] = (uint8_t)priority;
+    else fake_sys_priority[irq + 16] = (uint8_t)priority;     // SysTick_IRQn = -1 → sistem istisnası 15
+}
+
+uint32_t NVIC_GetPriority(IRQn_Type irq)
+{
+    return irq >= 0 ? fake_irq_priority[irq] : fake_sys_priority[irq + 16];
+}
+
+void __disable_irq(void)
+{
+    fake_primask = 1;
+}
+
+void __enable_irq(void)
+{
+    fake_primask = 0;
+}
+
+uint32_t __get_PRIMASK(void)
+{
+    return fake_primask;
+}
+
+void __set_PRIMASK(uint32_t v)
+{
+    fake_primask = v & 1;
+}
+
+uint32_t ITM_SendChar(uint32_t c)
+{
+    return c;                                   // Debugger bağlı değilmiş gibi karakter atılır
+}
@@ -0,0 +1,320 @@
+#ifndef __FAKE_STM32F4XX__    // Bilgisayar testleri için sahte CMSIS başlığı (header guard başlangıcı)
+#define __FAKE_STM32F4XX__
+
+// Register yapıları sıradan RAM değişkenleridir. Her çevre birimi erişimi (GPIOA->..., DWT->... vb.) fake_access()
+// üzerinden geçer: sanal CPU saati (DWT->CYCCNT) fake_cycles_per_access kadar ilerler ve varsa fake_hook çağrılır.
+// Böylece CYCCNT'yi bekleyen döngüler (DWT_Delay_us) sanal zamanda biter, modeller (HD44780, I2C) her erişimde çalışır.
+
+#include <stdint.h>
+
+#define __IO                volatile
+#define __STATIC_INLINE     static inline
+#define __ASM               __asm__
+
+typedef struct { __IO uint32_t MODER, OTYPER, OSPEEDR, PUPDR, IDR, ODR, BSRR, LCKR, AFR[2]; } GPIO_TypeDef;
+typedef struct { __IO uint32_t CR, PLLCFGR, CFGR, CIR, AHB1RSTR, AHB2RSTR, AHB3RSTR, RESERVED0, APB1RSTR, APB2RSTR, RESERVED1[2],
+                 AHB1ENR, AHB2ENR, AHB3ENR, RESERVED2, APB1ENR, APB2ENR; } RCC_TypeDef;
+typedef struct { __IO uint32_t SR, CR1, CR2, SMPR1, SMPR2, JOFR1, JOFR2, JOFR3, JOFR4, HTR, LTR, SQR1, SQR2, SQR3, JSQR,
+                 JDR1, JDR2, JDR3, JDR4, DR; } ADC_TypeDef;
+typedef struct { __IO uint32_t CSR, CCR, CDR; } ADC_Common_TypeDef;
+typedef struct { __IO uint32_t CR, NDTR, PAR, M0AR, M1AR, FCR; } DMA_Stream_TypeDef;
+typedef struct { __IO uint32_t LISR, HISR, LIFCR, HIFCR; } DMA_TypeDef;
+typedef struct { __IO uint32_t CR1, CR2, SMCR, DIER, SR, EGR, CCMR1, CCMR2, CCER, CNT, PSC, ARR, RCR, CCR1, CCR2, CCR3, CCR4,
+                 BDTR, DCR, DMAR, OR; } TIM_TypeDef;
+typedef struct { __IO uint32_t ACR, KEYR, OPTKEYR, SR, CR, OPTCR; } FLASH_TypeDef;
+typedef struct { __IO uint32_t CR, CSR; } PWR_TypeDef;
+typedef struct { __IO uint32_t SR, DR, BRR, CR1, CR2, CR3, GTPR; } USART_TypeDef;
+typedef struct { __IO uint32_t CR1, CR2, OAR1, OAR2, DR, SR1, SR2, CCR, TRISE, FLTR; } I2C_TypeDef;
+typedef struct { __IO uint32_t CTRL, LOAD, VAL, CALIB; } SysTick_Type;
+typedef struct { __IO uint32_t CTRL, CYCCNT; } DWT_Type;
+typedef struct { __IO uint32_t DHCSR, DCRSR, DCRDR, DEMCR; } CoreDebug_Type;
+typedef struct { __IO uint32_t CPUID, ICSR, VTOR, AIRCR, SCR, CCR; } SCB_Type;
+
+typedef enum {
+    SysTick_IRQn = -1, DMA1_Stream1_IRQn = 12, DMA1_Stream3_IRQn = 14, DMA1_Stream6_IRQn = 17, ADC_IRQn = 18,
+    TIM2_IRQn = 28, TIM3_IRQn = 29, TIM4_IRQn = 30, I2C1_EV_IRQn = 31, I2C1_ER_IRQn = 32, USART2_IRQn = 38,
+    DMA1_Stream7_IRQn = 47, TIM5_IRQn = 50, TIM6_DAC_IRQn = 54, TIM7_IRQn = 55, DMA2_Stream0_IRQn = 56
+} IRQn_Type;
+
+// Sanal saat ve erişim kancası (fake_stm32.c)
+extern uint64_t fake_cycles;                    // Testin başından beri geçen sanal CPU cycle'ı
+extern uint32_t fake_cycles_per_access;         // Her çevre birimi erişiminde ilerleme (varsayılan 1)
+extern void (*fake_hook)(void* periph);         // Her erişimden sonra çağrılır (model güncellemesi için)
+void* fake_access(void* periph);
+void fake_advance(uint64_t cycles);             // Sanal saati erişim olmadan ilerletir (kanca da çağrılır)
+void fake_reset(void);                          // Tüm register'ları sıfırlar, saati 0'a alır
+uint32_t fake_gpio_apply(GPIO_TypeDef* g);      // Bekleyen BSRR yazımını ODR'ye işler, ODR'yi döndürür
+
+extern GPIO_TypeDef fake_GPIOA, fake_GPIOB, fake_GPIOC, fake_GPIOD;
+extern RCC_TypeDef fake_RCC;
+extern ADC_TypeDef fake_ADC1;
+extern ADC_Common_TypeDef fake_ADC;
+extern DMA_TypeDef fake_DMA1, fake_DMA2;
+extern DMA_Stream_TypeDef fake_DMA1_Stream3, fake_DMA1_Stream6, fake_DMA2_Stream0;
+extern TIM_TypeDef fake_TIM2, fake_TIM3, fake_TIM6;
+extern FLASH_TypeDef fake_FLASH;
+extern PWR_TypeDef fake_PWR;
+extern USART_TypeDef fake_USART3;
+extern I2C_TypeDef fake_I2C1;
+extern SysTick_Type fake_SysTick;
+extern DWT_Type fake_DWT;
+extern CoreDebug_Type fake_CoreDebug;
+extern SCB_Type fake_SCB;
+
+#define FAKE_PERIPH(type, inst)     ((type*)fake_access(&(inst)))
+#define GPIOA               FAKE_PERIPH(GPIO_TypeDef, fake_GPIOA)
+#define GPIOB               FAKE_PERIPH(GPIO_TypeDef, fake_GPIOB)
+#define GPIOC               FAKE_PERIPH(GPIO_TypeDef, fake_GPIOC)
+#define GPIOD               FAKE_PERIPH(GPIO_TypeDef, fake_GPIOD)
+#define RCC                 FAKE_PERIPH(RCC_TypeDef, fake_RCC)
+#define ADC1                FAKE_PERIPH(ADC_TypeDef, fake_ADC1)
+#define ADC                 FAKE_PERIPH(ADC_Common_TypeDef, fake_ADC)
+#define ADC123_COMMON       ADC
+#define DMA1                FAKE_PERIPH(DMA_TypeDef, fake_DMA1)
+#define DMA2                FAKE_PERIPH(DMA_TypeDef, fake_DMA2)
+#define DMA1_Stream3        FAKE_PERIPH(DMA_Stream_TypeDef, fake_DMA1_Stream3)
+#define DMA1_Stream6        FAKE_PERIPH(DMA_Stream_TypeDef, fake_DMA1_Stream6)
+#define DMA2_Stream0        FAKE_PERIPH(DMA_Stream_TypeDef, fake_DMA2_Stream0)
+#define TIM2                FAKE_PERIPH(TIM_TypeDef, fake_TIM2)
+#define TIM3                FAKE_PERIPH(TIM_TypeDef, fake_TIM3)
+#define TIM6                FAKE_PERIPH(TIM_TypeDef, fake_TIM6)
+#define FLASH               FAKE_PERIPH(FLASH_TypeDef, fake_FLASH)
+#define PWR                 FAKE_PERIPH(PWR_TypeDef, fake_PWR)
+#define USART3              FAKE_PERIPH(USART_TypeDef, fake_USART3)
+#define I2C1                FAKE_PERIPH(I2C_TypeDef, fake_I2C1)
+#define SysTick             FAKE_PERIPH(SysTick_Type, fake_SysTick)
+#define DWT                 FAKE_PERIPH(DWT_Type, fake_DWT)
+#define CoreDebug           FAKE_PERIPH(CoreDebug_Type, fake_CoreDebug)
+#define SCB                 FAKE_PERIPH(SCB_Type, fake_SCB)
+
+// NVIC ve PRIMASK: durum kaydedilir, testler okuyabilir
+extern uint32_t fake_primask;
+extern uint8_t fake_irq_enabled[96];
+extern uint8_t fake_irq_priority[96];
+extern uint8_t fake_sys_priority[16];           // Sistem istisnaları (SysTick = 15)
+void NVIC_EnableIRQ(IRQn_Type irq);
+void NVIC_DisableIRQ(IRQn_Type irq);
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority);
+uint32_t NVIC_GetPriority(IRQn_Type irq);
+void __disable_irq(void);
+void __enable_irq(void);
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t v);
+static inline void __DSB(void) {}
+static inline void __ISB(void) {}
+static inline void __DMB(void) {}
+static inline void __NOP(void) {}
+static inline void __WFI(void) { fake_advance(32); }     // Uyku: sanal saat ilerler, bekleyen kesmeler çalışır
+uint32_t ITM_SendChar(uint32_t c);
+
+// Cortex-M4 DSP komutları: ARM ARM tanımıyla aynı sonucu veren C karşılıkları
+static inline uint32_t __SMUAD(uint32_t a, uint32_t b)
+{
+    return (uint32_t)((int32_t)(int16_t)a * (int16_t)b + (int32_t)(int16_t)(a >> 16) * (int16_t)(b >> 16));
+}
+static inline uint32_t __SMLAD(uint32_t a, uint32_t b, uint32_t acc)
+{
+    return acc + __SMUAD(a, b);
+}
+static inline uint64_t __SMLALD(uint32_t a, uint32_t b, uint64_t acc)
+{
+    return acc + (uint64_t)((int64_t)(int16_t)a * (int16_t)b + (int64_t)(int16_t)(a >> 16) * (int16_t)(b >> 16));
+}
+static inline uint32_t __PKHBT(uint32_t a, uint32_t b, uint32_t shift)
+{
+    return (a & 0xFFFFu) | ((b << shift) & 0xFFFF0000u);
+}
+static inline int32_t __SSAT(int32_t v, uint32_t bits)
+{
+    int32_t max = (1 << (bits - 1)) - 1;
+    return v > max ? max : v < -max - 1 ? -max - 1 : v;
+}
+static inline uint32_t __CLZ(uint32_t v)
+{
+    return v ? (uint32_t)__builtin_clz(v) : 32;
+}
+
+// Kullanılan bit tanımları (değerler RM0090 / CMSIS ile aynı)
+#define GPIO_MODER_MODE1            (3u << 2)
+#define GPIO_MODER_MODE1_0          (1u << 2)
+#define GPIO_MODER_MODE2            (3u << 4)
+#define GPIO_MODER_MODE2_0          (1u << 4)
+#define GPIO_MODER_MODE3            (3u << 6)
+#define GPIO_MODER_MODE3_0          (1u << 6)
+#define GPIO_MODER_MODE4            (3u << 8)
+#define GPIO_MODER_MODE4_0          (1u << 8)
+#define GPIO_MODER_MODE5            (3u << 10)
+#define GPIO_MODER_MODE5_0          (1u << 10)
+#define GPIO_MODER_MODE6            (3u << 12)
+#define GPIO_MODER_MODE6_0          (1u << 12)
+#define GPIO_MODER_MODE7            (3u << 14)
+#define GPIO_MODER_MODE7_0          (1u << 14)
+#define GPIO_MODER_MODER12_Pos      24
+#define GPIO_MODER_MODER13_Pos      26
+#define GPIO_MODER_MODER14_Pos      28
+#define GPIO_MODER_MODER15_Pos      30
+#define GPIO_ODR_OD1                (1u << 1)
+#define GPIO_ODR_OD3                (1u << 3)
+#define GPIO_ODR_OD4                (1u << 4)
+#define GPIO_ODR_OD5                (1u << 5)
+#define GPIO_ODR_OD6                (1u << 6)
+#define GPIO_ODR_OD7                (1u << 7)
+#define GPIO_OSPEEDR_OSPEED12_Pos   24
+#define GPIO_OSPEEDR_OSPEED13_Pos   26
+#define GPIO_OSPEEDR_OSPEED14_Pos   28
+#define GPIO_OSPEEDR_OSPEED15_Pos   30
+#define GPIO_OTYPER_OT12_Pos        12
+#define GPIO_OTYPER_OT13_Pos        13
+#define GPIO_OTYPER_OT14_Pos        14
+#define GPIO_OTYPER_OT15_Pos        15
+#define GPIO_PUPDR_PUPD12_Pos       24
+#define GPIO_PUPDR_PUPD13_Pos       26
+#define GPIO_PUPDR_PUPD14_Pos       28
+#define GPIO_PUPDR_PUPD15_Pos       30
+
+#define RCC_CR_HSEON                (1u << 16)
+#define RCC_CR_HSERDY               (1u << 17)
+#define RCC_CR_PLLON                (1u << 24)
+#define RCC_CR_PLLRDY               (1u << 25)
+#define RCC_PLLCFGR_PLLM_Pos        0
+#define RCC_PLLCFGR_PLLN_Pos        6
+#define RCC_PLLCFGR_PLLP_Pos        16
+#define RCC_PLLCFGR_PLLSRC_HSE      (1u << 22)
+#define RCC_PLLCFGR_PLLQ_Pos        24
+#define RCC_CFGR_SW_PLL             (2u << 0)
+#define RCC_CFGR_SWS                (3u << 2)
+#define RCC_CFGR_SWS_PLL            (2u << 2)
+#define RCC_CFGR_HPRE               (0xFu << 4)
+#define RCC_CFGR_PPRE1_Pos          10
+#define RCC_CFGR_PPRE1              (7u << 10)
+#define RCC_CFGR_PPRE2_Pos          13
+#define RCC_CFGR_PPRE2              (7u << 13)
+#define RCC_AHB1ENR_GPIOAEN         (1u << 0)
+#define RCC_AHB1ENR_GPIOBEN         (1u << 1)
+#define RCC_AHB1ENR_GPIOCEN         (1u << 2)
+#define RCC_AHB1ENR_GPIODEN         (1u << 3)
+#define RCC_AHB1ENR_CCMDATARAMEN    (1u << 20)
+#define RCC_AHB1ENR_DMA1EN          (1u << 21)
+#define RCC_AHB1ENR_DMA2EN          (1u << 22)
+#define RCC_APB1ENR_TIM2EN          (1u << 0)
+#define RCC_APB1ENR_TIM3EN          (1u << 1)
+#define RCC_APB1ENR_TIM6EN          (1u << 4)
+#define RCC_APB1ENR_USART3EN        (1u << 18)
+#define RCC_APB1ENR_I2C1EN          (1u << 21)
+#define RCC_APB1ENR_PWREN           (1u << 28)
+#define RCC_APB2ENR_ADC1EN          (1u << 8)
+#define PWR_CR_VOS                  (1u << 14)
+
+#define FLASH_ACR_LATENCY_Pos       0
+#define FLASH_ACR_LATENCY           (7u << 0)
+#define FLASH_ACR_LATENCY_2WS       (2u << 0)
+#define FLASH_ACR_PRFTEN            (1u << 8)
+#define FLASH_ACR_ICEN              (1u << 9)
+#define FLASH_ACR_DCEN              (1u << 10)
+#define FLASH_SR_WRPERR             (1u << 4)
+#define FLASH_SR_PGAERR             (1u << 5)
+#define FLASH_SR_PGPERR             (1u << 6)
+#define FLASH_SR_PGSERR             (1u << 7)
+#define FLASH_SR_BSY                (1u << 16)
+#define FLASH_CR_PG                 (1u << 0)
+#define FLASH_CR_SER                (1u << 1)
+#define FLASH_CR_SNB_Pos            3
+#define FLASH_CR_SNB                (0xFu << 3)
+#define FLASH_CR_PSIZE              (3u << 8)
+#define FLASH_CR_PSIZE_1            (2u << 8)
+#define FLASH_CR_STRT               (1u << 16)
+#define FLASH_CR_LOCK               (1u << 31)
+
+#define ADC_SR_AWD                  (1u << 0)
+#define ADC_SR_EOC                  (1u << 1)
+#define ADC_SR_STRT                 (1u << 4)
+#define ADC_SR_OVR                  (1u << 5)
+#define ADC_CR1_AWDCH_Pos           0
+#define ADC_CR1_AWDCH               (0x1Fu << 0)
+#define ADC_CR1_AWDIE               (1u << 6)
+#define ADC_CR1_SCAN                (1u << 8)
+#define ADC_CR1_AWDSGL              (1u << 9)
+#define ADC_CR1_AWDEN               (1u << 23)
+#define ADC_CR2_ADON                (1u << 0)
+#define ADC_CR2_CONT                (1u << 1)
+#define ADC_CR2_DMA                 (1u << 8)
+#define ADC_CR2_DDS                 (1u << 9)
+#define ADC_CR2_EXTSEL_Pos          24
+#define ADC_CR2_EXTSEL              (0xFu << 24)
+#define ADC_CR2_EXTEN               (3u << 28)
+#define ADC_CR2_EXTEN_0             (1u << 28)
+#define ADC_CR2_SWSTART             (1u << 30)
+#define ADC_CCR_ADCPRE_Pos          16
+#define ADC_CCR_ADCPRE              (3u << 16)
+
+#define DMA_LISR_TEIF0              (1u << 3)
+#define DMA_LISR_HTIF0              (1u << 4)
+#define DMA_LISR_TCIF0              (1u << 5)
+#define DMA_LISR_TEIF3              (1u << 25)
+#define DMA_LISR_TCIF3              (1u << 27)
+#define DMA_LIFCR_CFEIF0            (1u << 0)
+#define DMA_LIFCR_CDMEIF0           (1u << 2)
+#define DMA_LIFCR_CTEIF0            (1u << 3)
+#define DMA_LIFCR_CHTIF0            (1u << 4)
+#define DMA_LIFCR_CTCIF0            (1u << 5)
+#define DMA_LIFCR_CFEIF3            (1u << 22)
+#define DMA_LIFCR_CDMEIF3           (1u << 24)
+#define DMA_LIFCR_CTEIF3            (1u << 25)
+#define DMA_LIFCR_CHTIF3            (1u << 26)
+#define DMA_LIFCR_CTCIF3            (1u << 27)
+#define DMA_HIFCR_CFEIF6            (1u << 16)
+#define DMA_HIFCR_CDMEIF6           (1u << 18)
+#define DMA_HIFCR_CTEIF6            (1u << 19)
+#define DMA_HIFCR_CHTIF6            (1u << 20)
+#define DMA_HIFCR_CTCIF6            (1u << 21)
+#define DMA_SxCR_EN                 (1u << 0)
+#define DMA_SxCR_TEIE               (1u << 2)
+#define DMA_SxCR_HTIE               (1u << 3)
+#define DMA_SxCR_TCIE               (1u << 4)
+#define DMA_SxCR_DIR_0              (1u << 6)
+#define DMA_SxCR_CIRC               (1u << 8)
+#define DMA_SxCR_MINC               (1u << 10)
+#define DMA_SxCR_PSIZE_0            (1u << 11)
+#define DMA_SxCR_MSIZE_0            (1u << 13)
+#define DMA_SxCR_PL_1               (1u << 17)
+#define DMA_SxCR_CHSEL_Pos          25
+
+#define TIM_CR1_CEN                 (1u << 0)
+#define TIM_CR1_URS                 (1u << 2)
+#define TIM_CR1_OPM                 (1u << 3)
+#define TIM_CR2_MMS                 (7u << 4)
+#define TIM_CR2_MMS_1               (2u << 4)
+#define TIM_DIER_UIE                (1u << 0)
+#define TIM_DIER_CC1IE              (1u << 1)
+#define TIM_SR_UIF                  (1u << 0)
+#define TIM_SR_CC1IF                (1u << 1)
+#define TIM_EGR_UG                  (1u << 0)
+#define TIM_EGR_CC1G                (1u << 1)
+
+#define USART_CR1_TE                (1u << 3)
+#define USART_CR1_UE                (1u << 13)
+#define USART_CR3_DMAT              (1u << 7)
+
+#define I2C_CR1_PE                  (1u << 0)
+#define I2C_CR1_START               (1u << 8)
+#define I2C_CR1_STOP                (1u << 9)
+#define I2C_CR1_SWRST               (1u << 15)
+#define I2C_CR2_ITERREN             (1u << 8)
+#define I2C_CR2_ITEVTEN             (1u << 9)
+#define I2C_CR2_DMAEN               (1u << 11)
+#define I2C_SR1_SB                  (1u << 0)
+#define I2C_SR1_ADDR                (1u << 1)
+#define I2C_SR1_BTF                 (1u << 2)
+#define I2C_SR1_TXE                 (1u << 7)
+#define I2C_SR1_BERR                (1u << 8)
+#define I2C_SR1_ARLO                (1u << 9)
+#define I2C_SR1_AF                  (1u << 10)
+#define I2C_SR1_OVR                 (1u << 11)
+
+#define SysTick_CTRL_ENABLE_Msk     (1u << 0)
+#define SysTick_CTRL_TICKINT_Msk    (1u << 1)
+#define SysTick_CTRL_CLKSOURCE_Msk  (1u << 2)
+#define DWT_CTRL_CYCCNTENA_Msk      (1u << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk  (1u << 24)
+
+#endif  // __FAKE_STM32F4XX__  // Header guard bitişi
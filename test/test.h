@@ -0,0 +1,26 @@
+#ifndef __TEST__              // Bilgisayar testleri için ortak denetim makroları (header guard başlangıcı)
+#define __TEST__
+
+#include <stdio.h>
+
+static int test_failures;
+
+// Koşul sağlanmazsa dosya:satır ile yazdırır ve sayar; test devam eder
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            test_failures++; \
+            printf("%s:%d: CHECK(%s) başarısız\n", __FILE__, __LINE__, #cond); \
+        } \
+    } while (0)
+
+#define CHECK_EQ(a, b) do { \
+        long long test_a = (long long)(a), test_b = (long long)(b); \
+        if (test_a != test_b) { \
+            test_failures++; \
+            printf("%s:%d: %s == %s başarısız (%lld != %lld)\n", __FILE__, __LINE__, #a, #b, test_a, test_b); \
+        } \
+    } while (0)
+
+#define TEST_RESULT()   (printf("%s: %s\n", __FILE__, test_failures ? "BAŞARISIZ" : "tamam"), test_failures ? 1 : 0)
+
+#endif  // __TEST__           // Header guard bitişi
@@ -0,0 +1,85 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "test.h"
+#include "emu.h"
+#include "mq2.h"
+#include "timebase.h"
+
+// ADC1 + DMA2 Stream0 çift tampon: bloklar sırayla ve kayıpsız gelmeli, ilk dönüşümden önce adc1_read()
+// ADC_NOT_READY döndürmeli, DMA hatası adc1_dma_errors() ile görünmeli
+
+static uint16_t ramp;                   // Her dönüşümde bir artan giriş: kayıp / tekrar örnek hemen görülür
+static uint32_t blocks;
+static uint32_t block_errors;
+static uint16_t expect;
+static const uint16_t* last_block;
+
+static uint16_t test_ramp(uint8_t channel, uint64_t now_ns)
+{
+    (void)channel;
+    (void)now_ns;
+    return ramp++ & 0xFFF;
+}
+
+static void test_block(const uint16_t* block, uint16_t count)
+{
+    if (count != ADC_STREAM_BLOCK || block == last_block) block_errors++;   // Yarılar sırayla değişmeli
+    for (uint16_t i = 0; i < count; i++) {
+        if (block[i] != expect) block_errors++;
+        expect = (expect + 1) & 0xFFF;
+    }
+    last_block = block;
+    blocks++;
+}
+
+int main(void)
+{
+    emu_init();
+    emu_irq_attach(DMA2_Stream0_IRQn, DMA2_Stream0_IRQHandler);
+    emu_adc_set_source(test_ramp);
+    timebase_init();
+
+    gpio_pa0_analog_init();
+    adc1_init();
+
+    // Polling: her çağrı bir dönüşüm
+    CHECK_EQ(adc1_read(), 0);
+    CHECK_EQ(adc1_read(), 1);
+    ramp = 0;
+
+    // Akış başladı, ilk dönüşüm henüz bitmedi
+    adc1_stream_start(test_block);
+    CHECK_EQ(adc1_read(), ADC_NOT_READY);
+    emu_run_us(100);                                    // ~73 kSps: birkaç dönüşüm
+    uint16_t v = adc1_read();
+    CHECK(v != ADC_NOT_READY);
+    CHECK(v + 1 == ramp || v + 2 == ramp);              // En son (veya okuma sırasında biten bir önceki) örnek
+
+    // 40 blok: her biri 128 ardışık örnek, yarılar sırayla
+    while (blocks < 40) emu_run_us(100);
+    CHECK_EQ(block_errors, 0);
+    CHECK(adc1_read() != ADC_NOT_READY);
+    CHECK_EQ(adc1_dma_errors(), 0);
+
+    // DMA transfer hatası
+    emu_adc_dma_error();
+    emu_run_us(10);
+    CHECK_EQ(adc1_dma_errors(), 1);
+
+    // Durdurulunca adc1_read() tekrar polling yapar
+    adc1_stream_stop();
+    ramp = 100;
+    CHECK_EQ(adc1_read(), 100);
+
+    // Yeniden başlatma: eski tampon içeriği "hazır" sayılmamalı
+    blocks = 0;
+    last_block = 0;
+    ramp = 0;
+    expect = 0;
+    adc1_stream_start(test_block);
+    CHECK_EQ(adc1_read(), ADC_NOT_READY);
+    while (blocks < 4) emu_run_us(100);
+    CHECK_EQ(block_errors, 0);
+
+    return TEST_RESULT();
+}
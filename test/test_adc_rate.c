@@ -0,0 +1,94 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "test.h"
+#include "emu.h"
+#include "mq2.h"
+#include "timebase.h"
+
+// TIM3 TRGO ile tetiklenen ADC: PSC / ARR hesabı, dönüşümler arası süre ve blok zaman damgası
+
+static uint64_t sample_ns[4096];
+static uint32_t samples;
+static uint32_t blocks;
+static uint64_t block_cycles[8];
+
+static uint16_t test_source(uint8_t channel, uint64_t now_ns)
+{
+    (void)channel;
+    if (samples < 4096) sample_ns[samples] = now_ns;
+    return (uint16_t)(samples++ & 0xFFF);
+}
+
+static void test_block(const uint16_t* block, uint16_t count)
+{
+    (void)block;
+    (void)count;
+    if (blocks < 8) block_cycles[blocks] = adc1_block_time();
+    blocks++;
+}
+
+static void test_calc(uint32_t hz, uint16_t want_psc, uint16_t want_arr)
+{
+    uint16_t psc = 0, arr = 0;
+
+    CHECK_EQ(adc_timer_calc(CLOCK_APB1_TIMER_HZ, hz, &psc, &arr), 0);
+    CHECK_EQ(psc, want_psc);
+    CHECK_EQ(arr, want_arr);
+}
+
+int main(void)
+{
+    uint16_t psc, arr;
+
+    // Hesap: README / mq2.c'deki örnekler (TIM3 saati 84 MHz)
+    test_calc(1000, 1, 41999);
+    test_calc(10, 128, 65115);
+    test_calc(40000, 0, 2099);
+    CHECK_EQ(adc_timer_calc(CLOCK_APB1_TIMER_HZ, 0, &psc, &arr), 1);
+    CHECK_EQ(adc_timer_calc(CLOCK_APB1_TIMER_HZ, CLOCK_APB1_TIMER_HZ, &psc, &arr), 1);
+
+    // Bütün hızlarda gerçekleşen frekans istenene ‰1 yakın
+    for (uint32_t hz = 1; hz <= 40000; hz = hz * 3 / 2 + 1) {
+        CHECK_EQ(adc_timer_calc(CLOCK_APB1_TIMER_HZ, hz, &psc, &arr), 0);
+        double got = (double)CLOCK_APB1_TIMER_HZ / ((psc + 1.0) * (arr + 1.0));
+        CHECK(got > hz * 0.999 && got < hz * 1.001);
+    }
+
+    // Donanım: 1 kHz'de dönüşümler 1 ms arayla, bloklar 128 ms arayla
+    emu_init();
+    emu_irq_attach(DMA2_Stream0_IRQn, DMA2_Stream0_IRQHandler);
+    emu_adc_set_source(test_source);
+    timebase_init();
+    gpio_pa0_analog_init();
+    adc1_init();
+
+    CHECK_EQ(adc1_set_sample_rate(1000), 1000);
+    CHECK_EQ(adc1_get_sample_rate(), 1000);
+    adc1_stream_start(test_block);
+    while (blocks < 4) emu_run_us(1000);
+
+    CHECK(samples >= 4 * ADC_STREAM_BLOCK);
+    uint64_t worst = 0;
+    for (uint32_t i = 1; i < samples && i < 4096; i++) {
+        uint64_t d = sample_ns[i] - sample_ns[i - 1];
+        uint64_t err = d > 1000000 ? d - 1000000 : 1000000 - d;
+        if (err > worst) worst = err;
+    }
+    CHECK(worst < 100);                                 // Sanal saatte tam 84000 tick; yuvarlama < 100 ns
+    printf("  1 kHz: %lu dönüşüm, en büyük periyot hatası %lu ns\n", (unsigned long)samples, (unsigned long)worst);
+
+    for (int i = 1; i < 4; i++) {
+        uint64_t d = EMU_NS(block_cycles[i] - block_cycles[i - 1]);
+        CHECK(d > 127900000 && d < 128100000);          // 128 örnek × 1 ms
+    }
+
+    // Hız değişikliği çalışırken: yeni hız bir sonraki dönüşümden itibaren geçerli
+    CHECK_EQ(adc1_set_sample_rate(0), 0);               // Geçersiz: ayar değişmez
+    CHECK_EQ(adc1_get_sample_rate(), 1000);
+    CHECK_EQ(adc1_set_sample_rate(4000), 4000);
+    uint32_t before = samples;
+    emu_run_us(100000);
+    CHECK(samples - before >= 399 && samples - before <= 401);
+
+    return TEST_RESULT();
+}
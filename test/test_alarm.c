@@ -0,0 +1,192 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "test.h"
+#include "emu.h"
+#include "mq2.h"
+#include "timebase.h"
+#include "hrtimer.h"
+#include "gas_alarm.h"
+#include "telemetry.h"
+
+// gas_alarm geçiş kuyruğu: 250 ms'lik yoklamalar arasında kalan bırakma + yeniden alarm çifti de telemetriye gitmeli,
+// kuyruk dolunca en eski geçişler korunup kayıp sayılmalı; telemetri atma sayaçları her bağlamda ayrı tutulup toplanmalı;
+// gas_alarm_latency_last/max'ın TIM3 tetiğinden röle kenarına kadar geçen sanal süreyle aynı olması
+
+#define TEST_PULSE_MS   50                  // Her gaz darbesinin süresi
+
+static uint32_t pulse_ms[8];                // Darbelerin başlangıcı (ms)
+static uint8_t pulses;
+static uint64_t sample_ns;                  // Son dönüşümün bittiği an
+static uint64_t edge_ns[2];                 // Röleyi değiştiren son ADC kesmesine giriş / çıkış
+static uint64_t edge_sample_ns;             // O kesmeyi doğuran dönüşümün bittiği an
+
+static uint16_t test_gas(uint8_t channel, uint64_t now_ns)
+{
+    (void)channel;
+    uint64_t ms = now_ns / 1000000;
+    sample_ns = now_ns;
+    for (uint8_t i = 0; i < pulses; i++) {
+        if (ms >= pulse_ms[i] && ms < pulse_ms[i] + TEST_PULSE_MS) return 3500;
+    }
+    return 400;
+}
+
+static void test_block(const uint16_t* block, uint16_t count)
+{
+    (void)block;
+    (void)count;
+}
+
+static void test_adc_irq(void)
+{
+    uint8_t relay_was = gas_alarm_active();
+    uint64_t entry = emu_ns();
+
+    ADC_IRQHandler();
+    if (gas_alarm_active() != relay_was) {
+        edge_ns[0] = entry;
+        edge_ns[1] = emu_ns();
+        edge_sample_ns = sample_ns;
+    }
+}
+
+static uint32_t test_event_ms(const gas_alarm_event_t* e)
+{
+    return (uint32_t)timebase_cycles_to_ms(e->cycles);
+}
+
+static void test_polled(void)
+{
+    gas_alarm_event_t ev[8];
+    uint8_t n = 0;
+    uint8_t polled_changes = 0, last = 0;
+
+    // 100 ms'de alarm, 3.1 sn'de bırakma, 50 ms sonra tekrar alarm: 250 ms'lik yoklama ikisini de görmez
+    pulse_ms[0] = 100;
+    pulse_ms[1] = 100 + GAS_ALARM_MIN_ON_US / 1000 + 50;
+    pulses = 2;
+    for (uint32_t t = 0; t < 7000; t += 250) {
+        emu_run_us(250000);
+        if (gas_alarm_active() != last) {
+            polled_changes++;
+            last = gas_alarm_active();
+        }
+        while (n < 8 && gas_alarm_event_pop(&ev[n]) == 0) n++;
+    }
+    printf("  yoklama %u geçiş görüyor, kuyruk %u:", polled_changes, n);
+    for (uint8_t i = 0; i < n; i++) printf(" %s@%u", ev[i].state ? "on" : "off", test_event_ms(&ev[i]));
+    printf("\n");
+
+    CHECK_EQ(polled_changes, 2);
+    CHECK_EQ(n, 4);
+    CHECK_EQ(ev[0].state, 1);
+    CHECK_EQ(ev[1].state, 0);
+    CHECK_EQ(ev[2].state, 1);
+    CHECK_EQ(ev[3].state, 0);
+    CHECK(test_event_ms(&ev[0]) >= 100 && test_event_ms(&ev[0]) <= 102);       // 1 kHz örnekleme
+    CHECK(test_event_ms(&ev[1]) >= 3100 && test_event_ms(&ev[1]) <= 3102);     // En kısa açık kalma süresi sonunda
+    CHECK(test_event_ms(&ev[2]) >= 3150 && test_event_ms(&ev[2]) <= 3152);
+    CHECK(test_event_ms(&ev[3]) >= 6150 && test_event_ms(&ev[3]) <= 6152);
+    CHECK_EQ(ev[0].trips, 1);
+    CHECK_EQ(ev[2].trips, 2);
+    CHECK_EQ(gas_alarm_events_lost(), 0);
+}
+
+static void test_overflow(void)
+{
+    gas_alarm_event_t ev;
+    uint32_t start = (uint32_t)(emu_ns() / 1000000);
+
+    // Hiç boşaltmadan 4 alarm / bırakma: 8 geçiş, kuyruk 7 tutar (toplam süre CYCCNT taşmasından, 25.5 sn, kısa)
+    pulses = 4;
+    for (uint8_t i = 0; i < pulses; i++) pulse_ms[i] = start + 10 + i * (GAS_ALARM_MIN_ON_US / 1000 + 100);
+    emu_run_us(4 * (GAS_ALARM_MIN_ON_US + 100000) + 100000);
+
+    uint8_t n = 0, alternating = 1;
+    while (gas_alarm_event_pop(&ev) == 0) {
+        if (ev.state != ((n & 1) ? 0 : 1)) alternating = 0;
+        n++;
+    }
+    printf("  dolu kuyruk: %u geçiş alındı, %u kayıp\n", n, gas_alarm_events_lost());
+    CHECK_EQ(n, GAS_ALARM_EVENTS - 1);
+    CHECK(alternating);                                                         // En eskiler, sırayla
+    CHECK_EQ(gas_alarm_events_lost(), 8 - (GAS_ALARM_EVENTS - 1));
+    CHECK_EQ(gas_alarm_event_pop(&ev), 1);
+}
+
+static void test_latency(void)
+{
+    static const uint16_t smp[8] = { 3, 15, 28, 56, 84, 112, 144, 480 };
+    gas_alarm_event_t ev;
+    uint64_t conv_ns = EMU_NS((uint64_t)(smp[ADC1->SMPR2 & 7] + 12) * CLOCK_SYSCLK_HZ / CLOCK_ADC_HZ);   // Kanal 0
+    uint64_t tick_ns = EMU_NS((uint64_t)(TIM3->PSC + 1) * (CLOCK_SYSCLK_HZ / CLOCK_APB1_TIMER_HZ)) + 1;
+    uint32_t start = (uint32_t)(emu_ns() / 1000000);
+
+    while (gas_alarm_event_pop(&ev) == 0) {}
+    pulse_ms[0] = start + 20;
+    pulses = 1;
+    edge_ns[0] = 0;
+    emu_run_us(40000);
+    CHECK(gas_alarm_active());
+    CHECK(edge_ns[0] != 0);
+
+    // TIM3 update'i (dönüşümün başı) → röle kenarı; kenar kesmenin içinde, giriş ile çıkış arasında bir yerde
+    uint64_t trigger_ns = edge_sample_ns - conv_ns;
+    uint64_t lat_ns = EMU_NS(gas_alarm_latency_last());
+    printf("  gecikme: %u cycle (%u ns), sanal saat %u-%u ns, en kötü %u cycle\n", gas_alarm_latency_last(),
+           (uint32_t)lat_ns, (uint32_t)(edge_ns[0] - trigger_ns), (uint32_t)(edge_ns[1] - trigger_ns),
+           gas_alarm_latency_max());
+    CHECK(lat_ns + tick_ns > edge_ns[0] - trigger_ns);              // CNT tick'e yuvarlanır: bir tick eksik olabilir
+    CHECK(lat_ns <= edge_ns[1] - trigger_ns);
+    CHECK(lat_ns >= conv_ns);                                       // Dönüşüm bitmeden kesme gelemez
+    CHECK(gas_alarm_latency_max() >= gas_alarm_latency_last());
+
+    emu_run_us(GAS_ALARM_MIN_ON_US + 50000);                        // Bırakma zamanlayıcıyla olur, gecikmeyi değiştirmez
+    CHECK(!gas_alarm_active());
+    CHECK_EQ(EMU_NS(gas_alarm_latency_last()), lat_ns);
+}
+
+static void test_drops(void)
+{
+    uint8_t payload[40] = { 0 };
+    uint32_t frames = 0, samples = 0;
+
+    telemetry_init(115200);                 // USART3 / DMA1 modellenmiyor: başlatılan transfer hiç bitmez
+
+    for (uint32_t i = 0; i < TELEMETRY_SAMPLE_SIZE + 10; i++) telemetry_push_sample((uint16_t)i, i);
+    samples = 10 + 1;                       // Halka bir eksiğini tutar
+    CHECK_EQ(telemetry_dropped(), samples);
+
+    for (uint32_t i = 0; i < 40; i++) frames += telemetry_send(TELEMETRY_STATUS, payload, sizeof(payload), i);
+    CHECK(frames > 0 && frames < 40);                  // Halka dolana kadar kabul, sonra atılır
+    CHECK_EQ(telemetry_dropped(), samples + frames);
+
+    DMA1->LISR = DMA_LISR_TEIF3;            // Transfer hatası: DMA kesmesinin sayacı
+    DMA1_Stream3_IRQHandler();
+    printf("  atılan: %u örnek + %u çerçeve + 1 DMA hatası = %u\n", samples, frames, telemetry_dropped());
+    CHECK_EQ(telemetry_dropped(), samples + frames + 1);
+}
+
+int main(void)
+{
+    emu_init();
+    emu_irq_attach(DMA2_Stream0_IRQn, DMA2_Stream0_IRQHandler);
+    emu_irq_attach(ADC_IRQn, test_adc_irq);
+    emu_irq_attach(TIM2_IRQn, TIM2_IRQHandler);
+    emu_adc_set_source(test_gas);
+    timebase_init();
+    hrtimer_init();
+
+    gpio_pa0_analog_init();
+    adc1_init();
+    gas_alarm_init(0, GAS_ALARM_HIGH, GAS_ALARM_LOW);
+    CHECK_EQ(adc1_set_sample_rate(1000), 1000);
+    adc1_stream_start(test_block);
+
+    test_polled();
+    test_overflow();
+    test_latency();
+    test_drops();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,82 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "test.h"
+#include "emu.h"
+#include "hd44780.h"
+#include "lcd_config.h"
+#include "lcd_async.h"
+#include "lcd_transport.h"
+#include "hrtimer.h"
+
+// Kuyruk gönderim yaparken bloklayan lcd_send_* çağrılırsa pinler (veya I2C1) iki sürücü arasında paylaşılmamalı:
+// panelde zamanlama ihlali ve yarım bayt olmamalı, bayt sırası korunmalı
+
+#if LCD_TRANSPORT == LCD_TRANSPORT_PCF8574
+#define TEST_WIRING     EMU_LCD_PCF8574
+#else
+#define TEST_WIRING     EMU_LCD_GPIO4
+#endif
+
+static hd44780_t lcd;
+static volatile uint32_t callbacks;
+
+static void test_done(void)
+{
+    callbacks++;
+}
+
+static void test_row_is(uint8_t row, const char* want)
+{
+    char got[LCD_COLS + 1];
+
+    hd44780_row(&lcd, row, got, LCD_COLS);
+    if (strcmp(got, want) != 0) {
+        test_failures++;
+        printf("satır %u: \"%s\" bekleniyordu, \"%s\" okundu\n", row, want, got);
+    }
+}
+
+int main(void)
+{
+    emu_init();
+    emu_irq_attach(TIM2_IRQn, TIM2_IRQHandler);
+#if LCD_TRANSPORT == LCD_TRANSPORT_PCF8574
+    emu_irq_attach(I2C1_EV_IRQn, I2C1_EV_IRQHandler);
+    emu_irq_attach(I2C1_ER_IRQn, I2C1_ER_IRQHandler);
+#endif
+    emu_lcd_attach(&lcd, TEST_WIRING);
+    hrtimer_init();
+    lcd_async_init();
+    lcd_async_set_callback(test_done);
+    lcd_init();
+
+    for (int round = 0; round < 20; round++) {
+        char line[LCD_COLS + 1];
+        for (int c = 0; c < LCD_COLS; c++) line[c] = (char)('a' + (c + round) % 26);
+        line[LCD_COLS] = '\0';
+
+        lcd_fb_write(0, 0, line);
+        lcd_fb_write(1, 0, line);
+        CHECK(lcd_flush_async() > 0);
+        CHECK(lcd_async_busy());
+
+        // Kuyruk daha gönderirken: gölge çerçeveyi bilerek bozan bloklayan yazımlar (eski kod ana döngüde böyleydi)
+        emu_run_us(round * 37);                 // Kuyruğun farklı noktalarında araya gir
+        lcd_set_cursor(1, 10);
+        lcd_print_string("BLOK");
+        CHECK(!lcd_async_busy());               // Bloklayan yazım kuyruğun bitmesini bekledi
+
+        char want[LCD_COLS + 1];
+        memcpy(want, line, sizeof(want));
+        memcpy(&want[10], "BLOK", 4);
+        test_row_is(0, line);
+        test_row_is(1, want);
+    }
+
+    CHECK_EQ(hd44780_violation_total(&lcd), 0);
+    CHECK_EQ(lcd_transport_errors(), 0);
+    CHECK(callbacks >= 20);
+
+    return TEST_RESULT();
+}
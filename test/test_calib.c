@@ -0,0 +1,218 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <setjmp.h>
+#include "test.h"
+#include "nor_flash.h"
+#include "mq2_ppm.h"
+#include "mq2_calib.h"
+
+// mq2_calib: ısınma durum makinesi, temiz havada R0 takibi, gazda baz çizgisinin korunması ve iki sektörlü kayıt:
+// çalışma sırasında hiç silme yapılmamalı, her elektrik kesintisinden sonra son onaylı (veya o an yazılan) R0 yüklenmeli;
+// tam sayı olmayan güncelleme hızında (15.625 Hz) saniyelerin kaymaması
+
+#define TEST_SECTOR_A   FLASH_SECTOR_CALIB_FIRST
+#define TEST_SECTOR_B   (FLASH_SECTOR_CALIB_FIRST + 1)
+
+static uint32_t lcg = 777;
+static int test_noise(void)                             // -1, 0, +1 ADC
+{
+    lcg = lcg * 1664525u + 1013904223u;
+    return (int)((lcg >> 16) % 3) - 1;
+}
+
+static double test_r0(double adc)                       // Beklenen R0 / RL: (Rs / RL) / 9.83
+{
+    return (4095.0 - adc) / adc / MQ2_CLEAN_AIR_RATIO;
+}
+
+static uint32_t test_saved_r0;                          // test_run() içinde son kaydedilen değer
+
+static uint32_t test_erases(void)
+{
+    return nor_erases(TEST_SECTOR_A) + nor_erases(TEST_SECTOR_B);
+}
+
+static uint32_t test_run(uint32_t seconds, uint16_t adc)    // Sabit ortam + ±1 gürültü; her saniye servis de çalışır
+{
+    uint32_t saves = 0;
+
+    for (uint32_t t = 0; t < seconds; t++) {
+        mq2_calib_update((uint16_t)(adc + test_noise()));
+        uint32_t r0 = mq2_get_r0();
+        long ops = nor_ops();
+        mq2_calib_service();
+        if (nor_ops() != ops) {
+            saves++;
+            test_saved_r0 = r0;
+        }
+    }
+    return saves;
+}
+
+static void test_boot_until_ready(uint16_t adc)
+{
+    mq2_calib_init(1000);                               // 1 Hz: her güncelleme bir saniyelik pencere
+    for (uint32_t t = 0; t < 1000 && mq2_calib_state() != MQ2_CALIB_READY; t++) test_run(1, adc);
+    CHECK_EQ(mq2_calib_state(), MQ2_CALIB_READY);
+}
+
+static void test_warmup(void)
+{
+    uint32_t ready_s = 0;
+
+    nor_reset(0xFFFFFFFFu);
+    mq2_calib_init(1000);
+    CHECK(!mq2_calib_has_r0());
+    CHECK_EQ(test_erases(), 0);                         // Boş flash: silinecek bir şey yok
+
+    // Soğuk ısıtıcı: çıkış 1900'den 400'e üstel olarak iner (τ = 60 sn)
+    for (uint32_t t = 0; t < 900; t++) {
+        uint16_t adc = (uint16_t)(400 + 1500 * exp(-(double)t / 60) + test_noise());
+        mq2_calib_update(adc);
+        uint32_t r0 = mq2_get_r0();
+        long ops = nor_ops();
+        mq2_calib_service();
+        if (nor_ops() != ops) test_saved_r0 = r0;
+        if (t < MQ2_CALIB_MIN_WARMUP_S - 1) CHECK_EQ(mq2_calib_state(), MQ2_CALIB_WARMUP);
+        if (!ready_s && mq2_calib_state() == MQ2_CALIB_READY) ready_s = t + 1;
+    }
+    double err = test_saved_r0 / 65536.0 / test_r0(400) - 1;
+    printf("  ısınma: %u sn'de READY, ilk R0 hatası %+.3f, 15 dk sonra %+.4f\n",
+           ready_s, err, mq2_get_r0() / 65536.0 / test_r0(400) - 1);
+    CHECK(ready_s > 300 && ready_s < 600);              // 30 sn boyunca toplam kayma ≤ 3 ADC: hedefe ~6 ADC kala
+    CHECK(mq2_calib_has_r0());
+    CHECK(fabs(err) < 0.02);
+    CHECK_EQ(nor_ops(), 2);                             // İlk R0 hemen kaydedildi: iki kelime, silme yok
+
+    // Yeniden açılış: R0 ısınmayı beklemeden flash'tan gelir
+    mq2_set_r0((uint32_t)MQ2_Q16(5.0));
+    mq2_calib_init(1000);
+    CHECK(mq2_calib_has_r0());
+    CHECK_EQ(mq2_get_r0(), test_saved_r0);
+    CHECK_EQ(mq2_calib_state(), MQ2_CALIB_WARMUP);
+    CHECK_EQ(test_erases(), 0);
+}
+
+static void test_drift_and_step(void)
+{
+    test_boot_until_ready(400);
+
+    // Temiz havada 48 saatte %10 kayma (400 → 440): R0 yavaşça izler, saatte en fazla bir kayıt
+    uint32_t saves = 0;
+    for (uint32_t h = 0; h < 48; h++) saves += test_run(3600, (uint16_t)(400 + 40 * h / 48));
+    saves += test_run(6 * 3600, 440);
+    double err = mq2_get_r0() / 65536.0 / test_r0(440) - 1;
+    printf("  kayma: 48 saatte %%10, R0 hatası %+.4f, %u kayıt\n", err, saves);
+    CHECK(fabs(err) < 0.02);
+    CHECK(saves >= 2 && saves <= 54);
+
+    // Gaz: 30 dk boyunca 1500 → oran temiz hava aralığının dışında, baz çizgisi hiç değişmez
+    uint32_t r0 = mq2_get_r0();
+    CHECK_EQ(test_run(1800, 1500), 0);
+    CHECK_EQ(mq2_get_r0(), r0);
+
+    // Ani sıçrama (kararsız pencereler) de R0'a girmez
+    for (int i = 0; i < 600; i++) test_run(1, (i & 1) ? 430 : 450);
+    CHECK_EQ(mq2_get_r0(), r0);
+    CHECK_EQ(test_erases(), 0);
+}
+
+static void test_fill(void)
+{
+    // Küçük sektörlerde (128 kayıt) iki sektörü de doldur: mq2_calib_service() hiçbir zaman silmez
+    nor_reset(0xFFFFFFFFu);
+    test_boot_until_ready(400);
+
+    uint32_t saves = 1;                                 // Isınma sonunda öğrenilen ilk R0
+    for (uint32_t round = 0; round < 400; round++) saves += test_run(3 * 3600, (round & 1) ? 400 : 430);
+    uint32_t capacity = 2 * NOR_SECTOR_SIZE / 8;
+    printf("  doldurma: %u kayıt (kapasite %u), çalışırken silme %u\n", saves, capacity, test_erases());
+    CHECK_EQ(saves, capacity);
+    CHECK_EQ(test_erases(), 0);
+    CHECK_EQ(nor_overwrites(), 0);
+
+    // Açılışta eski sektör silinir, en yeni kayıt yüklenir, kayıt tekrar mümkün
+    mq2_set_r0((uint32_t)MQ2_Q16(5.0));
+    mq2_calib_init(1000);
+    CHECK_EQ(test_erases(), 1);
+    CHECK(mq2_calib_has_r0());
+    CHECK_EQ(mq2_get_r0(), test_saved_r0);
+    test_boot_until_ready(400);
+    CHECK(test_run(3 * 3600, 430) >= 1);
+    CHECK_EQ(nor_overwrites(), 0);
+}
+
+static void test_power_cut(void)
+{
+    static jmp_buf jump;
+    static uint32_t committed, attempted;              // longjmp'tan sonra da geçerli kalmalı (static)
+    static uint32_t cuts, recovered;
+
+    nor_reset(0);                                       // Fabrikadan çöp içerik: ilk açılışta silinmeli
+    for (uint32_t round = 0; round < 600; round++) {
+        if (setjmp(jump) == 0) {
+            nor_cut_after(rand() % 8, &jump);
+            mq2_set_r0((uint32_t)MQ2_Q16(5.0));
+            mq2_calib_init(1000);
+            nor_cut_after(-1, &jump);
+
+            if (mq2_calib_has_r0()) {
+                recovered++;
+                CHECK(mq2_get_r0() == committed || mq2_get_r0() == attempted);
+                committed = mq2_get_r0();
+            } else {
+                CHECK_EQ(committed, 0);                 // Bir kez kaydedilen R0 hiç kaybolmaz
+            }
+            attempted = committed;
+
+            nor_cut_after(rand() % 4, &jump);
+            uint16_t adc = (round & 1) ? 400 : 430;
+            for (uint32_t t = 0; t < 5 * 3600; t++) {
+                mq2_calib_update((uint16_t)(adc + test_noise()));
+                uint32_t r0 = mq2_get_r0();
+                long ops = nor_ops();
+                attempted = r0;
+                mq2_calib_service();
+                if (nor_ops() != ops) {
+                    committed = r0;
+                    break;
+                }
+                attempted = committed;
+            }
+            nor_cut_after(-1, &jump);
+        } else {
+            cuts++;                                     // Kesinti: bir sonraki tur yeniden açılış
+        }
+    }
+    printf("  kesinti: 600 tur, %u kesinti, %u açılışta R0 geri yüklendi\n", cuts, recovered);
+    CHECK(cuts > 100);
+    CHECK(recovered > 400);
+    CHECK_EQ(nor_overwrites(), 0);
+}
+
+static void test_fractional_rate(void)
+{
+    uint32_t n = 0;                                     // 1 kHz / 64 = 15.625 Hz: pencereler 15 veya 16 örnek, ortalaması tam 1 sn
+
+    nor_reset(0xFFFFFFFFu);
+    mq2_calib_init(15625);
+    while (mq2_calib_state() == MQ2_CALIB_WARMUP && n < 10000) {
+        mq2_calib_update(400);
+        n++;
+    }
+    printf("  15.625 Hz: ısınma %u örnekte bitti (%.3f sn)\n", n, n / 15.625);
+    CHECK_EQ(n, MQ2_CALIB_MIN_WARMUP_S * 15625 / 1000);    // 15'e yuvarlansaydı 1800 örnek (115.2 sn)
+}
+
+int main(void)
+{
+    test_warmup();
+    test_fractional_rate();
+    test_drift_and_step();
+    test_fill();
+    test_power_cut();
+
+    return TEST_RESULT();
+}
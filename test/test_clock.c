@@ -0,0 +1,70 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "test.h"
+#include "clock_config.h"
+
+// clock_config.h: derlenen CLOCK_SYSCLK_HZ için türetilen PLL (M / N / P / Q ve PLLCFGR kodu), flash bekleme durumu,
+// AHB / APB / ADC bölücüleri ve register kodları, timer saatleri, SysTick reload ve CLOCK_CYCLES_PER_US değerlerinin
+// datasheet'ten elle hesaplanmış tabloyla aynı olması; PLL çıkışlarının geri hesabı. Makefile her hazır ayar için
+// bir derleme yapar (clock_168, clock_72 = -DCLOCK_SYSCLK_HZ=72000000).
+
+typedef struct {
+    uint32_t sysclk;
+    uint32_t pllm, plln, pllp, pllq, pllp_bits;
+    uint32_t flash_ws;
+    uint32_t apb1_div, apb2_div, ppre1_bits, ppre2_bits;
+    uint32_t pclk1, pclk2, apb1_timer, apb2_timer;
+    uint32_t adc_div, adcpre_bits, adc_hz;
+    uint32_t systick_reload, cycles_per_us;
+} clock_preset_t;
+
+static const clock_preset_t presets[] = {
+    { 168000000, 8, 336, 2, 7, 0, 5, 4, 2, 5, 4, 42000000, 84000000, 84000000, 168000000, 4, 1, 21000000, 167999, 168 },
+    {  72000000, 8, 144, 2, 3, 0, 2, 2, 1, 4, 0, 36000000, 72000000, 72000000,  72000000, 2, 0, 36000000,  71999,  72 },
+};
+
+int main(void)
+{
+    const clock_preset_t* p = NULL;
+
+    for (uint8_t i = 0; i < sizeof(presets) / sizeof(presets[0]); i++) {
+        if (presets[i].sysclk == CLOCK_SYSCLK_HZ) p = &presets[i];
+    }
+    CHECK(p != NULL);                                   // Tabloda olmayan bir SYSCLK ile derlendi
+    if (!p) return TEST_RESULT();
+
+    CHECK_EQ(CLOCK_PLLM, p->pllm);
+    CHECK_EQ(CLOCK_PLLN, p->plln);
+    CHECK_EQ(CLOCK_PLLP, p->pllp);
+    CHECK_EQ(CLOCK_PLLQ, p->pllq);
+    CHECK_EQ(CLOCK_PLLP_BITS, p->pllp_bits);
+    CHECK_EQ((uint64_t)CLOCK_HSE_HZ / CLOCK_PLLM * CLOCK_PLLN / CLOCK_PLLP, CLOCK_SYSCLK_HZ);   // PLL'in verdiği SYSCLK
+    CHECK_EQ((uint64_t)CLOCK_HSE_HZ / CLOCK_PLLM * CLOCK_PLLN / CLOCK_PLLQ, CLOCK_USB_HZ);      // USB 48 MHz tam
+
+    CHECK_EQ(CLOCK_FLASH_WS, p->flash_ws);
+    CHECK(CLOCK_SYSCLK_HZ <= (CLOCK_FLASH_WS + 1) * CLOCK_FLASH_WS_STEP_HZ);    // Yeterli ve gereğinden fazla değil
+    CHECK(CLOCK_SYSCLK_HZ > CLOCK_FLASH_WS * CLOCK_FLASH_WS_STEP_HZ);
+
+    CHECK_EQ(CLOCK_HCLK_HZ, CLOCK_SYSCLK_HZ);
+    CHECK_EQ(CLOCK_APB1_DIV, p->apb1_div);
+    CHECK_EQ(CLOCK_APB2_DIV, p->apb2_div);
+    CHECK_EQ(CLOCK_PPRE1_BITS, p->ppre1_bits);
+    CHECK_EQ(CLOCK_PPRE2_BITS, p->ppre2_bits);
+    CHECK_EQ(CLOCK_PCLK1_HZ, p->pclk1);
+    CHECK_EQ(CLOCK_PCLK2_HZ, p->pclk2);
+    CHECK_EQ(CLOCK_APB1_TIMER_HZ, p->apb1_timer);
+    CHECK_EQ(CLOCK_APB2_TIMER_HZ, p->apb2_timer);
+
+    CHECK_EQ(CLOCK_ADC_DIV, p->adc_div);
+    CHECK_EQ(CLOCK_ADCPRE_BITS, p->adcpre_bits);
+    CHECK_EQ(CLOCK_ADC_HZ, p->adc_hz);
+
+    CHECK_EQ(CLOCK_SYSTICK_RELOAD, p->systick_reload);
+    CHECK_EQ(CLOCK_CYCLES_PER_US, p->cycles_per_us);
+    CHECK_EQ(CLOCK_CYCLES_PER_MS, p->cycles_per_us * 1000);
+
+    printf("  %u MHz: PLL %u/%u/%u/%u, %u WS, APB1 /%u APB2 /%u, ADC %u MHz, %u cycle/µs\n",
+           CLOCK_SYSCLK_HZ / 1000000, CLOCK_PLLM, CLOCK_PLLN, CLOCK_PLLP, CLOCK_PLLQ, CLOCK_FLASH_WS,
+           CLOCK_APB1_DIV, CLOCK_APB2_DIV, CLOCK_ADC_HZ / 1000000, CLOCK_CYCLES_PER_US);
+    return TEST_RESULT();
+}
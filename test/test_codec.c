@@ -0,0 +1,144 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "sample_codec.h"
+
+// sample_codec: rastgele bloklarda (her boy, her derece, en kötü sıçramalar) tam geri dönüşüm ve SAMPLE_CODEC_MAX_BYTES
+// sınırı, AUTO'nun derece seçimi, geçersiz derece / küçük tampon / kesik ve bozuk akışların reddi, arka arkaya blokların
+// consumed ile ayrılması, sentetik MQ2 izinde sıkıştırma oranı
+
+static uint32_t lcg = 12345;
+static uint32_t test_rand(void)
+{
+    lcg = lcg * 1664525u + 1013904223u;
+    return lcg >> 8;
+}
+
+static void test_block(uint16_t* x, uint16_t n, uint8_t kind)
+{
+    int32_t v = (int32_t)(test_rand() & 0xFFFF);
+    int32_t slope = (int32_t)(test_rand() % 41) - 20;
+
+    for (uint16_t i = 0; i < n; i++) {
+        switch (kind) {
+        case 0: x[i] = (uint16_t)test_rand(); break;                        // Tam 16-bit gürültü (en kötü)
+        case 1: x[i] = (test_rand() & 1) ? 0xFFFF : 0; break;               // Her örnekte uçtan uca sıçrama
+        case 2: v += (int32_t)(test_rand() % 65) - 32; break;               // Rastgele yürüyüş
+        default: v += slope; break;                                         // Doğrusal eğim
+        }
+        if (kind >= 2) {
+            if (v < 0) v = 0;
+            if (v > 0xFFFF) v = 0xFFFF;
+            x[i] = (uint16_t)v;
+        }
+    }
+}
+
+static void test_roundtrip(void)
+{
+    static uint16_t in[SAMPLE_CODEC_BLOCK_MAX], out[SAMPLE_CODEC_BLOCK_MAX];
+    static uint8_t buf[SAMPLE_CODEC_MAX_BYTES(SAMPLE_CODEC_BLOCK_MAX)];
+    uint32_t errors = 0, blocks = 0;
+
+    for (uint32_t b = 0; b < 20000; b++) {
+        uint16_t n = (uint16_t)(1 + test_rand() % SAMPLE_CODEC_BLOCK_MAX);
+        uint8_t order = (uint8_t)(b % 3);
+        uint16_t consumed = 0;
+
+        test_block(in, n, (uint8_t)(test_rand() % 4));
+        uint16_t len = sample_codec_encode(in, n, (sample_codec_order_t)order, buf, sizeof(buf));
+        if (len == 0 || len > SAMPLE_CODEC_MAX_BYTES(n)) { errors++; continue; }
+        if (sample_codec_decode(buf, len, out, n, &consumed) != n || consumed != len || memcmp(in, out, n * 2)) errors++;
+        blocks++;
+    }
+    printf("  geri dönüşüm: %u blok, %u hata\n", blocks, errors);
+    CHECK_EQ(errors, 0);
+}
+
+static void test_limits(void)
+{
+    uint16_t in[64], out[64];
+    uint8_t buf[SAMPLE_CODEC_MAX_BYTES(64)];
+    uint16_t consumed;
+
+    for (uint16_t i = 0; i < 64; i++) in[i] = (uint16_t)(1000 + 10 * i);
+
+    // AUTO: eğimde 2. derece, gürültüde delta seçilir
+    uint16_t len = sample_codec_encode(in, 64, SAMPLE_CODEC_AUTO, buf, sizeof(buf));
+    CHECK(len > 0);
+    CHECK_EQ(buf[3] >> 6, SAMPLE_CODEC_ORDER2);
+    CHECK_EQ(len, SAMPLE_CODEC_HEADER_LEN + (21 + 62 + 7) / 8);         // k = 0: ilk artık delta ile 10 (zig-zag 20 → 21 bit), kalan 62 artık 0 (1 bit)
+    for (uint16_t i = 0; i < 64; i++) in[i] = (uint16_t)(1000 + (i & 1) * 3);
+    CHECK(sample_codec_encode(in, 64, SAMPLE_CODEC_AUTO, buf, sizeof(buf)) > 0);
+    CHECK_EQ(buf[3] >> 6, SAMPLE_CODEC_DELTA);
+
+    // Geçersiz parametreler
+    CHECK_EQ(sample_codec_encode(in, 64, (sample_codec_order_t)3, buf, sizeof(buf)), 0);
+    CHECK_EQ(sample_codec_encode(in, 64, (sample_codec_order_t)200, buf, sizeof(buf)), 0);
+    CHECK_EQ(sample_codec_encode(in, 0, SAMPLE_CODEC_DELTA, buf, sizeof(buf)), 0);
+    CHECK_EQ(sample_codec_encode(in, SAMPLE_CODEC_BLOCK_MAX + 1, SAMPLE_CODEC_DELTA, buf, sizeof(buf)), 0);
+    CHECK_EQ(sample_codec_encode(in, 64, SAMPLE_CODEC_DELTA, buf, SAMPLE_CODEC_HEADER_LEN - 1), 0);
+    len = sample_codec_encode(in, 64, SAMPLE_CODEC_DELTA, buf, sizeof(buf));
+    CHECK_EQ(sample_codec_encode(in, 64, SAMPLE_CODEC_DELTA, buf, len - 1), 0);        // Sığmadı: yarım blok yok
+    CHECK_EQ(sample_codec_encode(in, 64, SAMPLE_CODEC_DELTA, buf, len), len);
+
+    // Tek örnek: sadece başlık
+    CHECK_EQ(sample_codec_encode(in, 1, SAMPLE_CODEC_ORDER2, buf, sizeof(buf)), SAMPLE_CODEC_HEADER_LEN);
+    CHECK_EQ(sample_codec_decode(buf, SAMPLE_CODEC_HEADER_LEN, out, 64, &consumed), 1);
+    CHECK_EQ(out[0], in[0]);
+
+    // Çözücü: kesik akış, küçük çıkış tamponu, derece 3 / 0 ve k > 16 başlıkları
+    for (uint16_t i = 0; i < 64; i++) in[i] = (uint16_t)(test_rand() & 0xFFF);
+    len = sample_codec_encode(in, 64, SAMPLE_CODEC_DELTA, buf, sizeof(buf));
+    CHECK_EQ(sample_codec_decode(buf, len - 2, out, 64, &consumed), 0);
+    CHECK_EQ(sample_codec_decode(buf, len, out, 63, &consumed), 0);
+    CHECK_EQ(sample_codec_decode(buf, SAMPLE_CODEC_HEADER_LEN - 1, out, 64, &consumed), 0);
+    uint8_t h = buf[3];
+    buf[3] = (uint8_t)((3 << 6) | (h & 0x1F));
+    CHECK_EQ(sample_codec_decode(buf, len, out, 64, &consumed), 0);
+    buf[3] = (uint8_t)(h & 0x1F);
+    CHECK_EQ(sample_codec_decode(buf, len, out, 64, &consumed), 0);
+    buf[3] = (uint8_t)((SAMPLE_CODEC_DELTA << 6) | 17);
+    CHECK_EQ(sample_codec_decode(buf, len, out, 64, &consumed), 0);
+}
+
+static void test_stream(void)
+{
+    // Sentetik MQ2 izi (15-bit): ısınmada üstel düşüş, yavaş kayma, ±32 LSB gürültü, bir gaz yükselişi
+    static uint16_t trace[16 * 128], out[128];
+    static uint8_t stream[sizeof(trace) * 2];
+    uint32_t pos = 0, errors = 0;
+
+    for (uint32_t i = 0; i < 16 * 128; i++) {
+        double v = 6000 + 8000 * (i < 512 ? (512 - i) / 512.0 : 0) + i * 0.5 + (i > 1400 && i < 1600 ? (i - 1400) * 40 : 0);
+        if (i >= 1600) v += 8000;
+        trace[i] = (uint16_t)(v + (int32_t)(test_rand() % 65) - 32);
+    }
+    for (uint32_t b = 0; b < 16; b++) {
+        pos += sample_codec_encode(&trace[b * 128], 128, SAMPLE_CODEC_AUTO, &stream[pos], (uint16_t)(sizeof(stream) - pos));
+    }
+
+    uint32_t at = 0;                                    // Arka arkaya bloklar: her biri consumed kadar yer kaplar
+    for (uint32_t b = 0; b < 16; b++) {
+        uint16_t consumed = 0;
+        if (sample_codec_decode(&stream[at], (uint16_t)(pos - at), out, 128, &consumed) != 128 ||
+            memcmp(out, &trace[b * 128], sizeof(out))) errors++;
+        at += consumed;
+    }
+    double ratio = (double)sizeof(trace) / pos;
+    printf("  MQ2 izi: %u örnek, %u bayt, oran %.2f, hata %u\n", 16 * 128, pos, ratio, errors);
+    CHECK_EQ(errors, 0);
+    CHECK_EQ(at, pos);
+    CHECK(ratio > 2.0);
+}
+
+int main(void)
+{
+    test_roundtrip();
+    test_limits();
+    test_stream();
+
+    return TEST_RESULT();
+}
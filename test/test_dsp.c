@@ -0,0 +1,168 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "dsp_filter.h"
+
+// dsp_filter: DSP komutlu yol (-DDSP_FILTER_SIMD=1, __SMLALD / __SMUAD / __PKHBT stub'daki C karşılıklarıyla) taşınabilir
+// C yolu ile bit bit aynı olmalı. FIR block_max'tan uzun blokları parçalayıp doğrudan konvolüsyonla aynı sonucu vermeli
+// (yerinde dahil). Biquad alçak geçiren DC kazancı ~1, medyan sıralama ile aynı ve tek örneklik sıçramaları silmeli.
+
+#define TEST_TAPS_MAX   101
+#define TEST_BLOCK_MAX  64
+#define TEST_N_MAX      256
+
+_Static_assert(DSP_FILTER_SIMD == 1, "Bu test DSP komutlu yolu derlemeli (Makefile: -DDSP_FILTER_SIMD=1)");
+
+static int16_t test_q15(void)
+{
+    return (int16_t)(rand() % 65536 - 32768);
+}
+
+static int16_t test_sat(int64_t v)
+{
+    return v > 32767 ? 32767 : v < -32768 ? -32768 : (int16_t)v;
+}
+
+static void test_fir(void)
+{
+    static int16_t coeffs[TEST_TAPS_MAX], in[TEST_N_MAX], out_simd[TEST_N_MAX], out_c[TEST_N_MAX];
+    static int16_t state_simd[TEST_TAPS_MAX - 1 + TEST_BLOCK_MAX], state_c[TEST_TAPS_MAX - 1 + TEST_BLOCK_MAX];
+    uint32_t blocks = 0, mismatch = 0;
+
+    for (uint16_t taps = 1; taps <= TEST_TAPS_MAX; taps++) {
+        dsp_fir_t a, b;
+        for (uint16_t i = 0; i < taps; i++) coeffs[i] = test_q15();
+        CHECK_EQ(dsp_fir_init(&a, coeffs, taps, state_simd, TEST_BLOCK_MAX), 0);
+        CHECK_EQ(dsp_fir_init(&b, coeffs, taps, state_c, TEST_BLOCK_MAX), 0);
+
+        for (uint8_t k = 0; k < 8; k++) {
+            uint16_t n = (uint16_t)(1 + rand() % TEST_N_MAX);     // Çoğu block_max'tan uzun
+            for (uint16_t i = 0; i < n; i++) in[i] = test_q15();  // Tam ölçek: doyma da karşılaştırılır
+            dsp_fir_process(&a, in, out_simd, n);
+            dsp_fir_process_c(&b, in, out_c, n);
+            if (memcmp(out_simd, out_c, n * 2)) mismatch++;
+            blocks++;
+        }
+    }
+    printf("  FIR 1-%u katsayı: %u blok, DSP / C farkı %u\n", TEST_TAPS_MAX, blocks, mismatch);
+    CHECK_EQ(mismatch, 0);
+}
+
+static void test_fir_reference(void)
+{
+    static const int16_t coeffs[7] = { 1000, -2000, 3000, 4000, 3000, -2000, 1000 };
+    static int16_t x[600], y[600], state[6 + 10];
+    static const uint16_t sizes[] = { 1, 9, 10, 11, 25, 200, 344 };     // Toplam 600; block_max = 10
+    dsp_fir_t f;
+    uint32_t bad = 0;
+
+    for (uint16_t i = 0; i < 600; i++) x[i] = (int16_t)(rand() % 40000 - 20000);
+    memcpy(y, x, sizeof(y));
+    CHECK_EQ(dsp_fir_init(&f, coeffs, 7, state, 10), 0);
+
+    uint16_t at = 0;
+    for (uint8_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+        dsp_fir_process(&f, &y[at], &y[at], sizes[k]);      // Yerinde, block_max'tan uzun bloklar dahil
+        at += sizes[k];
+    }
+
+    for (uint16_t i = 0; i < 600; i++) {
+        int64_t acc = 1 << 14;
+        for (uint16_t k = 0; k < 7; k++) {
+            int32_t j = i - 6 + k;
+            if (j >= 0) acc += (int32_t)x[j] * coeffs[k];
+        }
+        if (test_sat(acc >> 15) != y[i]) bad++;
+    }
+    printf("  FIR doğrudan konvolüsyon: 600 örnek, block_max 10, fark %u\n", bad);
+    CHECK_EQ(at, 600);
+    CHECK_EQ(bad, 0);
+}
+
+static void test_biquad(void)
+{
+    static int16_t coeffs[2 * 6], in[TEST_N_MAX], out_simd[TEST_N_MAX], out_c[TEST_N_MAX];
+    int16_t state_simd[2 * 4], state_c[2 * 4];
+    uint32_t blocks = 0, mismatch = 0;
+
+    for (uint16_t t = 0; t < 600; t++) {
+        uint8_t stages = (uint8_t)(1 + t % 2);
+        dsp_biquad_t a, b;
+        for (uint8_t i = 0; i < 12; i++) coeffs[i] = test_q15();       // Kararsız olanlar dahil: doyma da aynı olmalı
+        coeffs[1] = coeffs[7] = 0;
+        CHECK_EQ(dsp_biquad_init(&a, coeffs, stages, state_simd, (uint8_t)(t % 3)), 0);
+        CHECK_EQ(dsp_biquad_init(&b, coeffs, stages, state_c, (uint8_t)(t % 3)), 0);
+
+        for (uint8_t k = 0; k < 4; k++) {
+            uint16_t n = (uint16_t)(1 + rand() % TEST_N_MAX);
+            for (uint16_t i = 0; i < n; i++) in[i] = test_q15();
+            memcpy(out_simd, in, n * 2);
+            dsp_biquad_process(&a, out_simd, out_simd, n);          // Yerinde
+            dsp_biquad_process_c(&b, in, out_c, n);
+            if (memcmp(out_simd, out_c, n * 2)) mismatch++;
+            blocks++;
+        }
+    }
+
+    // main.c'deki 1 Hz alçak geçiren (Q14): basamak girişte DC kazancı
+    static const int16_t lp[6] = { 512, 0, 1023, 512, 23618, -9281 };
+    int16_t lp_state[4], step[TEST_N_MAX];
+    dsp_biquad_t q;
+    CHECK_EQ(dsp_biquad_init(&q, lp, 1, lp_state, 1), 0);
+    for (uint16_t i = 0; i < TEST_N_MAX; i++) step[i] = 20000;
+    dsp_biquad_process(&q, step, step, TEST_N_MAX);
+
+    int16_t peak = 0;
+    for (uint16_t i = 0; i < TEST_N_MAX; i++) if (step[i] > peak) peak = step[i];
+
+    printf("  biquad: %u blok, DSP / C farkı %u; alçak geçiren 20000 basamağı: ilk %d, tepe %d, son %d\n",
+           blocks, mismatch, step[0], peak, step[TEST_N_MAX - 1]);
+    CHECK_EQ(mismatch, 0);
+    CHECK(step[TEST_N_MAX - 1] > 19800 && step[TEST_N_MAX - 1] < 20200);
+    CHECK(step[0] < 2000);                                  // Basamak yumuşatıldı
+    CHECK(peak < 21000);                                    // 2. derece Butterworth: ~%4 aşım
+}
+
+static int test_cmp(const void* a, const void* b)
+{
+    return *(const int16_t*)a - *(const int16_t*)b;
+}
+
+static void test_median(void)
+{
+    uint32_t bad = 0;
+
+    for (uint8_t taps = 3; taps <= 7; taps += 2) {
+        for (uint32_t t = 0; t < 100000; t++) {
+            int16_t v[DSP_MEDIAN_MAX], sorted[DSP_MEDIAN_MAX];
+            for (uint8_t i = 0; i < taps; i++) v[i] = sorted[i] = (int16_t)(rand() % 9 - 4);   // Çok tekrar: eşitlikler
+            qsort(sorted, taps, sizeof(int16_t), test_cmp);
+            if (dsp_median_of(v, taps) != sorted[taps / 2]) bad++;
+        }
+    }
+    CHECK_EQ(bad, 0);
+
+    dsp_median_t m;
+    int16_t x[16] = { 0, 0, 0, 900, 0, 0, 0, 50, 50, 50, 50, 50, 0, 0, -700, 0 };
+    CHECK_EQ(dsp_median_init(&m, 5, 0), 0);
+    CHECK_EQ(dsp_median_init(&m, 4, 0), 1);
+    CHECK_EQ(dsp_median_init(&m, 5, 0), 0);
+    dsp_median_process(&m, x, x, 16);
+    for (uint8_t i = 0; i < 16; i++) {
+        CHECK(x[i] == 0 || x[i] == 50);                     // Tek örneklik sıçramalar silindi, basamak kaldı
+    }
+    CHECK_EQ(x[11], 50);
+}
+
+int main(void)
+{
+    srand(1);
+    test_fir();
+    test_fir_reference();
+    test_biquad();
+    test_median();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,124 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "emu.h"
+#include "hd44780.h"
+#include "lcd_config.h"
+
+// lcd_flush(): rastgele çerçeve değişikliklerinden sonra panel çerçeveyle aynı olmalı, gönderilen bayt sayısı
+// panelin gördüğü komut + veri sayısına eşit olmalı, değişmeyen çerçeve hiçbir bayt göndermemeli; CGRAM'e sadece
+// çerçevede görünen glyph'ler yüklenmeli
+
+static hd44780_t lcd;
+static char want[LCD_ROWS][LCD_COLS + 1];
+
+static uint32_t test_panel_bytes(void)
+{
+    return lcd.commands + lcd.writes;
+}
+
+static void test_panel_matches(int step)
+{
+    char got[LCD_COLS + 1];
+
+    for (uint8_t r = 0; r < LCD_ROWS; r++) {
+        hd44780_row(&lcd, r, got, LCD_COLS);
+        if (strcmp(got, want[r]) != 0) {
+            test_failures++;
+            printf("adım %d satır %u: \"%s\" bekleniyordu, \"%s\" okundu\n", step, r, want[r], got);
+        }
+    }
+}
+
+int main(void)
+{
+    emu_init();
+    emu_lcd_attach(&lcd, EMU_LCD_GPIO4);
+    lcd_init();
+
+    lcd_fb_clear();
+    for (uint8_t r = 0; r < LCD_ROWS; r++) {
+        memset(want[r], ' ', LCD_COLS);
+        want[r][LCD_COLS] = '\0';
+    }
+    CHECK_EQ(lcd_flush(), 0);                   // lcd_init panelini temizledi, gölge bunu biliyor
+
+    srand(1);
+    uint32_t changed_total = 0, sent_total = 0;
+    for (int step = 0; step < 2000; step++) {
+        int edits = rand() % 4;                 // 0: hiçbir şey değişmez
+        for (int i = 0; i < edits; i++) {
+            uint8_t r = rand() % LCD_ROWS;
+            uint8_t c = rand() % LCD_COLS;
+            char s[LCD_COLS + 1];
+            int len = 1 + rand() % 6;
+            for (int k = 0; k < len; k++) s[k] = (char)('0' + rand() % 4);  // Küçük alfabe: yazımların çoğu aynı karakter
+            s[len] = '\0';
+            lcd_fb_write(r, c, s);
+            for (int k = 0; k < len && c + k < LCD_COLS; k++) want[r][c + k] = s[k];
+        }
+
+        uint32_t before = test_panel_bytes();
+        uint8_t sent = lcd_flush();
+        CHECK_EQ(sent, test_panel_bytes() - before);
+        if (edits == 0) CHECK_EQ(sent, 0);
+        test_panel_matches(step);
+        sent_total += sent;
+        changed_total += edits;
+    }
+    CHECK_EQ(hd44780_violation_total(&lcd), 0);
+    printf("  2000 flush, %lu düzenleme, %lu bayt\n", (unsigned long)changed_total, (unsigned long)sent_total);
+
+    // Ardışık iki hane: imleç + 2 karakter; aynı bölgenin devamı yazılırsa imleç komutu gitmez
+    lcd_fb_write(0, 0, "ADC: 1234       ");
+    lcd_fb_write(1, 0, "                ");
+    lcd_flush();
+    lcd_fb_write(0, 7, "56");
+    CHECK_EQ(lcd_flush(), 3);
+    lcd_fb_write(0, 9, "7");                    // İmleç 0x09'da kaldı
+    CHECK_EQ(lcd_flush(), 1);
+
+    // Arada tek aynı hücre: iki bölge birleşir (imleç komutu yerine o hücre yeniden yazılır)
+    lcd_fb_write(0, 0, "X");
+    lcd_fb_write(0, 2, "Y");
+    CHECK_EQ(lcd_flush(), 1 + 3);
+
+    // Blok yazım sonrası gölge bozulmaz: lcd_clear çerçeveyi değil paneli temizler, flush her şeyi geri yazar
+    lcd_clear();
+    CHECK_EQ(lcd_flush(), 10);                  // "XDY: 12567": clear imleci 0x00'a aldı, tek boşluk bölgeyi bölmez
+
+    // Glyph: sadece çerçevede görünen slotlar yüklenir
+    lcd_fb_clear();
+    lcd_bar_graph(1, 0, 16, 37, 80);            // 7 tam hücre + 2 sütunluk slot 1
+    for (int i = 0; i < LCD_SPARK_SAMPLES; i++) lcd_sparkline_push((uint16_t)i, LCD_SPARK_SAMPLES);
+    lcd_sparkline_draw(0, 0);                   // Slot 4-7
+    uint32_t uploads = lcd_cgram_uploads();
+    lcd_flush();
+    CHECK_EQ(lcd_cgram_uploads() - uploads, 5);
+    CHECK_EQ(hd44780_glyph_row(&lcd, 1, 0), 0x18);
+
+    lcd_fb_write(0, 0, "    ");                 // Sparkline kaldırıldı; yeni örnekler çizilmeyen slotları yüklemez
+    lcd_bar_graph(1, 0, 16, 38, 80);            // Kısmi hücre slot 2'ye geçti, slot 1 artık görünmüyor
+    uploads = lcd_cgram_uploads();
+    lcd_flush();
+    CHECK_EQ(lcd_cgram_uploads() - uploads, 1);
+    lcd_bar_graph(1, 0, 16, 37, 80);            // Slot 1'in deseni CGRAM'de zaten var
+    uploads = lcd_cgram_uploads();
+    lcd_flush();
+    CHECK_EQ(lcd_cgram_uploads() - uploads, 0);
+
+    // Yeniden başlatma CGRAM'i bilinmez yapar: eskiden kullanılmış bütün slotlar değil, sadece ekrandaki glyph gider
+    lcd_init();
+    uploads = lcd_cgram_uploads();
+    uint32_t before = test_panel_bytes();
+    uint8_t sent = lcd_flush();
+    CHECK_EQ(lcd_cgram_uploads() - uploads, 1);
+    CHECK_EQ(sent, test_panel_bytes() - before);
+    CHECK_EQ(lcd.ddram[0x40 + 7], 0x08 + 1);
+    CHECK_EQ(hd44780_glyph_row(&lcd, 1, 0), 0x18);
+    CHECK_EQ(hd44780_violation_total(&lcd), 0);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,161 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <setjmp.h>
+#include "test.h"
+#include "nor_flash.h"
+#include "flash_log.h"
+
+// flash_log: sektör silme kayıt yazımının içinde değil, önceden flash_log_service() ile yapılmalı; dönüşlerde geçmiş
+// sıralı ve boşluksuz kalmalı, servis çağrılmazsa dönüş yine silerek çalışmalı. Rastgele elektrik kesintilerinden sonra
+// okunan her kayıt yazılanla aynı, zaman sırası korunmuş ve flash'a yazıldığı onaylanan son kayıt geçmişte olmalı.
+
+#define TEST_SLOTS      ((NOR_SECTOR_SIZE - FLASH_LOG_HEADER_SIZE) / FLASH_LOG_RECORD_SIZE)   // Sektör başına kayıt
+
+static uint32_t test_erases(void)
+{
+    return nor_erases(FLASH_SECTOR_LOG_FIRST) + nor_erases(FLASH_SECTOR_LOG_FIRST + 1);
+}
+
+static void test_record(uint32_t t, flash_log_record_t* r)     // İçerik zamandan türetilir: okunan kayıt doğrulanabilir
+{
+    r->timestamp_s = t;
+    r->min = (uint16_t)(t * 7);
+    r->max = (uint16_t)(t * 7 + 100);
+    r->mean = (uint16_t)(t * 7 + 50);
+    r->count = (uint16_t)(t ^ 0x5A5A);
+}
+
+static uint8_t test_record_ok(const flash_log_record_t* r)
+{
+    flash_log_record_t want;
+    test_record(r->timestamp_s, &want);
+    return r->min == want.min && r->max == want.max && r->mean == want.mean && r->count == want.count;
+}
+
+typedef struct {
+    uint32_t count;
+    uint32_t first;
+    uint32_t last;
+    uint32_t gaps;                      // Ardışık olmayan zaman (kayıp kayıt)
+    uint32_t bad;                       // İçerik hatalı veya zaman geriye gitti
+} test_history_t;
+
+static test_history_t test_read(void)
+{
+    test_history_t h = { 0 };
+    flash_log_iter_t it;
+    flash_log_record_t r;
+
+    flash_log_iter_begin(&it);
+    while (flash_log_iter_next(&it, &r) == 0) {
+        if (!test_record_ok(&r) || (h.count && r.timestamp_s <= h.last)) h.bad++;
+        else if (h.count && r.timestamp_s != h.last + 1) h.gaps++;
+        if (!h.count) h.first = r.timestamp_s;
+        h.last = r.timestamp_s;
+        h.count++;
+    }
+    return h;
+}
+
+static void test_preerase(void)
+{
+    flash_log_record_t r;
+    uint32_t inline_erases = 0, min_history = 0xFFFFFFFFu;
+
+    nor_reset(0xFFFFFFFFu);
+    CHECK_EQ(flash_log_init(), 0);
+    CHECK_EQ(test_erases(), 0);                         // Boş flash: ilk sektör silinmeden başlar
+
+    // Ana döngü gibi: her saniye önce servis, sonra kayıt; kaydın kendisi hiç silme yapmamalı
+    for (uint32_t t = 1; t <= 20 * TEST_SLOTS; t++) {
+        CHECK_EQ(flash_log_service(), 0);
+        uint32_t erases = test_erases();
+        test_record(t, &r);
+        CHECK_EQ(flash_log_append(&r), 0);
+        inline_erases += test_erases() - erases;
+
+        if (t > 2 * TEST_SLOTS) {
+            test_history_t h = test_read();
+            CHECK_EQ(h.bad, 0);
+            CHECK_EQ(h.gaps, 0);
+            CHECK_EQ(h.last, t);
+            if (h.count < min_history) min_history = h.count;
+        }
+    }
+    printf("  önceden silme: %u kayıt, %u silme (kayıt içinde %u), en kısa geçmiş %u kayıt (sektör %u)\n",
+           20 * TEST_SLOTS, test_erases(), inline_erases, min_history, TEST_SLOTS);
+    CHECK_EQ(inline_erases, 0);
+    CHECK(test_erases() >= 18 && test_erases() <= 20);
+    CHECK(min_history >= TEST_SLOTS * FLASH_LOG_PREERASE_PERCENT / 100);
+    CHECK_EQ(nor_overwrites(), 0);
+
+    // Yeniden açılış: önceden silinmiş sektör tanınır, tekrar silinmez
+    uint32_t erases = test_erases();
+    CHECK_EQ(flash_log_init(), 0);
+    for (uint32_t t = 20 * TEST_SLOTS + 1; t <= 22 * TEST_SLOTS; t++) {
+        test_record(t, &r);
+        CHECK_EQ(flash_log_append(&r), 0);
+        CHECK_EQ(flash_log_service(), 0);
+        if (t == 20 * TEST_SLOTS + 1) CHECK_EQ(test_erases(), erases);
+    }
+
+    // Servis hiç çağrılmazsa dönüş silerek yapılır, geçmiş yine boşluksuz
+    erases = test_erases();
+    for (uint32_t t = 22 * TEST_SLOTS + 1; t <= 26 * TEST_SLOTS; t++) {
+        test_record(t, &r);
+        CHECK_EQ(flash_log_append(&r), 0);
+    }
+    test_history_t h = test_read();
+    CHECK(test_erases() - erases >= 3);
+    CHECK_EQ(h.bad, 0);
+    CHECK_EQ(h.gaps, 0);
+    CHECK_EQ(h.last, 26 * TEST_SLOTS);
+    CHECK_EQ(nor_overwrites(), 0);
+}
+
+static void test_power_cut(void)
+{
+    static jmp_buf jump;
+    static uint32_t t, committed, cuts, lost_committed, bad;  // longjmp'tan sonra da geçerli kalmalı (static)
+    flash_log_record_t r;
+
+    nor_reset(0);                                       // Fabrikadan çöp içerik
+    t = 0;
+    committed = 0;
+    for (uint32_t round = 0; round < 600; round++) {
+        if (setjmp(jump) == 0) {
+            nor_cut_after(rand() % 4, &jump);
+            flash_log_init();
+            nor_cut_after(-1, &jump);
+
+            test_history_t h = test_read();
+            if (committed && (h.count == 0 || h.last < committed)) lost_committed++;
+            bad += h.bad;
+            if (h.count) t = h.last;                    // RAM'deki kayıtlar kayboldu: zaman flash'taki son kayıttan devam eder
+
+            nor_cut_after(rand() % 1000, &jump);                // Bazı turlar kesintisiz biter
+            for (uint32_t i = 0; i < 3 * TEST_SLOTS; i++) {
+                flash_log_service();
+                test_record(++t, &r);
+                if (flash_log_append(&r) == 0 && flash_log_staged() == 0) committed = t;
+            }
+            nor_cut_after(-1, &jump);
+        } else {
+            cuts++;
+        }
+    }
+    printf("  kesinti: 600 tur, %u kesinti, onaylı kayıp %u, hatalı kayıt %u\n", cuts, lost_committed, bad);
+    CHECK(cuts > 300);
+    CHECK_EQ(lost_committed, 0);
+    CHECK_EQ(bad, 0);
+    CHECK_EQ(nor_overwrites(), 0);
+}
+
+int main(void)
+{
+    test_preerase();
+    test_power_cut();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,174 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "test.h"
+#include "fmt.h"
+
+// fmt: fmt_u32 / fmt_i32 / fmt_fixed çıktısının snprintf ile aynı olması (sağa / sola yaslı, ' ' / '0' / başka dolgu,
+// INT32_MIN dahil uç değerler), sığmayan sayıda alanın '*' ile dolması ve dönüş 1, alanın dışına tek bayt yazılmaması,
+// çağrı başına süre (snprintf'e göre)
+
+#define GUARD   0x5A                            // Alanın önüne / arkasına konan işaret baytı
+
+static uint32_t lcg = 2024;
+static uint32_t test_rand(void)
+{
+    lcg = lcg * 1664525u + 1013904223u;
+    return lcg;
+}
+
+// snprintf ile beklenen alan: sığmazsa '*' dolu. Dönüş: 1 sığmadı
+static uint8_t ref_field(char* out, uint8_t width, const char* body, uint8_t neg, fmt_align_t align, char pad)
+{
+    uint8_t len = (uint8_t)strlen(body) + neg;
+
+    if (len > width) {
+        memset(out, FMT_OVERFLOW_CHAR, width);
+        return 1;
+    }
+    if (align == FMT_ALIGN_LEFT) {
+        snprintf(out, width + 1, "%s%s%*s", neg ? "-" : "", body, width - len, "");
+        if (pad != '0') for (uint8_t i = len; i < width; i++) out[i] = pad;
+    } else if (pad == '0') {
+        snprintf(out, width + 1, "%s%0*d%s", neg ? "-" : "", width - len, 0, body);
+        if (width == len) snprintf(out, width + 1, "%s%s", neg ? "-" : "", body);
+    } else {
+        snprintf(out, width + 1, "%*s%s%s", width - len, "", neg ? "-" : "", body);
+        for (uint8_t i = 0; i < width - len; i++) out[i] = pad;
+    }
+    return 0;
+}
+
+static uint8_t ref_fixed(char* out, uint8_t width, int32_t value, uint8_t decimals, fmt_align_t align, char pad)
+{
+    char body[24];
+    uint8_t neg = value < 0;
+    uint32_t mag = neg ? (0u - (uint32_t)value) : (uint32_t)value;
+    uint32_t scale = 1;
+
+    if (decimals > FMT_MAX_DIGITS - 1) decimals = FMT_MAX_DIGITS - 1;
+    for (uint8_t i = 0; i < decimals; i++) scale *= 10;
+    if (decimals) snprintf(body, sizeof(body), "%u.%0*u", mag / scale, decimals, mag % scale);
+    else snprintf(body, sizeof(body), "%u", mag);
+    return ref_field(out, width, body, neg, align, pad);
+}
+
+static void test_examples(void)
+{
+    char d[16];
+
+    CHECK_EQ(fmt_u32(d, 6, 42, FMT_ALIGN_RIGHT, ' '), 0);
+    CHECK(memcmp(d, "    42", 6) == 0);
+    CHECK_EQ(fmt_i32(d, 6, -42, FMT_ALIGN_RIGHT, '0'), 0);
+    CHECK(memcmp(d, "-00042", 6) == 0);
+    CHECK_EQ(fmt_fixed(d, 6, 1234, 2, FMT_ALIGN_LEFT, ' '), 0);
+    CHECK(memcmp(d, "12.34 ", 6) == 0);
+    CHECK_EQ(fmt_u32(d, 3, 12345, FMT_ALIGN_RIGHT, ' '), 1);
+    CHECK(memcmp(d, "***", 3) == 0);
+
+    CHECK_EQ(fmt_fixed(d, 5, -5, 2, FMT_ALIGN_RIGHT, ' '), 0);      // Baştaki sıfır
+    CHECK(memcmp(d, "-0.05", 5) == 0);
+    CHECK_EQ(fmt_fixed(d, 4, -5, 2, FMT_ALIGN_RIGHT, ' '), 1);
+    CHECK(memcmp(d, "****", 4) == 0);
+    CHECK_EQ(fmt_i32(d, 11, INT32_MIN, FMT_ALIGN_RIGHT, ' '), 0);
+    CHECK(memcmp(d, "-2147483648", 11) == 0);
+    CHECK_EQ(fmt_u32(d, 10, UINT32_MAX, FMT_ALIGN_LEFT, ' '), 0);
+    CHECK(memcmp(d, "4294967295", 10) == 0);
+    CHECK_EQ(fmt_u32(d, 4, 7, FMT_ALIGN_LEFT, '0'), 0);             // Sola yaslıda sağa sıfır değil boşluk
+    CHECK(memcmp(d, "7   ", 4) == 0);
+    CHECK_EQ(fmt_u32(d, 0, 7, FMT_ALIGN_RIGHT, ' '), 1);            // Boş alan: hiçbir şey yazılmaz
+}
+
+static void test_random(void)
+{
+    static const char pads[] = { ' ', '0', '_' };
+    uint32_t mismatch = 0, overflow = 0, calls = 0;
+
+    for (uint32_t n = 0; n < 200000; n++) {
+        char got[40], want[40];
+        uint32_t r = test_rand();
+        uint8_t kind = n % 3;
+        uint8_t width = (uint8_t)(test_rand() % 14);
+        uint8_t decimals = (uint8_t)(test_rand() % 5);
+        fmt_align_t align = (test_rand() & 1) ? FMT_ALIGN_LEFT : FMT_ALIGN_RIGHT;
+        char pad = pads[test_rand() % 3];
+        uint32_t value = r >> (test_rand() % 32);                   // Her basamak sayısı eşit sıklıkta
+        int32_t svalue = (r & 1) ? -(int32_t)(value >> 1) : (int32_t)(value >> 1);
+        uint8_t ret, ref;
+
+        if (n == 7) svalue = INT32_MIN;
+        if (n == 8) svalue = INT32_MAX;
+
+        memset(got, GUARD, sizeof(got));
+        memset(want, GUARD, sizeof(want));
+        if (kind == 0) {
+            char body[12];
+            snprintf(body, sizeof(body), "%u", value);
+            ret = fmt_u32(&got[8], width, value, align, pad);
+            ref = ref_field(&want[8], width, body, 0, align, pad);
+        } else if (kind == 1) {
+            ret = fmt_i32(&got[8], width, svalue, align, pad);
+            ref = ref_fixed(&want[8], width, svalue, 0, align, pad);
+        } else {
+            ret = fmt_fixed(&got[8], width, svalue, decimals, align, pad);
+            ref = ref_fixed(&want[8], width, svalue, decimals, align, pad);
+        }
+        want[8 + width] = GUARD;                                    // snprintf'in '\0'ı: fmt hiç yazmamalı
+
+        if (ret != ref || memcmp(got, want, sizeof(got)) != 0) {
+            if (mismatch < 5) printf("  fark: tip %u genişlik %u değer %d/%u: \"%.*s\" != \"%.*s\"\n",
+                                     kind, width, svalue, value, width, &got[8], width, &want[8]);
+            mismatch++;
+        }
+        overflow += ret;
+        calls++;
+    }
+    printf("  snprintf ile karşılaştırma: %u çağrı, %u sığmayan, %u fark\n", calls, overflow, mismatch);
+    CHECK_EQ(mismatch, 0);
+    CHECK(overflow > 0 && overflow < calls);
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static void test_speed(void)
+{
+    enum { CALLS = 200000, ROUNDS = 5 };
+    static char sink[16];
+    uint64_t best_fmt = UINT64_MAX, best_snp = UINT64_MAX;
+
+    for (uint8_t round = 0; round < ROUNDS; round++) {              // En iyi tur: zamanlayıcı gürültüsünü ayıklar
+        uint64_t t0 = now_ns();
+        for (uint32_t i = 0; i < CALLS; i++) {
+            fmt_fixed(sink, 6, (int32_t)(i * 7u) - 700000, 1, FMT_ALIGN_RIGHT, ' ');
+            __asm__ volatile("" ::: "memory");
+        }
+        uint64_t t1 = now_ns();
+        for (uint32_t i = 0; i < CALLS; i++) {
+            int32_t v = (int32_t)(i * 7u) - 700000;
+            snprintf(sink, sizeof(sink), "%4d.%d", v / 10, abs(v % 10));    // Ekrandaki eski yol: tam kısım + ayrı kesir
+            __asm__ volatile("" ::: "memory");
+        }
+        uint64_t t2 = now_ns();
+        if (t1 - t0 < best_fmt) best_fmt = t1 - t0;
+        if (t2 - t1 < best_snp) best_snp = t2 - t1;
+    }
+
+    printf("  çağrı başına (bilgisayar): fmt_fixed %.1f ns, snprintf %.1f ns (%.1fx)\n",
+           (double)best_fmt / CALLS, (double)best_snp / CALLS, (double)best_snp / best_fmt);
+    CHECK(best_fmt < best_snp);
+}
+
+int main(void)
+{
+    test_examples();
+    test_random();
+    test_speed();
+    return TEST_RESULT();
+}
@@ -0,0 +1,248 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "test.h"
+#include "dsp_filter.h"
+#include "gas_alarm.h"
+#include "gas_trend.h"
+
+// gas_trend: kayan toplamlarla bulunan eğim / ivme pencere tanımına tam eşit olmalı. main.c'deki ayar ve medyan + biquad
+// zinciriyle (15.625 Hz, σ gürültü + ‰2 olasılıkla ±400 sıçrama) gürültü ve yavaş kayma alarm vermemeli, kaçak 2300
+// eşiğinden önce alarm vermeli; sabit hızlı rampanın başlangıcı alarm değil ön alarm olmalı, hızlanan yükselişte ivme
+// kriteri eğim sınırından önce alarm vermeli. Isınmada (hold_rates) eğim / ivme susmalı, seviye kriteri çalışmalı.
+
+#define TEST_RATE_MHZ   15625
+#define TEST_FS         (TEST_RATE_MHZ / 1000.0)
+#define TEST_BASE       900.0       // Temiz havada filtrelenmiş değer
+#define TEST_WARMUP_S   120         // MQ2_CALIB_MIN_WARMUP_S: main bu sürede gas_trend_hold_rates() çağırır
+#define TEST_ONSET_S    60          // Isınmadan sonra senaryo başlayana kadar temiz hava
+
+static gas_trend_config_t test_cfg = {           // main.c ile aynı
+    .rate_mhz = TEST_RATE_MHZ,
+    .slope_window = GAS_TREND_SLOPE_WINDOW,
+    .accel_window = GAS_TREND_ACCEL_WINDOW,
+    .level_pre = GAS_TREND_LEVEL_PRE,
+    .level_alarm = GAS_ALARM_HIGH,
+    .level_hyst = GAS_ALARM_HIGH - GAS_ALARM_LOW,
+    .slope_pre = GAS_TREND_SLOPE_PRE,
+    .slope_alarm = GAS_TREND_SLOPE_ALARM,
+    .slope_hyst = GAS_TREND_SLOPE_HYST,
+    .accel_alarm = GAS_TREND_ACCEL_ALARM,
+    .raise_ms = GAS_TREND_RAISE_MS,
+    .clear_ms = GAS_TREND_CLEAR_MS,
+};
+
+typedef double (*test_signal_f)(double t);
+
+typedef struct {
+    double pre;                 // İlk ön alarm (sn, senaryonun başladığı andan; -1: hiç)
+    double alarm;               // İlk alarm
+    double level;               // Filtrelenmiş değerin ilk kez 2300'e ulaştığı an (eski sabit eşik)
+    uint32_t alarms;            // Alarm kademesine giriş sayısı
+} test_result_t;
+
+static double test_amp, test_tau, test_rate;
+
+static double test_gauss(void)
+{
+    double u = (rand() + 1.0) / (RAND_MAX + 2.0), v = (rand() + 1.0) / (RAND_MAX + 2.0);
+
+    return sqrt(-2 * log(u)) * cos(2 * M_PI * v);
+}
+
+static double test_clean(double t)  { (void)t; return TEST_BASE; }
+static double test_drift(double t)  { return TEST_BASE + test_rate * t / 60; }                       // ADC / dakika
+static double test_leak(double t)   { return TEST_BASE + test_amp * (1 - exp(-t / test_tau)); }      // Üstel açılan kaçak
+static double test_ramp(double t)   { return TEST_BASE + test_rate * t / 60; }
+static double test_speedup(double t) { return TEST_BASE + test_rate * t * t / 7200; }                // İvme test_rate ADC / dakika²
+
+// Isınma (hold_rates) + temiz hava + senaryo: sinyal ölçüm zincirinden geçip gas_trend'e verilir
+static test_result_t test_run(test_signal_f f, double secs, double sigma)
+{
+    static const int16_t lp[6] = { 512, 0, 1023, 512, 23618, -9281 };     // main.c'deki 1 Hz Butterworth (Q14)
+    int16_t lp_state[4];
+    dsp_median_t median;
+    dsp_biquad_t smooth;
+    gas_trend_t g;
+    test_result_t r = { -1, -1, -1, 0 };
+    gas_trend_level_t last = GAS_TREND_NORMAL;
+    long warm = (long)((TEST_WARMUP_S + TEST_ONSET_S) * TEST_FS), hold = (long)(TEST_ONSET_S * TEST_FS);
+    long n = (long)(secs * TEST_FS);
+
+    dsp_median_init(&median, 5, 0);
+    dsp_biquad_init(&smooth, lp, 1, lp_state, 1);
+    CHECK_EQ(gas_trend_init(&g, &test_cfg, 0), 0);
+
+    for (long i = -warm; i < n; i++) {
+        double t = i / TEST_FS;
+        double x = f(t < 0 ? 0 : t) + sigma * test_gauss();
+        if (rand() < 0.002 * RAND_MAX) x += rand() % 2 ? 400 : -400;         // Röle / motor kaynaklı tek örnek
+        if (x < 0) x = 0;
+        if (x > 4095) x = 4095;
+
+        int16_t v = (int16_t)(x * 8);                                       // main: 15-bit CIC çıktısı
+        dsp_median_process(&median, &v, &v, 1);
+        dsp_biquad_process(&smooth, &v, &v, 1);
+        if (v < 0) v = 0;
+        uint16_t value = (uint16_t)v >> 3;
+
+        if (i < -hold) gas_trend_hold_rates(&g);
+        gas_trend_level_t level = gas_trend_update(&g, value);
+        if (i < 0) continue;
+
+        if (r.level < 0 && value >= GAS_ALARM_HIGH) r.level = t;
+        if (level != last) {
+            if (level == GAS_TREND_ALARM) {
+                r.alarms++;
+                if (r.alarm < 0) r.alarm = t;
+            }
+            if (level >= GAS_TREND_PREALARM && r.pre < 0) r.pre = t;
+            last = level;
+        }
+    }
+    return r;
+}
+
+static void test_windows(void)
+{
+    static uint16_t x[3000];
+    static int32_t slopes[3000];
+    uint32_t bad = 0;
+
+    for (uint8_t w = 1; w <= GAS_TREND_WINDOW_MAX; w += 7) {
+        for (uint8_t a = 1; a <= GAS_TREND_ACCEL_MAX; a += 9) {
+            gas_trend_config_t c = test_cfg;
+            gas_trend_t g;
+
+            c.slope_window = w;
+            c.accel_window = a;
+            CHECK_EQ(gas_trend_init(&g, &c, 500), 0);
+            for (long n = 0; n < 3000; n++) {
+                x[n] = (uint16_t)(rand() % 4096);
+                gas_trend_update(&g, x[n]);
+
+                long sum_new = 0, sum_old = 0;                              // Pencereler doğrudan toplanır
+                for (long k = 0; k < w; k++) {
+                    sum_new += n - k >= 0 ? x[n - k] : 500;
+                    sum_old += n - w - k >= 0 ? x[n - w - k] : 500;
+                }
+                slopes[n] = (int32_t)((long long)(sum_new - sum_old) * 60 * TEST_RATE_MHZ / (1000LL * w * w));
+                int32_t prev = n - a >= 0 ? slopes[n - a] : 0;
+                int32_t accel = (int32_t)((long long)(slopes[n] - prev) * 60 * TEST_RATE_MHZ / (1000LL * a));
+                if (g.slope != slopes[n] || g.accel != accel) bad++;
+            }
+        }
+    }
+    CHECK_EQ(bad, 0);
+
+    gas_trend_config_t c = test_cfg;
+    gas_trend_t g;
+    c.slope_window = 0;
+    CHECK_EQ(gas_trend_init(&g, &c, 0), 1);
+    c.slope_window = GAS_TREND_WINDOW_MAX + 1;
+    CHECK_EQ(gas_trend_init(&g, &c, 0), 1);
+    c = test_cfg;
+    c.accel_window = GAS_TREND_ACCEL_MAX + 1;
+    CHECK_EQ(gas_trend_init(&g, &c, 0), 1);
+    c = test_cfg;
+    c.slope_pre = c.slope_alarm + 1;
+    CHECK_EQ(gas_trend_init(&g, &c, 0), 1);
+}
+
+static void test_hold(void)
+{
+    gas_trend_t g;
+    uint32_t rate_levels = 0, level_alarm = 0;
+
+    CHECK_EQ(gas_trend_init(&g, &test_cfg, 0), 0);
+    for (uint32_t i = 0; i < 20 * TEST_RATE_MHZ / 1000; i++) {             // Isınma: 0'dan 1500'e 20 sn'de (4500 ADC/dk)
+        gas_trend_hold_rates(&g);
+        if (gas_trend_update(&g, (uint16_t)(i * 1500 / (20 * TEST_FS))) != GAS_TREND_NORMAL) rate_levels++;
+    }
+    for (uint32_t i = 0; i < 2 * TEST_RATE_MHZ / 1000; i++) {              // Isınırken 2500: seviye kriteri çalışır
+        gas_trend_hold_rates(&g);
+        if (gas_trend_update(&g, 2500) == GAS_TREND_ALARM && !level_alarm) level_alarm = i + 1;
+    }
+    printf("  ısınma: hızlı yükselişte kademe değişimi %u örnek, ısınırken 2500 → alarm %u örnekte\n", rate_levels, level_alarm);
+    CHECK_EQ(rate_levels, 0);
+    CHECK(level_alarm > 0 && level_alarm <= 8);                             // raise_ms = 500 ms → 8 örnek
+
+    CHECK_EQ(gas_trend_init(&g, &test_cfg, 0), 0);                         // Karşılaştırma: aynı yükseliş bekletilmeden
+    uint8_t rose = 0;
+    for (uint32_t i = 0; i < 20 * TEST_RATE_MHZ / 1000; i++) {
+        if (gas_trend_update(&g, (uint16_t)(i * 1500 / (20 * TEST_FS))) == GAS_TREND_ALARM) rose = 1;
+    }
+    CHECK(rose);
+}
+
+static void test_scenarios(void)
+{
+    test_result_t r;
+
+    printf("  %-26s %9s %9s %9s %6s\n", "senaryo", "ön (sn)", "alarm", "2300", "alarm#");
+
+    static const double sigmas[] = { 2, 5, 10 };
+    for (uint8_t k = 0; k < 3; k++) {
+        r = test_run(test_clean, 3600, sigmas[k]);
+        printf("  gürültü σ=%-2.0f 1 saat        %9.1f %9.1f %9.1f %6u\n", sigmas[k], r.pre, r.alarm, r.level, r.alarms);
+        CHECK(r.pre < 0 && r.alarms == 0);
+    }
+
+    static const double drifts[] = { 2, 5, 10, 20 };
+    for (uint8_t k = 0; k < 4; k++) {
+        test_rate = drifts[k];
+        r = test_run(test_drift, 3 * 3600, 5);
+        printf("  kayma %2.0f ADC/dk 3 saat     %9.1f %9.1f %9.1f %6u\n", drifts[k], r.pre, r.alarm, r.level, r.alarms);
+        if (r.level < 0) CHECK_EQ(r.alarms, 0);                            // Yavaş kayma eğim sınırlarına ulaşmaz
+        else CHECK(r.alarm >= r.level - 5 && r.alarm < r.level + 60);       // Sadece seviye ile, 2300 çevresinde
+        if (r.pre >= 0) CHECK(r.pre > (GAS_TREND_LEVEL_PRE - TEST_BASE) * 60 / drifts[k] - 30);   // Ön alarm da sadece seviyeden
+    }
+
+    static const double taus[] = { 3, 10, 30, 60, 120 };
+    for (uint8_t k = 0; k < 5; k++) {
+        test_amp = 2000;
+        test_tau = taus[k];
+        r = test_run(test_leak, 600, 5);
+        printf("  kaçak +2000 τ=%3.0f sn        %9.1f %9.1f %9.1f %6u\n", taus[k], r.pre, r.alarm, r.level, r.alarms);
+        CHECK(r.pre >= 0 && r.pre < 5);
+        if (test_amp * 60 / test_tau >= GAS_TREND_SLOPE_ALARM) CHECK(r.alarm >= 0 && r.alarm < 5);  // Eğim ile, 2300'den önce
+        else CHECK(r.alarm >= r.level - 5 && r.alarm < r.level + 5);       // Yavaşlayan yükseliş: ön alarm, sonra seviye
+        CHECK(r.alarms >= 1 && r.alarms <= 2);          // Eğim düşünce ön alarma inip seviyede yeniden alarm olabilir
+    }
+
+    static const double ramps[] = { 600, 1200, 3000 };
+    for (uint8_t k = 0; k < 3; k++) {
+        test_rate = ramps[k];
+        r = test_run(test_ramp, 600, 5);
+        printf("  rampa %4.0f ADC/dk          %9.1f %9.1f %9.1f %6u\n", ramps[k], r.pre, r.alarm, r.level, r.alarms);
+        CHECK(r.pre >= 0 && r.pre < 10);
+        if (ramps[k] < GAS_TREND_SLOPE_ALARM) CHECK(r.alarm >= r.level - 5);   // Başlangıç ivmesi alarm vermez
+        else CHECK(r.alarm >= 0 && r.alarm < 10);
+    }
+
+    static const double speedups[] = { 7000, 10000 };
+    for (uint8_t k = 0; k < 2; k++) {
+        test_rate = speedups[k];
+        srand(11);
+        r = test_run(test_speedup, 600, 5);
+        test_cfg.accel_alarm = 0;                       // Aynı sinyal ivme kriteri olmadan
+        srand(11);
+        test_result_t slope_only = test_run(test_speedup, 600, 5);
+        test_cfg.accel_alarm = GAS_TREND_ACCEL_ALARM;
+        printf("  hızlanan %5.0f ADC/dk²      %9.1f %9.1f %9.1f %6u  (ivmesiz alarm %.1f)\n",
+               speedups[k], r.pre, r.alarm, r.level, r.alarms, slope_only.alarm);
+        CHECK(r.alarm >= 0 && r.alarm < r.level);
+        CHECK(r.alarm < slope_only.alarm);              // İvme kriteri eğim sınırından önce
+    }
+}
+
+int main(void)
+{
+    srand(7);
+    test_windows();
+    test_hold();
+    test_scenarios();
+
+    return TEST_RESULT();
+}
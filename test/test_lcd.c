@@ -0,0 +1,173 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "test.h"
+#include "emu.h"
+#include "hd44780.h"
+#include "lcd_config.h"
+#include "lcd_async.h"
+#include "lcd_transport.h"
+#include "lcd_timing.h"
+#include "hrtimer.h"
+
+#if LCD_TRANSPORT == LCD_TRANSPORT_GPIO4
+#define TEST_WIRING     EMU_LCD_GPIO4
+#define TEST_NAME       "GPIO 4-bit"
+#elif LCD_TRANSPORT == LCD_TRANSPORT_GPIO8
+#define TEST_WIRING     EMU_LCD_GPIO8
+#define TEST_NAME       "GPIO 8-bit"
+#else
+#define TEST_WIRING     EMU_LCD_PCF8574
+#define TEST_NAME       "PCF8574 I2C"
+#endif
+
+#if LCD_TIMING_PROFILE == LCD_TIMING_PROFILE_CONSERVATIVE
+#define TEST_PROFILE    "temkinli"
+#else
+#define TEST_PROFILE    "datasheet"
+#endif
+
+static hd44780_t lcd;
+
+static void test_setup(void)
+{
+    emu_init();
+    emu_irq_attach(TIM2_IRQn, TIM2_IRQHandler);
+#if LCD_TRANSPORT == LCD_TRANSPORT_PCF8574
+    emu_irq_attach(I2C1_EV_IRQn, I2C1_EV_IRQHandler);
+    emu_irq_attach(I2C1_ER_IRQn, I2C1_ER_IRQHandler);
+#endif
+    emu_lcd_attach(&lcd, TEST_WIRING);
+    hrtimer_init();
+    lcd_async_init();
+}
+
+static void test_row_is(uint8_t row, const char* want)
+{
+    char got[LCD_COLS + 1];
+
+    hd44780_row(&lcd, row, got, LCD_COLS);
+    if (strcmp(got, want) != 0) {
+        test_failures++;
+        printf("satır %u: \"%s\" bekleniyordu, \"%s\" okundu\n", row, want, got);
+    }
+}
+
+static void test_violations(const char* step)
+{
+    if (hd44780_violation_total(&lcd)) {
+        test_failures++;
+        printf("%s: %u zamanlama ihlali, ilki %s @ %.3f ms\n", step, hd44780_violation_total(&lcd),
+               hd44780_violation_name(lcd.first_violation), lcd.first_violation_ns / 1e6);
+    }
+}
+
+static double test_ms_since(uint64_t t0)
+{
+    return (emu_ns() - t0) / 1e6;
+}
+
+static void test_async_drain(void)
+{
+    while (lcd_async_busy()) emu_run_us(10);    // CPU boşta; kuyruk TIM2 / I2C kesmelerinde boşalır
+}
+
+int main(void)
+{
+    uint64_t t0;
+
+    printf("LCD_TRANSPORT = %s, LCD_TIMING_PROFILE = %s\n", TEST_NAME, TEST_PROFILE);
+    test_setup();
+
+    // Başlatma: güç açılışı ve init-by-instruction süreleri
+    t0 = emu_ns();
+    lcd_init();
+    printf("  lcd_init            %8.3f ms\n", test_ms_since(t0));
+    test_violations("lcd_init");
+    CHECK_EQ(lcd.dl8, LCD_BUS_BITS == 8);
+    CHECK_EQ(lcd.lines2, 1);
+    CHECK_EQ(lcd.display_on, 1);
+    test_row_is(0, "                ");
+
+    // Bloklayan yazım
+    t0 = emu_ns();
+    lcd_set_cursor(0, 0);
+    lcd_print_string("MQ2 Gaz Sensoru");
+    double ms = test_ms_since(t0);
+    printf("  imleç + 15 karakter %8.3f ms\n", ms);
+    CHECK(ms * 1000 >= LCD_TIMING(EXEC_ADDR_US) + 15 * LCD_TIMING(EXEC_DATA_US));    // Seçilen profilin süreleri beklenir
+    t0 = emu_ns();
+    lcd_clear();
+    ms = test_ms_since(t0);
+    printf("  lcd_clear           %8.3f ms\n", ms);
+    CHECK(ms * 1000 >= LCD_TIMING(EXEC_CLEAR_US));
+    test_row_is(0, "                ");
+
+    // Çerçeve: ilk flush bütün değişen hücreleri, ikincisi hiçbir şeyi göndermez
+    lcd_fb_clear();
+    lcd_fb_write(0, 0, "ADC: 1234");
+    lcd_fb_write(1, 4, "PPM 56");
+    t0 = emu_ns();
+    uint8_t sent = lcd_flush();
+    printf("  lcd_flush (%2u bayt) %8.3f ms\n", sent, test_ms_since(t0));
+    test_row_is(0, "ADC: 1234       ");
+    test_row_is(1, "    PPM 56      ");
+    CHECK_EQ(lcd_flush(), 0);
+
+    lcd_fb_write(0, 5, "1240");                 // Son iki hane değişti: imleç + 2 karakter
+    CHECK_EQ(lcd_flush(), 3);
+    test_row_is(0, "ADC: 1240       ");
+    test_violations("lcd_flush");
+
+    // Kesme ile gönderim: ana döngü beklemez
+    lcd_fb_write(0, 0, "ASYNC ROW 0 ....");
+    lcd_fb_write(1, 0, "async row 1 ....");
+    t0 = emu_ns();
+    sent = lcd_flush_async();
+    printf("  lcd_flush_async     %8.3f ms dönüş (%u bayt kuyrukta)\n", test_ms_since(t0), sent);
+    test_async_drain();
+    printf("                      %8.3f ms panelde\n", test_ms_since(t0));
+    test_row_is(0, "ASYNC ROW 0 ....");
+    test_row_is(1, "async row 1 ....");
+    test_violations("lcd_flush_async");
+
+    // Glyph: çubuk grafiğin kısmi hücresi CGRAM'e yüklenir
+    lcd_fb_clear();
+    lcd_bar_graph(1, 0, 16, 37, 80);            // 37 / 80 × 80 piksel = 37 → 7 tam hücre + 2 sütun
+    lcd_flush();
+    CHECK_EQ(lcd.ddram[0x40 + 7], 0x08 + 1);    // Slot 1: soldan 2 sütun dolu
+    CHECK_EQ(hd44780_glyph_row(&lcd, 1, 0), 0x18);
+    test_violations("glyph");
+
+    // Tam ekran hızı: her karede 2 × (imleç + 16 karakter) değişir
+    uint32_t irq0 = emu_irq_stats(TIM2_IRQn)->count + emu_irq_stats(I2C1_EV_IRQn)->count;
+    uint32_t bytes = 0;
+    t0 = emu_ns();
+    for (int frame = 0; frame < 50; frame++) {
+        char line[LCD_COLS + 1];
+        for (int r = 0; r < LCD_ROWS; r++) {
+            for (int c = 0; c < LCD_COLS; c++) line[c] = (char)('A' + (c + frame + r) % 26);
+            line[LCD_COLS] = '\0';
+            lcd_fb_write(r, 0, line);
+        }
+        bytes += lcd_flush_async();
+        test_async_drain();
+    }
+    double s = (emu_ns() - t0) / 1e9;
+    uint32_t irqs = emu_irq_stats(TIM2_IRQn)->count + emu_irq_stats(I2C1_EV_IRQn)->count - irq0;
+    printf("  tam ekran           %8.0f bayt/sn, bayt başına %.2f kesme\n", bytes / s, (double)irqs / bytes);
+    test_violations("tam ekran");
+
+    // Modelin kendisi: datasheet'ten kısa bir E darbesi ihlal olarak görülmeli
+#if LCD_TRANSPORT != LCD_TRANSPORT_PCF8574
+    emu_run_us(100);
+    lcd_bus_set(1, 'x');
+    emu_run_us(1);
+    lcd_bus_enable(1);
+    lcd_bus_enable(0);                          // ~2 cycle'lık darbe
+    emu_run_us(1);                              // Yazımın etkisi bir sonraki erişimde görülür
+    CHECK(lcd.violations[HD44780_V_PULSE] > 0);
+#endif
+
+    return TEST_RESULT();
+}
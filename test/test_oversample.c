@@ -0,0 +1,130 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "test.h"
+#include "oversample.h"
+
+// oversample_process(): DC kazancı, blok sınırından bağımsızlık, sıkıştırılmış gürültü ve uç değerler
+
+#define TEST_N      (256 * 64)
+
+static uint16_t input[TEST_N];
+static uint16_t out_whole[TEST_N];
+static uint16_t out_split[TEST_N];
+
+static uint32_t lcg = 12345;
+static double test_uniform(void)                    // [0, 1), tekrarlanabilir
+{
+    lcg = lcg * 1664525u + 1013904223u;
+    return (lcg >> 8) / 16777216.0;
+}
+
+static double test_gauss(void)
+{
+    double u = test_uniform() + 1e-12, v = test_uniform();
+    return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+static void test_dc(uint16_t ratio, oversample_mode_t mode, uint16_t x)
+{
+    oversample_t os;
+    uint16_t out[8];
+
+    for (int i = 0; i < TEST_N; i++) input[i] = x;
+    oversample_init(&os, ratio, mode);
+    uint16_t n = oversample_process(&os, input, ratio * 8, out, 8);
+    CHECK_EQ(n, 8);
+    uint8_t k = oversample_output_bits(&os) - OVERSAMPLE_INPUT_BITS;
+    for (int i = (mode == OVERSAMPLE_CIC2) ? 2 : 0; i < 8; i++) {    // CIC2: ilk iki çıktı geçiş süreci
+        CHECK_EQ(out[i], (uint32_t)x << k);
+    }
+}
+
+static void test_split(uint16_t ratio, oversample_mode_t mode)
+{
+    oversample_t a, b;
+
+    for (int i = 0; i < TEST_N; i++) input[i] = (uint16_t)(test_uniform() * 4096);
+    oversample_init(&a, ratio, mode);
+    oversample_init(&b, ratio, mode);
+
+    uint16_t whole = oversample_process(&a, input, TEST_N, out_whole, TEST_N);
+    uint16_t split = 0;
+    for (int pos = 0; pos < TEST_N; ) {
+        int len = 1 + rand() % 300;                 // R'nin katı olmayan bloklar
+        if (pos + len > TEST_N) len = TEST_N - pos;
+        split += oversample_process(&b, &input[pos], len, &out_split[split], TEST_N - split);
+        pos += len;
+    }
+    CHECK_EQ(whole, TEST_N / ratio);
+    CHECK_EQ(split, whole);
+    int diff = 0;
+    for (int i = 0; i < whole; i++) diff += out_whole[i] != out_split[i];
+    CHECK_EQ(diff, 0);
+}
+
+static double test_noise(uint16_t ratio, oversample_mode_t mode, double dc, double sigma)
+{
+    oversample_t os;
+    double sum = 0, sum2 = 0;
+
+    for (int i = 0; i < TEST_N; i++) {
+        double v = dc + sigma * test_gauss();
+        input[i] = (uint16_t)(v < 0 ? 0 : v > 4095 ? 4095 : lround(v));
+    }
+    oversample_init(&os, ratio, mode);
+    uint16_t n = oversample_process(&os, input, TEST_N, out_whole, TEST_N);
+    uint8_t k = oversample_output_bits(&os) - OVERSAMPLE_INPUT_BITS;
+    int skip = (mode == OVERSAMPLE_CIC2) ? 2 : 0;
+    for (int i = skip; i < n; i++) {
+        double y = out_whole[i] / (double)(1 << k);     // Giriş LSB'si cinsinden
+        sum += y;
+        sum2 += y * y;
+    }
+    double mean = sum / (n - skip);
+    uint8_t shift = (mode == OVERSAMPLE_CIC2) ? 3 * k : k;
+    double bias = 1.0 / (2 << shift) / (1 << k);   // Yuvarlamanın sapması (giriş LSB'si cinsinden)
+    CHECK(fabs(mean - dc) < bias + 0.1);            // Ek bitler DC'yi alt-LSB doğrulukla verir
+    return sqrt(sum2 / (n - skip) - mean * mean);
+}
+
+int main(void)
+{
+    oversample_t os;
+    static const uint16_t ratios[] = { 4, 16, 64, 256 };
+
+    CHECK_EQ(oversample_init(&os, 0, OVERSAMPLE_ACCUMULATE), 1);
+    CHECK_EQ(oversample_init(&os, 8, OVERSAMPLE_ACCUMULATE), 1);
+    CHECK_EQ(oversample_init(&os, 1024, OVERSAMPLE_CIC2), 1);
+
+    for (int r = 0; r < 4; r++) {
+        for (int m = 0; m < 2; m++) {
+            CHECK_EQ(oversample_init(&os, ratios[r], (oversample_mode_t)m), 0);
+            CHECK_EQ(oversample_output_bits(&os), 13 + r);
+            test_dc(ratios[r], (oversample_mode_t)m, 0);
+            test_dc(ratios[r], (oversample_mode_t)m, 1234);
+            test_dc(ratios[r], (oversample_mode_t)m, 4095);     // 256 × CIC2: 4095 << 4 = 65520, taşma yok
+            test_split(ratios[r], (oversample_mode_t)m);
+        }
+    }
+
+    // Beyaz gürültü: ACCUMULATE'te σ her 4 katta yarıya iner; CIC2 en az o kadar bastırır
+    for (int r = 0; r < 4; r++) {
+        double s_acc = test_noise(ratios[r], OVERSAMPLE_ACCUMULATE, 1000.3, 4.0);
+        double s_cic = test_noise(ratios[r], OVERSAMPLE_CIC2, 1000.3, 4.0);
+        double expect = 4.0 / sqrt(ratios[r]);
+        printf("  R = %3u: σ 4.00 → toplama %.3f, CIC2 %.3f LSB\n", ratios[r], s_acc, s_cic);
+        CHECK(s_acc > expect * 0.85 && s_acc < expect * 1.15);
+        CHECK(s_cic < expect * 1.15);
+    }
+
+    // out_max: fazla çıktılar atılır, durum yine ilerler
+    oversample_init(&os, 4, OVERSAMPLE_ACCUMULATE);
+    for (int i = 0; i < 64; i++) input[i] = 100;
+    CHECK_EQ(oversample_process(&os, input, 64, out_whole, 3), 3);
+    CHECK_EQ(oversample_process(&os, input, 4, out_whole, 3), 1);
+    CHECK_EQ(out_whole[0], 200);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,163 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "test.h"
+#include "emu.h"
+#include "hd44780.h"
+#include "lcd_config.h"
+#include "lcd_async.h"
+#include "lcd_transport.h"
+#include "hrtimer.h"
+
+// PCF8574 hata durumları: kart takılı değilken (NACK) ve SDA LOW'da kalmışken (START oluşmaz) senkron yazım da kuyruk da
+// sınırlı sürede dönmeli, hata sayılmalı; hat düzelince kurtarma sonrası yazımlar panele doğru ulaşmalı.
+// Hata sırasında kaybolan kare (aynı içerikle) yeniden çizilince panele ulaşmalı. I2C1 kesmeleri ADC, DMA ve TIM2'den
+// düşük öncelikli olmalı.
+
+static hd44780_t lcd;
+
+static void test_row_is(uint8_t row, const char* want)
+{
+    char got[LCD_COLS + 1];
+
+    hd44780_row(&lcd, row, got, LCD_COLS);
+    if (strcmp(got, want) != 0) {
+        test_failures++;
+        printf("satır %u: \"%s\" bekleniyordu, \"%s\" okundu\n", row, want, got);
+    }
+}
+
+static double test_sync_us(const char* str)
+{
+    uint64_t t0 = emu_ns();
+
+    lcd_set_cursor(0, 0);
+    lcd_print_string(str);
+    return (emu_ns() - t0) / 1e3;
+}
+
+static double test_async_us(char c)
+{
+    char line[LCD_COLS + 1];
+    uint64_t t0 = emu_ns();
+
+    memset(line, c, LCD_COLS);
+    line[LCD_COLS] = '\0';
+    lcd_fb_write(0, 0, line);
+    lcd_fb_write(1, 0, line);
+    lcd_flush_async();
+    for (uint32_t i = 0; i < 1000 && lcd_async_busy(); i++) emu_run_us(100);
+    CHECK(!lcd_async_busy());                   // Kuyruk takılmadı
+    return (emu_ns() - t0) / 1e3;
+}
+
+static void test_sync(void)
+{
+    uint32_t errors = lcd_transport_errors();
+    double ok_us = test_sync_us("abcd");
+
+    emu_pcf_set_present(0);
+    double nack_us = test_sync_us("efgh");
+    uint32_t nack_errors = lcd_transport_errors() - errors;
+    emu_pcf_set_present(1);
+
+    errors = lcd_transport_errors();
+    emu_i2c_set_stuck(1);
+    double stuck_us = test_sync_us("ijkl");
+    uint32_t stuck_errors = lcd_transport_errors() - errors;
+    emu_i2c_set_stuck(0);
+
+    errors = lcd_transport_errors();
+    test_sync_us("mnop");
+    printf("  senkron 4 bayt: normal %.0f µs, kart yok %.0f µs (%u hata), hat takılı %.0f µs (%u hata)\n",
+           ok_us, nack_us, nack_errors, stuck_us, stuck_errors);
+    CHECK_EQ(nack_errors, 5);                   // İmleç + 4 karakter, her biri bir NACK
+    CHECK_EQ(stuck_errors, 5);                  // Her yazım zaman aşımı + kurtarma
+    CHECK(nack_us < ok_us);
+    CHECK(stuck_us < 5 * (LCD_PCF_TIMEOUT_US + 200));
+    CHECK_EQ(lcd_transport_errors(), errors);   // Hat düzelince hatasız
+    test_row_is(0, "mnop            ");         // "efgh" ve "ijkl" gitmedi, "mnop" "abcd"nin üstüne yazıldı
+}
+
+static void test_async(void)
+{
+    uint32_t errors = lcd_transport_errors();
+    double ok_us = test_async_us('a');
+
+    emu_pcf_set_present(0);
+    double nack_us = test_async_us('b');
+    emu_pcf_set_present(1);
+    uint32_t nack_errors = lcd_transport_errors() - errors;
+
+    errors = lcd_transport_errors();
+    emu_i2c_set_stuck(1);
+    double stuck_us = test_async_us('c');
+    emu_i2c_set_stuck(0);
+    uint32_t stuck_errors = lcd_transport_errors() - errors;
+
+    errors = lcd_transport_errors();
+    test_async_us('d');
+    printf("  kuyruk 2 satır: normal %.0f µs, kart yok %.0f µs (%u hata), hat takılı %.0f µs (%u hata)\n",
+           ok_us, nack_us, nack_errors, stuck_us, stuck_errors);
+    CHECK_EQ(nack_errors, 2);                   // Satır başına bir parti
+    CHECK_EQ(stuck_errors, 2);
+    CHECK(stuck_us < 4 * ok_us);                // Zaman aşımı partinin süresinin iki katı
+    CHECK_EQ(lcd_transport_errors(), errors);
+    test_row_is(0, "dddddddddddddddd");
+    test_row_is(1, "dddddddddddddddd");
+    CHECK_EQ(hd44780_violation_total(&lcd), 0);
+}
+
+static void test_redraw(void)
+{
+    uint32_t errors;
+
+    test_async_us('e');
+    emu_pcf_set_present(0);
+    errors = lcd_transport_errors();
+    test_async_us('f');                         // Kart yokken çizilen kare atılır
+    CHECK(lcd_transport_errors() > errors);
+    emu_pcf_set_present(1);
+
+    errors = lcd_transport_errors();
+    test_async_us('f');                         // Aynı kare yeniden: gölge "yazıldı" sanmamalı
+    test_row_is(0, "ffffffffffffffff");
+    test_row_is(1, "ffffffffffffffff");
+
+    lcd_fb_write(0, 0, "gggg");                 // Senkron yazım kaybolursa çerçevedeki aynı metin yeniden gitmeli
+    emu_pcf_set_present(0);
+    lcd_set_cursor(0, 0);
+    lcd_print_string("gggg");
+    emu_pcf_set_present(1);
+    CHECK(lcd_transport_errors() > errors);
+    errors = lcd_transport_errors();
+    lcd_flush_async();
+    for (uint32_t i = 0; i < 1000 && lcd_async_busy(); i++) emu_run_us(100);
+    test_row_is(0, "ggggffffffffffff");
+    test_row_is(1, "ffffffffffffffff");
+    CHECK_EQ(lcd_transport_errors(), errors);
+    CHECK_EQ(hd44780_violation_total(&lcd), 0);
+}
+
+int main(void)
+{
+    emu_init();
+    emu_irq_attach(TIM2_IRQn, TIM2_IRQHandler);
+    emu_irq_attach(I2C1_EV_IRQn, I2C1_EV_IRQHandler);
+    emu_irq_attach(I2C1_ER_IRQn, I2C1_ER_IRQHandler);
+    emu_lcd_attach(&lcd, EMU_LCD_PCF8574);
+    hrtimer_init();
+    lcd_async_init();
+    lcd_init();
+    CHECK_EQ(lcd_transport_errors(), 0);
+
+    CHECK(NVIC_GetPriority(I2C1_EV_IRQn) > NVIC_GetPriority(TIM2_IRQn));
+    CHECK(NVIC_GetPriority(I2C1_ER_IRQn) > NVIC_GetPriority(TIM2_IRQn));
+    CHECK(NVIC_GetPriority(I2C1_EV_IRQn) > NVIC_GetPriority(DMA2_Stream0_IRQn));
+
+    test_sync();
+    test_async();
+    test_redraw();
+
+    return TEST_RESULT();
+}
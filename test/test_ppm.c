@@ -0,0 +1,77 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <math.h>
+#include "test.h"
+#include "mq2_ppm.h"
+#include "fmt.h"
+
+// mq2_ppm(): sabit nokta sonucu aynı datasheet noktalarından double ile hesaplanan eğriye yakın olmalı,
+// bütün ADC / R0 değerlerinde MQ2_PPM_MAX'i aşmamalı ve ekrandaki 6 hanelik alana sığmalı
+
+static const double lpg[6][2] = { { 200, 1.60 }, { 500, 1.15 }, { 1000, 0.85 }, { 2000, 0.62 }, { 5000, 0.41 }, { 10000, 0.28 } };
+
+static double test_reference(uint16_t adc, double r0_rl)
+{
+    double ratio = (4095.0 - adc) / adc / r0_rl;        // Rs / R0
+    double r = log2(ratio);
+    int i = 0;
+
+    while (i < 4 && r < log2(lpg[i + 1][1])) i++;
+    double slope = (log2(lpg[i + 1][0]) - log2(lpg[i][0])) / (log2(lpg[i + 1][1]) - log2(lpg[i][1]));
+    return exp2(log2(lpg[i][0]) + slope * (r - log2(lpg[i][1])));
+}
+
+int main(void)
+{
+    // log2 / exp2: tablo + doğrusal ara değer hatası < 2e-4 (log2 biriminde)
+    double worst_log = 0, worst_exp = 0;
+    for (uint64_t x = 1; x < 0x100000000ull; x = x * 5 / 4 + 1) {
+        double e = fabs(mq2_log2_q16((uint32_t)x) / 65536.0 - log2(x));
+        if (e > worst_log) worst_log = e;
+    }
+    for (int32_t y = -(20 << 16); y < 15 << 16; y += 777) {
+        double want = exp2(y / 65536.0) * 65536.0;
+        double e = fabs(log2(mq2_exp2_q16(y) / want));
+        if (want >= 65536 && e > worst_exp) worst_exp = e;   // 1.0'ın altında Q16 çözünürlüğü baskın
+    }
+    printf("  log2 hata %.2e, exp2 hata %.2e\n", worst_log, worst_exp);
+    CHECK(worst_log < 2e-4);
+    CHECK(worst_exp < 2e-4);
+    CHECK_EQ(mq2_exp2_q16(40 << 16), 0xFFFFFFFFu);     // Doyum
+
+    // Eğri: 200-10000 ppm aralığında %0.1 içinde, dışında MQ2_PPM_MAX ile sınırlı
+    static const double r0s[] = { 0.5, 1.0, 2.7, 10.0 };
+    double worst_ppm = 0;
+    for (int k = 0; k < 4; k++) {
+        mq2_set_r0((uint32_t)MQ2_Q16(r0s[k]));
+        uint32_t prev = 0;
+        for (uint16_t adc = 0; adc <= 4095; adc++) {
+            uint32_t ppm = mq2_ppm(adc, MQ2_GAS_LPG);
+            CHECK(ppm <= MQ2_PPM_MAX);
+            CHECK(ppm >= prev);                         // ADC arttıkça (Rs düştükçe) ppm azalmaz
+            prev = ppm;
+
+            if (adc == 0 || adc == 4095) continue;
+            double want = test_reference(adc, r0s[k]);
+            if (want >= 200 && want <= 10000) {
+                double e = (fabs(ppm - want) - 1) / want;     // Tam sayı ppm: 1 ppm'lik kesme hatası düşülür
+                if (e > worst_ppm) worst_ppm = e;
+            }
+        }
+        CHECK_EQ(mq2_ppm(4095, MQ2_GAS_LPG), MQ2_PPM_MAX);  // Çıkış beslemede: eğrinin çok ötesi
+    }
+    printf("  LPG eğrisi en büyük bağıl hata %.4f\n", worst_ppm);
+    CHECK(worst_ppm < 0.001);
+
+    for (int g = 0; g < MQ2_GAS_COUNT; g++) {
+        CHECK(mq2_ppm(4094, (mq2_gas_t)g) <= MQ2_PPM_MAX);
+    }
+    CHECK_EQ(mq2_ppm(2000, MQ2_GAS_COUNT), 0);
+
+    // Ekran alanı (main.c: 6 hane): en büyük değer de taşmadan yazılır
+    char field[8] = "#######";
+    CHECK_EQ(fmt_u32(field, 6, mq2_ppm(4095, MQ2_GAS_LPG), FMT_ALIGN_LEFT, ' '), 0);
+    CHECK_EQ(field[6], '#');
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,141 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "stm32f4xx.h"
+#include "test.h"
+#include "prof.h"
+
+// prof: PROF_BEGIN / PROF_END ve PROF_TRACE'in sanal CPU saatiyle (fake_cycles) ölçtüğü süreler; nokta başına count / min /
+// max / ortalama ve log2 histogram, CYCCNT'nin 32 bit taşması, PROF_TRACE_SIZE'lık halkanın taşması, prof_reset() ve
+// prof_dump() çıktısı
+
+static void timed(uint32_t cycles)
+{
+    PROF_BEGIN(t_timed);
+    fake_cycles += cycles;
+    PROF_END(t_timed);
+}
+
+static void traced(uint32_t gap)
+{
+    fake_cycles += gap;
+    PROF_TRACE(t_trace);
+}
+
+static prof_site_t* find_site(const char* name)
+{
+    for (prof_site_t* s = prof_sites(); s; s = s->next) {
+        if (strcmp(s->name, name) == 0) return s;
+    }
+    return NULL;
+}
+
+static char dump_buf[1024];
+static uint32_t dump_len;
+
+static void dump_put(char c)
+{
+    if (dump_len < sizeof(dump_buf) - 1) dump_buf[dump_len++] = c;
+}
+
+static void test_stats(void)
+{
+    static const uint32_t runs[] = { 10, 100, 1000, 5, 0, 40000 };
+    uint64_t total = 0;
+
+    for (uint8_t i = 0; i < sizeof(runs) / sizeof(runs[0]); i++) {
+        timed(runs[i]);
+        total += runs[i];
+    }
+
+    prof_site_t* s = find_site("t_timed");
+    CHECK(s != NULL);
+    if (!s) return;
+    CHECK_EQ(s->count, 6);
+    CHECK_EQ(s->min, 0);
+    CHECK_EQ(s->max, 40000);
+    CHECK_EQ(s->total, total);
+    CHECK_EQ(s->total / s->count, 6852);
+
+    CHECK_EQ(s->hist[0], 1);                    // 0
+    CHECK_EQ(s->hist[3], 1);                    // 5: [4, 8)
+    CHECK_EQ(s->hist[4], 1);                    // 10: [8, 16)
+    CHECK_EQ(s->hist[7], 1);                    // 100: [64, 128)
+    CHECK_EQ(s->hist[10], 1);                   // 1000: [512, 1024)
+    CHECK_EQ(s->hist[PROF_HIST_BINS - 1], 1);   // 40000 > 2^15: son kutu üstünü de toplar
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < PROF_HIST_BINS; i++) sum += s->hist[i];
+    CHECK_EQ(sum, s->count);
+
+    fake_cycles = 0xFFFFFFF0u;                  // CYCCNT ölçüm sırasında taşar
+    timed(0x30);
+    const prof_trace_t* t = prof_trace_get(0);
+    CHECK(t != NULL && t->site == s && t->start == 0xFFFFFFF0u && t->end == 0x20);
+    CHECK_EQ(s->max, 40000);
+    CHECK_EQ(s->count, 7);
+
+    dump_len = 0;
+    prof_dump(dump_put);
+    dump_buf[dump_len] = '\0';
+    CHECK(strstr(dump_buf, "name count min max mean") == dump_buf);
+    CHECK(strstr(dump_buf, "t_timed 7 0 40000 5880 | 1 0 0 1 1 0 1 1 0 0 1 0 0 0 0 1\n") != NULL);
+    printf("  %u kayıt: min %u max %u ortalama %u\n", s->count, s->min, s->max, (uint32_t)(s->total / s->count));
+}
+
+static void test_trace(void)
+{
+    traced(0);                                  // İlk geçiş: sadece zaman, nokta henüz listede değil
+    CHECK(find_site("t_trace") == NULL);
+
+    traced(50);
+    prof_site_t* s = find_site("t_trace");
+    CHECK(s != NULL);
+    if (!s) return;
+    CHECK_EQ(s->count, 1);
+    traced(70);
+    traced(60);
+    CHECK_EQ(s->count, 3);
+    CHECK_EQ(s->min, 50);
+    CHECK_EQ(s->max, 70);
+    CHECK_EQ(s->total, 180);
+
+    const prof_trace_t* t = prof_trace_get(0);
+    CHECK(t != NULL && t->site == s && t->end - t->start == 60);
+}
+
+static void test_wrap(void)
+{
+    prof_reset();
+    CHECK_EQ(prof_trace_count(), 0);
+    CHECK(prof_trace_get(0) == NULL);
+
+    prof_site_t* s = find_site("t_timed");
+    CHECK(s != NULL && s->count == 0 && s->max == 0 && s->total == 0);
+
+    uint32_t n = PROF_TRACE_SIZE + 10;          // Halka bir turdan fazla dolar
+    for (uint32_t i = 1; i <= n; i++) timed(i);
+
+    CHECK_EQ(prof_trace_count(), n);            // Taşanlar dahil toplam
+    CHECK_EQ(s->count, n);                      // İstatistik halkadan bağımsız
+    CHECK_EQ(s->min, 1);
+    CHECK_EQ(s->max, n);
+
+    uint32_t bad = 0;
+    for (uint32_t age = 0; age < PROF_TRACE_SIZE; age++) {      // En yeni PROF_TRACE_SIZE kayıt, yeniden eskiye
+        const prof_trace_t* t = prof_trace_get(age);
+        if (t == NULL || t->site != s || t->end - t->start != n - age) bad++;
+    }
+    CHECK_EQ(bad, 0);
+    CHECK(prof_trace_get(PROF_TRACE_SIZE) == NULL);             // Üzerine yazılanlar okunamaz
+    CHECK(prof_trace_get(n - 1) == NULL);
+    printf("  halka: %u kayıt, son %u okunabilir, en eski %u cycle\n", prof_trace_count(), PROF_TRACE_SIZE,
+           prof_trace_get(PROF_TRACE_SIZE - 1)->end - prof_trace_get(PROF_TRACE_SIZE - 1)->start);
+}
+
+int main(void)
+{
+    test_stats();
+    test_trace();
+    test_wrap();
+    return TEST_RESULT();
+}
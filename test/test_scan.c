@@ -0,0 +1,138 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "test.h"
+#include "emu.h"
+#include "mq2.h"
+#include "timebase.h"
+
+// Çok kanallı tarama: sıra / örnekleme süresi register kodlaması, tek DMA akışından kanal başına ayrıştırma,
+// adc1_read_index() ve tetik başına bütün sıranın dönüştürülmesi
+
+#define TEST_CHANNELS   3
+
+static const adc_channel_cfg_t test_table[TEST_CHANNELS] = {
+    { 0, ADC_SMP_480 },                 // PA0: MQ2
+    { 4, ADC_SMP_144 },                 // PA4
+    { 10, ADC_SMP_56 },                 // PC0
+};
+
+static uint16_t produced[19];           // Kanal başına üretilen örnek sayısı
+static uint16_t expect[TEST_CHANNELS];
+static uint32_t samples[TEST_CHANNELS];
+static uint32_t errors[TEST_CHANNELS];
+static uint32_t blocks;
+static uint64_t at_ns[19];              // Kanalın son dönüşümünün bittiği an
+
+static uint16_t test_source(uint8_t channel, uint64_t now_ns)      // Üst 4 bit kanal sırası, alt 8 bit kanalın sayacı
+{
+    at_ns[channel] = now_ns;
+    uint16_t tag = channel == 0 ? 1 : channel == 4 ? 2 : channel == 10 ? 3 : 0xF;
+    return (uint16_t)(tag << 8 | (produced[channel]++ & 0xFF));
+}
+
+static void test_pipe(uint8_t k, const uint16_t* block, uint16_t count)
+{
+    if (count != ADC_STREAM_BLOCK / TEST_CHANNELS) errors[k]++;     // 126 örneklik yarı: kanal başına 42
+    for (uint16_t i = 0; i < count; i++) {
+        if (block[i] != ((k + 1) << 8 | expect[k])) errors[k]++;   // Başka kanal karışmamış, kayıp / tekrar yok
+        expect[k] = (expect[k] + 1) & 0xFF;
+    }
+    samples[k] += count;
+}
+
+static void test_pipe0(const uint16_t* block, uint16_t count) { test_pipe(0, block, count); blocks++; }
+static void test_pipe1(const uint16_t* block, uint16_t count) { test_pipe(1, block, count); }
+static void test_pipe2(const uint16_t* block, uint16_t count) { test_pipe(2, block, count); }
+
+static void test_encode(void)
+{
+    adc_sequence_regs_t regs;
+    adc_channel_cfg_t table[17];
+
+    CHECK_EQ(adc_sequence_encode(test_table, TEST_CHANNELS, &regs), 0);
+    CHECK_EQ(regs.sqr1, 2u << 20);                                          // L = 3 - 1
+    CHECK_EQ(regs.sqr3, 0u | 4u << 5 | 10u << 10);
+    CHECK_EQ(regs.sqr2, 0);
+    CHECK_EQ(regs.smpr2, (uint32_t)ADC_SMP_480 << 0 | (uint32_t)ADC_SMP_144 << 12);
+    CHECK_EQ(regs.smpr1, (uint32_t)ADC_SMP_56 << 0);
+
+    for (int i = 0; i < 16; i++) table[i] = (adc_channel_cfg_t){ (uint8_t)(i + 2), ADC_SMP_3 };    // Kanal 2-17
+    CHECK_EQ(adc_sequence_encode(table, 16, &regs), 0);
+    CHECK_EQ(regs.sqr1 >> 20, 15);
+    CHECK_EQ(regs.sqr2 & 0x1F, 8);                                          // SQ7 = 7. kanal (2 + 6)
+    CHECK_EQ((regs.sqr1 >> 15) & 0x1F, 17);                                 // SQ16
+
+    CHECK_EQ(adc_sequence_encode(table, 0, &regs), 1);
+    CHECK_EQ(adc_sequence_encode(table, 17, &regs), 1);
+    table[0] = (adc_channel_cfg_t){ 19, ADC_SMP_3 };
+    CHECK_EQ(adc_sequence_encode(table, 1, &regs), 1);                      // Kanal 0-18
+    table[0] = (adc_channel_cfg_t){ 5, 8 };
+    CHECK_EQ(adc_sequence_encode(table, 1, &regs), 1);
+    table[0] = (adc_channel_cfg_t){ 5, ADC_SMP_15 };
+    table[1] = (adc_channel_cfg_t){ 5, ADC_SMP_15 };
+    CHECK_EQ(adc_sequence_encode(table, 2, &regs), 0);                      // Aynı kanal iki kez, aynı süre: geçerli
+    table[1] = (adc_channel_cfg_t){ 5, ADC_SMP_28 };
+    CHECK_EQ(adc_sequence_encode(table, 2, &regs), 1);                      // Farklı süre: örnekleme süresi kanala ait
+}
+
+int main(void)
+{
+    test_encode();
+
+    emu_init();
+    emu_irq_attach(DMA2_Stream0_IRQn, DMA2_Stream0_IRQHandler);
+    emu_adc_set_source(test_source);
+    timebase_init();
+    gpio_pa0_analog_init();
+    adc1_init();
+
+    CHECK_EQ(adc1_scan_config(test_table, TEST_CHANNELS), 0);
+    CHECK_EQ((GPIOA->MODER >> 8) & 3, 3);                                   // PA4 analog
+    CHECK_EQ(GPIOC->MODER & 3, 3);                                          // PC0 analog
+    adc1_scan_set_pipeline(1, test_pipe1);
+    adc1_scan_set_pipeline(2, test_pipe2);
+
+    // 1 kHz tetik: her tetik bütün sırayı dönüştürür, kanal başına 1 kHz
+    CHECK_EQ(adc1_set_sample_rate(1000), 1000);
+    adc1_stream_start(test_pipe0);
+    CHECK_EQ(adc1_scan_config(test_table, 1), 1);                           // Akış sürerken sıra değişmez
+    for (uint8_t k = 0; k < TEST_CHANNELS; k++) CHECK_EQ(adc1_read_index(k), ADC_NOT_READY);
+    CHECK_EQ(adc1_read_index(TEST_CHANNELS), ADC_NOT_READY);               // Sırada olmayan indeks
+
+    emu_run_us(1500);                                                       // İlk sıra dönüştürüldü
+    for (uint8_t k = 0; k < TEST_CHANNELS; k++) {
+        uint16_t v = adc1_read_index(k);
+        CHECK_EQ(v >> 8, k + 1);                                            // Her indeks kendi kanalının örneği
+    }
+    CHECK_EQ(adc1_read_index(TEST_CHANNELS), ADC_NOT_READY);               // Örnekler varken de 0 (geçerli bir ölçüm) değil
+    CHECK_EQ(adc1_read_index(ADC_MAX_CHANNELS), ADC_NOT_READY);
+    CHECK_EQ(adc1_read_index(0xFF), ADC_NOT_READY);
+
+    uint64_t start = emu_ns();
+    while (blocks < 10) emu_run_us(1000);
+    uint64_t ms = (emu_ns() - start) / 1000000;
+    printf("  3 kanal, 1 kHz: 10 blok (kanal başına 42 örnek) %lu ms, hata %u / %u / %u\n",
+           (unsigned long)ms, errors[0], errors[1], errors[2]);
+    for (uint8_t k = 0; k < TEST_CHANNELS; k++) {
+        CHECK_EQ(errors[k], 0);
+        CHECK_EQ(samples[k], 10 * 42);
+    }
+    CHECK(ms >= 9 * 42 && ms <= 10 * 42 + 2);                               // Yarım tampon 42 tetikte bir
+    CHECK_EQ(produced[0], produced[4]);                                     // Tetik başına sıranın tamamı
+    CHECK_EQ(produced[4], produced[10]);
+
+    for (uint8_t k = 0; k < TEST_CHANNELS; k++) {                           // En son örnek: o kanalın son sayacı (veya bir önceki)
+        uint16_t v = adc1_read_index(k);
+        uint16_t last = (uint16_t)((produced[test_table[k].channel] - 1) & 0xFF);
+        CHECK_EQ(v >> 8, k + 1);
+        CHECK((v & 0xFF) == last || (v & 0xFF) == ((last - 1) & 0xFF));
+    }
+
+    // Bir tetikteki sıra: kanal 0'dan sonra kanal 4 (144 + 12) ve kanal 10 (56 + 12) ADCCLK sonra biter
+    double gap_us = (at_ns[10] - at_ns[0]) / 1000.0;
+    double want_us = (144 + 12 + 56 + 12) * 1e6 / CLOCK_ADC_HZ;
+    printf("  sıra içi: kanal 0 → 10 arası %.2f µs (beklenen %.2f)\n", gap_us, want_us);
+    CHECK(gap_us > want_us - 0.05 && gap_us < want_us + 0.05);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,113 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "test.h"
+#include "scheduler.h"
+
+// sched_dispatch(): son tarih sınırı (tam sınırda biten görev kaçırmış sayılmaz), öncelik sırası, faz korunması,
+// atlanan periyotlar, tek seferlik görev ve millis() taşması
+
+#define TEST_PER_MS     1000            // Sahte sayaç: 1 ms = 1000 sayım
+
+static uint32_t fake_clock;
+static uint32_t work;                   // Bir sonraki çalışmanın "süresi" (sayım)
+static char order[16];
+static uint8_t order_len;
+
+static uint32_t test_clock(void)
+{
+    return fake_clock;
+}
+
+static void test_work(void)
+{
+    fake_clock += work;
+}
+
+static void test_a(void) { if (order_len < 15) order[order_len++] = 'a'; }
+static void test_b(void) { if (order_len < 15) order[order_len++] = 'b'; }
+
+static uint32_t test_missed_after(uint32_t late_ms, uint32_t elapsed)  // 10 ms son tarihli görev: geç başla, elapsed kadar çalış
+{
+    sched_init(test_clock, TEST_PER_MS);
+    uint8_t id = sched_add_oneshot("t", test_work, 1000, 0, 10);
+    const sched_task_t* t = sched_task(id);
+
+    work = elapsed;
+    sched_dispatch(1000 + late_ms);
+    return t->missed;                   // Tek seferlik görev bitince pasif olur ama kayıt okunabilir
+}
+
+int main(void)
+{
+    // Son tarih sınırı: tetiklenmeden bitişe tam 10 ms → kaçırılmadı, 1 sayım fazlası → kaçırıldı
+    CHECK_EQ(test_missed_after(0, 10 * TEST_PER_MS), 0);
+    CHECK_EQ(test_missed_after(0, 10 * TEST_PER_MS + 1), 1);
+    CHECK_EQ(test_missed_after(10, 0), 0);
+    CHECK_EQ(test_missed_after(11, 0), 1);
+    CHECK_EQ(test_missed_after(9, TEST_PER_MS), 0);
+    CHECK_EQ(test_missed_after(9, TEST_PER_MS + 1), 1);             // 1 ms'nin altındaki aşım da görülür
+    CHECK_EQ(test_missed_after(0, 9 * TEST_PER_MS + 999), 0);
+
+    // Sayaçsız: sadece gecikme, yine > ile
+    sched_init(NULL, 0);
+    uint8_t id = sched_add_oneshot("t", test_work, 0, 5, 3);
+    const sched_task_t* t = sched_task(id);
+    sched_dispatch(8);
+    CHECK_EQ(t->missed, 0);                                         // 3 ms geç: tam sınırda
+    CHECK_EQ(sched_task(id), NULL);                                 // Tek seferlik görev bitti
+    sched_init(NULL, 0);
+    id = sched_add_periodic("p", test_work, 0, 10, 0, 3);
+    sched_dispatch(4);
+    CHECK_EQ(sched_task(id)->missed, 1);
+    sched_dispatch(13);
+    CHECK_EQ(sched_task(id)->missed, 1);                            // 10'da tetiklendi, 13'te başladı: tam sınırda
+
+    // Öncelik: aynı anda tetiklenen görevlerde tablo sırası
+    sched_init(test_clock, TEST_PER_MS);
+    work = 0;
+    sched_add_periodic("a", test_a, 0, 10, 0, 0);
+    sched_add_periodic("b", test_b, 0, 5, 0, 0);
+    for (uint32_t now = 0; now <= 20; now++) sched_dispatch(now);
+    order[order_len] = '\0';
+    CHECK(order_len == 8 && order[0] == 'a' && order[1] == 'b');    // 0: a b, 5: b, 10: a b, 15: b, 20: a b
+    printf("  sıra: %s\n", order);
+
+    // Faz: geç çalışma periyodu kaydırmaz; bir periyottan fazla gecikme atlanır ve sayılır
+    sched_init(test_clock, TEST_PER_MS);
+    id = sched_add_periodic("p", test_work, 0, 100, 0, 0);
+    t = sched_task(id);
+    sched_dispatch(30);                                             // 30 ms geç: son tarih 100, kaçırılmadı
+    CHECK_EQ(t->release_ms, 100);
+    CHECK_EQ(t->missed, 0);
+    sched_dispatch(350);                                            // 100'deki çalışma 250 ms geç; 200 ve 300 atlandı
+    CHECK_EQ(t->runs, 2);
+    CHECK_EQ(t->missed, 1 + 2);
+    CHECK_EQ(t->release_ms, 400);
+
+    // WCET sayaç biriminde
+    work = 1234;
+    sched_dispatch(400);
+    CHECK_EQ(t->wcet, 1234);
+
+    // millis() taşması (49.7 gün)
+    sched_init(test_clock, TEST_PER_MS);
+    work = 0;
+    id = sched_add_periodic("w", test_work, 0xFFFFFFF0u, 10, 0, 0);
+    t = sched_task(id);
+    uint32_t runs = 0;
+    for (uint32_t now = 0xFFFFFFF0u; now != 40; now++) runs += sched_dispatch(now);
+    CHECK_EQ(runs, 6);                                              // -16, -6, 4, 14, 24, 34
+    CHECK_EQ(t->missed, 0);
+
+    // Tablo dolu / geçersiz parametre
+    sched_init(test_clock, TEST_PER_MS);
+    for (int i = 0; i < SCHED_MAX_TASKS; i++) CHECK(sched_add_periodic("x", test_work, 0, 1, 0, 0) != SCHED_INVALID);
+    CHECK_EQ(sched_add_periodic("x", test_work, 0, 1, 0, 0), SCHED_INVALID);
+    sched_cancel(3);
+    CHECK_EQ(sched_task(3), NULL);
+    CHECK_EQ(sched_add_oneshot("y", test_work, 0, 1, 0), 3);
+    CHECK_EQ(sched_add_periodic("z", test_work, 0, 0, 0, 0), SCHED_INVALID);
+    CHECK_EQ(sched_add_oneshot("z", NULL, 0, 1, 0), SCHED_INVALID);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,138 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <sys/time.h>
+#include "test.h"
+#include "timebase.h"
+#include "clock_config.h"
+
+// timebase: 64-bit sayaç CYCCNT'nin on binlerce taşmasında geriye gitmemeli ve gerçek zamanı aşmamalı. Okuyucu yazıcıyı
+// (SysTick) kesebilir, yazıcı okuyucuyu kesebilir; sinyal ile rastgele anlarda (kopyalar yazılırken dahil) okunur.
+// Sayaç timebase.c derlenirken TIMEBASE_COUNTER() ile test_counter()'a bağlanır (Makefile).
+
+enum { TEST_PLAIN, TEST_TICK_IN_READ, TEST_READ_IN_TICK, TEST_MODES, TEST_ASYNC = TEST_MODES };
+
+static const char* const test_mode_name[TEST_MODES] = { "sıralı", "okuma içinde tick", "tick içinde okuma" };
+
+static volatile uint64_t truth;         // Gerçek 64-bit cycle sayısı
+static uint8_t mode, in_tick, in_read;
+static volatile sig_atomic_t in_signal;
+static uint32_t nested_bad, nested_reads;
+static volatile uint32_t signal_bad, signal_reads;
+static volatile uint64_t signal_floor;  // Sinyal okuyucusunun görmesi gereken en küçük değer
+
+uint32_t test_counter(void)
+{
+    if (in_signal) return (uint32_t)truth;             // Sinyal içinde zaman ilerlemez: okuma anındaki gerçek değer
+
+    if (mode == TEST_ASYNC) truth += 0x7FFFFF00u + (truth & 0xFF);      // Kısa yol, iki tick'te bir taşma: hi sürekli değişir
+    else truth += 1 + (uint32_t)(rand() % 50000000);    // Okuma başına 0.3 sn'ye kadar: taşma SysTick'ten önce görülür
+    uint32_t v = (uint32_t)truth;
+
+    if (mode == TEST_TICK_IN_READ && !in_tick && !in_read && rand() % 3 == 0) {
+        in_tick = 1;                                    // Okuyucu CYCCNT'yi okurken SysTick kesmesi
+        timebase_tick();
+        in_tick = 0;
+    }
+    if (mode == TEST_READ_IN_TICK && in_tick && !in_read && rand() % 2 == 0) {
+        in_read = 1;                                    // Yazıcıyı kesen daha öncelikli kesme okur
+        uint64_t before = truth;
+        uint64_t c = timebase_cycles();
+        if (c < before || c > truth) nested_bad++;
+        nested_reads++;
+        in_read = 0;
+    }
+    return v;
+}
+
+static void test_signal(int sig)
+{
+    (void)sig;
+    in_signal = 1;
+    uint64_t c = timebase_cycles();
+    if (c < signal_floor || c > truth) signal_bad++;
+    signal_reads++;
+    in_signal = 0;
+}
+
+static void test_modes(void)
+{
+    for (mode = 0; mode < TEST_MODES; mode++) {
+        uint32_t bad = 0;
+        uint64_t prev = 0;
+
+        truth = 0;
+        timebase_init();
+        for (long i = 0; i < 2000000; i++) {
+            if (rand() % 2) {
+                in_tick = 1;
+                timebase_tick();
+                in_tick = 0;
+            }
+            uint64_t before = truth;
+            uint64_t c = timebase_cycles();
+            if (c < prev || c <= before || c > truth) bad++;
+            prev = c;
+        }
+        printf("  %s: %llu taşma, hata %u, tekrar okuma %u\n", test_mode_name[mode],
+               (unsigned long long)(truth >> 32), bad, timebase_retries());
+        CHECK_EQ(bad, 0);
+        CHECK(truth >> 32 > 10000);
+        if (mode == TEST_TICK_IN_READ) CHECK(timebase_retries() > 1000);      // Araya giren yazıcı görüldü
+    }
+    printf("  iç içe okuma: %u, hata %u\n", nested_reads, nested_bad);
+    CHECK(nested_reads > 100000);
+    CHECK_EQ(nested_bad, 0);
+}
+
+static void test_async(void)
+{
+    struct itimerval it = { { 0, 20 }, { 0, 20 } };     // Çekirdeğin izin verdiği en sık aralık
+    uint32_t bad = 0;
+    uint64_t prev = 0;
+
+    mode = TEST_ASYNC;
+    truth = 0;
+    signal_floor = 0;
+    timebase_init();
+    signal(SIGALRM, test_signal);
+    setitimer(ITIMER_REAL, &it, NULL);
+    for (long i = 0; signal_reads < 20000; i++) {
+        timebase_tick();                                // Döngü neredeyse sadece yazıcı: sinyal çoğu kez kopyalar yazılırken gelir
+        if (i % 64 == 0) {
+            uint64_t c = timebase_cycles();
+            if (c < prev || c > truth) bad++;
+            prev = c;
+            signal_floor = c;                           // Bundan sonraki her okuma en az bu kadar
+        }
+    }
+    it = (struct itimerval){ { 0, 0 }, { 0, 0 } };
+    setitimer(ITIMER_REAL, &it, NULL);
+    printf("  sinyal: %u okuma, %llu taşma, hata %u\n", signal_reads, (unsigned long long)(truth >> 32), signal_bad);
+    CHECK_EQ(bad, 0);
+    CHECK_EQ(signal_bad, 0);
+}
+
+static void test_convert(void)
+{
+    uint32_t bad = 0;
+
+    for (long i = 0; i < 2000000; i++) {
+        uint64_t x = ((uint64_t)rand() << 34 ^ (uint64_t)rand() << 3 ^ (uint64_t)rand()) & ((1ull << 56) - 1);
+        if (i < 1000) x = (1ull << 56) - 1 - i;         // Sınırın hemen altı
+        if (i >= 1000 && i < 2000) x = i - 1000;
+        if (timebase_cycles_to_us(x) != x / CLOCK_CYCLES_PER_US ||
+            timebase_cycles_to_ms(x) != x / (CLOCK_CYCLES_PER_US * 1000ull)) bad++;
+    }
+    CHECK_EQ(bad, 0);
+}
+
+int main(void)
+{
+    test_modes();
+    test_async();
+    test_convert();
+
+    return TEST_RESULT();
+}
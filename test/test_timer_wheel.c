@@ -0,0 +1,162 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "test.h"
+#include "emu.h"
+#include "mq2.h"
+#include "hrtimer.h"
+#include "timer_wheel.h"
+
+// timer_wheel: rastgele kurma / iptal / ilerletmede (callback içinden iptal, 32-bit zaman taşması dahil) her tek seferlik
+// zamanlayıcı tam zamanında, sırayla ve sadece kuruluyken çağrılmalı. hrtimer: callback'ler kesmeler açıkken çalışmalı,
+// uzun bir callback PRIMASK'ı tutmamalı ve daha öncelikli DMA kesmesi araya girebilmeli.
+
+#define TEST_TIMERS     2000
+
+static timer_wheel_t wheel;
+static timer_wheel_timer_t timers[TEST_TIMERS];
+static uint32_t want[TEST_TIMERS];          // Beklenen ilk çağrılma zamanı
+static uint8_t armed[TEST_TIMERS];
+static uint32_t last_fire, fires, errors;
+
+static void test_fire(void* arg)
+{
+    uint32_t i = (uint32_t)(uintptr_t)arg;
+    uint32_t now = wheel.now;
+
+    if (!armed[i]) errors++;                                // İptal edilmiş zamanlayıcı çağrıldı
+    if ((int32_t)(now - last_fire) < 0) errors++;           // Zaman geriye gitti
+    if (now != want[i]) errors++;                           // Erken veya geç
+    last_fire = now;
+    fires++;
+
+    if (timers[i].period) want[i] = timers[i].expires;     // Callback'ten önce yeniden kuruldu
+    else armed[i] = 0;
+
+    if (rand() % 10 == 0) {                                 // Callback içinden başka bir zamanlayıcıyı iptal
+        uint32_t j = (uint32_t)rand() % TEST_TIMERS;
+        timer_wheel_cancel(&wheel, &timers[j]);
+        armed[j] = 0;
+    }
+}
+
+static uint32_t test_delay(void)
+{
+    switch (rand() % 5) {
+    case 0: return (uint32_t)(rand() % 40);                 // 0. seviye, süresi geçmiş dahil
+    case 1: return (uint32_t)(rand() % 2000);
+    case 2: return (uint32_t)(rand() % 100000);
+    case 3: return (uint32_t)(rand() % 5000000);
+    default: return (uint32_t)rand() % 100000000u;          // En üst seviyeden de uzak (~100 sn)
+    }
+}
+
+static void test_random(void)
+{
+    uint32_t now = 0xFFF00000u;                             // Birkaç saniye içinde 32-bit taşma
+
+    timer_wheel_init(&wheel, now);
+    for (uint32_t i = 0; i < TEST_TIMERS; i++) timer_wheel_timer_init(&timers[i], test_fire, (void*)(uintptr_t)i);
+    last_fire = now;
+
+    for (uint32_t step = 0; step < 300000; step++) {
+        uint32_t i = (uint32_t)rand() % TEST_TIMERS;
+        switch (rand() % 4) {
+        case 0: {
+            uint32_t delay = test_delay();
+            uint32_t period = (rand() % 8 == 0) ? 20000 + test_delay() % 500000 : 0;
+            CHECK_EQ(timer_wheel_add(&wheel, &timers[i], now + delay, period), 0);
+            want[i] = now + delay;
+            if ((int32_t)(want[i] - wheel.now) < 0) want[i] = wheel.now;    // Çark geride: ilk fırsatta
+            armed[i] = 1;
+            break;
+        }
+        case 1:
+            timer_wheel_cancel(&wheel, &timers[i]);
+            armed[i] = 0;
+            break;
+        default:
+            now += (uint32_t)rand() % (rand() % 8 == 0 ? 300000 : 200);
+            timer_wheel_advance(&wheel, now);
+            break;
+        }
+    }
+
+    uint32_t overdue = 0, left = 0;
+    now += 200000000u;                                      // Her tek seferlik zamanlayıcının süresi dolar
+    timer_wheel_advance(&wheel, now);
+    for (uint32_t i = 0; i < TEST_TIMERS; i++) {
+        if (armed[i] && !timers[i].period) left++;
+        if (timer_wheel_is_pending(&timers[i]) && (int32_t)(now - timers[i].expires) >= 0) overdue++;
+    }
+    printf("  rastgele: %u çağrı, hata %u, çağrılmayan %u, süresi geçmiş bekleyen %u\n", fires, errors, left, overdue);
+    CHECK(fires > 100000);
+    CHECK_EQ(errors, 0);
+    CHECK_EQ(left, 0);
+    CHECK_EQ(overdue, 0);
+}
+
+#define TEST_BUSY_US    30000                               // Uzun callback: DMA yarı tamponu (12.8 ms) en az iki kez dolar
+
+static timer_wheel_timer_t busy_timer, quick_timer;
+static uint32_t busy_primask, busy_dma, busy_calls, quick_calls;
+
+static void test_block(const uint16_t* block, uint16_t count)
+{
+    (void)block;
+    (void)count;
+}
+
+static void test_quick(void* arg)
+{
+    (void)arg;
+    quick_calls++;
+}
+
+static void test_busy(void* arg)
+{
+    (void)arg;
+    uint32_t dma = emu_irq_stats(DMA2_Stream0_IRQn)->count;
+    uint32_t start = hrtimer_now();
+
+    busy_primask |= __get_PRIMASK();
+    while (hrtimer_now() - start < TEST_BUSY_US) { }
+    busy_dma += emu_irq_stats(DMA2_Stream0_IRQn)->count - dma;
+    busy_calls++;
+    hrtimer_start(&quick_timer, 100, 0);                    // Callback içinden kurulan zamanlayıcı kaybolmamalı
+}
+
+static void test_isr(void)
+{
+    emu_init();
+    emu_irq_attach(DMA2_Stream0_IRQn, DMA2_Stream0_IRQHandler);
+    emu_irq_attach(TIM2_IRQn, TIM2_IRQHandler);
+    hrtimer_init();
+    adc1_init();
+    CHECK_EQ(adc1_set_sample_rate(10000), 10000);
+    adc1_stream_start(test_block);
+
+    timer_wheel_timer_init(&busy_timer, test_busy, 0);
+    timer_wheel_timer_init(&quick_timer, test_quick, 0);
+    CHECK_EQ(hrtimer_start(&busy_timer, 1000, 40000), 0);
+    emu_run_us(130000);
+    hrtimer_cancel(&busy_timer);
+    emu_run_us(1000);
+
+    printf("  kesmede: %u uzun callback, PRIMASK %u, araya giren DMA %u, en uzun PRIMASK %llu ns, callback'ten kurulan %u\n",
+           busy_calls, busy_primask, busy_dma, (unsigned long long)emu_primask_max_ns(), quick_calls);
+    CHECK_EQ(busy_calls, 4);                                // 1, 41, 81, 121 ms
+    CHECK_EQ(busy_primask, 0);
+    CHECK(busy_dma >= 2 * busy_calls);                      // DMA kesmesi callback sürerken işlendi
+    CHECK(emu_primask_max_ns() < 20000);                    // Callback süresi kilidin içinde değil
+    CHECK_EQ(quick_calls, busy_calls);
+    CHECK_EQ(hrtimer_pending(), 0);
+}
+
+int main(void)
+{
+    test_random();
+    test_isr();
+
+    return TEST_RESULT();
+}
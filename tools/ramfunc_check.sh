@@ -0,0 +1,49 @@
+#!/bin/sh
+#
+# ramfunc_check: ELF'teki sıcak yol fonksiyonlarının (static olanlar dahil) .RamFunc içinde, yani SRAM'de olduğunu denetler.
+# Linker script'teki ASSERT'ler sadece global sembolleri görebilir; static yardımcılar sembol tablosundan okunur.
+#
+# Kullanım (link sonrası adım olarak):
+#	tools/ramfunc_check.sh Debug/gaz.elf
+#	NM=/opt/gcc-arm/bin/arm-none-eabi-nm tools/ramfunc_check.sh gaz.elf
+#
+# Çıkış kodu 0: hepsi SRAM'de. 1: en az biri flash'ta, yok (inline edilmiş / derlenmemiş) veya .RamFunc boş (MEM_PLACEMENT=0).
+#
+
+ELF=${1:?"kullanım: $0 <elf>"}
+NM=${NM:-arm-none-eabi-nm}
+
+SYMS="ADC_IRQHandler gas_alarm_arm gas_alarm_relay_set gas_alarm_apply gas_alarm_release
+TIM2_IRQHandler hrtimer_now hrtimer_program hrtimer_start hrtimer_cancel hrtimer_expire
+timer_wheel_add timer_wheel_cancel timer_wheel_next timer_wheel_expire tw_link tw_unlink
+SysTick_Handler timebase_tick timebase_cycles
+DMA2_Stream0_IRQHandler adc_dispatch oversample_process
+flash_erase_sector flash_program_word flash_wait flash_check_errors"
+
+TABLE=$("$NM" "$ELF") || exit 1
+
+addr() {
+	echo "$TABLE" | awk -v s="$1" '$3 == s { print $1; exit }'
+}
+
+start=$(addr _sramfunc)
+end=$(addr _eramfunc)
+if [ -z "$start" ] || [ -z "$end" ] || [ "$start" = "$end" ]; then
+	echo "ramfunc_check: .RamFunc yok veya boş (_sramfunc / _eramfunc)"
+	exit 1
+fi
+
+fail=0
+for s in $SYMS; do
+	a=$(addr "$s")
+	if [ -z "$a" ]; then
+		echo "ramfunc_check: $s sembol tablosunda yok"
+		fail=1
+	elif [ $((0x$a)) -lt $((0x$start)) ] || [ $((0x$a)) -ge $((0x$end)) ]; then
+		echo "ramfunc_check: $s 0x$a, .RamFunc (0x$start-0x$end) dışında"
+		fail=1
+	fi
+done
+
+[ $fail -eq 0 ] && echo "ramfunc_check: $(echo $SYMS | wc -w) fonksiyon .RamFunc içinde"
+exit $fail
@@ -0,0 +1,93 @@
+/*
+
+telemetry_decode: USART3 telemetri akışını (COBS + CRC16 çerçeveler) CSV'ye çevirir.
+
+Derleme (bilgisayarda):
+	gcc -O2 -IInc -o telemetry_decode tools/telemetry_decode.c Src/telemetry_frame.c
+
+Kullanım:
+	stty -F /dev/ttyUSB0 115200 raw && cat /dev/ttyUSB0 | ./telemetry_decode > kayit.csv
+	./telemetry_decode < yakalama.bin > kayit.csv
+
+Çıktı satırları (ilk sütun kayıt tipi):
+	sample,seq,t_ms,channel,value
+	status,seq,t_ms,alarm,trips,latency_max_cycles,ppm,calib_state
+	relay,seq,t_ms,state,trips
+	Bozuk çerçeve ve seq atlamaları sonunda stderr'e özet olarak yazılır.
+
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include "telemetry_frame.h"
+
+static void print_frame(const telemetry_frame_t* f)
+{
+    const uint8_t* p = f->payload;
+
+    switch (f->type) {
+    case TELEMETRY_SAMPLES: {
+        if (f->len < 4) break;
+        uint8_t channel = p[0];
+        uint8_t count = p[1];
+        uint16_t period_us = telemetry_get_u16(&p[2]);
+        if (f->len < 4 + 2 * count) break;
+        for (uint8_t i = 0; i < count; i++) {
+            double t = f->timestamp_ms - (double)(count - 1 - i) * period_us / 1000.0;   // Damga son örneğe ait
+            printf("sample,%u,%.3f,%u,%u\n", f->seq, t, channel, telemetry_get_u16(&p[4 + 2 * i]));
+        }
+        return;
+    }
+    case TELEMETRY_STATUS:
+        if (f->len < 14) break;
+        printf("status,%u,%lu,%u,%lu,%lu,%lu,%u\n", f->seq, (unsigned long)f->timestamp_ms, p[0],
+               (unsigned long)telemetry_get_u32(&p[1]), (unsigned long)telemetry_get_u32(&p[5]),
+               (unsigned long)telemetry_get_u32(&p[9]), p[13]);
+        return;
+    case TELEMETRY_RELAY:
+        if (f->len < 5) break;
+        printf("relay,%u,%lu,%u,%lu\n", f->seq, (unsigned long)f->timestamp_ms, p[0],
+               (unsigned long)telemetry_get_u32(&p[1]));
+        return;
+    default:
+        break;
+    }
+    printf("unknown,%u,%lu,%u\n", f->seq, (unsigned long)f->timestamp_ms, f->type);
+}
+
+int main(void)
+{
+    uint8_t buf[TELEMETRY_FRAME_MAX];
+    uint16_t len = 0;
+    uint8_t overflow = 0;
+    unsigned long good = 0, bad = 0, lost = 0;
+    int have_seq = 0;
+    uint8_t next_seq = 0;
+    int c;
+
+    while ((c = getchar()) != EOF) {
+        if (c != TELEMETRY_DELIMITER) {
+            if (len < sizeof(buf)) buf[len++] = (uint8_t)c;
+            else overflow = 1;
+            continue;
+        }
+
+        telemetry_frame_t f;
+        if (len == 0) {
+            continue;                                   // Boş çerçeve (art arda ayırıcı)
+        } else if (overflow || telemetry_frame_parse(buf, len, &f)) {
+            bad++;
+        } else {
+            if (have_seq && f.seq != next_seq) lost += (uint8_t)(f.seq - next_seq);
+            have_seq = 1;
+            next_seq = f.seq + 1;
+            good++;
+            print_frame(&f);
+        }
+        len = 0;
+        overflow = 0;
+    }
+
+    fprintf(stderr, "frames: %lu ok, %lu bad, %lu lost (seq gaps)\n", good, bad, lost);
+    return 0;
+}